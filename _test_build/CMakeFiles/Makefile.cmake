@@ -0,0 +1,134 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/cmake/DetectFlags.cmake"
+  "/root/repo/cmake/DetectHeaders.cmake"
+  "/root/repo/cmake/DetectIntrinsics.cmake"
+  "/root/repo/cmake/DetectLibraries.cmake"
+  "/root/repo/cmake/MakeDoc.cmake"
+  "/root/repo/source/libakrypt-base.h.in"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCheckCompilerFlagCommonPatterns.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CPack.cmake"
+  "/usr/share/cmake-3.25/Modules/CPackComponent.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCCompilerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFileCXX.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckTypeSize.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindGettext.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/GNUInstallDirs.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckCompilerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckFlagCommonConfig.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  "/usr/share/cmake-3.25/Modules/TestBigEndian.cmake"
+  "/usr/share/cmake-3.25/Templates/CPackConfig.cmake.in"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "libakrypt-base.h"
+  "CPackConfig.cmake"
+  "CPackSourceConfig.cmake"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/akbase-shared.dir/DependInfo.cmake"
+  "CMakeFiles/akrypt-shared.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-log.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-ini.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-ini-file.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-file.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-mmap.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-realpath.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-0.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-1.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-2.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-3.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-4.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-5.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-6.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-7.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-8.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-9.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-11.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-12.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-13.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-14.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-15.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-16.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-17.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-18.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-19.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-20.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-21.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-22.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-24.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-25.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-26.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-27.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-30.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-31.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-32.dir/DependInfo.cmake"
+  "CMakeFiles/example-shared-33.dir/DependInfo.cmake"
+  "CMakeFiles/test-random01.dir/DependInfo.cmake"
+  "CMakeFiles/test-gf2n.dir/DependInfo.cmake"
+  "CMakeFiles/test-mgm01.dir/DependInfo.cmake"
+  "CMakeFiles/test-xtsmac01.dir/DependInfo.cmake"
+  "CMakeFiles/test-aead.dir/DependInfo.cmake"
+  "CMakeFiles/test-asn1-build.dir/DependInfo.cmake"
+  "CMakeFiles/test-asn1-parse.dir/DependInfo.cmake"
+  "CMakeFiles/test-sign01.dir/DependInfo.cmake"
+  "CMakeFiles/test-asn1-keys.dir/DependInfo.cmake"
+  "CMakeFiles/test-asn1-keys02.dir/DependInfo.cmake"
+  "CMakeFiles/test-blom-keys.dir/DependInfo.cmake"
+  "CMakeFiles/test-cmac01.dir/DependInfo.cmake"
+  "CMakeFiles/test-cmac02.dir/DependInfo.cmake"
+  "CMakeFiles/test-hmac.dir/DependInfo.cmake"
+  "CMakeFiles/test-kdf-state.dir/DependInfo.cmake"
+  "CMakeFiles/test-ctr-parallel.dir/DependInfo.cmake"
+  "CMakeFiles/test-hash-multi.dir/DependInfo.cmake"
+  "CMakeFiles/test-wpoint-pow.dir/DependInfo.cmake"
+  "CMakeFiles/test-mpzn-inverse.dir/DependInfo.cmake"
+  "CMakeFiles/test-sign-batch.dir/DependInfo.cmake"
+  "CMakeFiles/test-encrypt-file.dir/DependInfo.cmake"
+  "CMakeFiles/test-mac-file.dir/DependInfo.cmake"
+  "CMakeFiles/test-hash-tree.dir/DependInfo.cmake"
+  "CMakeFiles/test-log-ring.dir/DependInfo.cmake"
+  "CMakeFiles/test-oid-index.dir/DependInfo.cmake"
+  "CMakeFiles/test-asn1-arena.dir/DependInfo.cmake"
+  "CMakeFiles/test-skey-mask.dir/DependInfo.cmake"
+  "CMakeFiles/aktool.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,30 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/source/ak_base64.c" "CMakeFiles/akbase-shared.dir/source/ak_base64.c.o" "gcc" "CMakeFiles/akbase-shared.dir/source/ak_base64.c.o.d"
+  "/root/repo/source/ak_file.c" "CMakeFiles/akbase-shared.dir/source/ak_file.c.o" "gcc" "CMakeFiles/akbase-shared.dir/source/ak_file.c.o.d"
+  "/root/repo/source/ak_ini.c" "CMakeFiles/akbase-shared.dir/source/ak_ini.c.o" "gcc" "CMakeFiles/akbase-shared.dir/source/ak_ini.c.o.d"
+  "/root/repo/source/ak_list.c" "CMakeFiles/akbase-shared.dir/source/ak_list.c.o" "gcc" "CMakeFiles/akbase-shared.dir/source/ak_list.c.o.d"
+  "/root/repo/source/ak_tools.c" "CMakeFiles/akbase-shared.dir/source/ak_tools.c.o" "gcc" "CMakeFiles/akbase-shared.dir/source/ak_tools.c.o.d"
+  )
+
+# Pairs of files generated by the same build rule.
+set(CMAKE_MULTIPLE_OUTPUT_PAIRS
+  "/root/repo/_test_build/libakrypt-base.so" "/root/repo/_test_build/libakrypt-base.so.0.9"
+  "/root/repo/_test_build/libakrypt-base.so.0.9.10" "/root/repo/_test_build/libakrypt-base.so.0.9"
+  )
+
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,21 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/akbase-shared.dir/source/ak_base64.c.o"
+  "CMakeFiles/akbase-shared.dir/source/ak_base64.c.o.d"
+  "CMakeFiles/akbase-shared.dir/source/ak_file.c.o"
+  "CMakeFiles/akbase-shared.dir/source/ak_file.c.o.d"
+  "CMakeFiles/akbase-shared.dir/source/ak_ini.c.o"
+  "CMakeFiles/akbase-shared.dir/source/ak_ini.c.o.d"
+  "CMakeFiles/akbase-shared.dir/source/ak_list.c.o"
+  "CMakeFiles/akbase-shared.dir/source/ak_list.c.o.d"
+  "CMakeFiles/akbase-shared.dir/source/ak_tools.c.o"
+  "CMakeFiles/akbase-shared.dir/source/ak_tools.c.o.d"
+  "libakrypt-base.pdb"
+  "libakrypt-base.so"
+  "libakrypt-base.so.0.9"
+  "libakrypt-base.so.0.9.10"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/akbase-shared.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,54 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/source/ak_acpkm.c" "CMakeFiles/akrypt-shared.dir/source/ak_acpkm.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_acpkm.c.o.d"
+  "/root/repo/source/ak_aead.c" "CMakeFiles/akrypt-shared.dir/source/ak_aead.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_aead.c.o.d"
+  "/root/repo/source/ak_asn1.c" "CMakeFiles/akrypt-shared.dir/source/ak_asn1.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_asn1.c.o.d"
+  "/root/repo/source/ak_asn1_cert.c" "CMakeFiles/akrypt-shared.dir/source/ak_asn1_cert.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_asn1_cert.c.o.d"
+  "/root/repo/source/ak_asn1_keys.c" "CMakeFiles/akrypt-shared.dir/source/ak_asn1_keys.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_asn1_keys.c.o.d"
+  "/root/repo/source/ak_bckey.c" "CMakeFiles/akrypt-shared.dir/source/ak_bckey.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_bckey.c.o.d"
+  "/root/repo/source/ak_blom.c" "CMakeFiles/akrypt-shared.dir/source/ak_blom.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_blom.c.o.d"
+  "/root/repo/source/ak_cmac.c" "CMakeFiles/akrypt-shared.dir/source/ak_cmac.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_cmac.c.o.d"
+  "/root/repo/source/ak_curves.c" "CMakeFiles/akrypt-shared.dir/source/ak_curves.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_curves.c.o.d"
+  "/root/repo/source/ak_encrypt.c" "CMakeFiles/akrypt-shared.dir/source/ak_encrypt.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_encrypt.c.o.d"
+  "/root/repo/source/ak_gf2n.c" "CMakeFiles/akrypt-shared.dir/source/ak_gf2n.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_gf2n.c.o.d"
+  "/root/repo/source/ak_hash.c" "CMakeFiles/akrypt-shared.dir/source/ak_hash.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_hash.c.o.d"
+  "/root/repo/source/ak_hmac.c" "CMakeFiles/akrypt-shared.dir/source/ak_hmac.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_hmac.c.o.d"
+  "/root/repo/source/ak_kdf.c" "CMakeFiles/akrypt-shared.dir/source/ak_kdf.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_kdf.c.o.d"
+  "/root/repo/source/ak_kuznechik.c" "CMakeFiles/akrypt-shared.dir/source/ak_kuznechik.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_kuznechik.c.o.d"
+  "/root/repo/source/ak_libakrypt.c" "CMakeFiles/akrypt-shared.dir/source/ak_libakrypt.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_libakrypt.c.o.d"
+  "/root/repo/source/ak_mac.c" "CMakeFiles/akrypt-shared.dir/source/ak_mac.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_mac.c.o.d"
+  "/root/repo/source/ak_magma.c" "CMakeFiles/akrypt-shared.dir/source/ak_magma.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_magma.c.o.d"
+  "/root/repo/source/ak_mgm.c" "CMakeFiles/akrypt-shared.dir/source/ak_mgm.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_mgm.c.o.d"
+  "/root/repo/source/ak_mpzn.c" "CMakeFiles/akrypt-shared.dir/source/ak_mpzn.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_mpzn.c.o.d"
+  "/root/repo/source/ak_oid.c" "CMakeFiles/akrypt-shared.dir/source/ak_oid.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_oid.c.o.d"
+  "/root/repo/source/ak_options.c" "CMakeFiles/akrypt-shared.dir/source/ak_options.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_options.c.o.d"
+  "/root/repo/source/ak_parameters.c" "CMakeFiles/akrypt-shared.dir/source/ak_parameters.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_parameters.c.o.d"
+  "/root/repo/source/ak_random.c" "CMakeFiles/akrypt-shared.dir/source/ak_random.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_random.c.o.d"
+  "/root/repo/source/ak_sign.c" "CMakeFiles/akrypt-shared.dir/source/ak_sign.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_sign.c.o.d"
+  "/root/repo/source/ak_skey.c" "CMakeFiles/akrypt-shared.dir/source/ak_skey.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_skey.c.o.d"
+  "/root/repo/source/ak_xts.c" "CMakeFiles/akrypt-shared.dir/source/ak_xts.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_xts.c.o.d"
+  "/root/repo/source/ak_xtsmac.c" "CMakeFiles/akrypt-shared.dir/source/ak_xtsmac.c.o" "gcc" "CMakeFiles/akrypt-shared.dir/source/ak_xtsmac.c.o.d"
+  )
+
+# Pairs of files generated by the same build rule.
+set(CMAKE_MULTIPLE_OUTPUT_PAIRS
+  "/root/repo/_test_build/libakrypt.so" "/root/repo/_test_build/libakrypt.so.0.9"
+  "/root/repo/_test_build/libakrypt.so.0.9.10" "/root/repo/_test_build/libakrypt.so.0.9"
+  )
+
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_test_build/CMakeFiles/akbase-shared.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
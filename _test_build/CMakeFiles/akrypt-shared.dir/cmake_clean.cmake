@@ -0,0 +1,67 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/akrypt-shared.dir/source/ak_acpkm.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_acpkm.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_aead.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_aead.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_asn1.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_asn1.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_asn1_cert.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_asn1_cert.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_asn1_keys.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_asn1_keys.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_bckey.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_bckey.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_blom.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_blom.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_cmac.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_cmac.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_curves.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_curves.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_encrypt.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_encrypt.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_gf2n.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_gf2n.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_hash.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_hash.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_hmac.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_hmac.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_kdf.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_kdf.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_kuznechik.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_kuznechik.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_libakrypt.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_libakrypt.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_mac.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_mac.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_magma.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_magma.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_mgm.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_mgm.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_mpzn.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_mpzn.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_oid.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_oid.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_options.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_options.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_parameters.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_parameters.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_random.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_random.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_sign.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_sign.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_skey.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_skey.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_xts.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_xts.c.o.d"
+  "CMakeFiles/akrypt-shared.dir/source/ak_xtsmac.c.o"
+  "CMakeFiles/akrypt-shared.dir/source/ak_xtsmac.c.o.d"
+  "libakrypt.pdb"
+  "libakrypt.so"
+  "libakrypt.so.0.9"
+  "libakrypt.so.0.9.10"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/akrypt-shared.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
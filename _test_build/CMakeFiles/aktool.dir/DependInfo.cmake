@@ -0,0 +1,27 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/aktool/aktool.c" "CMakeFiles/aktool.dir/aktool/aktool.c.o" "gcc" "CMakeFiles/aktool.dir/aktool/aktool.c.o.d"
+  "/root/repo/aktool/aktool_asn1.c" "CMakeFiles/aktool.dir/aktool/aktool_asn1.c.o" "gcc" "CMakeFiles/aktool.dir/aktool/aktool_asn1.c.o.d"
+  "/root/repo/aktool/aktool_encrypt.c" "CMakeFiles/aktool.dir/aktool/aktool_encrypt.c.o" "gcc" "CMakeFiles/aktool.dir/aktool/aktool_encrypt.c.o.d"
+  "/root/repo/aktool/aktool_icode.c" "CMakeFiles/aktool.dir/aktool/aktool_icode.c.o" "gcc" "CMakeFiles/aktool.dir/aktool/aktool_icode.c.o.d"
+  "/root/repo/aktool/aktool_key.c" "CMakeFiles/aktool.dir/aktool/aktool_key.c.o" "gcc" "CMakeFiles/aktool.dir/aktool/aktool_key.c.o.d"
+  "/root/repo/aktool/aktool_show.c" "CMakeFiles/aktool.dir/aktool/aktool_show.c.o" "gcc" "CMakeFiles/aktool.dir/aktool/aktool_show.c.o.d"
+  "/root/repo/aktool/aktool_test.c" "CMakeFiles/aktool.dir/aktool/aktool_test.c.o" "gcc" "CMakeFiles/aktool.dir/aktool/aktool_test.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_test_build/CMakeFiles/akrypt-shared.dir/DependInfo.cmake"
+  "/root/repo/_test_build/CMakeFiles/akbase-shared.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,23 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/aktool.dir/aktool/aktool.c.o"
+  "CMakeFiles/aktool.dir/aktool/aktool.c.o.d"
+  "CMakeFiles/aktool.dir/aktool/aktool_asn1.c.o"
+  "CMakeFiles/aktool.dir/aktool/aktool_asn1.c.o.d"
+  "CMakeFiles/aktool.dir/aktool/aktool_encrypt.c.o"
+  "CMakeFiles/aktool.dir/aktool/aktool_encrypt.c.o.d"
+  "CMakeFiles/aktool.dir/aktool/aktool_icode.c.o"
+  "CMakeFiles/aktool.dir/aktool/aktool_icode.c.o.d"
+  "CMakeFiles/aktool.dir/aktool/aktool_key.c.o"
+  "CMakeFiles/aktool.dir/aktool/aktool_key.c.o.d"
+  "CMakeFiles/aktool.dir/aktool/aktool_show.c.o"
+  "CMakeFiles/aktool.dir/aktool/aktool_show.c.o.d"
+  "CMakeFiles/aktool.dir/aktool/aktool_test.c.o"
+  "CMakeFiles/aktool.dir/aktool/aktool_test.c.o.d"
+  "aktool"
+  "aktool.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/aktool.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-0.dir/examples/faq/example-0.c.o"
+  "CMakeFiles/example-shared-0.dir/examples/faq/example-0.c.o.d"
+  "example-shared-0"
+  "example-shared-0.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-0.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-1.dir/examples/faq/example-1.c.o"
+  "CMakeFiles/example-shared-1.dir/examples/faq/example-1.c.o.d"
+  "example-shared-1"
+  "example-shared-1.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-1.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
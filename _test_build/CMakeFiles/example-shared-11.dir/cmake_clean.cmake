@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-11.dir/examples/faq/example-11.c.o"
+  "CMakeFiles/example-shared-11.dir/examples/faq/example-11.c.o.d"
+  "example-shared-11"
+  "example-shared-11.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-11.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-12.dir/examples/faq/example-12.c.o"
+  "CMakeFiles/example-shared-12.dir/examples/faq/example-12.c.o.d"
+  "example-shared-12"
+  "example-shared-12.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-12.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
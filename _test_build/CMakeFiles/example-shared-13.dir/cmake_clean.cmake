@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-13.dir/examples/faq/example-13.c.o"
+  "CMakeFiles/example-shared-13.dir/examples/faq/example-13.c.o.d"
+  "example-shared-13"
+  "example-shared-13.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-13.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-14.dir/examples/faq/example-14.c.o"
+  "CMakeFiles/example-shared-14.dir/examples/faq/example-14.c.o.d"
+  "example-shared-14"
+  "example-shared-14.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-14.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-15.dir/examples/faq/example-15.c.o"
+  "CMakeFiles/example-shared-15.dir/examples/faq/example-15.c.o.d"
+  "example-shared-15"
+  "example-shared-15.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-15.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-16.dir/examples/faq/example-16.c.o"
+  "CMakeFiles/example-shared-16.dir/examples/faq/example-16.c.o.d"
+  "example-shared-16"
+  "example-shared-16.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-16.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
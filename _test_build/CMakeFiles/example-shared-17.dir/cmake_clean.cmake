@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-17.dir/examples/faq/example-17.c.o"
+  "CMakeFiles/example-shared-17.dir/examples/faq/example-17.c.o.d"
+  "example-shared-17"
+  "example-shared-17.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-17.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-18.dir/examples/faq/example-18.c.o"
+  "CMakeFiles/example-shared-18.dir/examples/faq/example-18.c.o.d"
+  "example-shared-18"
+  "example-shared-18.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-18.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
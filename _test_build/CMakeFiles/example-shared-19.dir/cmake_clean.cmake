@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-19.dir/examples/faq/example-19.c.o"
+  "CMakeFiles/example-shared-19.dir/examples/faq/example-19.c.o.d"
+  "example-shared-19"
+  "example-shared-19.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-19.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-2.dir/examples/faq/example-2.c.o"
+  "CMakeFiles/example-shared-2.dir/examples/faq/example-2.c.o.d"
+  "example-shared-2"
+  "example-shared-2.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-2.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
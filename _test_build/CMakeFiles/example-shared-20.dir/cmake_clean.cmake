@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-20.dir/examples/faq/example-20.c.o"
+  "CMakeFiles/example-shared-20.dir/examples/faq/example-20.c.o.d"
+  "example-shared-20"
+  "example-shared-20.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-20.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-21.dir/examples/faq/example-21.c.o"
+  "CMakeFiles/example-shared-21.dir/examples/faq/example-21.c.o.d"
+  "example-shared-21"
+  "example-shared-21.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-21.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-22.dir/examples/faq/example-22.c.o"
+  "CMakeFiles/example-shared-22.dir/examples/faq/example-22.c.o.d"
+  "example-shared-22"
+  "example-shared-22.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-22.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
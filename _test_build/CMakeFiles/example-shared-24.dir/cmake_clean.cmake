@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-24.dir/examples/faq/example-24.c.o"
+  "CMakeFiles/example-shared-24.dir/examples/faq/example-24.c.o.d"
+  "example-shared-24"
+  "example-shared-24.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-24.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
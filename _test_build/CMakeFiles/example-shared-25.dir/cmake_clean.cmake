@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-25.dir/examples/faq/example-25.c.o"
+  "CMakeFiles/example-shared-25.dir/examples/faq/example-25.c.o.d"
+  "example-shared-25"
+  "example-shared-25.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-25.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-26.dir/examples/faq/example-26.c.o"
+  "CMakeFiles/example-shared-26.dir/examples/faq/example-26.c.o.d"
+  "example-shared-26"
+  "example-shared-26.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-26.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-27.dir/examples/faq/example-27.c.o"
+  "CMakeFiles/example-shared-27.dir/examples/faq/example-27.c.o.d"
+  "example-shared-27"
+  "example-shared-27.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-27.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
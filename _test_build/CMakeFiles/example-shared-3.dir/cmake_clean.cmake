@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-3.dir/examples/faq/example-3.c.o"
+  "CMakeFiles/example-shared-3.dir/examples/faq/example-3.c.o.d"
+  "example-shared-3"
+  "example-shared-3.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-3.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-30.dir/examples/faq/example-30.c.o"
+  "CMakeFiles/example-shared-30.dir/examples/faq/example-30.c.o.d"
+  "example-shared-30"
+  "example-shared-30.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-30.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
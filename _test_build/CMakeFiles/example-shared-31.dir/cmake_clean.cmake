@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-31.dir/examples/faq/example-31.c.o"
+  "CMakeFiles/example-shared-31.dir/examples/faq/example-31.c.o.d"
+  "example-shared-31"
+  "example-shared-31.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-31.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-32.dir/examples/faq/example-32.c.o"
+  "CMakeFiles/example-shared-32.dir/examples/faq/example-32.c.o.d"
+  "example-shared-32"
+  "example-shared-32.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-32.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
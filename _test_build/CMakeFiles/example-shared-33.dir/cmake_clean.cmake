@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-33.dir/examples/faq/example-33.c.o"
+  "CMakeFiles/example-shared-33.dir/examples/faq/example-33.c.o.d"
+  "example-shared-33"
+  "example-shared-33.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-33.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
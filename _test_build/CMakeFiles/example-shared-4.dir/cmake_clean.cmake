@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-4.dir/examples/faq/example-4.c.o"
+  "CMakeFiles/example-shared-4.dir/examples/faq/example-4.c.o.d"
+  "example-shared-4"
+  "example-shared-4.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-4.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-5.dir/examples/faq/example-5.c.o"
+  "CMakeFiles/example-shared-5.dir/examples/faq/example-5.c.o.d"
+  "example-shared-5"
+  "example-shared-5.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-5.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
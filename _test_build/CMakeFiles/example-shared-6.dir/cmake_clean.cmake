@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-6.dir/examples/faq/example-6.c.o"
+  "CMakeFiles/example-shared-6.dir/examples/faq/example-6.c.o.d"
+  "example-shared-6"
+  "example-shared-6.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-6.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
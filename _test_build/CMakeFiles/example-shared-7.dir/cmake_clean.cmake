@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-7.dir/examples/faq/example-7.c.o"
+  "CMakeFiles/example-shared-7.dir/examples/faq/example-7.c.o.d"
+  "example-shared-7"
+  "example-shared-7.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-7.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-8.dir/examples/faq/example-8.c.o"
+  "CMakeFiles/example-shared-8.dir/examples/faq/example-8.c.o.d"
+  "example-shared-8"
+  "example-shared-8.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-8.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
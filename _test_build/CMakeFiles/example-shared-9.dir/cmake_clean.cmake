@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-9.dir/examples/faq/example-9.c.o"
+  "CMakeFiles/example-shared-9.dir/examples/faq/example-9.c.o.d"
+  "example-shared-9"
+  "example-shared-9.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-9.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
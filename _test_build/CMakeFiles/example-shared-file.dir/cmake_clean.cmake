@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-file.dir/examples/akbase/example-file.c.o"
+  "CMakeFiles/example-shared-file.dir/examples/akbase/example-file.c.o.d"
+  "example-shared-file"
+  "example-shared-file.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-file.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
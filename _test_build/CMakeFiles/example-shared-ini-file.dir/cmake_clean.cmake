@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-ini-file.dir/examples/akbase/example-ini-file.c.o"
+  "CMakeFiles/example-shared-ini-file.dir/examples/akbase/example-ini-file.c.o.d"
+  "example-shared-ini-file"
+  "example-shared-ini-file.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-ini-file.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-ini.dir/examples/akbase/example-ini.c.o"
+  "CMakeFiles/example-shared-ini.dir/examples/akbase/example-ini.c.o.d"
+  "example-shared-ini"
+  "example-shared-ini.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-ini.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
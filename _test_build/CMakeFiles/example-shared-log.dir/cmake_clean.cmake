@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-log.dir/examples/akbase/example-log.c.o"
+  "CMakeFiles/example-shared-log.dir/examples/akbase/example-log.c.o.d"
+  "example-shared-log"
+  "example-shared-log.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-log.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
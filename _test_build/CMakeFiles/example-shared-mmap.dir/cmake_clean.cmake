@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-mmap.dir/examples/akbase/example-mmap.c.o"
+  "CMakeFiles/example-shared-mmap.dir/examples/akbase/example-mmap.c.o.d"
+  "example-shared-mmap"
+  "example-shared-mmap.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-mmap.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example-shared-realpath.dir/examples/akbase/example-realpath.c.o"
+  "CMakeFiles/example-shared-realpath.dir/examples/akbase/example-realpath.c.o.d"
+  "example-shared-realpath"
+  "example-shared-realpath.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example-shared-realpath.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
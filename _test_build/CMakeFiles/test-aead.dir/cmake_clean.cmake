@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-aead.dir/examples/tests/test-aead.c.o"
+  "CMakeFiles/test-aead.dir/examples/tests/test-aead.c.o.d"
+  "test-aead"
+  "test-aead.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-aead.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-asn1-arena.dir/examples/tests/test-asn1-arena.c.o"
+  "CMakeFiles/test-asn1-arena.dir/examples/tests/test-asn1-arena.c.o.d"
+  "test-asn1-arena"
+  "test-asn1-arena.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-asn1-arena.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-asn1-build.dir/examples/tests/test-asn1-build.c.o"
+  "CMakeFiles/test-asn1-build.dir/examples/tests/test-asn1-build.c.o.d"
+  "test-asn1-build"
+  "test-asn1-build.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-asn1-build.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
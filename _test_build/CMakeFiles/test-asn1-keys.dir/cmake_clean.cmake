@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-asn1-keys.dir/examples/tests/test-asn1-keys.c.o"
+  "CMakeFiles/test-asn1-keys.dir/examples/tests/test-asn1-keys.c.o.d"
+  "test-asn1-keys"
+  "test-asn1-keys.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-asn1-keys.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
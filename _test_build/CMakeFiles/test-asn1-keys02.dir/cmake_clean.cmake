@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-asn1-keys02.dir/examples/tests/test-asn1-keys02.c.o"
+  "CMakeFiles/test-asn1-keys02.dir/examples/tests/test-asn1-keys02.c.o.d"
+  "test-asn1-keys02"
+  "test-asn1-keys02.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-asn1-keys02.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-asn1-parse.dir/examples/tests/test-asn1-parse.c.o"
+  "CMakeFiles/test-asn1-parse.dir/examples/tests/test-asn1-parse.c.o.d"
+  "test-asn1-parse"
+  "test-asn1-parse.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-asn1-parse.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
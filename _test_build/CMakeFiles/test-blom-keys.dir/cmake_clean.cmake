@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-blom-keys.dir/examples/tests/test-blom-keys.c.o"
+  "CMakeFiles/test-blom-keys.dir/examples/tests/test-blom-keys.c.o.d"
+  "test-blom-keys"
+  "test-blom-keys.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-blom-keys.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
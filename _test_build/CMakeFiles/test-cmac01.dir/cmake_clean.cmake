@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-cmac01.dir/examples/tests/test-cmac01.c.o"
+  "CMakeFiles/test-cmac01.dir/examples/tests/test-cmac01.c.o.d"
+  "test-cmac01"
+  "test-cmac01.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-cmac01.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
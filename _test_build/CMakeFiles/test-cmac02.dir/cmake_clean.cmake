@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-cmac02.dir/examples/tests/test-cmac02.c.o"
+  "CMakeFiles/test-cmac02.dir/examples/tests/test-cmac02.c.o.d"
+  "test-cmac02"
+  "test-cmac02.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-cmac02.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-ctr-parallel.dir/examples/tests/test-ctr-parallel.c.o"
+  "CMakeFiles/test-ctr-parallel.dir/examples/tests/test-ctr-parallel.c.o.d"
+  "test-ctr-parallel"
+  "test-ctr-parallel.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-ctr-parallel.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
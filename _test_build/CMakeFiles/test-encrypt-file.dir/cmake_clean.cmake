@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-encrypt-file.dir/examples/tests/test-encrypt-file.c.o"
+  "CMakeFiles/test-encrypt-file.dir/examples/tests/test-encrypt-file.c.o.d"
+  "test-encrypt-file"
+  "test-encrypt-file.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-encrypt-file.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
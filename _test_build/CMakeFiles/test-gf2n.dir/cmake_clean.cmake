@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-gf2n.dir/examples/tests/test-gf2n.c.o"
+  "CMakeFiles/test-gf2n.dir/examples/tests/test-gf2n.c.o.d"
+  "test-gf2n"
+  "test-gf2n.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-gf2n.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
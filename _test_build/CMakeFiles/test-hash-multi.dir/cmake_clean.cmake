@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-hash-multi.dir/examples/tests/test-hash-multi.c.o"
+  "CMakeFiles/test-hash-multi.dir/examples/tests/test-hash-multi.c.o.d"
+  "test-hash-multi"
+  "test-hash-multi.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-hash-multi.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
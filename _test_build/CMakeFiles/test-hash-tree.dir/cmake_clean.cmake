@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-hash-tree.dir/examples/tests/test-hash-tree.c.o"
+  "CMakeFiles/test-hash-tree.dir/examples/tests/test-hash-tree.c.o.d"
+  "test-hash-tree"
+  "test-hash-tree.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-hash-tree.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
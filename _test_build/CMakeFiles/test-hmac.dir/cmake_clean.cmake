@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-hmac.dir/examples/tests/test-hmac.c.o"
+  "CMakeFiles/test-hmac.dir/examples/tests/test-hmac.c.o.d"
+  "test-hmac"
+  "test-hmac.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-hmac.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-kdf-state.dir/examples/tests/test-kdf-state.c.o"
+  "CMakeFiles/test-kdf-state.dir/examples/tests/test-kdf-state.c.o.d"
+  "test-kdf-state"
+  "test-kdf-state.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-kdf-state.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
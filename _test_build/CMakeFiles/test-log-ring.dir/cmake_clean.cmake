@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-log-ring.dir/examples/tests/test-log-ring.c.o"
+  "CMakeFiles/test-log-ring.dir/examples/tests/test-log-ring.c.o.d"
+  "test-log-ring"
+  "test-log-ring.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-log-ring.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-mac-file.dir/examples/tests/test-mac-file.c.o"
+  "CMakeFiles/test-mac-file.dir/examples/tests/test-mac-file.c.o.d"
+  "test-mac-file"
+  "test-mac-file.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-mac-file.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
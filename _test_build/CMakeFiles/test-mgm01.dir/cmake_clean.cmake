@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-mgm01.dir/examples/tests/test-mgm01.c.o"
+  "CMakeFiles/test-mgm01.dir/examples/tests/test-mgm01.c.o.d"
+  "test-mgm01"
+  "test-mgm01.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-mgm01.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-mpzn-inverse.dir/examples/tests/test-mpzn-inverse.c.o"
+  "CMakeFiles/test-mpzn-inverse.dir/examples/tests/test-mpzn-inverse.c.o.d"
+  "test-mpzn-inverse"
+  "test-mpzn-inverse.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-mpzn-inverse.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
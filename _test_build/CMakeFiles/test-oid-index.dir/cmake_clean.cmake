@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-oid-index.dir/examples/tests/test-oid-index.c.o"
+  "CMakeFiles/test-oid-index.dir/examples/tests/test-oid-index.c.o.d"
+  "test-oid-index"
+  "test-oid-index.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-oid-index.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
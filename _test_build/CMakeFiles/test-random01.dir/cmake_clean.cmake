@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-random01.dir/examples/tests/test-random01.c.o"
+  "CMakeFiles/test-random01.dir/examples/tests/test-random01.c.o.d"
+  "test-random01"
+  "test-random01.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-random01.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-sign-batch.dir/examples/tests/test-sign-batch.c.o"
+  "CMakeFiles/test-sign-batch.dir/examples/tests/test-sign-batch.c.o.d"
+  "test-sign-batch"
+  "test-sign-batch.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-sign-batch.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
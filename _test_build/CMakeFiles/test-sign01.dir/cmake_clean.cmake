@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-sign01.dir/examples/tests/test-sign01.c.o"
+  "CMakeFiles/test-sign01.dir/examples/tests/test-sign01.c.o.d"
+  "test-sign01"
+  "test-sign01.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-sign01.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
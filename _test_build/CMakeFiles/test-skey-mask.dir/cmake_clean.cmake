@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-skey-mask.dir/examples/tests/test-skey-mask.c.o"
+  "CMakeFiles/test-skey-mask.dir/examples/tests/test-skey-mask.c.o.d"
+  "test-skey-mask"
+  "test-skey-mask.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-skey-mask.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
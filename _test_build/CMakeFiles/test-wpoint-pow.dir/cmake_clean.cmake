@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-wpoint-pow.dir/examples/tests/test-wpoint-pow.c.o"
+  "CMakeFiles/test-wpoint-pow.dir/examples/tests/test-wpoint-pow.c.o.d"
+  "test-wpoint-pow"
+  "test-wpoint-pow.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-wpoint-pow.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
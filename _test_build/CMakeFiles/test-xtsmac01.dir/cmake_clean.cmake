@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test-xtsmac01.dir/examples/tests/test-xtsmac01.c.o"
+  "CMakeFiles/test-xtsmac01.dir/examples/tests/test-xtsmac01.c.o.d"
+  "test-xtsmac01"
+  "test-xtsmac01.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test-xtsmac01.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
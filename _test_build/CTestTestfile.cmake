@@ -0,0 +1,132 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_test_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(example-shared-log "/root/repo/_test_build/example-shared-log")
+set_tests_properties(example-shared-log PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;251;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-ini "/root/repo/_test_build/example-shared-ini")
+set_tests_properties(example-shared-ini PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;251;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-ini-file "/root/repo/_test_build/example-shared-ini-file")
+set_tests_properties(example-shared-ini-file PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;251;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-file "/root/repo/_test_build/example-shared-file")
+set_tests_properties(example-shared-file PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;251;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-mmap "/root/repo/_test_build/example-shared-mmap")
+set_tests_properties(example-shared-mmap PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;251;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-realpath "/root/repo/_test_build/example-shared-realpath")
+set_tests_properties(example-shared-realpath PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;251;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-0 "/root/repo/_test_build/example-shared-0")
+set_tests_properties(example-shared-0 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-1 "/root/repo/_test_build/example-shared-1")
+set_tests_properties(example-shared-1 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-2 "/root/repo/_test_build/example-shared-2")
+set_tests_properties(example-shared-2 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-3 "/root/repo/_test_build/example-shared-3")
+set_tests_properties(example-shared-3 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-4 "/root/repo/_test_build/example-shared-4")
+set_tests_properties(example-shared-4 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-5 "/root/repo/_test_build/example-shared-5")
+set_tests_properties(example-shared-5 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-6 "/root/repo/_test_build/example-shared-6")
+set_tests_properties(example-shared-6 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-7 "/root/repo/_test_build/example-shared-7")
+set_tests_properties(example-shared-7 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-8 "/root/repo/_test_build/example-shared-8")
+set_tests_properties(example-shared-8 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-9 "/root/repo/_test_build/example-shared-9")
+set_tests_properties(example-shared-9 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-11 "/root/repo/_test_build/example-shared-11")
+set_tests_properties(example-shared-11 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-12 "/root/repo/_test_build/example-shared-12")
+set_tests_properties(example-shared-12 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-13 "/root/repo/_test_build/example-shared-13")
+set_tests_properties(example-shared-13 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-14 "/root/repo/_test_build/example-shared-14")
+set_tests_properties(example-shared-14 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-15 "/root/repo/_test_build/example-shared-15")
+set_tests_properties(example-shared-15 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-16 "/root/repo/_test_build/example-shared-16")
+set_tests_properties(example-shared-16 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-17 "/root/repo/_test_build/example-shared-17")
+set_tests_properties(example-shared-17 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-18 "/root/repo/_test_build/example-shared-18")
+set_tests_properties(example-shared-18 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-19 "/root/repo/_test_build/example-shared-19")
+set_tests_properties(example-shared-19 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-20 "/root/repo/_test_build/example-shared-20")
+set_tests_properties(example-shared-20 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-21 "/root/repo/_test_build/example-shared-21")
+set_tests_properties(example-shared-21 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-22 "/root/repo/_test_build/example-shared-22")
+set_tests_properties(example-shared-22 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-24 "/root/repo/_test_build/example-shared-24")
+set_tests_properties(example-shared-24 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-25 "/root/repo/_test_build/example-shared-25")
+set_tests_properties(example-shared-25 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-26 "/root/repo/_test_build/example-shared-26")
+set_tests_properties(example-shared-26 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-27 "/root/repo/_test_build/example-shared-27")
+set_tests_properties(example-shared-27 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-30 "/root/repo/_test_build/example-shared-30")
+set_tests_properties(example-shared-30 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-31 "/root/repo/_test_build/example-shared-31")
+set_tests_properties(example-shared-31 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-32 "/root/repo/_test_build/example-shared-32")
+set_tests_properties(example-shared-32 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example-shared-33 "/root/repo/_test_build/example-shared-33")
+set_tests_properties(example-shared-33 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;269;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-random01 "/root/repo/_test_build/test-random01")
+set_tests_properties(test-random01 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-gf2n "/root/repo/_test_build/test-gf2n")
+set_tests_properties(test-gf2n PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-mgm01 "/root/repo/_test_build/test-mgm01")
+set_tests_properties(test-mgm01 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-xtsmac01 "/root/repo/_test_build/test-xtsmac01")
+set_tests_properties(test-xtsmac01 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-aead "/root/repo/_test_build/test-aead")
+set_tests_properties(test-aead PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-asn1-build "/root/repo/_test_build/test-asn1-build")
+set_tests_properties(test-asn1-build PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-asn1-parse "/root/repo/_test_build/test-asn1-parse")
+set_tests_properties(test-asn1-parse PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-sign01 "/root/repo/_test_build/test-sign01")
+set_tests_properties(test-sign01 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-asn1-keys "/root/repo/_test_build/test-asn1-keys")
+set_tests_properties(test-asn1-keys PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-asn1-keys02 "/root/repo/_test_build/test-asn1-keys02")
+set_tests_properties(test-asn1-keys02 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-blom-keys "/root/repo/_test_build/test-blom-keys")
+set_tests_properties(test-blom-keys PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-cmac01 "/root/repo/_test_build/test-cmac01")
+set_tests_properties(test-cmac01 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-cmac02 "/root/repo/_test_build/test-cmac02")
+set_tests_properties(test-cmac02 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-hmac "/root/repo/_test_build/test-hmac")
+set_tests_properties(test-hmac PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-kdf-state "/root/repo/_test_build/test-kdf-state")
+set_tests_properties(test-kdf-state PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-ctr-parallel "/root/repo/_test_build/test-ctr-parallel")
+set_tests_properties(test-ctr-parallel PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-hash-multi "/root/repo/_test_build/test-hash-multi")
+set_tests_properties(test-hash-multi PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-wpoint-pow "/root/repo/_test_build/test-wpoint-pow")
+set_tests_properties(test-wpoint-pow PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-mpzn-inverse "/root/repo/_test_build/test-mpzn-inverse")
+set_tests_properties(test-mpzn-inverse PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-sign-batch "/root/repo/_test_build/test-sign-batch")
+set_tests_properties(test-sign-batch PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-encrypt-file "/root/repo/_test_build/test-encrypt-file")
+set_tests_properties(test-encrypt-file PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-mac-file "/root/repo/_test_build/test-mac-file")
+set_tests_properties(test-mac-file PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-hash-tree "/root/repo/_test_build/test-hash-tree")
+set_tests_properties(test-hash-tree PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-log-ring "/root/repo/_test_build/test-log-ring")
+set_tests_properties(test-log-ring PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-oid-index "/root/repo/_test_build/test-oid-index")
+set_tests_properties(test-oid-index PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-asn1-arena "/root/repo/_test_build/test-asn1-arena")
+set_tests_properties(test-asn1-arena PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test-skey-mask "/root/repo/_test_build/test-skey-mask")
+set_tests_properties(test-skey-mask PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
@@ -29,7 +29,9 @@
  #define aktool_password_max_length (256)
 
 /* ----------------------------------------------------------------------------------------------- */
-#if defined(__unix__) || defined(__APPLE__)
+#ifdef AK_HAVE_SYSRANDOM_H
+  #define aktool_default_generator "getrandom"
+#elif defined(__unix__) || defined(__APPLE__)
   #define aktool_default_generator "dev-random"
 #else
   #ifdef AK_HAVE_WINDOWS_H
@@ -132,6 +134,12 @@
    bool_t ignore_errors;
   /* при установленном флаге программа не выводит статистику */
    bool_t dont_show_stat;
+  /* количество потоков, используемых для одновременной обработки файлов */
+   size_t threads;
+  /* флаг использования индекса контрольных сумм */
+   bool_t use_index;
+  /* флаг обработки всех файлов, вне зависимости от содержимого индекса */
+   bool_t full;
   /* структура для параметров асимметричного шифрования */
    struct encryption_set heset;
  #ifdef AK_HAVE_BZLIB_H
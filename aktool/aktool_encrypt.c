@@ -57,6 +57,7 @@
      { "inpass-hex",          1, NULL,  251 },
      { "inpass",              1, NULL,  252 },
      { "delete-source",       0, NULL,  253 },
+     { "threads",             1, NULL,  254 },
 
    #ifdef AK_HAVE_BZLIB_H
      { "bz2",                 0, NULL,  'j' },
@@ -86,6 +87,7 @@
   ki.heset.fraction.mechanism = size_fraction;
   ki.heset.fraction.value = 16*ak_libakrypt_get_option_by_name( "kuznechik_cipher_resource" );
   ki.heset.scheme = ecies_scheme;
+  ki.threads = 0; /* используется значение опции encrypt_file_threads */
   ki.delete_source = ak_false;
 
  /* разбираем опции командной строки */
@@ -334,6 +336,10 @@
                    ki.delete_source = ak_true;
                    break;
 
+        case 254: /* --threads */
+                   ki.threads = ( size_t )ak_max( 1, atoi( optarg ));
+                   break;
+
         default:  /* обрабатываем ошибочные параметры */
                    if( next_option != -1 ) work = do_nothing;
                    break;
@@ -343,6 +349,7 @@
 
  /* начинаем работу с криптографическими примитивами */
    if( !aktool_create_libakrypt( )) return EXIT_FAILURE;
+   if( ki.threads > 0 ) ak_libakrypt_set_option( "encrypt_file_threads", ki.threads );
 
  /* основная часть */
     switch( work )
@@ -794,6 +801,8 @@
      "                         the generator will be used for ephermal keys generation [ default value: \"%s\" ]\n"
      "     --random-file       set the name of file with random sequence\n"
      " -r, --recursive         recursive search of files\n"
+     "     --threads           set the number of threads used to encrypt or decrypt fragments of one file\n"
+     "                         [ default value is taken from the encrypt_file_threads option ]\n"
   ), ki.heset.mode->name[0], aktool_default_generator );
   aktool_print_common_options();
 
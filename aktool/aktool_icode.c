@@ -12,6 +12,15 @@
 #ifdef AK_HAVE_ERRNO_H
  #include <errno.h>
 #endif
+#ifdef AK_HAVE_PTHREAD_H
+ #include <pthread.h>
+#endif
+#ifdef AK_HAVE_SYSSTAT_H
+ #include <sys/stat.h>
+#endif
+#ifdef AK_HAVE_SYSMMAN_H
+ #include <sys/mman.h>
+#endif
 
 /* ----------------------------------------------------------------------------------------------- */
  int aktool_icode_help( void );
@@ -39,6 +48,9 @@
      { "check",               1, NULL,  'c' },
      { "dont-show-stat",      0, NULL,  161 },
      { "ignore-errors",       0, NULL,  162 },
+     { "threads",             1, NULL,  163 },
+     { "index",               0, NULL,  164 },
+     { "full",                0, NULL,  165 },
 
     /* аналоги из aktool_key */
      { "key",                 1, NULL,  203 },
@@ -67,6 +79,9 @@
   ki.key_derive = ak_true;
   ki.ignore_errors = ak_false;
   ki.dont_show_stat = ak_false;
+  ki.threads = 1;
+  ki.use_index = ak_false;
+  ki.full = ak_false;
 
  /* разбираем опции командной строки */
   do {
@@ -162,6 +177,18 @@
                    ki.ignore_errors = ak_true;
                    break;
 
+        case 163: /* --threads */
+                   ki.threads = ( size_t )ak_max( 1, atoi( optarg ));
+                   break;
+
+        case 164: /* --index */
+                   ki.use_index = ak_true;
+                   break;
+
+        case 165: /* --full */
+                   ki.full = ak_true;
+                   break;
+
         case 252: /* --inpass */
                    memset( ki.inpass, 0, sizeof( ki.inpass ));
                    strncpy( ki.inpass, optarg, sizeof( ki.inpass ) -1 );
@@ -241,61 +268,62 @@
   int errcount;
   int total;
   int lines;
+  /* индекс контрольных сумм (используется при инкрементальной обработке файлов) */
+  struct icode_index *index;
  } handle_ptr_t;
 
 /* ----------------------------------------------------------------------------------------------- */
- static int aktool_icode_function( const char *filename, ak_pointer ptr )
+/*! \brief Функция вырабатывает производный ключ для заданного файла (если пользователь
+    не запретил выработку производных ключей); в противном случае возвращается handle.
+    \details Ключ вырабатывается из handle - ключа, принадлежащего вызывающему потоку. */
+ static ak_pointer aktool_icode_derive_key( handle_ptr_t *st,
+                                                      ak_pointer handle, const char *filename )
+{
+  ak_pointer kh = NULL;
+
+  if( !ki.key_derive || st->oid->engine == hash_function ) return handle;
+
+  kh = ak_skey_new_derive_kdf256( st->oid, handle,
+                                           (ak_uint8 *)filename, strlen( filename ),
+                                            ki.seed != NULL ? (ak_uint8 *)ki.seed : NULL,
+                                            ki.seed != NULL ? strlen( ki.seed ) : 0 );
+  if( kh == NULL ) aktool_error(_("incorrect creation of derivative key for %s"), filename );
+
+ return kh;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static void aktool_icode_release_key( handle_ptr_t *st, ak_pointer handle, ak_pointer kh )
+{
+  if(( kh == NULL ) || ( kh == handle )) return;
+  ak_oid_delete_object( st->oid, kh );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вычисляет контрольную сумму (имитовставку) для одного файла.
+    \details Аргумент handle содержит контекст, принадлежащий вызывающему потоку
+    (контекст функции хеширования или копию исходного ключа). */
+/* ----------------------------------------------------------------------------------------------- */
+ static int aktool_icode_evaluate( handle_ptr_t *st,
+                                         ak_pointer handle, const char *filename, ak_uint8 *buffer )
 {
-  handle_ptr_t *st = ptr;
-  ak_uint8 buffer[256];
   ak_pointer kh = NULL;
   int error = ak_error_ok;
-  char flongname[FILENAME_MAX];
 
  /* проверяем размер доступной памяти для вычисления имитовставки */
-  if( sizeof( buffer ) < st->tagsize ) {
-    st->errcount++;
-    return ak_error_wrong_length;
-  }
-
- /* файл для вывода результатов не хешируем */
-  if( ki.outfp != stdout ) {
-    memset( flongname, 0, sizeof( flongname ));
-   #ifdef _WIN32
-    GetFullPathName( filename, FILENAME_MAX, flongname, NULL );
-   #else
-    if( ak_realpath( filename, flongname, sizeof( flongname ) -1 ) != ak_error_ok )
-      return ak_error_null_pointer;
-   #endif
-    if( !strncmp( flongname, ki.op_file, FILENAME_MAX -2 )) return ak_error_ok;
-    if( !strncmp( flongname, ki.audit_filename, sizeof( ki.audit_filename ) -2 )) return ak_error_ok;
-  }
+  if( 256 < st->tagsize ) return ak_error_wrong_length;
 
  /* вырабатываем производный ключ (если пользователь не запретил) */
-  if( !ki.key_derive || st->oid->engine == hash_function ) {
-    kh = st->handle;
-  }
-   else {
-    if(( kh = ak_skey_new_derive_kdf256( st->oid, st->handle,
-                                           (ak_uint8 *)filename, strlen( filename ),
-                                            ki.seed != NULL ? (ak_uint8 *)ki.seed : NULL,
-                                            ki.seed != NULL ? strlen( ki.seed ) : 0 )) == NULL ) {
-      aktool_error(_("incorrect creation of derivative key for %s"), filename );
-      st->errcount++;
-      return ak_error_get_value();
-    }
-  }
+  if(( kh = aktool_icode_derive_key( st, handle, filename )) == NULL ) return ak_error_get_value();
 
  /* проверяем ресурс секретного ключа */
   if( st->oid->engine == block_cipher ) {
     struct file fs;
     if(( error = ak_file_open_to_read( &fs, filename )) != ak_error_ok ) {
       aktool_error(_("access error to %s [%s]"), filename, strerror( errno ));
-      st->errcount++;
       goto labex;
     }
     if( ((ak_bckey)kh)->key.resource.value.counter < (ssize_t)(1 + fs.size/st->tagsize )) {
-      st->errcount++;
       aktool_error(_("low key resource for %s (%lld bytes)"), filename, fs.size );
       error = ak_error_low_key_resource;
     }
@@ -305,13 +333,24 @@
 
  /* хешируем */
   if(( error = st->icode( kh, /* производный ключ */
-                              filename, buffer, st->tagsize )) != ak_error_ok ) {
+                              filename, buffer, st->tagsize )) != ak_error_ok )
     aktool_error(_("incorrect integrity code calculation for %s"), filename );
+
+  labex:
+   aktool_icode_release_key( st, handle, kh );
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция выводит результат вычисления контрольной суммы для одного файла. */
+ static int aktool_icode_report( handle_ptr_t *st,
+                                          const char *filename, int error, ak_uint8 *buffer )
+{
+  if( error != ak_error_ok ) {
     st->errcount++;
     return error;
   }
 
- /* теперь вывод результата */
   if( ki.tag ) { /* вывод bsd */
     fprintf( ki.outfp, "%s (%s) = %s\n", st->oid->name[0], filename,
                                        ak_ptr_to_hexstr( buffer, st->tagsize, ki.reverse_order ));
@@ -319,12 +358,390 @@
       fprintf( ki.outfp, "%s %s\n",
                             ak_ptr_to_hexstr( buffer, st->tagsize, ki.reverse_order ), filename );
     }
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*                 Индекс контрольных сумм (инкрементальная обработка файлов)                      */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Сигнатура файла с индексом контрольных сумм. */
+ #define aktool_icode_index_magic        "akidx01"
+/*! \brief Метка, используемая для выработки ключа имитозащиты индекса. */
+ #define aktool_icode_index_label        "aktool icode index"
+/*! \brief Максимальная длина контрольной суммы, хранящейся в индексе. */
+ #define aktool_icode_index_tagsize      (64)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Заголовок файла с индексом.
+    \details Файл индекса состоит из заголовка, массива записей, упорядоченных по хеш-коду
+    полного имени файла, и имитовставки (контрольной суммы) от заголовка и всех записей,
+    занимающей aktool_icode_index_tagsize октетов. Значения хранятся в формате
+    используемой платформы, поэтому файл может быть отображен в память и использован
+    без дополнительного преобразования. */
+/* ----------------------------------------------------------------------------------------------- */
+ typedef struct icode_index_header {
+  /* сигнатура файла */
+   char magic[8];
+  /* константа 0x01020304, позволяющая определить порядок следования байт */
+   ak_uint32 order;
+  /* количество записей */
+   ak_uint32 count;
+  /* время создания индекса */
+   ak_int64 created;
+ } *aktool_icode_index_header;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Запись индекса, содержащая сведения об одном файле. */
+ typedef struct icode_index_entry {
+  /* хеш-код полного имени файла */
+   ak_uint8 path[32];
+  /* размер файла */
+   ak_uint64 size;
+  /* время последней модификации файла */
+   ak_int64 mtime;
+  /* номер индексного дескриптора */
+   ak_uint64 inode;
+  /* идентификатор алгоритма вычисления контрольной суммы */
+   char oid[32];
+  /* длина контрольной суммы */
+   ak_uint32 tagsize;
+  /* выравнивание */
+   ak_uint32 reserved;
+  /* значение контрольной суммы */
+   ak_uint8 tag[aktool_icode_index_tagsize];
+ } *aktool_icode_index_entry;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Индекс контрольных сумм, используемый в процессе обработки файлов. */
+ typedef struct icode_index {
+  /* имя файла с индексом */
+   char filename[FILENAME_MAX];
+  /* дескриптор считанного индекса */
+   struct file fp;
+  /* память, в которой размещен считанный индекс */
+   ak_uint8 *data;
+  /* флаг отображения считанного индекса в память */
+   bool_t mapped;
+  /* записи считанного индекса */
+   aktool_icode_index_entry entries;
+  /* количество записей считанного индекса */
+   size_t count;
+  /* записи, формирующие новый индекс */
+   aktool_icode_index_entry fresh;
+  /* количество записей и объем памяти для нового индекса */
+   size_t used, allocated;
+  /* контекст функции хеширования имен файлов */
+   struct hash ctx;
+  /* время начала обработки файлов */
+   ak_int64 started;
+ } *aktool_icode_index;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вычисляет имитовставку (контрольную сумму) индекса.
+    \details Для вычисления используется ключ, выработанный из ключа пользователя
+    (если пользователь не запретил выработку производных ключей), либо функция хеширования,
+    используемая для вычисления контрольных сумм файлов. */
+/* ----------------------------------------------------------------------------------------------- */
+ static int aktool_icode_index_mac( handle_ptr_t *st, ak_uint8 *data, size_t size, ak_uint8 *out )
+{
+  ak_pointer kh = NULL;
+  int error = ak_error_ok;
+
+  memset( out, 0, aktool_icode_index_tagsize );
+  if(( kh = aktool_icode_derive_key( st, st->handle, aktool_icode_index_label )) == NULL )
+    return ak_error_get_value();
+
+  switch( st->oid->engine ) {
+    case hash_function: error = ak_hash_ptr( kh, data, size, out, st->tagsize );
+      break;
+    case hmac_function: error = ak_hmac_ptr( kh, data, size, out, st->tagsize );
+      break;
+    case block_cipher:  error = ak_bckey_cmac( kh, data, size, out, st->tagsize );
+      break;
+    default: error = ak_error_undefined_function;
+  }
+  aktool_icode_release_key( st, st->handle, kh );
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция считывает индекс и проверяет его целостность.
+    \details Поврежденный индекс, равно как и индекс, созданный с использованием другого ключа,
+    не используется; в этом случае контрольные суммы всех файлов вычисляются заново. */
+/* ----------------------------------------------------------------------------------------------- */
+ static int aktool_icode_index_load( handle_ptr_t *st, aktool_icode_index idx )
+{
+  size_t size = 0;
+  aktool_icode_index_header hdr = NULL;
+  ak_uint8 tag[aktool_icode_index_tagsize];
+
+  if( ak_file_or_directory( idx->filename ) != DT_REG ) return ak_error_ok; /* индекс еще не создан */
+  if( ak_file_open_to_read( &idx->fp, idx->filename ) != ak_error_ok ) goto labex;
+  if(( idx->fp.size < ( ak_int64 )( sizeof( struct icode_index_header ) +
+                                                               aktool_icode_index_tagsize )) ||
+     (( ak_uint64 )idx->fp.size > ( ak_uint64 )(( size_t )-1 ))) goto labex;
+  size = ( size_t )idx->fp.size;
+
+ /* отображаем индекс в память, а если не получилось, то считываем его */
+ #ifdef AK_HAVE_SYSMMAN_H
+  if(( idx->data = ak_file_mmap( &idx->fp, NULL, size, PROT_READ, MAP_PRIVATE, 0 )) == MAP_FAILED )
+    idx->data = NULL;
+   else idx->mapped = ak_true;
+ #endif
+  if( idx->data == NULL ) {
+    ak_error_set_value( ak_error_ok );
+    if(( idx->data = malloc( size )) == NULL ) goto labex;
+    if( ak_file_read( &idx->fp, idx->data, size ) != ( ssize_t )size ) goto labex;
+  }
+
+ /* проверяем формат и целостность */
+  hdr = ( aktool_icode_index_header )idx->data;
+  if( memcmp( hdr->magic, aktool_icode_index_magic, sizeof( hdr->magic )) != 0 ) goto labex;
+  if( hdr->order != 0x01020304 ) goto labex;
+  if( size != sizeof( struct icode_index_header ) +
+          hdr->count*sizeof( struct icode_index_entry ) + aktool_icode_index_tagsize ) goto labex;
+  if( aktool_icode_index_mac( st, idx->data, size - aktool_icode_index_tagsize,
+                                                                        tag ) != ak_error_ok ) goto labex;
+  if( memcmp( tag, idx->data + size - aktool_icode_index_tagsize,
+                                                         aktool_icode_index_tagsize ) != 0 ) goto labex;
+
+  idx->entries = ( aktool_icode_index_entry )( idx->data + sizeof( struct icode_index_header ));
+  idx->count = hdr->count;
+ return ak_error_ok;
 
   labex:
-   if( kh != st->handle ) ak_oid_delete_object( st->oid, kh );
+   if( !ki.quiet ) aktool_error(_("index file %s is corrupted or created with another key, "
+                                                 "all files will be processed"), idx->filename );
+   if( idx->data != NULL ) {
+     if( idx->mapped ) ak_file_unmap( &idx->fp );
+      else free( idx->data );
+   }
+   idx->data = NULL;
+   idx->mapped = ak_false;
+   ak_file_close( &idx->fp );
+   ak_error_set_value( ak_error_ok );
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция создает индекс, связанный с заданным файлом контрольных сумм. */
+ static int aktool_icode_index_create( handle_ptr_t *st, const char *filename )
+{
+  aktool_icode_index idx = NULL;
+
+  if( st->tagsize > aktool_icode_index_tagsize ) {
+    aktool_error(_("the integrity code is too long to be stored in index"));
+    return EXIT_FAILURE;
+  }
+  if(( idx = calloc( 1, sizeof( struct icode_index ))) == NULL ) {
+    aktool_error(_("incorrect memory allocation for index"));
+    return EXIT_FAILURE;
+  }
+  ak_snprintf( idx->filename, sizeof( idx->filename ), "%s.idx", filename );
+  if( ak_hash_create_streebog256( &idx->ctx ) != ak_error_ok ) {
+    free( idx );
+    return EXIT_FAILURE;
+  }
+  idx->started = ( ak_int64 )time( NULL );
+  if( !ki.full ) aktool_icode_index_load( st, idx );
+  st->index = idx;
+
+ return EXIT_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция заполняет запись индекса сведениями о файле и ищет ее в считанном индексе.
+    \return Функция возвращает \ref ak_true, если файл не изменялся с момента создания индекса;
+    в этом случае в запись помещается сохраненное значение контрольной суммы. */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t aktool_icode_index_lookup( handle_ptr_t *st,
+                                            const char *filename, aktool_icode_index_entry entry )
+{
+  char flongname[FILENAME_MAX];
+  size_t left = 0, right = 0, mid = 0;
+  aktool_icode_index idx = st->index;
+  aktool_icode_index_entry found = NULL;
+ #ifdef _WIN32
+  struct _stat sb;
+ #else
+  struct stat sb;
+ #endif
+
+  memset( entry, 0, sizeof( struct icode_index_entry ));
+  memset( flongname, 0, sizeof( flongname ));
+ #ifdef _WIN32
+  GetFullPathName( filename, FILENAME_MAX, flongname, NULL );
+  if( _stat( flongname, &sb ) < 0 ) return ak_false;
+ #else
+  if( ak_realpath( filename, flongname, sizeof( flongname ) -1 ) != ak_error_ok ) {
+    ak_error_set_value( ak_error_ok );
+    return ak_false;
+  }
+  if( stat( flongname, &sb ) < 0 ) return ak_false;
+ #endif
+
+  ak_hash_ptr( &idx->ctx, flongname, strlen( flongname ), entry->path, sizeof( entry->path ));
+  entry->size = ( ak_uint64 )sb.st_size;
+  entry->mtime = ( ak_int64 )sb.st_mtime;
+  entry->inode = ( ak_uint64 )sb.st_ino;
+  strncpy( entry->oid, st->oid->id[0], sizeof( entry->oid ) -1 );
+  entry->tagsize = ( ak_uint32 )st->tagsize;
+
+ /* двоичный поиск по хеш-коду имени файла */
+  right = idx->count;
+  while( left < right ) {
+    int cmp = memcmp( entry->path, idx->entries[mid = ( left + right ) >> 1].path, 32 );
+    if( cmp == 0 ) { found = idx->entries + mid; break; }
+    if( cmp < 0 ) right = mid;
+      else left = mid + 1;
+  }
+  if( found == NULL ) return ak_false;
+  if(( found->size != entry->size ) || ( found->mtime != entry->mtime ) ||
+     ( found->inode != entry->inode ) || ( found->tagsize != entry->tagsize ) ||
+     ( strncmp( found->oid, entry->oid, sizeof( entry->oid )) != 0 )) return ak_false;
+
+  memcpy( entry->tag, found->tag, sizeof( entry->tag ));
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция добавляет в новый индекс запись с вычисленным значением контрольной суммы.
+    \details Файлы, измененные после начала обработки (или в ту же секунду), в индекс не
+    добавляются, поскольку точность времени модификации не позволяет отличить их от
+    файлов, которые будут изменены позднее. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void aktool_icode_index_update( handle_ptr_t *st,
+                                                   aktool_icode_index_entry entry, ak_uint8 *tag )
+{
+  aktool_icode_index idx = st->index;
+  aktool_icode_index_entry ptr = NULL;
+
+  if(( entry->tagsize == 0 ) || ( entry->mtime >= idx->started )) return;
+  if( idx->used == idx->allocated ) {
+    size_t allocated = ak_max( 1024, idx->allocated << 1 );
+    if(( ptr = realloc( idx->fresh, allocated*sizeof( struct icode_index_entry ))) == NULL ) return;
+    idx->fresh = ptr;
+    idx->allocated = allocated;
+  }
+  if( tag != entry->tag ) memcpy( entry->tag, tag, entry->tagsize );
+  memcpy( idx->fresh + idx->used++, entry, sizeof( struct icode_index_entry ));
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static int aktool_icode_index_compare( const void *left, const void *right )
+{
+ return memcmp( (( aktool_icode_index_entry )left )->path,
+                                                     (( aktool_icode_index_entry )right )->path, 32 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция сохраняет новый индекс и освобождает выделенную под индекс память. */
+ static int aktool_icode_index_destroy( handle_ptr_t *st )
+{
+  struct file fp;
+  size_t size = 0;
+  ak_uint8 *data = NULL;
+  int error = ak_error_ok;
+  aktool_icode_index idx = st->index;
+  aktool_icode_index_header hdr = NULL;
+
+  if( idx == NULL ) return ak_error_ok;
+  if( idx->data != NULL ) {
+    if( idx->mapped ) ak_file_unmap( &idx->fp );
+      else free( idx->data );
+    ak_file_close( &idx->fp );
+  }
+
+ /* формируем новый индекс */
+  if( idx->used > 1 )
+    qsort( idx->fresh, idx->used, sizeof( struct icode_index_entry ), aktool_icode_index_compare );
+  size = sizeof( struct icode_index_header ) +
+                              idx->used*sizeof( struct icode_index_entry ) + aktool_icode_index_tagsize;
+  if(( data = calloc( 1, size )) == NULL ) {
+    error = ak_error_message( ak_error_out_of_memory, __func__, "incorrect memory allocation" );
+    goto labex;
+  }
+  hdr = ( aktool_icode_index_header )data;
+  memcpy( hdr->magic, aktool_icode_index_magic, sizeof( hdr->magic ));
+  hdr->order = 0x01020304;
+  hdr->count = ( ak_uint32 )idx->used;
+  hdr->created = idx->started;
+  if( idx->used )
+    memcpy( data + sizeof( struct icode_index_header ),
+                                      idx->fresh, idx->used*sizeof( struct icode_index_entry ));
+  if(( error = aktool_icode_index_mac( st, data,
+                   size - aktool_icode_index_tagsize, data + size - aktool_icode_index_tagsize ))
+                                                                              != ak_error_ok ) goto labex;
+ /* сохраняем */
+  if(( error = ak_file_create_to_write( &fp, idx->filename )) != ak_error_ok ) goto labex;
+  if( ak_file_write( &fp, data, size ) != ( ssize_t )size ) error = ak_error_write_data;
+  ak_file_close( &fp );
+
+  labex:
+   if( error != ak_error_ok ) aktool_error(_("index file %s cannot be created"), idx->filename );
+   if( data != NULL ) free( data );
+   if( idx->fresh != NULL ) free( idx->fresh );
+   ak_hash_destroy( &idx->ctx );
+   free( idx );
+   st->index = NULL;
+
  return error;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция проверяет, что файл не является файлом для вывода результатов, аудита
+    или индекса контрольных сумм. */
+ static int aktool_icode_skip_file( handle_ptr_t *st, const char *filename, bool_t *skip )
+{
+  char flongname[FILENAME_MAX];
+
+  *skip = ak_false;
+  if( ki.outfp != stdout ) {
+    memset( flongname, 0, sizeof( flongname ));
+   #ifdef _WIN32
+    GetFullPathName( filename, FILENAME_MAX, flongname, NULL );
+   #else
+    if( ak_realpath( filename, flongname, sizeof( flongname ) -1 ) != ak_error_ok ) {
+      st->errcount++;
+      return ak_error_null_pointer;
+    }
+   #endif
+    if( !strncmp( flongname, ki.op_file, FILENAME_MAX -2 )) *skip = ak_true;
+    if( !strncmp( flongname, ki.audit_filename, sizeof( ki.audit_filename ) -2 )) *skip = ak_true;
+    if(( st->index != NULL ) &&
+       ( !strncmp( flongname, st->index->filename, FILENAME_MAX -2 ))) *skip = ak_true;
+  }
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static int aktool_icode_function( const char *filename, ak_pointer ptr )
+{
+  handle_ptr_t *st = ptr;
+  ak_uint8 buffer[256];
+  bool_t skip = ak_false;
+  int error = ak_error_ok;
+  struct icode_index_entry entry;
+
+ /* файл для вывода результатов не хешируем */
+  if(( error = aktool_icode_skip_file( ptr, filename, &skip )) != ak_error_ok ) return error;
+  if( skip ) return ak_error_ok;
+
+ /* файл, не изменявшийся с момента создания индекса, повторно не хешируем */
+  if( st->index != NULL ) {
+    if( aktool_icode_index_lookup( st, filename, &entry )) {
+      aktool_icode_index_update( st, &entry, entry.tag );
+      return aktool_icode_report( st, filename, ak_error_ok, entry.tag );
+    }
+  }
+  if((( error = aktool_icode_evaluate( st, st->handle, filename, buffer )) == ak_error_ok ) &&
+                                    ( st->index != NULL )) aktool_icode_index_update( st, &entry, buffer );
+
+ return aktool_icode_report( st, filename, error, buffer );
+}
+
 /* ----------------------------------------------------------------------------------------------- */
  static int aktool_create_handle( handle_ptr_t *st )
 {
@@ -388,6 +805,357 @@
  return EXIT_SUCCESS;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*                                 Многопоточная обработка файлов                                  */
+/* ----------------------------------------------------------------------------------------------- */
+#ifdef AK_HAVE_PTHREAD_H
+ #define aktool_icode_max_threads (64)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Задание на вычисление контрольной суммы одного файла. */
+ typedef struct icode_job {
+  /* имя обрабатываемого файла */
+   char filename[FILENAME_MAX];
+  /* вычисленное значение контрольной суммы */
+   ak_uint8 icode[256];
+  /* значение контрольной суммы, считанное из файла (используется при проверке) */
+   ak_uint8 expected[256];
+  /* код ошибки, возникшей при вычислении */
+   int error;
+  /* флаг завершения вычислений */
+   bool_t done;
+  /* флаг того, что контрольная сумма взята из индекса */
+   bool_t cached;
+  /* сведения о файле, помещаемые в индекс */
+   struct icode_index_entry entry;
+ } *aktool_icode_job;
+
+ struct icode_pool;
+ typedef int ( aktool_function_icode_report ) ( struct icode_pool * , aktool_icode_job );
+ typedef int ( aktool_function_icode_evaluate ) ( handle_ptr_t * ,
+                                                              ak_pointer, const char *, ak_uint8 * );
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Пул потоков, вычисляющих контрольные суммы.
+    \details Задания помещаются в кольцевой буффер в порядке перечисления файлов; результаты
+    выводятся основным потоком строго в том же порядке, поэтому содержимое создаваемых файлов
+    не зависит от количества потоков. */
+/* ----------------------------------------------------------------------------------------------- */
+ typedef struct icode_pool {
+  /* общий контекст обработки файлов */
+   handle_ptr_t *st;
+  /* кольцевой буффер заданий */
+   struct icode_job *jobs;
+  /* количество заданий в кольцевом буффере */
+   size_t count;
+  /* номера следующего добавляемого, выполняемого и выводимого заданий */
+   size_t added, taken, emitted;
+  /* флаг того, что новых заданий не будет */
+   bool_t finished;
+  /* код ошибки, прервавшей вывод результатов (используется при проверке) */
+   int error;
+  /* функция вычисления контрольной суммы (при выработке и при проверке) */
+   aktool_function_icode_evaluate *evaluate;
+  /* функция вывода результата */
+   aktool_function_icode_report *report;
+  /* блокировка доступа к очереди заданий */
+   pthread_mutex_t mutex;
+  /* появление нового задания */
+   pthread_cond_t work;
+  /* завершение очередного задания */
+   pthread_cond_t done;
+  /* общий ресурс исходного ключа, который распределяется между потоками */
+   ssize_t resource;
+  /* количество потоков */
+   size_t nthreads;
+  /* потоки и используемые ими контексты */
+   pthread_t threads[aktool_icode_max_threads];
+   ak_pointer handles[aktool_icode_max_threads];
+ } *aktool_icode_pool;
+
+/* ----------------------------------------------------------------------------------------------- */
+ typedef struct icode_worker {
+   aktool_icode_pool pool;
+   ak_pointer handle;
+ } *aktool_icode_worker;
+
+ static struct icode_worker icode_workers[aktool_icode_max_threads];
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция выдает ключу потока часть общего ресурса, необходимую для обработки файла.
+    \details Расход ресурса оценивается так же, как при последовательной обработке файлов:
+    каждое вычисление hmac (в том числе при выработке производного ключа) расходует две единицы
+    ресурса; ключ блочного шифра при выработке производных ключей не расходуется, в противном
+    случае он расходуется в объеме, проверяемом функцией aktool_icode_evaluate(). Если общий
+    ресурс исчерпан, ключ потока получает только его остаток, и обработка файла завершается
+    ошибкой. */
+ static void aktool_icode_pool_reserve( aktool_icode_pool pool,
+                                                     ak_pointer handle, const char *filename )
+{
+  struct file fs;
+  ssize_t need = 2;
+
+  if( pool->st->oid->engine == hash_function ) return;
+  if( ki.key_derive ) {
+    if( pool->st->oid->engine == block_cipher ) need = 0;
+  } else
+     if( pool->st->oid->engine == block_cipher ) {
+       if( ak_file_open_to_read( &fs, filename ) == ak_error_ok ) {
+         need = ( ssize_t )( 1 + fs.size/pool->st->tagsize );
+         ak_file_close( &fs );
+       }
+     }
+
+  pthread_mutex_lock( &pool->mutex );
+  need = ak_min( need, ak_max( pool->resource, 0 ));
+  pool->resource -= need;
+  (( ak_skey )handle )->resource.value.counter = need;
+  pthread_mutex_unlock( &pool->mutex );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция возвращает неизрасходованный ресурс ключа потока в общий ресурс
+    (вызывается при захваченной блокировке). */
+ static void aktool_icode_pool_release( aktool_icode_pool pool, ak_pointer handle )
+{
+  ak_skey skey = handle;
+
+  if( pool->st->oid->engine == hash_function ) return;
+  if( skey->resource.value.counter > 0 ) pool->resource += skey->resource.value.counter;
+  skey->resource.value.counter = 0;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static void *aktool_icode_worker_function( void *ptr )
+{
+  aktool_icode_job job = NULL;
+  aktool_icode_worker worker = ptr;
+  aktool_icode_pool pool = worker->pool;
+
+  do{
+     pthread_mutex_lock( &pool->mutex );
+     while(( pool->taken == pool->added ) && !pool->finished )
+       pthread_cond_wait( &pool->work, &pool->mutex );
+     if( pool->taken == pool->added ) {
+       pthread_mutex_unlock( &pool->mutex );
+       break;
+     }
+     job = pool->jobs + ( pool->taken++ )%pool->count;
+     pthread_mutex_unlock( &pool->mutex );
+
+     if( !job->cached ) {
+       aktool_icode_pool_reserve( pool, worker->handle, job->filename );
+       job->error = pool->evaluate( pool->st, worker->handle, job->filename, job->icode );
+     }
+
+     pthread_mutex_lock( &pool->mutex );
+     aktool_icode_pool_release( pool, worker->handle );
+     job->done = ak_true;
+     pthread_cond_signal( &pool->done );
+     pthread_mutex_unlock( &pool->mutex );
+  } while( ak_true );
+
+ return NULL;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вывод всех завершенных заданий, идущих подряд (вызывается при захваченной блокировке) */
+ static size_t aktool_icode_pool_emit( aktool_icode_pool pool )
+{
+  size_t cnt = 0;
+  aktool_icode_job job = NULL;
+
+  while( pool->emitted < pool->added ) {
+    job = pool->jobs + pool->emitted%pool->count;
+    if( !job->done ) break;
+    if(( pool->st->index != NULL ) && ( job->error == ak_error_ok ))
+      aktool_icode_index_update( pool->st, &job->entry, job->icode );
+    if( pool->error == ak_error_ok ) pool->error = pool->report( pool, job );
+    pool->emitted++;
+    cnt++;
+  }
+ return cnt;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static void aktool_icode_pool_free( aktool_icode_pool pool )
+{
+  size_t i;
+
+ /* неизрасходованный общий ресурс возвращается исходному ключу
+    (функция вызывается после завершения всех потоков) */
+  if( pool->st->oid->engine != hash_function )
+    (( ak_skey )pool->st->handle )->resource.value.counter = pool->resource;
+  for( i = 0; i < aktool_icode_max_threads; i++ )
+     if(( pool->handles[i] != NULL ) && ( pool->handles[i] != pool->st->handle ))
+       ak_oid_delete_object( pool->st->oid, pool->handles[i] );
+
+  pthread_cond_destroy( &pool->done );
+  pthread_cond_destroy( &pool->work );
+  pthread_mutex_destroy( &pool->mutex );
+  free( pool->jobs );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция создает копию исходного ключа для одного из потоков.
+    \details Значение ключа копируется так же, как в функции ak_bckey_create_and_set_bckey();
+    копия получает временной интервал исходного ключа; ресурс выдается копии перед обработкой
+    каждого файла функцией aktool_icode_pool_reserve(). */
+ static ak_pointer aktool_icode_clone_key( handle_ptr_t *st )
+{
+  ak_pointer kh = NULL;
+  int error = ak_error_ok;
+  ak_skey skey = ( ak_skey )st->handle;
+
+  if( st->oid->func.first.set_key == NULL ) return NULL;
+  if(( kh = ak_oid_new_object( st->oid )) == NULL ) return NULL;
+  if(( error = skey->unmask( skey )) == ak_error_ok ) {
+    error = st->oid->func.first.set_key( kh, skey->key, skey->key_size );
+    skey->set_mask( skey );
+  }
+  if( error != ak_error_ok ) {
+    ak_oid_delete_object( st->oid, kh );
+    return NULL;
+  }
+  (( ak_skey )kh )->resource = skey->resource;
+  (( ak_skey )kh )->resource.value.counter = 0;
+
+ return kh;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static int aktool_icode_pool_create( aktool_icode_pool pool, handle_ptr_t *st,
+                aktool_function_icode_evaluate *evaluate, aktool_function_icode_report *report )
+{
+  size_t i;
+
+  memset( pool, 0, sizeof( struct icode_pool ));
+  pool->st = st;
+  pool->evaluate = evaluate;
+  pool->report = report;
+  pool->error = ak_error_ok;
+  pool->nthreads = ak_min( ki.threads, aktool_icode_max_threads );
+  pool->count = 4*pool->nthreads;
+  if(( pool->jobs = calloc( pool->count, sizeof( struct icode_job ))) == NULL ) {
+    aktool_error(_("incorrect memory allocation for job queue"));
+    return EXIT_FAILURE;
+  }
+  pthread_mutex_init( &pool->mutex, NULL );
+  pthread_cond_init( &pool->work, NULL );
+  pthread_cond_init( &pool->done, NULL );
+
+ /* ресурс исходного ключа становится общим для всех потоков и выдается им по мере
+    обработки файлов, поэтому суммарный расход не превышает ресурса исходного ключа */
+  if( st->oid->engine != hash_function ) {
+    pool->resource = (( ak_skey )st->handle )->resource.value.counter;
+    (( ak_skey )st->handle )->resource.value.counter = 0;
+  }
+
+ /* каждый поток получает собственный контекст функции хеширования или копию ключа,
+    первый поток использует исходный контекст */
+  pool->handles[0] = st->handle;
+  for( i = 1; i < pool->nthreads; i++ ) {
+     if( st->oid->engine == hash_function ) pool->handles[i] = ak_oid_new_object( st->oid );
+      else pool->handles[i] = aktool_icode_clone_key( st );
+     if( pool->handles[i] == NULL ) break;
+  }
+  pool->nthreads = i;
+
+  for( i = 0; i < pool->nthreads; i++ ) {
+     icode_workers[i].pool = pool;
+     icode_workers[i].handle = pool->handles[i];
+     if( pthread_create( pool->threads +i, NULL,
+                                 aktool_icode_worker_function, icode_workers +i ) != 0 ) break;
+  }
+  if(( pool->nthreads = i ) == 0 ) {
+    aktool_error(_("incorrect creation of working threads"));
+    aktool_icode_pool_free( pool );
+    return EXIT_FAILURE;
+  }
+
+ return EXIT_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static int aktool_icode_pool_add( aktool_icode_pool pool, const char *filename, ak_uint8 *expected )
+{
+  aktool_icode_job job = NULL;
+  struct icode_index_entry entry;
+  bool_t cached = ak_false;
+  int error = ak_error_ok;
+
+ /* поиск в индексе выполняется основным потоком */
+  if( pool->st->index != NULL ) {
+    if(( cached = aktool_icode_index_lookup( pool->st, filename, &entry )) && ( expected != NULL ))
+      cached = ( memcmp( entry.tag, expected, pool->st->tagsize ) == 0 );
+  }
+
+  pthread_mutex_lock( &pool->mutex );
+  if(( error = pool->error ) != ak_error_ok ) { /* проверка прервана, новые задания не нужны */
+    pthread_mutex_unlock( &pool->mutex );
+    return error;
+  }
+  while( pool->added - pool->emitted == pool->count )
+    if( !aktool_icode_pool_emit( pool )) pthread_cond_wait( &pool->done, &pool->mutex );
+
+  job = pool->jobs + pool->added%pool->count;
+  memset( job->filename, 0, sizeof( job->filename ));
+  strncpy( job->filename, filename, sizeof( job->filename ) -1 );
+  if( expected != NULL ) memcpy( job->expected, expected, sizeof( job->expected ));
+  job->error = ak_error_ok;
+  job->done = ak_false;
+  if(( job->cached = cached )) memcpy( job->icode, entry.tag, sizeof( entry.tag ));
+  if( pool->st->index != NULL ) memcpy( &job->entry, &entry, sizeof( entry ));
+  pool->added++;
+  pthread_cond_signal( &pool->work );
+  aktool_icode_pool_emit( pool );
+  error = pool->error;
+  pthread_mutex_unlock( &pool->mutex );
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static int aktool_icode_pool_destroy( aktool_icode_pool pool )
+{
+  size_t i;
+
+ /* дожидаемся вывода всех результатов */
+  pthread_mutex_lock( &pool->mutex );
+  pool->finished = ak_true;
+  pthread_cond_broadcast( &pool->work );
+  while( pool->emitted < pool->added )
+    if( !aktool_icode_pool_emit( pool )) pthread_cond_wait( &pool->done, &pool->mutex );
+  pthread_mutex_unlock( &pool->mutex );
+
+  for( i = 0; i < pool->nthreads; i++ ) pthread_join( pool->threads[i], NULL );
+
+  aktool_icode_pool_free( pool );
+
+ return pool->error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static int aktool_icode_pool_report( aktool_icode_pool pool, aktool_icode_job job )
+{
+  aktool_icode_report( pool->st, job->filename, job->error, job->icode );
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static int aktool_icode_pool_function( const char *filename, ak_pointer ptr )
+{
+  bool_t skip = ak_false;
+  int error = ak_error_ok;
+  aktool_icode_pool pool = ptr;
+
+  if(( error = aktool_icode_skip_file( pool->st, filename, &skip )) != ak_error_ok ) return error;
+  if( skip ) return ak_error_ok;
+
+ return aktool_icode_pool_add( pool, filename, NULL );
+}
+#endif
+
 /* ----------------------------------------------------------------------------------------------- */
  int aktool_icode_work( int argc, tchar *argv[] )
 {
@@ -398,9 +1166,15 @@
      .lines = 0,
      .oid = NULL,
      .tagsize = 0,
-     .total = 0
+     .total = 0,
+     .index = NULL
    };
    int errcount = 0;
+   ak_function_find *function = aktool_icode_function;
+   ak_pointer ptr = &st;
+  #ifdef AK_HAVE_PTHREAD_H
+   struct icode_pool pool;
+  #endif
 
   /* проверяем, что файлы для контроля заданы */
    ++optind; /* пропускаем команду - i или icode */
@@ -413,18 +1187,40 @@
   /* создаем контекст хеширования (имитозащиты) и проверяем входные параметры  */
    if( aktool_create_handle( &st ) != EXIT_SUCCESS ) return EXIT_FAILURE;
 
+  /* считываем индекс, расположенный рядом с файлом контрольных сумм */
+   if( ki.use_index ) {
+     if( ki.outfp == stdout ) {
+       aktool_error(_("the --index option requires the name of output file (see --output option)"));
+       errcount++;
+       goto labex;
+     }
+     if( aktool_icode_index_create( &st, ki.op_file ) != EXIT_SUCCESS ) {
+       errcount++;
+       goto labex;
+     }
+   }
+
+  /* при многопоточной обработке файлы передаются в пул потоков,
+     а основной поток выводит результаты (если потоки не созданы, файлы обрабатываются
+     последовательно) */
+  #ifdef AK_HAVE_PTHREAD_H
+   if( ki.threads > 1 ) {
+     if( aktool_icode_pool_create( &pool, &st,
+                           aktool_icode_evaluate, aktool_icode_pool_report ) == EXIT_SUCCESS ) {
+       function = aktool_icode_pool_function;
+       ptr = &pool;
+     }
+   }
+  #endif
+
   /* только сейчас начинаем основной цикл хеширования файлов и каталогов, указанных пользователем */
    while( optind < argc ) {
      char *value = argv[optind++];
      switch( ak_file_or_directory( value )) {
-        case DT_DIR:
-          st.errcount = 0;
-          if( ak_file_find( value, ki.pattern,
-                            aktool_icode_function, &st, ki.tree ) != ak_error_ok )
-                                                                           errcount += st.errcount;
+        case DT_DIR: ak_file_find( value, ki.pattern, function, ptr, ki.tree );
           break;
 
-        case DT_REG: if( aktool_icode_function( value, &st )!= ak_error_ok ) errcount++;
+        case DT_REG: function( value, ptr );
           break;
 
         default: aktool_error(_("%s is unsupported argument"), value ); errcount++;
@@ -432,7 +1228,18 @@
      }
    }
 
+  #ifdef AK_HAVE_PTHREAD_H
+   if( function != aktool_icode_function ) aktool_icode_pool_destroy( &pool );
+  #endif
+  /* ошибки обработки файлов учитываются в st.errcount одинаково в обоих режимах;
+     при многопоточной обработке счетчик окончательно известен после вывода всех результатов */
+   errcount += st.errcount;
+
+  /* сохраняем новый индекс */
+   if( aktool_icode_index_destroy( &st ) != ak_error_ok ) errcount++;
+
   /* освобождаем выделенную ранее память */
+   labex:
    if( st.handle != NULL ) {
      if( st.icode == (ak_function_icode_file *)ak_hash_file )
        ak_oid_delete_object( ((ak_hash)st.handle)->oid, st.handle );
@@ -450,12 +1257,14 @@
 /* ----------------------------------------------------------------------------------------------- */
 /*                    Реализация алгоритма проверки файла с контрольными суммами                   */
 /* ----------------------------------------------------------------------------------------------- */
- static int aktool_icode_check_function( const tchar *string, ak_pointer ptr )
+/*! \brief Функция разбирает строку файла с контрольными суммами.
+    \return Функция возвращает \ref ak_error_ok, если строка содержит имя файла и значение
+    контрольной суммы; в противном случае возвращается код ошибки. */
+/* ----------------------------------------------------------------------------------------------- */
+ static int aktool_icode_check_parse( handle_ptr_t *st,
+                                      const tchar *string, tchar **fname, ak_uint8 *out2, size_t size )
 {
   size_t len;
-  ak_pointer kh = NULL;
-  handle_ptr_t *st = ptr;
-  ak_uint8 buffer[256], out2[256];
   tchar *substr = NULL, *filename = NULL, *icode = NULL;
   int error = ak_error_ok, reterror = ak_error_undefined_value;
 
@@ -468,8 +1277,7 @@
   if( strlen( substr ) == 0 ) { /* строка не содержит скобки => вариант строки в формате Linux */
    /* получаем первый токен - это должно быть значение контрольной суммы */
     if(( icode = aktool_strtok_r( (tchar *)string, " ", &substr )) == NULL ) return reterror;
-    if(( error = ak_hexstr_to_ptr( icode,
-                                      out2, sizeof( out2 ), ki.reverse_order )) != ak_error_ok ) {
+    if(( error = ak_hexstr_to_ptr( icode, out2, size, ki.reverse_order )) != ak_error_ok ) {
       st->errcount++;
       return ak_error_message_fmt( error, __func__, "incorrect icode string %s\n", icode );
     }
@@ -494,55 +1302,113 @@
 
    /* теперь, контрольная сумма */
     while(( *substr == ' ' ) || ( *substr == '=' )) substr++;
-    if(( error = ak_hexstr_to_ptr( substr, out2, sizeof( out2 ), ki.reverse_order )) != ak_error_ok ) {
+    if(( error = ak_hexstr_to_ptr( substr, out2, size, ki.reverse_order )) != ak_error_ok ) {
       st->errcount++;
       return ak_error_message_fmt( error, __func__, "incorrect icode string %s\n", icode );
     }
   }
 
- /* приступаем к проверке*/
-  st->total++;
+  *fname = filename;
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вычисляет контрольную сумму файла, значение которой будет проверяться. */
+ static int aktool_icode_check_evaluate( handle_ptr_t *st,
+                                         ak_pointer handle, const char *filename, ak_uint8 *buffer )
+{
+  ak_pointer kh = NULL;
+  int error = ak_error_ok;
 
  /* вырабатываем производный ключ (если пользователь не запретил) */
-  if( !ki.key_derive || st->oid->engine == hash_function ) {
-    kh = st->handle;
-  }
-   else {
-    if(( kh = ak_skey_new_derive_kdf256( st->oid, st->handle,
-                                           (ak_uint8 *)filename, strlen( filename ),
-                                            ki.seed != NULL ? (ak_uint8 *)ki.seed : NULL,
-                                            ki.seed != NULL ? strlen( ki.seed ) : 0 )) == NULL ) {
-      aktool_error(_("incorrect creation of derivative key for %s"), filename );
-      st->errcount++;
-      return ak_error_get_value();
-    }
-  }
+  if(( kh = aktool_icode_derive_key( st, handle, filename )) == NULL ) return ak_error_get_value();
 
- /* проверяем контрольную сумму */
-  if(( error = st->icode( kh, filename, buffer, sizeof( buffer ))) != ak_error_ok ) {
-    if( !ki.quiet ) printf(_("%s Wrong\n"), filename );
+ /* вычисляем контрольную сумму */
+  if(( error = st->icode( kh, filename, buffer, 256 )) != ak_error_ok )
     ak_error_message_fmt( error, __func__,
                                "incorrect evaluation integrity code for \"%s\" file", filename );
+
+  aktool_icode_release_key( st, handle, kh );
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция выводит результат проверки контрольной суммы одного файла. */
+ static int aktool_icode_check_report( handle_ptr_t *st, const char *filename,
+                                                int error, ak_uint8 *buffer, ak_uint8 *out2 )
+{
+ /* контрольная сумма не вычислена */
+  if( error != ak_error_ok ) {
+    if( !ki.quiet ) printf(_("%s Wrong\n"), filename );
     st->errcount++;
-    goto labex;
+    return error;
   }
 
   if( ak_ptr_is_equal_with_log( buffer, out2, st->tagsize ) == ak_true ) {
     if( !ki.quiet ) printf("%s Ok\n", filename );
-    goto labex;
-  } else {
-     if( !ki.quiet ) printf(_("%s %sWrong%s\n"), filename,
+    return ak_error_ok;
+  }
+
+  if( !ki.quiet ) printf(_("%s %sWrong%s\n"), filename,
                                           ak_error_get_start_string(), ak_error_get_end_string());
-     st->errcount++;
-     if( ki.ignore_errors ) error = ak_error_ok;
-       else error = ak_error_not_equal_data;
+  st->errcount++;
+  if( ki.ignore_errors ) return ak_error_ok;
+ return ak_error_not_equal_data;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static int aktool_icode_check_function( const tchar *string, ak_pointer ptr )
+{
+  handle_ptr_t *st = ptr;
+  tchar *filename = NULL;
+  ak_uint8 buffer[256], out2[256];
+  int error = ak_error_ok;
+  struct icode_index_entry entry;
+
+  if(( error = aktool_icode_check_parse( st, string,
+                                          &filename, out2, sizeof( out2 ))) != ak_error_ok )
+    return error;
+
+ /* приступаем к проверке*/
+  st->total++;
+  if( st->index != NULL ) { /* сохраненная контрольная сумма совпадает с проверяемой */
+    if( aktool_icode_index_lookup( st, filename, &entry ) &&
+                                           ( memcmp( entry.tag, out2, st->tagsize ) == 0 )) {
+      aktool_icode_index_update( st, &entry, entry.tag );
+      return aktool_icode_check_report( st, filename, ak_error_ok, entry.tag, out2 );
     }
+  }
+  if((( error = aktool_icode_check_evaluate( st, st->handle, filename, buffer )) == ak_error_ok ) &&
+                                    ( st->index != NULL )) aktool_icode_index_update( st, &entry, buffer );
 
-  labex:
-   if( kh != st->handle ) ak_oid_delete_object( st->oid, kh );
+ return aktool_icode_check_report( st, filename, error, buffer, out2 );
+}
 
- return error;
+#ifdef AK_HAVE_PTHREAD_H
+/* ----------------------------------------------------------------------------------------------- */
+ static int aktool_icode_check_pool_report( aktool_icode_pool pool, aktool_icode_job job )
+{
+  pool->st->total++;
+ return aktool_icode_check_report( pool->st, job->filename, job->error, job->icode, job->expected );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static int aktool_icode_check_pool_function( const tchar *string, ak_pointer ptr )
+{
+  aktool_icode_pool pool = ptr;
+  tchar *filename = NULL;
+  ak_uint8 out2[256];
+  int error = ak_error_ok;
+
+ /* строки файла разбираются основным потоком */
+  pthread_mutex_lock( &pool->mutex );
+  error = aktool_icode_check_parse( pool->st, string, &filename, out2, sizeof( out2 ));
+  pthread_mutex_unlock( &pool->mutex );
+  if( error != ak_error_ok ) return error;
+
+ return aktool_icode_pool_add( pool, filename, out2 );
 }
+#endif
 
 /* ----------------------------------------------------------------------------------------------- */
  int aktool_icode_check( void )
@@ -554,15 +1420,30 @@
      .lines = 0,
      .oid = NULL,
      .tagsize = 0,
-     .total = 0
+     .total = 0,
+     .index = NULL
    };
-   int exit_status = EXIT_FAILURE;
+   int error = ak_error_ok, exit_status = EXIT_FAILURE;
+  #ifdef AK_HAVE_PTHREAD_H
+   struct icode_pool pool;
+  #endif
 
  /* создаем контекст хеширования (имитозащиты) и проверяем входные параметры  */
   if( aktool_create_handle( &st ) != EXIT_SUCCESS ) return EXIT_FAILURE;
+  if( ki.use_index && ( aktool_icode_index_create( &st, ki.os_file ) != EXIT_SUCCESS )) goto labex;
 
  /* теперь разбираем файл со строками и ведем статичтику происходящего */
-  if( ak_file_read_by_lines( ki.os_file, aktool_icode_check_function, &st ) == ak_error_ok ) {
+ #ifdef AK_HAVE_PTHREAD_H
+  if(( ki.threads > 1 ) &&
+     ( aktool_icode_pool_create( &pool, &st,
+                   aktool_icode_check_evaluate, aktool_icode_check_pool_report ) == EXIT_SUCCESS )) {
+    error = ak_file_read_by_lines( ki.os_file, aktool_icode_check_pool_function, &pool );
+    if( aktool_icode_pool_destroy( &pool ) != ak_error_ok ) error = pool.error;
+  } else
+ #endif
+  error = ak_file_read_by_lines( ki.os_file, aktool_icode_check_function, &st );
+
+  if( error == ak_error_ok ) {
     if( !ki.quiet ) {
       if( !ki.dont_show_stat ) {
         printf(_("\n%s [%d lines, %d files, where: correct %d, wrong %d]\n"),
@@ -573,7 +1454,11 @@
     if( !st.errcount ) exit_status = EXIT_SUCCESS;
   }
 
+ /* сохраняем новый индекс */
+  if( aktool_icode_index_destroy( &st ) != ak_error_ok ) exit_status = EXIT_FAILURE;
+
  /* освобождаем выделенную ранее память */
+  labex:
   if( st.handle != NULL ) {
     if( st.icode == (ak_function_icode_file *)ak_hash_file )
       ak_oid_delete_object( ((ak_hash)st.handle)->oid, st.handle );
@@ -594,7 +1479,10 @@
      "                         default algorithm is \"streebog256\" defined by RFC 6986\n"
      " -c, --check             check previously generated authentication or integrity codes\n"
      "     --dont-show-stat    don't show a statistical results after checking\n"
+     "     --full              process all files, even if they are unchanged since the index was created\n"
      "     --ignore-errors     don't break a check if file is missing or corrupted\n"
+     "     --index             store the metadata of processed files in the index located next to the\n"
+     "                         checksum file and skip the files which are unchanged since the last run\n"
      "     --inpass            set the password for the secret key to be read directly in command line\n"
      "     --inpass-hex        read the password for the secret key as hexademal string\n"
      "     --key               specify the name of file with the secret key\n"
@@ -606,6 +1494,7 @@
      "     --reverse-order     output of authentication or integrity code in reverse byte order\n"
      "     --seed              set the initial value of key derivation functions (used only for file authentication)\n"
      "     --tag               create a BSD-style checksum format\n"
+     "     --threads           set the number of threads used to process files [ default value: 1 ]\n"
   ));
   aktool_print_common_options();
 
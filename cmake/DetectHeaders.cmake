@@ -226,6 +226,35 @@ check_c_source_compiles("
      return 0;
   }" AK_HAVE_BYTESWAP_H )
 
+# -------------------------------------------------------------------------------------------------- #
+check_c_source_compiles("
+  #include <sys/random.h>
+  int main( void ) {
+     char buffer[8];
+     return getrandom( buffer, sizeof( buffer ), 0 ) != 8;
+  }" AK_HAVE_SYSRANDOM_H )
+
+# -------------------------------------------------------------------------------------------------- #
+check_c_source_compiles("
+  #include <threads.h>
+  static int run( void *ptr ) { return ptr == NULL; }
+  int main( void ) {
+     thrd_t thread;
+     return thrd_create( &thread, run, NULL ) != thrd_success;
+  }" AK_HAVE_THREADS_H )
+
+# -------------------------------------------------------------------------------------------------- #
+# обработчики fork() и однократный вызов функций доступны в стандартной библиотеке
+# и без подключения библиотеки pthread (glibc 2.34 и новее, musl, bsd)
+check_c_source_compiles("
+  #include <pthread.h>
+  static pthread_once_t once = PTHREAD_ONCE_INIT;
+  static void child( void ) { }
+  static void run( void ) { pthread_atfork( NULL, NULL, child ); }
+  int main( void ) {
+     return pthread_once( &once, run );
+  }" AK_HAVE_PTHREAD_ATFORK )
+
 # -------------------------------------------------------------------------------------------------- #
 if( LIBAKRYPT_PTHREAD )
   check_c_source_compiles("
@@ -19,6 +19,22 @@ if( AK_HAVE_BUILTIN_MULQ_GCC )
     set( CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DAK_HAVE_BUILTIN_MULQ_GCC" )
 endif()
 
+# -------------------------------------------------------------------------------------------------- #
+# -------------------------------------------------------------------------------------------------- #
+check_c_source_compiles("
+  __extension__ typedef unsigned __int128 uint128;
+  int main( void ) {
+
+   unsigned long long u = 1, v = 2;
+   uint128 w = ( uint128 )u*v;
+
+  return ( int )( w >> 64 );
+ }" AK_HAVE_BUILTIN_UINT128 )
+
+if( AK_HAVE_BUILTIN_UINT128 )
+    set( CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DAK_HAVE_BUILTIN_UINT128" )
+endif()
+
 # -------------------------------------------------------------------------------------------------- #
 # -------------------------------------------------------------------------------------------------- #
 check_c_source_compiles("
@@ -35,6 +51,25 @@ if( AK_HAVE_BUILTIN_CLMULEPI64 )
     set( CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DAK_HAVE_BUILTIN_CLMULEPI64" )
 endif()
 
+# -------------------------------------------------------------------------------------------------- #
+# -------------------------------------------------------------------------------------------------- #
+check_c_source_compiles("
+  #include <wmmintrin.h>
+  __attribute__((target(\"pclmul\"))) static __m128i mul( __m128i a, __m128i b ) {
+    return _mm_clmulepi64_si128( a, b, 0x00 );
+  }
+  int main( void ) {
+
+   __m128i a = _mm_set_epi64x( 0, 3 ), b = _mm_set_epi64x( 0, 5 );
+   a = mul( a, b );
+
+  return _mm_cvtsi128_si32( a );
+ }" AK_HAVE_BUILTIN_CLMULEPI64_TARGET )
+
+if( AK_HAVE_BUILTIN_CLMULEPI64_TARGET )
+    set( CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DAK_HAVE_BUILTIN_CLMULEPI64_TARGET" )
+endif()
+
 # -------------------------------------------------------------------------------------------------- #
 # -------------------------------------------------------------------------------------------------- #
 check_c_source_compiles("
@@ -53,3 +88,117 @@ check_c_source_compiles("
 if( AK_HAVE_BUILTIN_MM256_SLL )
     set( CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DAK_HAVE_BUILTIN_MM256_SLL" )
 endif()
+
+# -------------------------------------------------------------------------------------------------- #
+# -------------------------------------------------------------------------------------------------- #
+check_c_source_compiles("
+  #include <emmintrin.h>
+  int main( void ) {
+
+   __m128i a = _mm_setzero_si128(), b = _mm_set1_epi32( 1 );
+   a = _mm_xor_si128( a, _mm_loadu_si128( &b ));
+
+  return _mm_cvtsi128_si32( a );
+ }" AK_HAVE_BUILTIN_XOR_SI128 )
+
+if( AK_HAVE_BUILTIN_XOR_SI128 )
+    set( CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DAK_HAVE_BUILTIN_XOR_SI128" )
+endif()
+
+# -------------------------------------------------------------------------------------------------- #
+# -------------------------------------------------------------------------------------------------- #
+check_c_source_compiles("
+  int main( void ) {
+
+   __builtin_cpu_init();
+   if( __builtin_cpu_supports( \"sse2\" )) return 0;
+     else return 1;
+ }" AK_HAVE_BUILTIN_CPU_SUPPORTS )
+
+if( AK_HAVE_BUILTIN_CPU_SUPPORTS )
+    set( CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DAK_HAVE_BUILTIN_CPU_SUPPORTS" )
+endif()
+
+# -------------------------------------------------------------------------------------------------- #
+# -------------------------------------------------------------------------------------------------- #
+check_c_source_compiles("
+  #include <tmmintrin.h>
+  __attribute__((target(\"ssse3\"))) static __m128i lookup( __m128i t, __m128i x ) {
+    return _mm_shuffle_epi8( t, x );
+  }
+  int main( void ) {
+
+   __m128i a = _mm_setzero_si128(), b = _mm_set1_epi8( 1 );
+   a = lookup( a, b );
+
+  return 0;
+ }" AK_HAVE_BUILTIN_SHUFFLE_EPI8 )
+
+if( AK_HAVE_BUILTIN_SHUFFLE_EPI8 )
+    set( CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DAK_HAVE_BUILTIN_SHUFFLE_EPI8" )
+endif()
+
+# -------------------------------------------------------------------------------------------------- #
+# -------------------------------------------------------------------------------------------------- #
+check_c_source_compiles("
+  #include <immintrin.h>
+  __attribute__((target(\"avx2\"))) static void lookup( unsigned int *p ) {
+    __m256i t = _mm256_broadcastsi128_si256( _mm_set1_epi8( 1 ));
+    _mm256_storeu_si256(( __m256i *)p, _mm256_shuffle_epi8( t, _mm256_set1_epi32( 3 )));
+  }
+  int main( void ) {
+
+   unsigned int p[8];
+   lookup( p );
+
+  return 0;
+ }" AK_HAVE_BUILTIN_MM256_SHUFFLE_EPI8 )
+
+if( AK_HAVE_BUILTIN_MM256_SHUFFLE_EPI8 )
+    set( CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DAK_HAVE_BUILTIN_MM256_SHUFFLE_EPI8" )
+endif()
+
+# -------------------------------------------------------------------------------------------------- #
+# -------------------------------------------------------------------------------------------------- #
+check_c_source_compiles("
+  #include <immintrin.h>
+  __attribute__((target(\"avx2,gfni\"))) static void multiply( unsigned int *p ) {
+    __m256i t = _mm256_set1_epi8( 3 );
+    t = _mm256_gf2p8mul_epi8( t, _mm256_gf2p8affine_epi64_epi8( t, _mm256_set1_epi64x( 1 ), 0 ));
+    _mm256_storeu_si256(( __m256i *)p, t );
+  }
+  int main( void ) {
+
+   unsigned int p[8];
+   __builtin_cpu_init();
+   if( __builtin_cpu_supports( \"gfni\" )) multiply( p );
+
+  return 0;
+ }" AK_HAVE_BUILTIN_MM256_GF2P8MUL )
+
+if( AK_HAVE_BUILTIN_MM256_GF2P8MUL )
+    set( CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DAK_HAVE_BUILTIN_MM256_GF2P8MUL" )
+endif()
+
+# -------------------------------------------------------------------------------------------------- #
+# -------------------------------------------------------------------------------------------------- #
+check_c_source_compiles("
+  #include <immintrin.h>
+  __attribute__((target(\"avx512bw,avx512vbmi,gfni\"))) static void multiply( unsigned int *p ) {
+    __m512i t = _mm512_set1_epi8( 3 );
+    t = _mm512_permutex2var_epi8( t, _mm512_gf2p8mul_epi8( t, t ), t );
+    t = _mm512_mask_blend_epi8( _mm512_movepi8_mask( t ), t, _mm512_setzero_si512());
+    _mm512_storeu_si512(( __m512i *)p, t );
+  }
+  int main( void ) {
+
+   unsigned int p[16];
+   __builtin_cpu_init();
+   if( __builtin_cpu_supports( \"avx512vbmi\" )) multiply( p );
+
+  return 0;
+ }" AK_HAVE_BUILTIN_MM512_GF2P8MUL )
+
+if( AK_HAVE_BUILTIN_MM512_GF2P8MUL )
+    set( CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DAK_HAVE_BUILTIN_MM512_GF2P8MUL" )
+endif()
@@ -61,6 +61,30 @@ cat result.kuznechik
 run "i -c result.kuznechik --key kuznechik.key -m cmac-kuznechik --inpass 123 --dont-show-stat"
 #
 #
+echo; echo "Тестируем многопоточное вычисление контрольных сумм"
+TMPDIR=$(mktemp -d)
+run "i --key kuznechik.key -m cmac-kuznechik --inpass 123 --tag * -o ${TMPDIR}/result.seq"
+run "i --key kuznechik.key -m cmac-kuznechik --inpass 123 --tag --threads 4 * -o ${TMPDIR}/result.threads"
+if ! cmp -s ${TMPDIR}/result.seq ${TMPDIR}/result.threads
+then echo "результаты многопоточного вычисления не совпадают"; exit;
+fi
+run "i -c ${TMPDIR}/result.threads --key kuznechik.key -m cmac-kuznechik --inpass 123 --threads 3"
+rm -rf ${TMPDIR}
+#
+#
+echo; echo "Тестируем инкрементальное вычисление контрольных сумм"
+run "i --key kuznechik.key -m cmac-kuznechik --inpass 123 --index * -o result.index"
+run "i --key kuznechik.key -m cmac-kuznechik --inpass 123 --index * -o result.index"
+run "i -c result.index --key kuznechik.key -m cmac-kuznechik --inpass 123 --index"
+run "i -c result.index --key kuznechik.key -m cmac-kuznechik --inpass 123 --index --full"
+# многопоточная обработка пропускает файл индекса так же, как и последовательная
+run "i --key kuznechik.key -m cmac-kuznechik --inpass 123 --index --threads 2 * -o result.index"
+if grep -q "result.index.idx" result.index
+then echo "файл индекса не должен обрабатываться"; exit;
+fi
+run "i -c result.index --key kuznechik.key -m cmac-kuznechik --inpass 123 --index --threads 2"
+#
+#
 rm -f magma.key kuznechik.key hmac256.key hmac512.key
 rm -f result.*
 echo "Тест пройден"
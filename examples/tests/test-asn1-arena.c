@@ -0,0 +1,127 @@
+/* ----------------------------------------------------------------------------------------------- */
+/*  Тестовый пример, иллюстрирующий совпадение ASN.1 деревьев, полученных при обычном              */
+/*  декодировании der-последовательности и при декодировании с размещением всех узлов в одной      */
+/*  области памяти, а также использование функций чтения значений узлов.                           */
+/* ----------------------------------------------------------------------------------------------- */
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt.h>
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Рекурсивное сравнение двух уровней ASN.1 дерева. */
+ static bool_t compare_levels( ak_asn1 heap, ak_asn1 arena, ak_uint8 *buffer, size_t size )
+{
+  ak_tlv x = NULL, y = NULL;
+
+  if( heap->count != arena->count ) return ak_false;
+  ak_asn1_first( heap );
+  ak_asn1_first( arena );
+  for( x = heap->current, y = arena->current; x != NULL; x = x->next, y = y->next ) {
+     if(( y == NULL ) || ( x->tag != y->tag ) || ( x->len != y->len )) return ak_false;
+     if( DATA_STRUCTURE( x->tag ) == CONSTRUCTED ) {
+       if( !compare_levels( x->data.constructed, y->data.constructed, buffer, size ))
+         return ak_false;
+     }
+      else {
+       /* данные не копируются, а указывают внутрь декодируемой последовательности */
+        if(( y->free != ak_false ) || ( y->data.primitive < buffer ) ||
+                                                ( y->data.primitive + y->len > buffer + size ))
+          return ak_false;
+        if( memcmp( x->data.primitive, y->data.primitive, x->len ) != 0 ) return ak_false;
+      }
+  }
+ return ( y == NULL );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+  ak_oid algorithm = NULL, parameters = NULL;
+  ak_uint8 buffer[1024], encoded[1024];
+  size_t size = sizeof( buffer ), esize = sizeof( encoded );
+  ak_asn1 asn = NULL, seq = NULL, heap = NULL;
+  ak_pointer ptr = NULL;
+  struct asn1_arena arena;
+  ak_uint32 value = 0;
+  int exitcode = EXIT_FAILURE;
+
+  if( !ak_libakrypt_create( ak_function_log_stderr )) return ak_libakrypt_destroy();
+
+ /* формируем дерево и кодируем его */
+  asn = ak_asn1_new();
+  seq = ak_asn1_new();
+  ak_asn1_add_uint32( seq, 20230517 );
+  ak_asn1_add_utf8_string( seq, "arena decoding" );
+  ak_asn1_add_oid( seq, "1.2.643.7.1.1.2.2" );
+  ak_asn1_add_algorithm_identifier( seq, ak_oid_find_by_name( "sign256" ),
+                                      ak_oid_find_by_name( "id-tc26-gost-3410-2012-256-paramSetA" ));
+  ak_asn1_add_octet_string( seq, "0123456789abcdef", 16 );
+  ak_asn1_add_bool( seq, ak_true );
+  ak_asn1_add_asn1( asn, TSEQUENCE, seq );
+  ak_asn1_add_utc_time( asn, 1700000000 );
+  if( ak_asn1_encode( asn, buffer, &size ) != ak_error_ok ) goto ex;
+  ak_asn1_delete( asn );
+
+ /* декодируем последовательность двумя способами и сравниваем результаты */
+  ak_asn1_decode( heap = ak_asn1_new(), buffer, size, ak_true );
+  if( ak_asn1_arena_decode( &arena, buffer, size ) != ak_error_ok ) {
+    printf("arena decoding is Wrong\n");
+    goto ex2;
+  }
+  if( !compare_levels( heap, arena.root, buffer, size )) {
+    printf("arena tree is not equal to heap tree\n");
+    goto ex3;
+  }
+  if(( ak_asn1_encode( arena.root, encoded, &esize ) != ak_error_ok ) ||
+                                          ( esize != size ) || memcmp( buffer, encoded, size )) {
+    printf("encoding of arena tree is Wrong\n");
+    goto ex3;
+  }
+
+ /* считываем значения узлов */
+  ak_asn1_first( arena.root );
+  seq = arena.root->current->data.constructed;
+  ak_asn1_first( seq );
+  if(( ak_tlv_get_uint32( seq->current, &value ) != ak_error_ok ) || ( value != 20230517 )) {
+    printf("uint32 value is Wrong\n");
+    goto ex3;
+  }
+  ak_asn1_next( seq );
+  if(( ak_tlv_get_utf8_string( seq->current, &ptr ) != ak_error_ok ) ||
+                                                       strcmp( ptr, "arena decoding" ) != 0 ) {
+    printf("utf8 string is Wrong\n");
+    goto ex3;
+  }
+  ak_asn1_next( seq );
+  if(( ak_tlv_get_oid( seq->current, &ptr ) != ak_error_ok ) ||
+                                                    strcmp( ptr, "1.2.643.7.1.1.2.2" ) != 0 ) {
+    printf("object identifier is Wrong\n");
+    goto ex3;
+  }
+  ak_asn1_next( seq );
+  if(( ak_tlv_get_algorithm_identifier( seq->current, &algorithm, &parameters ) != ak_error_ok )
+                               || ( algorithm != ak_oid_find_by_name( "sign256" )) || ( parameters !=
+                               ak_oid_find_by_name( "id-tc26-gost-3410-2012-256-paramSetA" ))) {
+    printf("algorithm identifier is Wrong\n");
+    goto ex3;
+  }
+  ak_asn1_arena_destroy( &arena );
+
+ /* усеченная последовательность не декодируется, память не выделяется */
+  if(( ak_asn1_arena_decode( &arena, buffer, size - 1 ) == ak_error_ok ) ||
+                                                                      ( arena.memory != NULL )) {
+    printf("truncated sequence is accepted\n");
+    goto ex3;
+  }
+  printf("arena decoding: Ok\n");
+  exitcode = EXIT_SUCCESS;
+
+  ex3: ak_asn1_arena_destroy( &arena );
+  ex2: ak_asn1_delete( heap );
+  ex:
+   ak_error_set_value( ak_error_ok );
+   ak_libakrypt_destroy();
+
+ return exitcode;
+}
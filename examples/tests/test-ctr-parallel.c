@@ -0,0 +1,107 @@
+/* ----------------------------------------------------------------------------------------------- */
+/*  Тестовый пример, иллюстрирующий совпадение результатов последовательной и многопоточной        */
+/*  реализаций режимов гаммирования (ctr и ctr-acpkm).                                             */
+/* ----------------------------------------------------------------------------------------------- */
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt.h>
+
+/* ----------------------------------------------------------------------------------------------- */
+ ak_uint8 testkey[32] = {
+    0xef, 0xcd, 0xab, 0x89, 0x67, 0x45, 0x23, 0x01, 0x10, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe,
+    0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00, 0xff, 0xee, 0xdd, 0xcc, 0xbb, 0xaa, 0x99, 0x88 };
+ ak_uint8 iv[8] = { 0x12, 0x34, 0x56, 0x78, 0x90, 0xab, 0xcd, 0xef };
+
+/* ----------------------------------------------------------------------------------------------- */
+ static int test_cipher( ak_function_bckey_create *create, const char *name,
+                                                        ak_uint8 *in, ak_uint8 *out1, ak_uint8 *out2,
+                                                                                       size_t size )
+{
+  struct bckey bkey;
+  size_t threads, sizes[3] = { size, size - 13, 32768 };
+  int i, result = ak_true;
+
+  create( &bkey );
+  for( i = 0; i < 3; i++ ) {
+    for( threads = 2; threads <= 8; threads += 3 ) {
+      /* после использования в режиме ctr-acpkm ресурс ключа определяется количеством сообщений,
+         поэтому на каждой итерации ключ устанавливается заново */
+       ak_bckey_set_key( &bkey, testkey, 32 );
+
+      /* режим гаммирования, включая продолжение с сохраненной синхропосылкой */
+       ak_bckey_ctr( &bkey, in, out1, sizes[i] - 4*bkey.bsize, iv, bkey.bsize >> 1 );
+       ak_bckey_ctr( &bkey, in + sizes[i] - 4*bkey.bsize,
+                                  out1 + sizes[i] - 4*bkey.bsize, 4*bkey.bsize, NULL, 0 );
+       memset( out2, 0, size );
+       ak_bckey_ctr_parallel( &bkey, in, out2,
+                                     sizes[i] - 4*bkey.bsize, iv, bkey.bsize >> 1, threads );
+       ak_bckey_ctr( &bkey, in + sizes[i] - 4*bkey.bsize,
+                                  out2 + sizes[i] - 4*bkey.bsize, 4*bkey.bsize, NULL, 0 );
+       if( memcmp( out1, out2, sizes[i] ) != 0 ) {
+         printf("%s ctr: size %u, threads %u is Wrong\n", name,
+                                                       (unsigned int)sizes[i], (unsigned int)threads );
+         result = ak_false;
+       }
+
+      /* режим ctr-acpkm */
+       ak_bckey_ctr_acpkm( &bkey, in, out1, sizes[i], 128*bkey.bsize, iv, 8 );
+       memset( out2, 0, size );
+       ak_bckey_ctr_acpkm_parallel( &bkey, in, out2, sizes[i], 128*bkey.bsize, iv, 8, threads );
+       if( memcmp( out1, out2, sizes[i] ) != 0 ) {
+         printf("%s ctr-acpkm: size %u, threads %u is Wrong\n", name,
+                                                       (unsigned int)sizes[i], (unsigned int)threads );
+         result = ak_false;
+       }
+    }
+  }
+  if( result == ak_true ) printf("%s: Ok\n", name );
+  ak_bckey_destroy( &bkey );
+
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+  size_t size = 1048576 + 7;
+  ak_uint8 *in = NULL, *out1 = NULL, *out2 = NULL;
+  int oc = ak_false, exitcode = EXIT_FAILURE;
+  ak_uint32 seed = 1317;
+  struct random generator;
+
+  ak_libakrypt_create( ak_function_log_stderr );
+
+  in = malloc( size ); out1 = malloc( size ); out2 = malloc( size );
+  if(( in == NULL ) || ( out1 == NULL ) || ( out2 == NULL )) goto ex;
+
+ /* формируем как бы случайные данные */
+  ak_random_create_lcg( &generator );
+  ak_random_randomize( &generator, &seed, 4 );
+  ak_random_ptr( &generator, in, size );
+  ak_random_destroy( &generator );
+
+  if( test_cipher( ak_bckey_create_magma, "magma", in, out1, out2, size ) != ak_true ) goto ex;
+  if( test_cipher( ak_bckey_create_kuznechik, "kuznechik", in, out1, out2, size ) != ak_true )
+    goto ex;
+
+ /* повторяем проверку в режиме совместимости с openssl, в котором ключ Магмы
+    хранится в перевернутом виде */
+  oc = (int) ak_libakrypt_get_option_by_name( "openssl_compability" );
+  ak_libakrypt_set_openssl_compability( ak_true );
+  if( test_cipher( ak_bckey_create_magma, "magma (openssl)", in, out1, out2, size ) != ak_true )
+    goto ex;
+  if( test_cipher( ak_bckey_create_kuznechik, "kuznechik (openssl)",
+                                                            in, out1, out2, size ) != ak_true )
+    goto ex;
+  exitcode = EXIT_SUCCESS;
+
+  ex:
+   ak_libakrypt_set_openssl_compability( oc );
+   if( in ) free( in );
+   if( out1 ) free( out1 );
+   if( out2 ) free( out2 );
+   ak_libakrypt_destroy();
+
+ return exitcode;
+}
@@ -0,0 +1,183 @@
+/* ----------------------------------------------------------------------------------------------- */
+/*  Тестовый пример, иллюстрирующий совпадение контейнеров, формируемых при последовательном       */
+/*  и многопоточном зашифровании файла, а также корректность их расшифрования.                     */
+/* ----------------------------------------------------------------------------------------------- */
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt.h>
+
+/* ----------------------------------------------------------------------------------------------- */
+ static ssize_t get_user_password( const char *prompt, char *password, size_t psize, password_t flag )
+{
+  (void)prompt;
+  (void)flag;
+
+  memset( password, 0, psize );
+  ak_snprintf( password, psize, "password" );
+ return strlen( password );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Побайтовое сравнение двух файлов. */
+ static bool_t compare_files( const char *name1, const char *name2 )
+{
+  ssize_t val1, val2;
+  struct file fp1, fp2;
+  bool_t result = ak_false;
+  ak_uint8 buf1[4096], buf2[4096];
+
+  if( ak_file_open_to_read( &fp1, name1 ) != ak_error_ok ) return ak_false;
+  if( ak_file_open_to_read( &fp2, name2 ) != ak_error_ok ) {
+    ak_file_close( &fp1 );
+    return ak_false;
+  }
+  if( fp1.size == fp2.size ) {
+    do {
+      val1 = ak_file_read( &fp1, buf1, sizeof( buf1 ));
+      val2 = ak_file_read( &fp2, buf2, sizeof( buf2 ));
+      if(( val1 != val2 ) || ( memcmp( buf1, buf2, ( size_t )ak_max( 0, val1 )) != 0 )) break;
+    } while( val1 > 0 );
+    result = ( val1 == 0 );
+  }
+  ak_file_close( &fp1 );
+  ak_file_close( &fp2 );
+
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Изменение одного октета в конце файла (в данных последнего фрагмента). */
+ static bool_t corrupt_file( const char *name )
+{
+  FILE *fp;
+  int ch;
+
+  if(( fp = fopen( name, "r+b" )) == NULL ) return ak_false;
+  fseek( fp, -100, SEEK_END );
+  ch = fgetc( fp );
+  fseek( fp, -100, SEEK_END );
+  fputc( ch^0x5a, fp );
+  fclose( fp );
+
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t test_encrypt( ak_ecies_scheme scheme, const char *mode,
+                                      fraction_mechanism_t mechanism, size_t value, const char *skey )
+{
+  size_t i, threads[3] = { 1, 2, 5 };
+  ak_uint32 seed = 0x3517;
+  bool_t result = ak_true;
+  struct random generator;
+  char outfile[64];
+  struct encryption_set set = {
+    .mode = ak_oid_find_by_name( mode ),
+    .fraction = { .mechanism = mechanism, .value = value },
+    .scheme = ecies_scheme
+  };
+
+  for( i = 0; i < 3; i++ ) {
+    /* одинаковая последовательность случайных значений для всех вариантов */
+     ak_random_create_lcg( &generator );
+     ak_random_randomize( &generator, &seed, sizeof( seed ));
+     ak_libakrypt_set_option( "encrypt_file_threads", threads[i] );
+     ak_snprintf( outfile, sizeof( outfile ), "encrypt-file-%u.bin", (unsigned int)i );
+     if( ak_encrypt_file( "encrypt-file.dat", &set, scheme,
+                                             outfile, 0, &generator, "container-password-for-the-test", 32 ) != ak_error_ok ) {
+       printf("%s (threads: %u): encryption is Wrong\n", mode, (unsigned int)threads[i] );
+       result = ak_false;
+     }
+     ak_random_destroy( &generator );
+
+     if(( i > 0 ) && !compare_files( "encrypt-file-0.bin", outfile )) {
+       printf("%s (threads: %u): containers are not equal\n", mode, (unsigned int)threads[i] );
+       result = ak_false;
+     }
+  }
+
+  ak_snprintf( outfile, sizeof( outfile ), "encrypt-file.out" );
+  for( i = 0; i < 3; i++ ) {
+     ak_libakrypt_set_option( "encrypt_file_threads", threads[i] );
+     if( ak_decrypt_file( "encrypt-file-2.bin", "container-password-for-the-test", 32,
+                                                               skey, outfile, 0 ) != ak_error_ok ) {
+       printf("%s (threads: %u): decryption is Wrong\n", mode, (unsigned int)threads[i] );
+       result = ak_false;
+     } else
+        if( !compare_files( "encrypt-file.dat", outfile )) {
+          printf("%s (threads: %u): decrypted data is Wrong\n", mode, (unsigned int)threads[i] );
+          result = ak_false;
+        }
+     remove( outfile );
+  }
+
+ /* искаженный контейнер не должен расшифровываться */
+  if( corrupt_file( "encrypt-file-1.bin" )) {
+    if( ak_decrypt_file( "encrypt-file-1.bin", "container-password-for-the-test", 32,
+                                                               skey, outfile, 0 ) == ak_error_ok ) {
+      printf("%s: corrupted container is decrypted\n", mode );
+      result = ak_false;
+    }
+  } else result = ak_false;
+
+  for( i = 0; i < 3; i++ ) {
+     ak_snprintf( outfile, sizeof( outfile ), "encrypt-file-%u.bin", (unsigned int)i );
+     remove( outfile );
+  }
+  remove( "encrypt-file.out" );
+  if( result ) printf("%s: Ok\n", mode );
+
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+  struct file fp;
+  struct signkey sk;
+  struct random generator;
+  struct ecies_scheme scheme;
+  ak_uint8 buffer[4096];
+  ak_uint32 seed = 1317;
+  char skey[128];
+  size_t i;
+  int exitcode = EXIT_FAILURE;
+
+  if( ak_libakrypt_create( ak_function_log_stderr ) != ak_true ) return ak_libakrypt_destroy();
+  ak_libakrypt_set_password_read_function( get_user_password );
+
+ /* формируем как бы случайный входной файл */
+  ak_random_create_lcg( &generator );
+  ak_random_randomize( &generator, &seed, sizeof( seed ));
+  if( ak_file_create_to_write( &fp, "encrypt-file.dat" ) != ak_error_ok ) goto ex;
+  for( i = 0; i < 75; i++ ) {
+     ak_random_ptr( &generator, buffer, sizeof( buffer ));
+     ak_file_write( &fp, buffer, sizeof( buffer ) - (( i == 74 ) ? 1001 : 0 ));
+  }
+  ak_file_close( &fp );
+
+ /* создаем ключевую пару получателя */
+  memset( &scheme, 0, sizeof( struct ecies_scheme ));
+  ak_signkey_create_str( &sk, "id-tc26-gost-3410-2012-256-paramSetA" );
+  ak_signkey_set_key_random( &sk, &generator );
+  ak_verifykey_create_from_signkey( &scheme.recipient.vkey, &sk );
+  memset( skey, 0, sizeof( skey ));
+  ak_skey_export_to_file_with_password( &sk, "password", 8, skey, sizeof( skey ), asn1_der_format );
+  ak_signkey_destroy( &sk );
+  ak_random_destroy( &generator );
+
+  if( !test_encrypt( &scheme, "mgm-kuznechik", size_fraction, 20000, skey )) goto ex2;
+  if( !test_encrypt( &scheme, "mgm-magma", random_size_fraction, 10, skey )) goto ex2;
+  if( !test_encrypt( &scheme, "ctr-cmac-kuznechik", count_fraction, 7, skey )) goto ex2;
+  exitcode = EXIT_SUCCESS;
+
+  ex2:
+   ak_verifykey_destroy( &scheme.recipient.vkey );
+   remove( skey );
+  ex:
+   remove( "encrypt-file.dat" );
+   ak_libakrypt_destroy();
+
+ return exitcode;
+}
@@ -0,0 +1,110 @@
+/* ----------------------------------------------------------------------------------------------- */
+/*  Тестовый пример, иллюстрирующий совпадение результатов последовательного и пакетного          */
+/*  вычисления хеш-кодов и имитовставок для нескольких независимых сообщений.                      */
+/* ----------------------------------------------------------------------------------------------- */
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt.h>
+
+/* ----------------------------------------------------------------------------------------------- */
+ #define count (7)
+ size_t sizes[count] = { 0, 63, 64, 1000, 4101, 128, 70000 };
+
+/* ----------------------------------------------------------------------------------------------- */
+ static int test_hash( ak_uint8 *data )
+{
+  size_t idx = 0;
+  int result = ak_true;
+  struct hash ctx[count];
+  ak_hash hctx[count];
+  ak_pointer in[count], out[count];
+  ak_uint8 out1[count][64], out2[count][64];
+
+  for( idx = 0; idx < count; idx++ ) {
+     if( idx&1 ) ak_hash_create_streebog256( hctx[idx] = ctx + idx );
+       else ak_hash_create_streebog512( hctx[idx] = ctx + idx );
+     in[idx] = data + 3*idx;
+     out[idx] = out2[idx];
+     memset( out1[idx], 0, 64 );
+     memset( out2[idx], 0, 64 );
+     ak_hash_ptr( hctx[idx], in[idx], sizes[idx], out1[idx], 64 );
+  }
+
+  if( ak_hash_ptr_multi( hctx, in, sizes, out, 64, count ) != ak_error_ok ) result = ak_false;
+  for( idx = 0; idx < count; idx++ ) {
+     if( memcmp( out1[idx], out2[idx], 64 ) != 0 ) {
+       printf("hash: message %u with length %u is Wrong\n",
+                                                   (unsigned int)idx, (unsigned int)sizes[idx] );
+       result = ak_false;
+     }
+     ak_hash_destroy( hctx[idx] );
+  }
+  if( result == ak_true ) printf("ak_hash_ptr_multi: Ok\n");
+
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static int test_hmac( ak_uint8 *data )
+{
+  size_t idx = 0;
+  int result = ak_true;
+  struct hmac ctx[count];
+  ak_hmac hctx[count];
+  ak_pointer in[count], out[count];
+  ak_uint8 out1[count][64], out2[count][64];
+
+  for( idx = 0; idx < count; idx++ ) {
+     if( idx&1 ) ak_hmac_create_streebog256( hctx[idx] = ctx + idx );
+       else ak_hmac_create_streebog512( hctx[idx] = ctx + idx );
+     ak_hmac_set_key( hctx[idx], data + 11*idx, 32 );
+     in[idx] = data + 5*idx;
+     out[idx] = out2[idx];
+     memset( out1[idx], 0, 64 );
+     memset( out2[idx], 0, 64 );
+     ak_hmac_ptr( hctx[idx], in[idx], sizes[idx], out1[idx], 64 );
+  }
+
+  if( ak_hmac_ptr_multi( hctx, in, sizes, out, 64, count ) != ak_error_ok ) result = ak_false;
+  for( idx = 0; idx < count; idx++ ) {
+     if( memcmp( out1[idx], out2[idx], 64 ) != 0 ) {
+       printf("hmac: message %u with length %u is Wrong\n",
+                                                   (unsigned int)idx, (unsigned int)sizes[idx] );
+       result = ak_false;
+     }
+     ak_hmac_destroy( hctx[idx] );
+  }
+  if( result == ak_true ) printf("ak_hmac_ptr_multi: Ok\n");
+
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+  size_t size = 70100;
+  ak_uint8 *data = NULL;
+  int exitcode = EXIT_FAILURE;
+  ak_uint32 seed = 1931;
+  struct random generator;
+
+  ak_libakrypt_create( ak_function_log_stderr );
+  if(( data = malloc( size )) == NULL ) goto ex;
+
+ /* формируем как бы случайные данные */
+  ak_random_create_lcg( &generator );
+  ak_random_randomize( &generator, &seed, 4 );
+  ak_random_ptr( &generator, data, size );
+  ak_random_destroy( &generator );
+
+  if( test_hash( data ) != ak_true ) goto ex;
+  if( test_hmac( data ) != ak_true ) goto ex;
+  exitcode = EXIT_SUCCESS;
+
+  ex:
+   if( data ) free( data );
+   ak_libakrypt_destroy();
+
+ return exitcode;
+}
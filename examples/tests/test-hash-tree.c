@@ -0,0 +1,217 @@
+/* ----------------------------------------------------------------------------------------------- */
+/*  Тестовый пример, иллюстрирующий совпадение результатов древовидного хеширования данных,        */
+/*  размещенных в оперативной памяти, и многопоточного хеширования файлов, а также сохранение,      */
+/*  повторное использование и проверку хеш-кодов листьев.                                          */
+/* ----------------------------------------------------------------------------------------------- */
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt.h>
+
+/* ----------------------------------------------------------------------------------------------- */
+ #define leaf ak_streebog_tree_leaf_size
+
+ ak_uint8 testkey[32] = {
+    0xef, 0xcd, 0xab, 0x89, 0x67, 0x45, 0x23, 0x01, 0x10, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe,
+    0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00, 0xff, 0xee, 0xdd, 0xcc, 0xbb, 0xaa, 0x99, 0x88 };
+
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t write_file( const char *name, ak_uint8 *data, size_t size )
+{
+  struct file fp;
+
+  if( ak_file_create_to_write( &fp, name ) != ak_error_ok ) return ak_false;
+  if( size ) ak_file_write( &fp, data, size );
+  ak_file_close( &fp );
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление хеш-кода дерева из двух листьев с помощью функции Стрибог256. */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t test_construction( ak_uint8 *data, size_t size )
+{
+  size_t i;
+  struct hash sctx, tctx;
+  ak_uint8 m[81], d[2][32], out1[32], out2[32], *buffer = NULL;
+
+  if(( buffer = malloc( leaf + 1 )) == NULL ) return ak_false;
+  ak_hash_create_streebog256( &sctx );
+  memcpy( buffer, data, leaf ); buffer[leaf] = 0x00;
+  ak_hash_ptr( &sctx, buffer, leaf + 1, d[0], 32 );
+  memcpy( buffer, data + leaf, size - leaf ); buffer[size - leaf] = 0x00;
+  ak_hash_ptr( &sctx, buffer, size - leaf + 1, d[1], 32 );
+  memcpy( m, d[0], 32 ); memcpy( m+32, d[1], 32 ); m[64] = 0x01;
+  ak_hash_ptr( &sctx, m, 65, m, 32 );
+  for( i = 0; i < 8; i++ ) {
+     m[32+i] = ( ak_uint8 )(( ak_uint64 )size >> ( i << 3 ));
+     m[40+i] = ( ak_uint8 )(( ak_uint64 )leaf >> ( i << 3 ));
+  }
+  m[48] = 0x02;
+  ak_hash_ptr( &sctx, m, 49, out1, 32 );
+  ak_hash_destroy( &sctx );
+  free( buffer );
+
+  ak_hash_create_tree_streebog256( &tctx );
+  ak_hash_ptr( &tctx, data, size, out2, 32 );
+  ak_hash_destroy( &tctx );
+
+  if( memcmp( out1, out2, 32 ) != 0 ) {
+    printf("tree construction is Wrong\n");
+    return ak_false;
+  }
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t test_file( ak_hash hctx, ak_hmac hmac, ak_uint8 *data, size_t size )
+{
+  size_t len, done;
+  bool_t result = ak_true;
+  int mmap, threads;
+  ak_uint8 out1[3][64], out2[2][64];
+
+  if( !write_file( "hash-tree.dat", data, size )) return ak_false;
+
+ /* хеширование в оперативной памяти, целиком и фрагментами произвольной длины */
+  memset( out1, 0, sizeof( out1 ));
+  ak_hash_ptr( hctx, data, size, out1[0], 64 );
+  ak_hmac_ptr( hmac, data, size, out1[1], 64 );
+  ak_hash_clean( hctx );
+  for( done = 0; done + 1000 < size; done += len )
+     ak_hash_update( hctx, data + done, len = ak_min( 1000, size - done - 1000 ));
+  ak_hash_finalize( hctx, data + done, size - done, out1[2], 64 );
+  if( memcmp( out1[0], out1[2], 64 ) != 0 ) {
+    printf("size %u, fragmented update is Wrong\n", (unsigned int)size );
+    result = ak_false;
+  }
+
+  for( mmap = 0; mmap < 2; mmap++ ) {
+     ak_libakrypt_set_option( "use_mmap_for_files", mmap );
+     for( threads = 1; threads <= 5; threads += 2 ) {
+        ak_libakrypt_set_option( "tree_hash_threads", threads );
+        memset( out2, 0, sizeof( out2 ));
+        ak_hash_file( hctx, "hash-tree.dat", out2[0], 64 );
+        ak_hmac_file( hmac, "hash-tree.dat", out2[1], 64 );
+        if( memcmp( out1, out2, sizeof( out2 )) != 0 ) {
+          printf("size %u, threads %d, mmap %d is Wrong\n", (unsigned int)size, threads, mmap );
+          result = ak_false;
+        }
+     }
+  }
+  remove( "hash-tree.dat" );
+
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t test_leaves( ak_hash hctx, ak_uint8 *data, size_t size )
+{
+  struct file fp;
+  size_t damaged = 0;
+  ak_uint8 out1[64], out2[64], out3[64], *buffer = NULL;
+  bool_t result = ak_false;
+  int error = ak_error_ok;
+
+  if( !write_file( "hash-tree.dat", data, size )) return ak_false;
+  remove( "hash-tree.leaves" );
+  ak_hash_file( hctx, "hash-tree.dat", out1, 64 );
+  if(( ak_hash_tree_file_leaves( hctx, "hash-tree.dat", "hash-tree.leaves", out2, 64 )
+                                                 != ak_error_ok ) || memcmp( out1, out2, 64 )) {
+    printf("leaves: computation is Wrong\n");
+    goto labex;
+  }
+  if(( ak_hash_tree_leaves_root( hctx, "hash-tree.leaves", out3, 64 ) != ak_error_ok ) ||
+                                                                       memcmp( out1, out3, 64 )) {
+    printf("leaves: root computation is Wrong\n");
+    goto labex;
+  }
+
+ /* имитируем прерванное вычисление: оставляем заголовок и хеш-код первого листа */
+  if( ak_file_open_to_read( &fp, "hash-tree.leaves" ) != ak_error_ok ) goto labex;
+  if(( buffer = malloc(( size_t )fp.size )) == NULL ) { ak_file_close( &fp ); goto labex; }
+  ak_file_read( &fp, buffer, ( size_t )fp.size );
+  ak_file_close( &fp );
+  if( !write_file( "hash-tree.leaves", buffer, 32 + ak_hash_get_tag_size( hctx ))) goto labex;
+  if( ak_hash_tree_leaves_root( hctx, "hash-tree.leaves", out3, 64 ) == ak_error_ok ) {
+    printf("leaves: incomplete file is accepted\n");
+    goto labex;
+  }
+  memset( out2, 0, sizeof( out2 ));
+  if(( ak_hash_tree_file_leaves( hctx, "hash-tree.dat", "hash-tree.leaves", out2, 64 )
+                                                 != ak_error_ok ) || memcmp( out1, out2, 64 )) {
+    printf("leaves: resumed computation is Wrong\n");
+    goto labex;
+  }
+
+ /* проверяем все листья, затем искажаем третий лист и проверяем заново */
+  if( ak_hash_tree_file_check_leaves( hctx, "hash-tree.dat",
+                                             "hash-tree.leaves", 0, 0, &damaged ) != ak_error_ok ) {
+    printf("leaves: check is Wrong\n");
+    goto labex;
+  }
+  data[2*leaf + 5] ^= 0x01;
+  write_file( "hash-tree.dat", data, size );
+  data[2*leaf + 5] ^= 0x01;
+  if( ak_hash_tree_file_check_leaves( hctx, "hash-tree.dat",
+                                             "hash-tree.leaves", 0, 2, &damaged ) != ak_error_ok ) {
+    printf("leaves: check of undamaged range is Wrong\n");
+    goto labex;
+  }
+  error = ak_hash_tree_file_check_leaves( hctx, "hash-tree.dat",
+                                                          "hash-tree.leaves", 1, 0, &damaged );
+  if(( error != ak_error_not_equal_data ) || ( damaged != 2 )) {
+    printf("leaves: damaged leaf is not found\n");
+    goto labex;
+  }
+  printf("leaves: Ok\n");
+  result = ak_true;
+
+  labex:
+   if( buffer != NULL ) free( buffer );
+   remove( "hash-tree.dat" );
+   remove( "hash-tree.leaves" );
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+  size_t i, sizes[8] = { 0, 1, 63, 64, leaf - 1, leaf, leaf + 1, 3*leaf + 17 };
+  int exitcode = EXIT_FAILURE;
+  struct random generator;
+  ak_uint32 seed = 1317;
+  ak_uint8 *data = NULL;
+  struct hash hctx;
+  struct hmac hmac;
+
+  ak_libakrypt_create( ak_function_log_stderr );
+
+  if(( data = malloc( sizes[7] )) == NULL ) goto ex;
+  ak_random_create_lcg( &generator );
+  ak_random_randomize( &generator, &seed, sizeof( seed ));
+  ak_random_ptr( &generator, data, sizes[7] );
+  ak_random_destroy( &generator );
+
+  exitcode = EXIT_SUCCESS;
+  if( !test_construction( data, leaf + 100 )) exitcode = EXIT_FAILURE;
+
+  ak_hash_create_tree_streebog256( &hctx );
+  ak_hmac_create_tree_streebog512( &hmac );
+  ak_hmac_set_key( &hmac, testkey, 32 );
+  for( i = 0; i < 8; i++ )
+     if( !test_file( &hctx, &hmac, data, sizes[i] )) exitcode = EXIT_FAILURE;
+  if( exitcode == EXIT_SUCCESS ) printf("tree hash file: Ok\n");
+  ak_hmac_destroy( &hmac );
+  ak_hash_destroy( &hctx );
+
+  ak_hash_create_tree_streebog512( &hctx );
+  if( !test_leaves( &hctx, data, sizes[7] )) exitcode = EXIT_FAILURE;
+  ak_hash_destroy( &hctx );
+
+  ex:
+   if( data ) free( data );
+   ak_libakrypt_destroy();
+
+ return exitcode;
+}
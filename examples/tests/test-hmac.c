@@ -17,11 +17,44 @@
       (unsigned long int)ak_hmac_get_tag_size( ctx ), ctx->key.oid->name[0], ctx->key.oid->id[0] );
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка того, что сохраненные состояния функции хеширования обновляются
+    при смене ключа, а повторные вычисления дают одинаковый результат. */
+/* ----------------------------------------------------------------------------------------------- */
+ bool_t rekey( ak_oid oid )
+{
+  ak_hmac ctx1, ctx2;
+  bool_t result = ak_true;
+  ak_uint8 out1[64], out2[64], out3[64];
+  size_t size = 0;
+
+  ctx1 = ak_oid_new_object( oid );
+  ctx2 = ak_oid_new_object( oid );
+  size = ak_hmac_get_tag_size( ctx1 );
+  ak_hmac_set_key( ctx1, "first key", 9 );
+  ak_hmac_ptr( ctx1, "data", 4, out1, sizeof( out1 ));
+  ak_hmac_ptr( ctx1, "data", 4, out2, sizeof( out2 ));
+  if( memcmp( out1, out2, size ) != 0 ) result = ak_false;
+
+  ak_hmac_set_key( ctx1, "second key", 10 );
+  ak_hmac_set_key( ctx2, "second key", 10 );
+  ak_hmac_ptr( ctx1, "data", 4, out2, sizeof( out2 ));
+  ak_hmac_ptr( ctx2, "data", 4, out3, sizeof( out3 ));
+  if(( memcmp( out2, out3, size ) != 0 ) ||
+     ( memcmp( out1, out2, size ) == 0 )) result = ak_false;
+
+  printf("%s rekey: %s\n", oid->name[0], result ? "Ok" : "Wrong" );
+  ak_oid_delete_object( oid, ctx1 );
+  ak_oid_delete_object( oid, ctx2 );
+ return result;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
  int main( void )
 {
   ak_oid oid;
   ak_pointer ptr;
+  int exitcode = EXIT_SUCCESS;
 
   /* проверяем создание/удаление контекстов с алгоритмами hmac */
    function( ptr = ak_oid_new_object( oid = ak_oid_find_by_name( "nmac-streebog" )));
@@ -33,10 +66,15 @@
    function( ptr = ak_oid_new_object( oid = ak_oid_find_by_name( "hmac-streebog512" )));
    ak_oid_delete_object( oid, ptr );
 
+  /* проверяем повторное использование сохраненных состояний */
+   if( !rekey( ak_oid_find_by_name( "nmac-streebog" ))) exitcode = EXIT_FAILURE;
+   if( !rekey( ak_oid_find_by_name( "hmac-streebog512" ))) exitcode = EXIT_FAILURE;
+   if( !rekey( ak_oid_find_by_name( "hmac-tree-streebog256" ))) exitcode = EXIT_FAILURE;
+
   /* проверяем выработку производной ключевой информации с исопльзованием указанных алгоритмов */
   // ak_skey_derive_key_to_ptr
 
- return EXIT_SUCCESS;
+ return exitcode;
 }
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -0,0 +1,192 @@
+/* ----------------------------------------------------------------------------------------------- */
+/*  Тестовый пример, иллюстрирующий независимость кодов ошибок, устанавливаемых различными         */
+/*  потоками, подавление сообщений на уровне аудита ak_log_silent и вывод сообщений через          */
+/*  кольцевые буфферы потоков.                                                                     */
+/* ----------------------------------------------------------------------------------------------- */
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt.h>
+#ifdef AK_HAVE_PTHREAD_H
+ #include <pthread.h>
+#else
+ #ifdef AK_HAVE_THREADS_H
+  #include <threads.h>
+ #endif
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+ #define threads_count (8)
+ #define messages_count (40)
+
+ static size_t received = 0;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вывода, вызываемая только потоком, обслуживающим кольцевые буфферы. */
+ static int count_messages( const char *message )
+{
+  if( strstr( message, "test message" ) != NULL ) received++;
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка того, что на уровне ak_log_silent сообщения не выводятся, а код ошибки
+    по-прежнему устанавливается; остальные отрицательные уровни соответствуют ak_log_none. */
+ static bool_t test_silent( void )
+{
+  bool_t result = ak_true;
+
+  received = 0;
+  ak_log_set_function( count_messages );
+  ak_log_set_level( ak_log_silent );
+  if(( ak_error_message( -100, __func__, "test message" ) != -100 ) ||
+     ( ak_error_get_value() != -100 )) result = ak_false;
+  if(( ak_error_message_fmt( -101, __func__, "test message %d", 1 ) != -101 ) ||
+     ( ak_error_get_value() != -101 )) result = ak_false;
+  if( received != 0 ) result = ak_false;
+  ak_log_set_level( ak_log_none );
+  ak_error_message( -102, __func__, "test message" );
+  if( received != 1 ) result = ak_false;
+  if( ak_log_set_level( -1 ) != ak_log_none ) result = ak_false;
+  ak_error_message( -103, __func__, "test message" );
+  if( received != 2 ) result = ak_false;
+  ak_log_set_function( ak_function_log_stderr );
+  ak_error_set_value( ak_error_ok );
+
+  if( result ) printf("silent log level: Ok\n");
+   else printf("silent log level: Wrong\n");
+ return result;
+}
+
+#if defined( AK_HAVE_PTHREAD_H ) || defined( AK_HAVE_THREADS_H )
+/* ----------------------------------------------------------------------------------------------- */
+ typedef struct task {
+ #ifdef AK_HAVE_PTHREAD_H
+   pthread_t thread;
+ #else
+   thrd_t thread;
+ #endif
+   bool_t started;
+   int code;
+   bool_t result;
+ } *ak_task;
+
+/* ----------------------------------------------------------------------------------------------- */
+ static void run_task( ak_task task )
+{
+  size_t i;
+
+  task->result = ak_true;
+  for( i = 0; i < messages_count; i++ ) {
+     ak_error_message( task->code, __func__, "test message" );
+     if( ak_error_get_value() != task->code ) task->result = ak_false;
+     if( ak_log_get_level() >= ak_log_maximum )
+       ak_error_message_fmt( ak_error_ok, __func__, "informational message %u", (unsigned int)i );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+#ifdef AK_HAVE_PTHREAD_H
+ static void *worker( void *ptr )
+{
+  run_task( ptr );
+ return NULL;
+}
+#else
+ static int worker( void *ptr )
+{
+  run_task( ptr );
+ return 0;
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Запуск потоков, каждый из которых устанавливает собственный код ошибки. */
+ static bool_t run_tasks( struct task *tasks )
+{
+  size_t i;
+  bool_t result = ak_true;
+
+  for( i = 0; i < threads_count; i++ ) {
+     tasks[i].code = -100 - ( int )i;
+    #ifdef AK_HAVE_PTHREAD_H
+     tasks[i].started = ( pthread_create( &tasks[i].thread, NULL, worker, tasks+i ) == 0 );
+    #else
+     tasks[i].started = ( thrd_create( &tasks[i].thread, worker, tasks+i ) == thrd_success );
+    #endif
+     if( !tasks[i].started ) worker( tasks+i );
+  }
+  for( i = 0; i < threads_count; i++ ) {
+    #ifdef AK_HAVE_PTHREAD_H
+     if( tasks[i].started ) pthread_join( tasks[i].thread, NULL );
+    #else
+     if( tasks[i].started ) thrd_join( tasks[i].thread, NULL );
+    #endif
+  }
+  for( i = 0; i < threads_count; i++ )
+     if( tasks[i].result != ak_true ) {
+       printf("thread %u: error code is Wrong\n", (unsigned int)i );
+       result = ak_false;
+     }
+ return result;
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+#if defined( AK_HAVE_PTHREAD_H ) || defined( AK_HAVE_THREADS_H )
+  struct task tasks[ threads_count ];
+#endif
+  int exitcode = EXIT_SUCCESS;
+
+  if( !ak_libakrypt_create( ak_function_log_stderr )) return ak_libakrypt_destroy();
+  if( !test_silent( )) exitcode = EXIT_FAILURE;
+
+#ifdef AK_HAVE_PTHREAD_H
+ /* на минимальном уровне аудита информационные сообщения не выводятся */
+  received = 0;
+  ak_log_set_level( ak_log_none );
+  if( ak_log_ring_start( count_messages ) != ak_error_ok ) {
+    ak_libakrypt_destroy();
+    return EXIT_FAILURE;
+  }
+  if( !run_tasks( tasks )) exitcode = EXIT_FAILURE;
+  ak_log_ring_stop();
+  ak_log_set_level( ak_log_standard );
+
+  if( received != threads_count*messages_count ) {
+    printf("received %u messages of %u: Wrong\n",
+                              (unsigned int)received, (unsigned int)( threads_count*messages_count ));
+    exitcode = EXIT_FAILURE;
+  }
+
+ /* сообщение, помещенное в буффер после остановки потока, выводится при следующем запуске */
+  ak_function_log_ring( "late test message" );
+  if(( ak_log_ring_start( count_messages ) != ak_error_ok ) ||
+     ( ak_log_ring_stop() != ak_error_ok ) || ( received != threads_count*messages_count + 1 )) {
+    printf("late message is lost: Wrong\n");
+    exitcode = EXIT_FAILURE;
+  }
+  if( exitcode == EXIT_SUCCESS ) printf("ring logger: Ok\n");
+#else
+ #ifdef AK_HAVE_THREADS_H
+ /* без поддержки потоков POSIX кольцевые буфферы недоступны, поэтому проверяется только
+    независимость кодов ошибок, а сообщения не выводятся */
+  ak_log_set_level( ak_log_silent );
+  if( !run_tasks( tasks )) exitcode = EXIT_FAILURE;
+  ak_log_set_level( ak_log_standard );
+  if( exitcode == EXIT_SUCCESS ) printf("thread local error codes: Ok\n");
+ #else
+  printf("thread local error codes: skipped (no threads support)\n");
+ #endif
+  if( ak_log_ring_start( count_messages ) == ak_error_ok ) {
+    printf("ring logger started without POSIX threads support: Wrong\n");
+    exitcode = EXIT_FAILURE;
+  }
+#endif
+  ak_error_set_value( ak_error_ok );
+  ak_libakrypt_destroy();
+
+ return exitcode;
+}
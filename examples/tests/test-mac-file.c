@@ -0,0 +1,92 @@
+/* ----------------------------------------------------------------------------------------------- */
+/*  Тестовый пример, иллюстрирующий совпадение хеш-кодов и имитовставок, вычисленных для файлов    */
+/*  (с отображением файлов в память и без него, для различных длин буффера), со значениями,        */
+/*  вычисленными для данных, размещенных в оперативной памяти.                                     */
+/* ----------------------------------------------------------------------------------------------- */
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt.h>
+
+/* ----------------------------------------------------------------------------------------------- */
+ ak_uint8 testkey[32] = {
+    0xef, 0xcd, 0xab, 0x89, 0x67, 0x45, 0x23, 0x01, 0x10, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe,
+    0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00, 0xff, 0xee, 0xdd, 0xcc, 0xbb, 0xaa, 0x99, 0x88 };
+
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t test_file( ak_hash hctx, ak_hmac hmac, ak_bckey bkey, ak_uint8 *data, size_t size )
+{
+  struct file fp;
+  int mmap, bufsize;
+  bool_t result = ak_true;
+  ak_uint8 out1[3][64], out2[3][64];
+
+  if( ak_file_create_to_write( &fp, "mac-file.dat" ) != ak_error_ok ) return ak_false;
+  ak_file_write( &fp, data, size );
+  ak_file_close( &fp );
+
+  memset( out1, 0, sizeof( out1 ));
+  ak_hash_ptr( hctx, data, size, out1[0], 32 );
+  ak_hmac_ptr( hmac, data, size, out1[1], 64 );
+  ak_bckey_cmac( bkey, size ? data : NULL, size, out1[2], 16 );
+
+  for( mmap = 0; mmap < 2; mmap++ ) {
+     ak_libakrypt_set_option( "use_mmap_for_files", mmap );
+     for( bufsize = 4096; bufsize <= 16384; bufsize <<= 2 ) {
+        ak_libakrypt_set_option( "file_buffer_size", bufsize );
+        memset( out2, 0, sizeof( out2 ));
+        ak_hash_file( hctx, "mac-file.dat", out2[0], 32 );
+        ak_hmac_file( hmac, "mac-file.dat", out2[1], 64 );
+        ak_bckey_cmac_file( bkey, "mac-file.dat", out2[2], 16 );
+        if( memcmp( out1, out2, sizeof( out1 )) != 0 ) {
+          printf("size %u, buffer %d, mmap %d is Wrong\n", (unsigned int)size, bufsize, mmap );
+          result = ak_false;
+        }
+     }
+  }
+  remove( "mac-file.dat" );
+
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+  size_t i, sizes[7] = { 0, 1, 4095, 4096, 16384, 40000, 65536 + 4096 + 17 };
+  int exitcode = EXIT_FAILURE;
+  struct random generator;
+  ak_uint32 seed = 1317;
+  ak_uint8 *data = NULL;
+  struct bckey bkey;
+  struct hash hctx;
+  struct hmac hmac;
+
+  ak_libakrypt_create( ak_function_log_stderr );
+
+  if(( data = malloc( sizes[6] )) == NULL ) goto ex;
+  ak_random_create_lcg( &generator );
+  ak_random_randomize( &generator, &seed, sizeof( seed ));
+  ak_random_ptr( &generator, data, sizes[6] );
+  ak_random_destroy( &generator );
+
+  ak_hash_create_streebog256( &hctx );
+  ak_hmac_create_streebog512( &hmac );
+  ak_hmac_set_key( &hmac, testkey, 32 );
+  ak_bckey_create_kuznechik( &bkey );
+  ak_bckey_set_key( &bkey, testkey, 32 );
+
+  exitcode = EXIT_SUCCESS;
+  for( i = 0; i < 7; i++ )
+     if( !test_file( &hctx, &hmac, &bkey, data, sizes[i] )) exitcode = EXIT_FAILURE;
+  if( exitcode == EXIT_SUCCESS ) printf("mac file: Ok\n");
+
+  ak_bckey_destroy( &bkey );
+  ak_hmac_destroy( &hmac );
+  ak_hash_destroy( &hctx );
+
+  ex:
+   if( data ) free( data );
+   ak_libakrypt_destroy();
+
+ return exitcode;
+}
@@ -0,0 +1,98 @@
+/* ----------------------------------------------------------------------------------------------- */
+/*  Тестовый пример, иллюстрирующий совпадение результатов обращения вычетов в представлении       */
+/*  Монтгомери с помощью шагов деления и с помощью возведения в степень p-2 (q-2)                  */
+/*  для модулей всех эллиптических кривых.                                                         */
+/* ----------------------------------------------------------------------------------------------- */
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt.h>
+
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t test_inverse( ak_uint64 *x, ak_uint64 *r2,
+                                                   ak_uint64 *p, ak_uint64 n0, const size_t size )
+{
+  ak_mpznmax u, z1, z2, z3, one = ak_mpznmax_one;
+
+  ak_mpzn_set_ui( u, size, 2 );
+  ak_mpzn_sub( u, p, u, size );
+  ak_mpzn_modpow_montgomery( z1, x, u, p, n0, size );
+  ak_mpzn_inverse_montgomery( z2, x, r2, p, n0, size, ak_true );
+  ak_mpzn_inverse_montgomery( z3, x, r2, p, n0, size, ak_false );
+
+  if( memcmp( z1, z2, size*sizeof( ak_uint64 )) != 0 ) return ak_false;
+  if( memcmp( z1, z3, size*sizeof( ak_uint64 )) != 0 ) return ak_false;
+  if( ak_mpzn_cmp_ui( x, size, 0 )) return ak_true;
+
+ /* проверяем, что x*x^{-1} = 1 */
+  ak_mpzn_mul_montgomery( z2, z2, x, p, n0, size );
+  ak_mpzn_mul_montgomery( z2, z2, one, p, n0, size );
+ return ak_mpzn_cmp_ui( z2, size, 1 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t test_modulo( ak_uint64 *r2, ak_uint64 *p, ak_uint64 n0, const size_t size,
+                                              const char *name, const char *mod, ak_random generator )
+{
+  int i = 0;
+  ak_mpznmax x;
+
+ /* граничные значения */
+  ak_mpzn_set_ui( x, size, 0 );
+  if( !test_inverse( x, r2, p, n0, size )) {
+    printf("%s: x = 0 (mod %s) is Wrong\n", name, mod ); return ak_false;
+  }
+  ak_mpzn_set_ui( x, size, 1 );
+  if( !test_inverse( x, r2, p, n0, size )) {
+    printf("%s: x = 1 (mod %s) is Wrong\n", name, mod ); return ak_false;
+  }
+  ak_mpzn_set( x, p, size );
+  x[0]--;
+  if( !test_inverse( x, r2, p, n0, size )) {
+    printf("%s: x = %s-1 is Wrong\n", name, mod ); return ak_false;
+  }
+
+ /* случайные значения */
+  for( i = 0; i < 64; i++ ) {
+     ak_mpzn_set_random_modulo( x, p, size, generator );
+     if( !test_inverse( x, r2, p, n0, size )) {
+       printf("%s: random x (mod %s) is Wrong\n", name, mod ); return ak_false;
+     }
+  }
+
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t test_curve( ak_wcurve wc, const char *name, ak_random generator )
+{
+  if( !test_modulo( wc->r2, wc->p, wc->n, wc->size, name, "p", generator )) return ak_false;
+  if( !test_modulo( wc->r2q, wc->q, wc->nq, wc->size, name, "q", generator )) return ak_false;
+  printf("%s: Ok\n", name );
+
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+  ak_oid oid = NULL;
+  struct random generator;
+  int exitcode = EXIT_SUCCESS;
+
+  ak_libakrypt_create( ak_function_log_stderr );
+  ak_random_create_lcg( &generator );
+
+  oid = ak_oid_find_by_engine( identifier );
+  while( oid != NULL ) {
+    if(( oid->mode == wcurve_params ) && ( oid->data != NULL ))
+      if( !test_curve( ( ak_wcurve ) oid->data, oid->name[0], &generator ))
+        exitcode = EXIT_FAILURE;
+    oid = ak_oid_findnext_by_engine( oid, identifier );
+  }
+
+  ak_random_destroy( &generator );
+  ak_libakrypt_destroy();
+
+ return exitcode;
+}
@@ -0,0 +1,125 @@
+/* ----------------------------------------------------------------------------------------------- */
+/*  Тестовый пример, иллюстрирующий совпадение результатов поиска идентификаторов с помощью        */
+/*  индексов с результатами последовательного перебора массива идентификаторов библиотеки.         */
+/* ----------------------------------------------------------------------------------------------- */
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt.h>
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Последовательный перебор: поиск первого oid, содержащего заданную строку. */
+ static ak_oid linear_find( const char *str, bool_t names )
+{
+  size_t idx, jdx;
+
+  for( idx = 0; idx < ak_libakrypt_oids_count(); idx++ ) {
+     ak_oid oid = ak_oid_find_by_index( idx );
+     const char **list = names ? oid->name : oid->id;
+     for( jdx = 0; ( list != NULL ) && ( list[jdx] != NULL ); jdx++ )
+        if( strcmp( list[jdx], str ) == 0 ) return oid;
+  }
+ return NULL;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Последовательный перебор: поиск первого oid, ссылающегося на заданные данные. */
+ static ak_oid linear_find_data( ak_const_pointer ptr )
+{
+  size_t idx;
+
+  for( idx = 0; idx < ak_libakrypt_oids_count(); idx++ )
+     if( ak_oid_find_by_index( idx )->data == ptr ) return ak_oid_find_by_index( idx );
+ return NULL;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Сравнение списков идентификаторов заданного типа или режима. */
+ static bool_t test_lists( void )
+{
+  size_t idx, value;
+  ak_oid oid, expected;
+
+  for( value = 0; value < undefined_engine; value++ ) {
+     idx = 0; expected = NULL;
+     oid = ak_oid_find_by_engine( value );
+     do {
+       while(( idx < ak_libakrypt_oids_count()) &&
+                                    ( ak_oid_find_by_index( idx )->engine != value )) idx++;
+       expected = ( idx < ak_libakrypt_oids_count()) ? ak_oid_find_by_index( idx++ ) : NULL;
+       if( oid != expected ) {
+         printf("engine %s: list is Wrong\n", ak_libakrypt_get_engine_name( value ));
+         return ak_false;
+       }
+       if( oid != NULL ) oid = ak_oid_findnext_by_engine( oid, value );
+     } while( expected != NULL );
+  }
+  for( value = 0; value < undefined_mode; value++ ) {
+     idx = 0; expected = NULL;
+     oid = ak_oid_find_by_mode( value );
+     do {
+       while(( idx < ak_libakrypt_oids_count()) &&
+                                      ( ak_oid_find_by_index( idx )->mode != value )) idx++;
+       expected = ( idx < ak_libakrypt_oids_count()) ? ak_oid_find_by_index( idx++ ) : NULL;
+       if( oid != expected ) {
+         printf("mode %s: list is Wrong\n", ak_libakrypt_get_mode_name( value ));
+         return ak_false;
+       }
+       if( oid != NULL ) oid = ak_oid_findnext_by_mode( oid, value );
+     } while( expected != NULL );
+  }
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+  size_t idx, jdx, count = 0;
+  int exitcode = EXIT_SUCCESS;
+  ak_oid oid = NULL;
+
+ /* поиск может выполняться до инициализации библиотеки */
+  if( ak_oid_find_by_name( "streebog256" ) == NULL ) {
+    printf("search before initialization is Wrong\n");
+    exitcode = EXIT_FAILURE;
+  }
+  if( !ak_libakrypt_create( ak_function_log_stderr )) return ak_libakrypt_destroy();
+
+  for( idx = 0; idx < ak_libakrypt_oids_count(); idx++ ) {
+     oid = ak_oid_find_by_index( idx );
+     for( jdx = 0; ( oid->name != NULL ) && ( oid->name[jdx] != NULL ); jdx++, count++ )
+        if(( ak_oid_find_by_name( oid->name[jdx] ) != linear_find( oid->name[jdx], ak_true )) ||
+           ( ak_oid_find_by_ni( oid->name[jdx] ) != linear_find( oid->name[jdx], ak_true ))) {
+          printf("name %s is Wrong\n", oid->name[jdx] );
+          exitcode = EXIT_FAILURE;
+        }
+     for( jdx = 0; ( oid->id != NULL ) && ( oid->id[jdx] != NULL ); jdx++, count++ )
+        if( ak_oid_find_by_id( oid->id[jdx] ) != linear_find( oid->id[jdx], ak_false )) {
+          printf("identifier %s is Wrong\n", oid->id[jdx] );
+          exitcode = EXIT_FAILURE;
+        }
+     if(( oid->data != NULL ) && ( ak_oid_find_by_data( oid->data ) != linear_find_data( oid->data ))) {
+       printf("data of %s is Wrong\n", oid->name[0] );
+       exitcode = EXIT_FAILURE;
+     }
+     if( !ak_oid_check( oid )) {
+       printf("check of %s is Wrong\n", oid->name[0] );
+       exitcode = EXIT_FAILURE;
+     }
+  }
+
+ /* несуществующие ключи и некорректные адреса */
+  if(( ak_oid_find_by_name( "streebog" ) != NULL ) || ( ak_oid_find_by_id( "1.2.643" ) != NULL ) ||
+     ( ak_oid_find_by_ni( "" ) != NULL ) || ( ak_oid_find_by_data( &count ) != NULL ) ||
+     ( ak_oid_check( &count )) || ( ak_oid_check(( ak_uint8 *)ak_oid_find_by_index( 1 ) + 1 )) ||
+     ( ak_oid_check( ak_oid_find_by_index( 0 ) + ak_libakrypt_oids_count( )))) {
+    printf("search of undefined values is Wrong\n");
+    exitcode = EXIT_FAILURE;
+  }
+  if( !test_lists( )) exitcode = EXIT_FAILURE;
+  if( exitcode == EXIT_SUCCESS ) printf("oid index (%u keys): Ok\n", (unsigned int)count );
+  ak_error_set_value( ak_error_ok );
+  ak_libakrypt_destroy();
+
+ return exitcode;
+}
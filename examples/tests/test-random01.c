@@ -9,6 +9,10 @@
  #include <string.h>
  #include <stdlib.h>
  #include <libakrypt.h>
+#if defined(__unix__) || defined(__APPLE__)
+ #include <unistd.h>
+ #include <sys/wait.h>
+#endif
 
 /* основная тестирующая функция */
  int test_function( ak_function_random create, const char *result )
@@ -47,6 +51,124 @@
  return retval;
 }
 
+/* проверка того, что выработка данных фрагментами произвольной длины не зависит
+   от границ внутренних фрагментов генератора ctr-drbg-kuznechik */
+ int test_ctr_drbg( void )
+{
+ struct random generator;
+ ak_uint8 seed[4] = { 0x13, 0xAE, 0x4F, 0x0E };
+ size_t i = 0, len = 0, done = 0, size = 1048576 + 3*65536 + 1001;
+ ak_uint8 *buffer = NULL, *chunks = NULL;
+ int retval = ak_false;
+
+  if(( buffer = malloc( 2*size )) == NULL ) return ak_false;
+  chunks = buffer + size;
+  memset( buffer, 0, 2*size );
+
+  if( ak_random_create_ctr_drbg_kuznechik( &generator ) != ak_error_ok ) goto ex;
+  ak_random_randomize( &generator, seed, sizeof( seed ));
+  ak_random_ptr( &generator, buffer, size );
+  ak_random_randomize( &generator, seed, sizeof( seed ));
+  for( i = 1; done < size; done += len, i = ( 7*i + 5 )%20011 )
+     ak_random_ptr( &generator, chunks + done, len = ak_min( i, size - done ));
+  ak_random_destroy( &generator );
+
+  if( memcmp( buffer, chunks, size ) != 0 ) printf("ctr-drbg-kuznechik chunks: Wrong\n");
+   else { printf("ctr-drbg-kuznechik chunks: Ok\n"); retval = ak_true; }
+  ex: free( buffer );
+
+ return retval;
+}
+
+/* проверка того, что при ресурсе ключа Кузнечика, меньшем мегабайта, ключ генератора
+   ctr-drbg-kuznechik меняется до исчерпания ресурса */
+ int test_ctr_drbg_resource( void )
+{
+ struct random generator;
+ size_t size = 2*1048576;
+ ak_uint8 *buffer = NULL;
+ ak_int64 resource = ak_libakrypt_get_option_by_name( "kuznechik_cipher_resource" );
+ int retval = ak_false;
+
+  if(( buffer = malloc( size )) == NULL ) return ak_false;
+  ak_libakrypt_set_option( "kuznechik_cipher_resource", 8196 );
+  if( ak_random_create_ctr_drbg_kuznechik( &generator ) == ak_error_ok ) {
+    retval = ( ak_random_ptr( &generator, buffer, size ) == ak_error_ok );
+    ak_random_destroy( &generator );
+  }
+  ak_libakrypt_set_option( "kuznechik_cipher_resource", resource );
+  free( buffer );
+  printf("ctr-drbg-kuznechik with small key resource: %s\n", retval ? "Ok" : "Wrong" );
+
+ return retval;
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+/* проверка того, что после fork() родительский и дочерний процессы не продолжают
+   одну и ту же последовательность генератора ctr-drbg-kuznechik */
+ int test_ctr_drbg_fork( void )
+{
+ struct random generator;
+ ak_uint8 seed[4] = { 0x13, 0xAE, 0x4F, 0x0E };
+ ak_uint8 parent[32], child[32];
+ int fd[2], status = 0, retval = ak_false;
+ pid_t pid;
+
+  if( ak_random_create_ctr_drbg_kuznechik( &generator ) != ak_error_ok ) return ak_false;
+  ak_random_randomize( &generator, seed, sizeof( seed )); /* одинаковое состояние до fork() */
+  ak_random_ptr( &generator, parent, 8 );
+  if( pipe( fd ) != 0 ) goto ex;
+  if(( pid = fork()) < 0 ) { close( fd[0] ); close( fd[1] ); goto ex; }
+  if( pid == 0 ) {
+    ak_random_ptr( &generator, child, sizeof( child ));
+    status = ( write( fd[1], child, sizeof( child )) == sizeof( child )) ? 0 : 1;
+    _exit( status );
+  }
+  ak_random_ptr( &generator, parent, sizeof( parent ));
+  if(( read( fd[0], child, sizeof( child )) == sizeof( child )) &&
+                                               ( memcmp( parent, child, sizeof( child )) != 0 ))
+    retval = ak_true;
+  waitpid( pid, &status, 0 );
+  close( fd[0] ); close( fd[1] );
+  printf("ctr-drbg-kuznechik fork: %s\n", retval ? "Ok" : "Wrong" );
+
+  ex: ak_random_destroy( &generator );
+ return retval;
+}
+#endif
+
+#ifdef AK_HAVE_SYSRANDOM_H
+/* проверка того, что после fork() родительский и дочерний процессы
+   не получают одинаковые данные из буффера генератора getrandom */
+ int test_getrandom_fork( void )
+{
+ struct random generator;
+ ak_uint8 parent[32], child[32];
+ int fd[2], status = 0, retval = ak_false;
+ pid_t pid;
+
+  if( ak_random_create_getrandom( &generator ) != ak_error_ok ) return ak_false;
+  ak_random_ptr( &generator, parent, 8 ); /* заполняем буффер текущего потока */
+  if( pipe( fd ) != 0 ) goto ex;
+  if(( pid = fork()) < 0 ) { close( fd[0] ); close( fd[1] ); goto ex; }
+  if( pid == 0 ) {
+    ak_random_ptr( &generator, child, sizeof( child ));
+    status = ( write( fd[1], child, sizeof( child )) == sizeof( child )) ? 0 : 1;
+    _exit( status );
+  }
+  ak_random_ptr( &generator, parent, sizeof( parent ));
+  if(( read( fd[0], child, sizeof( child )) == sizeof( child )) &&
+                                               ( memcmp( parent, child, sizeof( child )) != 0 ))
+    retval = ak_true;
+  waitpid( pid, &status, 0 );
+  close( fd[0] ); close( fd[1] );
+  printf("getrandom fork: %s\n", retval ? "Ok" : "Wrong" );
+
+  ex: ak_random_destroy( &generator );
+ return retval;
+}
+#endif
+
  int main( void )
 {
  int error = EXIT_SUCCESS;
@@ -63,10 +185,24 @@
       "578e3e9c0e85850e8037d519a05f8c1d4e88ed3393c869ccded3000d68d524cb" ) != ak_true )
      error = EXIT_FAILURE;
 
+   if( test_function( ak_random_create_ctr_drbg_kuznechik,
+      "692286a237d7e52f2fcbaf800d0e8d525f738479e931a56efb0b005562b3fa08" ) != ak_true )
+     error = EXIT_FAILURE;
+   if( test_ctr_drbg() != ak_true ) error = EXIT_FAILURE;
+   if( test_ctr_drbg_resource() != ak_true ) error = EXIT_FAILURE;
+  #if defined(__unix__) || defined(__APPLE__)
+   if( test_ctr_drbg_fork() != ak_true ) error = EXIT_FAILURE;
+  #endif
+
   #ifdef _WIN32
    if( test_function( ak_random_create_winrtl, NULL ) != ak_true ) error = EXIT_FAILURE;
   #endif
 
+  #ifdef AK_HAVE_SYSRANDOM_H
+   if( test_function( ak_random_create_getrandom, NULL ) != ak_true ) error = EXIT_FAILURE;
+   if( test_getrandom_fork() != ak_true ) error = EXIT_FAILURE;
+  #endif
+
   #if defined(__unix__) || defined(__APPLE__)
    if( test_function( ak_random_create_random, NULL ) != ak_true ) error = EXIT_FAILURE;
    if( test_function( ak_random_create_urandom, NULL ) != ak_true ) error = EXIT_FAILURE;
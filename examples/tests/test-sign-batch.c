@@ -0,0 +1,102 @@
+/* ----------------------------------------------------------------------------------------------- */
+/*  Тестовый пример, иллюстрирующий совпадение результатов пакетной проверки электронных подписей  */
+/*  с результатами последовательной проверки, в том числе для подписей, выработанных на разных     */
+/*  эллиптических кривых, и для искаженных подписей.                                               */
+/* ----------------------------------------------------------------------------------------------- */
+ #include <time.h>
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt.h>
+
+/* ----------------------------------------------------------------------------------------------- */
+ #define count (24)
+
+ int main( void )
+{
+  size_t i, threads;
+  struct random generator;
+  struct signkey sk[2];
+  struct verifykey pk[2];
+  int error, result = EXIT_SUCCESS;
+  ak_uint8 hash[count][64], sign[count][128];
+  ak_pointer hptr[count], sptr[count];
+  ak_verifykey vptr[count];
+  size_t hsize[count];
+  bool_t results[count];
+  const char *curves[2] = { "id-tc26-gost-3410-2012-256-paramSetA",
+                            "id-tc26-gost-3410-2012-512-paramSetA" };
+
+  if( !ak_libakrypt_create( ak_function_log_stderr )) {
+    ak_libakrypt_destroy();
+    return EXIT_FAILURE;
+  }
+  ak_random_create_lcg( &generator );
+
+ /* создаем пару ключей для каждой кривой */
+  for( i = 0; i < 2; i++ ) {
+     ak_signkey_create_str( &sk[i], curves[i] );
+     ak_signkey_set_key_random( &sk[i], &generator );
+     ak_skey_set_resource_values( &sk[i].key, key_using_resource,
+                                 "digital_signature_count_resource", 0, time(NULL)+2592000 );
+     ak_verifykey_create_from_signkey( &pk[i], &sk[i] );
+  }
+  ak_verifykey_precompute_table( &pk[1] );
+
+ /* вырабатываем подписи, чередуя кривые */
+  for( i = 0; i < count; i++ ) {
+     vptr[i] = &pk[i%2];
+     hsize[i] = pk[i%2].wc->size*sizeof( ak_uint64 );
+     hptr[i] = hash[i]; sptr[i] = sign[i];
+     ak_random_ptr( &generator, hash[i], hsize[i] );
+     ak_signkey_sign_hash( &sk[i%2], &generator, hash[i], hsize[i], sign[i], sizeof( sign[i] ));
+  }
+
+ /* все подписи верны */
+  for( threads = 1; threads <= 3; threads += 2 ) {
+     memset( results, 0, sizeof( results ));
+     if(( error = ak_verifykey_verify_batch( vptr, hptr, hsize, sptr,
+                                                        count, results, threads )) != ak_error_ok ) {
+       printf("batch (threads: %u): Wrong (error: %d)\n", (unsigned int)threads, error );
+       result = EXIT_FAILURE;
+     } else printf("batch (threads: %u): Ok\n", (unsigned int)threads );
+     for( i = 0; i < count; i++ )
+        if( results[i] != ak_true ) {
+          printf("item %u is Wrong\n", (unsigned int)i );
+          result = EXIT_FAILURE;
+        }
+  }
+
+ /* искажаем часть подписей, хеш-кодов и длин */
+  sign[3][0] ^= 0x01;
+  sign[11][70] ^= 0x80;
+  hash[17][5] ^= 0x10;
+  hsize[20] = 16;
+  sptr[22] = NULL;
+  for( threads = 1; threads <= 3; threads += 2 ) {
+     error = ak_verifykey_verify_batch( vptr, hptr, hsize, sptr, count, results, threads );
+     if( error != ak_error_not_equal_data ) result = EXIT_FAILURE;
+     for( i = 0; i < count; i++ ) {
+        bool_t expected = ( sptr[i] == NULL ) ? ak_false :
+                                ak_verifykey_verify_hash( vptr[i], hptr[i], hsize[i], sptr[i] );
+        if( results[i] != expected ) {
+          printf("modified item %u is Wrong\n", (unsigned int)i );
+          result = EXIT_FAILURE;
+        }
+        if( expected && (( i == 3 ) || ( i == 11 ) || ( i == 17 ) || ( i == 20 ) || ( i == 22 ))) {
+          printf("modified item %u is accepted\n", (unsigned int)i );
+          result = EXIT_FAILURE;
+        }
+     }
+  }
+  if( result == EXIT_SUCCESS ) printf("batch (modified signs): Ok\n");
+
+  for( i = 0; i < 2; i++ ) {
+     ak_signkey_destroy( &sk[i] );
+     ak_verifykey_destroy( &pk[i] );
+  }
+  ak_random_destroy( &generator );
+  ak_libakrypt_destroy();
+
+ return result;
+}
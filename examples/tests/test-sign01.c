@@ -54,6 +54,16 @@
     printf("verify: Ok\n");
    else { printf("verify: Wrong\n"); result = EXIT_FAILURE; }
 
+ /* проверяем подпись с использованием сохраненной таблицы кратных точек открытого ключа */
+  ak_verifykey_precompute_table( &pk );
+  if( ak_verifykey_verify_file( &pk, argv[0], sign ) == ak_true )
+    printf("verify (precomputed table): Ok\n");
+   else { printf("verify (precomputed table): Wrong\n"); result = EXIT_FAILURE; }
+  sign[0] ^= 0x01;
+  if( ak_verifykey_verify_file( &pk, argv[0], sign ) != ak_true )
+    printf("verify (modified sign): Ok\n");
+   else { printf("verify (modified sign): Wrong\n"); result = EXIT_FAILURE; }
+
   ak_signkey_destroy( &sk );
   ak_verifykey_destroy( &pk );
 
@@ -0,0 +1,158 @@
+/* ----------------------------------------------------------------------------------------------- */
+/*  Тестовый пример, иллюстрирующий смену маски секретного ключа в соответствии с политиками       */
+/*  маскирования: после каждого использования ключ остается корректным (контрольная сумма          */
+/*  совпадает, данные расшифровываются), а маска меняется только тогда, когда этого требует        */
+/*  политика.                                                                                      */
+/* ----------------------------------------------------------------------------------------------- */
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt.h>
+
+/* ----------------------------------------------------------------------------------------------- */
+ ak_uint8 testkey[32] = {
+    0xef, 0xcd, 0xab, 0x89, 0x67, 0x45, 0x23, 0x01, 0x10, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe,
+    0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00, 0xff, 0xee, 0xdd, 0xcc, 0xbb, 0xaa, 0x99, 0x88 };
+
+ #define calls_count (12)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Описание проверяемой политики и ожидаемого момента смены маски. */
+ static struct test_policy {
+   mask_policy_t type;
+   ak_uint64 interval;
+   const char *name;
+ } policies[] = {
+   { mask_always_policy, 0, "always" },
+   { mask_every_n_calls_policy, 3, "every 3 calls" },
+   { mask_every_n_bytes_policy, 40, "every 40 octets" },
+   { mask_never_after_schedule_policy, 0, "never after schedule" }
+ };
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка того, что после call-го обращения к ключу (обращения нумеруются с единицы),
+    в котором обрабатывается size октетов, маска должна смениться. */
+ static bool_t mask_must_change( struct test_policy *policy, size_t call, size_t size )
+{
+  switch( policy->type ) {
+    case mask_always_policy: return ak_true;
+    case mask_every_n_calls_policy: return ( call%policy->interval ) == 0;
+   /* счетчик октетов обнуляется при смене маски */
+    case mask_every_n_bytes_policy:
+      return ( call%(( policy->interval + size - 1 )/size )) == 0;
+    default: return ak_false;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка ключа алгоритма блочного шифрования. */
+ static bool_t test_bckey( ak_function_bckey_create *create, struct test_policy *policy )
+{
+  size_t idx = 0;
+  struct bckey bkey;
+  bool_t changed = ak_false, result = ak_true;
+  ak_uint8 in[16], out[16], dec[16], mask[32];
+
+  create( &bkey );
+  ak_bckey_set_key( &bkey, testkey, 32 );
+  ak_skey_set_mask_policy( &bkey.key, policy->type, policy->interval );
+  for( idx = 0; idx < sizeof( in ); idx++ ) in[idx] = ( ak_uint8 )idx;
+
+  for( idx = 1; idx <= calls_count; idx++ ) {
+     memcpy( mask, bkey.key.key + bkey.key.key_size, bkey.key.key_size );
+     ak_bckey_encrypt_ecb( &bkey, in, out, bkey.bsize );
+     changed = ( memcmp( mask, bkey.key.key + bkey.key.key_size, bkey.key.key_size ) != 0 );
+     if( changed != mask_must_change( policy, idx, bkey.bsize )) {
+       printf("%s, %s: mask is %s after call %u: Wrong\n", bkey.key.oid->name[0],
+                policy->name, changed ? "changed" : "not changed", (unsigned int)idx );
+       result = ak_false;
+     }
+     if( !bkey.key.check_icode( &bkey.key )) {
+       printf("%s, %s: integrity code after call %u is Wrong\n",
+                                      bkey.key.oid->name[0], policy->name, (unsigned int)idx );
+       result = ak_false;
+     }
+  }
+ /* после всех смен маски ключ по-прежнему расшифровывает данные */
+  ak_bckey_decrypt_ecb( &bkey, out, dec, bkey.bsize );
+  if( memcmp( in, dec, bkey.bsize ) != 0 ) {
+    printf("%s, %s: decryption is Wrong\n", bkey.key.oid->name[0], policy->name );
+    result = ak_false;
+  }
+
+ /* ключ, с которого снята маска, маскируется вне зависимости от политики */
+  bkey.key.unmask( &bkey.key );
+  ak_skey_remask( &bkey.key, 0 );
+  if((( bkey.key.flags&key_flag_set_mask ) == 0 ) || !bkey.key.check_icode( &bkey.key )) {
+    printf("%s, %s: masking of unmasked key is Wrong\n", bkey.key.oid->name[0], policy->name );
+    result = ak_false;
+  }
+  ak_bckey_destroy( &bkey );
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка ключа алгоритма выработки имитовставки HMAC. */
+ static bool_t test_hmac( struct test_policy *policy )
+{
+  size_t idx = 0;
+  struct hmac hctx;
+  bool_t changed = ak_false, result = ak_true;
+  ak_uint8 mask[64], out[32], out2[32];
+
+  ak_hmac_create_streebog256( &hctx );
+  ak_hmac_set_key( &hctx, testkey, 32 );
+  ak_skey_set_mask_policy( &hctx.key, policy->type, policy->interval );
+
+ /* ключ используется один раз, при вычислении состояний, соответствующих
+    ключу, сложенному с константами ipad и opad (обрабатывается блок из 64 октетов) */
+  memcpy( mask, hctx.key.key + hctx.key.key_size, hctx.key.key_size );
+  ak_hmac_ptr( &hctx, testkey, sizeof( testkey ), out, sizeof( out ));
+  changed = ( memcmp( mask, hctx.key.key + hctx.key.key_size, hctx.key.key_size ) != 0 );
+  if( changed != mask_must_change( policy, 1, hctx.mctx.bsize )) {
+    printf("hmac, %s: mask is %s after key using: Wrong\n",
+                                             policy->name, changed ? "changed" : "not changed" );
+    result = ak_false;
+  }
+ /* последующие вычисления используют сохраненные состояния */
+  for( idx = 1; idx <= calls_count; idx++ ) {
+     ak_hmac_ptr( &hctx, testkey, sizeof( testkey ), out2, sizeof( out2 ));
+     if( !hctx.key.check_icode( &hctx.key ) || ( memcmp( out, out2, sizeof( out )) != 0 )) {
+       printf("hmac, %s: key after call %u is Wrong\n", policy->name, (unsigned int)idx );
+       result = ak_false;
+     }
+  }
+  ak_hmac_destroy( &hctx );
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+  size_t idx = 0;
+  struct bckey bkey;
+  int exitcode = EXIT_SUCCESS;
+
+  if( !ak_libakrypt_create( ak_function_log_stderr )) return ak_libakrypt_destroy();
+
+  for( idx = 0; idx < sizeof( policies )/sizeof( struct test_policy ); idx++ ) {
+     if( !test_bckey( ak_bckey_create_kuznechik, policies + idx )) exitcode = EXIT_FAILURE;
+     if( !test_bckey( ak_bckey_create_magma, policies + idx )) exitcode = EXIT_FAILURE;
+     if( !test_hmac( policies + idx )) exitcode = EXIT_FAILURE;
+  }
+
+ /* некорректные параметры политик */
+  ak_bckey_create_kuznechik( &bkey );
+  if(( ak_skey_set_mask_policy( &bkey.key, mask_every_n_calls_policy, 0 ) == ak_error_ok ) ||
+     ( ak_skey_set_mask_policy( &bkey.key, ( mask_policy_t )100, 1 ) == ak_error_ok )) {
+    printf("wrong policy is accepted\n");
+    exitcode = EXIT_FAILURE;
+  }
+  ak_bckey_destroy( &bkey );
+
+  if( exitcode == EXIT_SUCCESS ) printf("key mask policies: Ok\n");
+  ak_error_set_value( ak_error_ok );
+  ak_libakrypt_destroy();
+
+ return exitcode;
+}
@@ -0,0 +1,108 @@
+/* ----------------------------------------------------------------------------------------------- */
+/*  Тестовый пример, иллюстрирующий совпадение результатов вычисления кратных точек с помощью      */
+/*  лесенки Монтгомери, гребенчатого метода и метода Штрауса для всех эллиптических кривых.        */
+/* ----------------------------------------------------------------------------------------------- */
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt.h>
+
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t test_power( ak_wcurve wc, ak_uint64 *k )
+{
+  struct wpoint wp, wq;
+
+  ak_wpoint_pow( &wp, &wc->point, k, wc->size, wc );
+  ak_wpoint_reduce( &wp, wc );
+  ak_wpoint_pow_base( &wq, k, wc->size, wc );
+  ak_wpoint_reduce( &wq, wc );
+
+  if( memcmp( wp.x, wq.x, wc->size*sizeof( ak_uint64 )) != 0 ) return ak_false;
+  if( memcmp( wp.y, wq.y, wc->size*sizeof( ak_uint64 )) != 0 ) return ak_false;
+  if( memcmp( wp.z, wq.z, wc->size*sizeof( ak_uint64 )) != 0 ) return ak_false;
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t test_power2( ak_wcurve wc, ak_uint64 *k1, ak_uint64 *k2 )
+{
+  struct wpoint wp, wq, wr;
+
+ /* в качестве второй точки используем [k1+1]P */
+  ak_wpoint_pow( &wq, &wc->point, k1, wc->size, wc );
+  ak_wpoint_add( &wq, &wc->point, wc );
+  ak_wpoint_reduce( &wq, wc );
+
+  ak_wpoint_pow( &wp, &wc->point, k1, wc->size, wc );
+  ak_wpoint_pow( &wr, &wq, k2, wc->size, wc );
+  ak_wpoint_add( &wp, &wr, wc );
+  ak_wpoint_reduce( &wp, wc );
+  ak_wpoint_pow2( &wr, &wc->point, k1, &wq, k2, wc->size, wc );
+  ak_wpoint_reduce( &wr, wc );
+
+  if( memcmp( wp.x, wr.x, wc->size*sizeof( ak_uint64 )) != 0 ) return ak_false;
+  if( memcmp( wp.y, wr.y, wc->size*sizeof( ak_uint64 )) != 0 ) return ak_false;
+  if( memcmp( wp.z, wr.z, wc->size*sizeof( ak_uint64 )) != 0 ) return ak_false;
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t test_curve( ak_wcurve wc, const char *name, ak_random generator )
+{
+  int i = 0;
+  ak_mpznmax k, k2;
+
+ /* граничные значения степени */
+  ak_mpzn_set_ui( k, wc->size, 0 );
+  if( !test_power( wc, k )) { printf("%s: k = 0 is Wrong\n", name ); return ak_false; }
+  ak_mpzn_set_ui( k, wc->size, 1 );
+  if( !test_power( wc, k )) { printf("%s: k = 1 is Wrong\n", name ); return ak_false; }
+  ak_mpzn_set( k, wc->q, wc->size );
+  if( !test_power( wc, k )) { printf("%s: k = q is Wrong\n", name ); return ak_false; }
+  k[0]--;
+  if( !test_power( wc, k )) { printf("%s: k = q-1 is Wrong\n", name ); return ak_false; }
+
+ /* случайные значения степени */
+  for( i = 0; i < 8; i++ ) {
+     ak_mpzn_set_random_modulo( k, wc->q, wc->size, generator );
+     if( !test_power( wc, k )) { printf("%s: random k is Wrong\n", name ); return ak_false; }
+  }
+
+ /* сумма кратных точек */
+  ak_mpzn_set_ui( k2, wc->size, 0 );
+  if( !test_power2( wc, k, k2 )) { printf("%s: k2 = 0 is Wrong\n", name ); return ak_false; }
+  for( i = 0; i < 4; i++ ) {
+     ak_mpzn_set_random_modulo( k, wc->q, wc->size, generator );
+     ak_mpzn_set_random_modulo( k2, wc->q, wc->size, generator );
+     if( !test_power2( wc, k, k2 )) {
+       printf("%s: random k1, k2 is Wrong\n", name ); return ak_false;
+     }
+  }
+  printf("%s: Ok\n", name );
+
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+  ak_oid oid = NULL;
+  struct random generator;
+  int exitcode = EXIT_SUCCESS;
+
+  ak_libakrypt_create( ak_function_log_stderr );
+  ak_random_create_lcg( &generator );
+
+  oid = ak_oid_find_by_engine( identifier );
+  while( oid != NULL ) {
+    if(( oid->mode == wcurve_params ) && ( oid->data != NULL ))
+      if( !test_curve( ( ak_wcurve ) oid->data, oid->name[0], &generator ))
+        exitcode = EXIT_FAILURE;
+    oid = ak_oid_findnext_by_engine( oid, identifier );
+  }
+
+  ak_random_destroy( &generator );
+  ak_libakrypt_destroy();
+
+ return exitcode;
+}
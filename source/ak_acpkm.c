@@ -6,6 +6,9 @@
 /*  - содержит реализацию криптографических алгоритмов семейства ACPKM из Р 1323565.1.017—2018     */
 /* ----------------------------------------------------------------------------------------------- */
  #include <libakrypt-internal.h>
+#ifdef AK_HAVE_PTHREAD_H
+ #include <pthread.h>
+#endif
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! \details Функция вычисляет новое значение секретного ключа в соответствии с соотношениями
@@ -42,20 +45,15 @@
  /* выработка нового значения */
    switch( bkey->bsize ) {
       case  8: /* шифр с длиной блока 64 бита */
-         bkey->encrypt( &bkey->key, acpkm, new_key );
-         bkey->encrypt( &bkey->key, acpkm +8, new_key +8 );
-         bkey->encrypt( &bkey->key, acpkm +16, new_key +16 );
-         bkey->encrypt( &bkey->key, acpkm +24, new_key +24 );
-         counter = ak_libakrypt_get_option_by_name( "acpkm_section_magma_block_count" );
+         bkey->encrypt_blocks( &bkey->key, acpkm, new_key, 4 );
          break;
       case 16: /* шифр с длиной блока 128 бит */
-         bkey->encrypt( &bkey->key, acpkm, new_key );
-         bkey->encrypt( &bkey->key, acpkm +16, new_key +16 );
-         counter = ak_libakrypt_get_option_by_name( "acpkm_section_kuznechik_block_count" );
+         bkey->encrypt_blocks( &bkey->key, acpkm, new_key, 2 );
          break;
       default: return ak_error_message( ak_error_wrong_block_cipher,
                                            __func__ , "incorrect block size of block cipher key" );
    }
+   counter = ak_bckey_get_options( bkey )->acpkm_section_block_count;
 
  /* присваиваем ключу значение */
   if(( error = ak_bckey_set_key( bkey, new_key, bkey->key.key_size )) != ak_error_ok )
@@ -69,41 +67,230 @@
 }
 
 /* ----------------------------------------------------------------------------------------------- */
-#ifdef AK_LITTLE_ENDIAN
-  #define acpkm_block64 {\
-              nkey.encrypt( &nkey.key, ctr, yaout );\
-              ctr[0] += 1;\
-              ((ak_uint64 *) outptr)[0] = yaout[0] ^ ((ak_uint64 *) inptr)[0];\
-              outptr++; inptr++;\
-           }
-
-  #define acpkm_block128 {\
-              nkey.encrypt( &nkey.key, ctr, yaout );\
-              if(( ctr[0] += 1 ) == 0 ) ctr[1]++;\
-              ((ak_uint64 *) outptr)[0] = yaout[0] ^ ((ak_uint64 *) inptr)[0];\
-              ((ak_uint64 *) outptr)[1] = yaout[1] ^ ((ak_uint64 *) inptr)[1];\
-              outptr += 2; inptr += 2;\
-           }
+/*! \brief Функция гаммирования нескольких последовательных блоков данных в рамках одной секции.
+
+    Значения счетчика формируются сразу для \ref ak_bckey_batch_size октетов гаммы,
+    которые затем зашифровываются одним вызовом функции encrypt_blocks.
+
+    @param nkey Ключ текущей секции.
+    @param ctr Текущее значение счетчика (изменяется в ходе работы функции).
+    @param inptr Указатель на входные данные.
+    @param outptr Указатель на выходные данные.
+    @param blocks Количество обрабатываемых блоков.                                                */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_bckey_acpkm_blocks( ak_bckey nkey, ak_uint64 *ctr,
+                                       ak_uint64 *inptr, ak_uint64 *outptr, size_t blocks )
+{
+  size_t i, cnt, words = nkey->bsize >> 3;
+  ak_uint64 gamma[ ak_bckey_batch_size/sizeof( ak_uint64 )];
+
+  while( blocks > 0 ) {
+     cnt = ak_min( blocks, ak_bckey_batch_size/nkey->bsize );
+     for( i = 0; i < cnt; i++ ) {
+        gamma[i*words] = ctr[0];
+        if( words > 1 ) gamma[i*words+1] = ctr[1];
+       #ifdef AK_LITTLE_ENDIAN
+        if(( ctr[0] += 1 ) == 0 ) ctr[1]++;
+       #else
+        ctr[0] = bswap_64( bswap_64( ctr[0] ) + 1 );
+        if( ctr[0] == 0 ) ctr[1] = bswap_64( bswap_64( ctr[1] ) + 1 );
+       #endif
+     }
+     nkey->encrypt_blocks( &nkey->key, gamma, gamma, cnt );
+     for( i = 0; i < cnt*words; i++ ) outptr[i] = gamma[i] ^ inptr[i];
+     inptr += cnt*words; outptr += cnt*words;
+     blocks -= cnt;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Гаммирование последовательности секций, а также, при необходимости, фрагмента данных,
+    не кратного длине секции.
+
+    После обработки каждой секции, за исключением последней, вычисляется ключ следующей секции.
+    Если после последней секции присутствует фрагмент данных, то для него также вычисляется
+    новый ключ.
+
+    @param nkey Ключ первой обрабатываемой секции (изменяется в ходе работы функции).
+    @param ctr Текущее значение счетчика (изменяется в ходе работы функции).
+    @param inptr Указатель на входные данные.
+    @param outptr Указатель на выходные данные.
+    @param sections Количество обрабатываемых секций.
+    @param seclen Длина одной секции (в блоках).
+    @param tail Длина фрагмента данных, следующего за последней секцией (в октетах).
+    @return В случае возникновения ошибки функция возвращает ее код, в противном случае
+    возвращается \ref ak_error_ok (ноль)                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_bckey_acpkm_sections( ak_bckey nkey, ak_uint64 *ctr, ak_uint64 *inptr,
+                           ak_uint64 *outptr, ssize_t sections, ssize_t seclen, ssize_t tail )
+{
+  ssize_t j = 0;
+  ak_uint64 yaout[2];
+  int error = ak_error_ok;
+
+  while( sections > 0 ) {
+    /* обрабатываем одну секцию */
+     ak_bckey_acpkm_blocks( nkey, ctr, inptr, outptr, ( size_t )seclen );
+     inptr += seclen*( ssize_t )( nkey->bsize >> 3 );
+     outptr += seclen*( ssize_t )( nkey->bsize >> 3 );
+    /* вычисляем следующий ключ */
+     if(( --sections > 0 ) || tail ) {
+       if(( error = ak_bckey_next_acpkm_key( nkey )) != ak_error_ok )
+         return ak_error_message_fmt( error, __func__, "incorrect key generation after %u sections",
+                                                                         (unsigned int) sections );
+     }
+  }
+
+  if( tail ) { /* теперь обрабатываем фрагмент данных, не кратный длине секции */
+    if(( seclen = tail/(ssize_t)( nkey->bsize )) > 0 ) { /* обрабатываем данные, кратные длине блока */
+       ak_bckey_acpkm_blocks( nkey, ctr, inptr, outptr, ( size_t )seclen );
+       inptr += seclen*( ssize_t )( nkey->bsize >> 3 );
+       outptr += seclen*( ssize_t )( nkey->bsize >> 3 );
+    }
+  /* остался последний фрагмент, длина которого меньше длины блока
+                      в качестве гаммы мы используем старшие байты */
+    if(( tail -= seclen*(ssize_t)( nkey->bsize )) > 0 ) {
+      nkey->encrypt( &nkey->key, ctr, yaout );
+      for( j = 0; j < tail; j++ ) ((ak_uint8 *) outptr)[j] =
+                        ((ak_uint8 *)yaout)[(ssize_t)nkey->bsize-tail+j] ^ ((ak_uint8 *) inptr)[j];
+    }
+  }
+
+ return error;
+}
+
+#ifdef AK_HAVE_PTHREAD_H
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Увеличение значения счетчика режима `CTR-ACPKM` на заданную величину.
+
+    @param ctr Значение счетчика (изменяется в ходе работы функции).
+    @param n Величина, на которую увеличивается счетчик.                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_bckey_acpkm_ctr_add( ak_uint64 *ctr, ak_uint64 n )
+{
+ #ifdef AK_LITTLE_ENDIAN
+  if(( ctr[0] += n ) < n ) ctr[1]++;
+ #else
+  ak_uint64 x = bswap_64( ctr[0] ) + n;
+  if( x < n ) ctr[1] = bswap_64( bswap_64( ctr[1] ) + 1 );
+  ctr[0] = bswap_64( x );
+ #endif
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Группа последовательных секций, обрабатываемая в режиме `CTR-ACPKM` отдельным потоком. */
+ typedef struct acpkm_task {
+  /*! \brief Ключ первой секции группы. */
+   struct bckey key;
+  /*! \brief Значение счетчика для первого блока группы. */
+   ak_uint64 ctr[2];
+  /*! \brief Указатель на входные данные. */
+   ak_uint64 *in;
+  /*! \brief Указатель на выходные данные. */
+   ak_uint64 *out;
+  /*! \brief Количество секций в группе. */
+   ssize_t sections;
+  /*! \brief Длина фрагмента данных, следующего за последней секцией группы (в октетах). */
+   ssize_t tail;
+  /*! \brief Длина одной секции (в блоках). */
+   ssize_t seclen;
+  /*! \brief Код ошибки, возникшей при обработке группы. */
+   int error;
+  /*! \brief Поток, обрабатывающий группу. */
+   pthread_t thread;
+  /*! \brief Флаг того, что поток был успешно запущен. */
+   bool_t started;
+} *ak_acpkm_task;
+
+/* ----------------------------------------------------------------------------------------------- */
+ static void *ak_bckey_acpkm_task( void *ptr )
+{
+  ak_acpkm_task task = ( ak_acpkm_task )ptr;
+
+  task->error = ak_bckey_acpkm_sections( &task->key, task->ctr,
+                               task->in, task->out, task->sections, task->seclen, task->tail );
+ return NULL;
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Гаммирование последовательности секций с помощью нескольких потоков.
+
+    Секции разбиваются на группы, каждая из которых обрабатывается отдельным потоком.
+    Ключ первой секции каждой группы вычисляется вызывающим потоком, который последовательно
+    проходит цепочку производных ключей; поток, обрабатывающий группу, запускается сразу после
+    вычисления ее первого ключа. Фрагмент данных, не кратный длине секции, обрабатывается
+    потоком, которому досталась последняя группа.
+
+    @param nkey Ключ первой секции (изменяется в ходе работы функции).
+    @param ctr Начальное значение счетчика.
+    @param inptr Указатель на входные данные.
+    @param outptr Указатель на выходные данные.
+    @param sections Количество секций.
+    @param seclen Длина одной секции (в блоках).
+    @param tail Длина фрагмента данных, следующего за последней секцией (в октетах).
+    @param threads Максимальное количество используемых потоков.
+    @return В случае возникновения ошибки функция возвращает ее код, в противном случае
+    возвращается \ref ak_error_ok (ноль)                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_bckey_acpkm_sections_threads( ak_bckey nkey, ak_uint64 *ctr, ak_uint64 *inptr,
+          ak_uint64 *outptr, ssize_t sections, ssize_t seclen, ssize_t tail, size_t threads )
+{
+#ifdef AK_HAVE_PTHREAD_H
+  ak_acpkm_task tasks = NULL;
+  int error = ak_error_ok;
+  size_t i, j, per, count, words = nkey->bsize >> 3;
+
+ /* разбиение выполняется с точностью до секции */
+  if(( count = ak_bckey_split_blocks( ( size_t )seclen*nkey->bsize,
+                                                   ( size_t )sections, threads, &per )) < 2 )
+    return ak_bckey_acpkm_sections( nkey, ctr, inptr, outptr, sections, seclen, tail );
+
+  if(( tasks = calloc( count, sizeof( struct acpkm_task ))) == NULL )
+    return ak_error_message( ak_error_out_of_memory, __func__,
+                                                     "incorrect memory allocation for thread tasks" );
+  for( i = 0; i < count; i++ ) {
+     if(( tasks[i].error = ak_bckey_create_and_set_bckey( &tasks[i].key, nkey )) != ak_error_ok ) {
+       ak_error_message( error = tasks[i].error, __func__, "incorrect key duplication" );
+       break;
+     }
+     memcpy( tasks[i].ctr, ctr, sizeof( tasks[i].ctr ));
+     ak_bckey_acpkm_ctr_add( tasks[i].ctr, ( ak_uint64 )( i*per*( size_t )seclen ));
+     tasks[i].in = inptr + i*per*( size_t )seclen*words;
+     tasks[i].out = outptr + i*per*( size_t )seclen*words;
+     tasks[i].sections = ( ssize_t )ak_min( per, ( size_t )sections - i*per );
+     tasks[i].tail = ( i == count - 1 ) ? tail : 0;
+     tasks[i].seclen = seclen;
+     if( pthread_create( &tasks[i].thread, NULL, ak_bckey_acpkm_task, tasks+i ) == 0 )
+       tasks[i].started = ak_true;
+      else ak_bckey_acpkm_task( tasks+i ); /* не удалось создать поток - обрабатываем группу сами */
+
+    /* вычисляем ключ первой секции следующей группы */
+     if( i < count - 1 ) {
+       for( j = 0; j < per; j++ )
+          if(( error = ak_bckey_next_acpkm_key( nkey )) != ak_error_ok ) break;
+       if( error != ak_error_ok ) {
+         ak_error_message( error, __func__, "incorrect key generation for next group of sections" );
+         i++;
+         break;
+       }
+     }
+  }
+
+ /* дожидаемся завершения потоков и уничтожаем копии ключа */
+  while( i-- > 0 ) {
+     if( tasks[i].started ) pthread_join( tasks[i].thread, NULL );
+     if(( tasks[i].error != ak_error_ok ) && ( error == ak_error_ok )) error = tasks[i].error;
+     ak_bckey_destroy( &tasks[i].key );
+  }
+  free( tasks );
 
+ return error;
 #else
-  #define acpkm_block64 {\
-              nkey.encrypt( &nkey.key, ctr, yaout );\
-              ctr[0] = bswap_64( ctr[0] ); ctr[0] += 1; ctr[0] = bswap_64( ctr[0] );\
-              ((ak_uint64 *) outptr)[0] = yaout[0] ^ ((ak_uint64 *) inptr)[0];\
-              outptr++; inptr++;\
-           }
-
-  #define acpkm_block128 {\
-              nkey.encrypt( &nkey.key, ctr, yaout );\
-              ctr[0] = bswap_64( ctr[0] ); ctr[0] += 1; ctr[0] = bswap_64( ctr[0] );\
-              if( ctr[0] == 0 ) { \
-                ctr[1] = bswap_64( ctr[0] ); ctr[1] += 1; ctr[1] = bswap_64( ctr[0] );\
-              }\
-              ((ak_uint64 *) outptr)[0] = yaout[0] ^ ((ak_uint64 *) inptr)[0];\
-              ((ak_uint64 *) outptr)[1] = yaout[1] ^ ((ak_uint64 *) inptr)[1];\
-              outptr += 2; inptr += 2;\
-           }
+  (void)threads;
+ return ak_bckey_acpkm_sections( nkey, ctr, inptr, outptr, sections, seclen, tail );
 #endif
+}
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! В режиме `ACPKM` для шифрования используется операция гаммирования - операция сложения
@@ -143,11 +330,42 @@
 /* ----------------------------------------------------------------------------------------------- */
  int ak_bckey_ctr_acpkm( ak_bckey bkey, ak_pointer in, ak_pointer out, size_t size,
                                                  size_t section_size, ak_pointer iv, size_t iv_size)
+{
+ return ak_bckey_ctr_acpkm_parallel( bkey, in, out, size, section_size, iv, iv_size, 1 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция реализует режим `CTR-ACPKM`, аналогичный функции ak_bckey_ctr_acpkm(), однако
+    последовательность секций разбивается на группы, которые обрабатываются одновременно
+    несколькими потоками. Результат работы функции совпадает с результатом работы функции
+    ak_bckey_ctr_acpkm() с теми же параметрами.
+
+    Производные ключи, с которых начинается обработка каждой группы, вычисляются вызывающим
+    потоком, каждый поток использует собственную копию ключа. Ресурс исходного ключа
+    уменьшается один раз, до начала обработки данных.
+
+    @param bkey Контекст ключа алгоритма блочного шифрования,
+    используемый для шифрования и порождения цепочки производных ключей.
+    @param in Указатель на область памяти, где хранятся входные
+    (зашифровываемые/расшифровываемые) данные
+    @param out Указатель на область памяти, куда помещаются выходные
+    (расшифровываемые/зашифровываемые) данные; этот указатель может совпадать с in
+    @param size Размер зашировываемых данных (в байтах).
+    @param section_size Размер одной секции в байтах.
+    @param iv имитовставка
+    @param iv_size длина имитовставки (в байтах)
+    @param threads Максимальное количество потоков, используемых для обработки данных.
+
+    @return В случае возникновения ошибки функция возвращает ее код, в противном случае
+    возвращается \ref ak_error_ok (ноль)                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_bckey_ctr_acpkm_parallel( ak_bckey bkey, ak_pointer in, ak_pointer out, size_t size,
+                               size_t section_size, ak_pointer iv, size_t iv_size, size_t threads )
 {
   struct bckey nkey;
   int error = ak_error_ok;
-  ssize_t j = 0, sections = 0, tail = 0, seclen = 0, maxseclen = 0, mcount = 0;
-  ak_uint64 yaout[2], *inptr = (ak_uint64 *)in, *outptr = (ak_uint64 *)out, ctr[2] = { 0, 0 };
+  ssize_t sections = 0, tail = 0, seclen = 0, maxseclen = 0, mcount = 0;
+  ak_uint64 *inptr = (ak_uint64 *)in, *outptr = (ak_uint64 *)out, ctr[2] = { 0, 0 };
 
  /* выполняем проверку размера входных данных */
   if( section_size%bkey->bsize != 0 )
@@ -168,8 +386,6 @@
                                                              а также устанавливаем синхропосылку */
   switch( bkey->bsize ) {
     case 8:
-       maxseclen = ak_libakrypt_get_option_by_name( "acpkm_section_magma_block_count" );
-       mcount = ak_libakrypt_get_option_by_name( "magma_cipher_resource" )/maxseclen;
        #ifdef AK_LITTLE_ENDIAN
          ctr[0] = ((ak_uint64 *)iv)[0] << 32;
        #else
@@ -178,13 +394,14 @@
       break;
 
     case 16:
-       maxseclen = ak_libakrypt_get_option_by_name( "acpkm_section_kuznechik_block_count" );
-       mcount = ak_libakrypt_get_option_by_name( "kuznechik_cipher_resource" )/maxseclen;
        ctr[1] = ((ak_uint64 *) iv)[0];
       break;
     default: return ak_error_message( ak_error_wrong_block_cipher,
                                            __func__ , "incorrect block size of block cipher key" );
   }
+  maxseclen = ak_bckey_get_options( bkey )->acpkm_section_block_count;
+  mcount = ak_bckey_get_options( bkey )->cipher_resource/maxseclen;
+
  /* проверяем, что пользователь определил длину секции не очень большим значением */
   seclen = ( ssize_t )( section_size/bkey->bsize );
   if( seclen > maxseclen ) return ak_error_message( ak_error_wrong_length, __func__,
@@ -210,42 +427,9 @@
  /* дальнейшие криптографические действия применяются к новому экземпляру ключа */
   sections = ( ssize_t )( size/section_size );
   tail = ( ssize_t )( size - ( size_t )( sections*seclen )*nkey.bsize );
-  if( sections > 0 ) {
-    do{
-       switch( nkey.bsize ) { /* обрабатываем одну секцию */
-         case 8: for( j = 0; j < seclen; j++ ) acpkm_block64; break;
-         case 16: for( j = 0; j < seclen; j++ ) acpkm_block128; break;
-         default: ak_error_message( ak_error_wrong_block_cipher,
-                                           __func__ , "incorrect block size of block cipher key" );
-       }
-      /* вычисляем следующий ключ */
-       if(( error = ak_bckey_next_acpkm_key( &nkey )) != ak_error_ok ) {
-         ak_error_message_fmt( error, __func__, "incorrect key generation after %u sections",
-                                                                         (unsigned int) sections );
-         goto labex;
-       }
-    } while( --sections > 0 );
-  } /* конец обработки случая, когда sections > 0 */
-
-  if( tail ) { /* теперь обрабатываем фрагмент данных, не кратный длине секции */
-    if(( seclen = tail/(ssize_t)( nkey.bsize )) > 0 ) {
-       switch( nkey.bsize ) { /* обрабатываем данные, кратные длине блока */
-         case 8: for( j = 0; j < seclen; j++ ) acpkm_block64; break;
-         case 16: for( j = 0; j < seclen; j++ ) acpkm_block128; break;
-         default: ak_error_message( ak_error_wrong_block_cipher,
-                                            __func__ , "incorrect block size of block cipher key" );
-       }
-    }
-  /* остался последний фрагмент, длина которого меньше длины блока
-                      в качестве гаммы мы используем старшие байты */
-    if(( tail -= seclen*(ssize_t)( nkey.bsize )) > 0 ) {
-      nkey.encrypt( &nkey.key, ctr, yaout );
-      for( j = 0; j < tail; j++ ) ((ak_uint8 *) outptr)[j] =
-                         ((ak_uint8 *)yaout)[(ssize_t)nkey.bsize-tail+j] ^ ((ak_uint8 *) inptr)[j];
-    }
-  }
-
-  labex: ak_bckey_destroy( &nkey );
+  error = ak_bckey_acpkm_sections_threads( &nkey, ctr, inptr, outptr,
+                                                            sections, seclen, tail, threads );
+  ak_bckey_destroy( &nkey );
  return error;
 }
 
@@ -2738,6 +2738,147 @@ AlgorithmIdentifier  ::=  SEQUENCE  {
  return ak_error_ok;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Подсчет количества узлов и уровней ASN.1 дерева, закодированного der-последовательностью.
+    \details Функция проверяет корректность длин всех элементов, поэтому последующее размещение
+    узлов дерева не может завершиться ошибкой.                                                     */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_asn1_arena_count( ak_uint8 *ptr, const size_t size, size_t *tlvs, size_t *levels )
+{
+  size_t len = 0;
+  int error = ak_error_ok;
+  ak_uint8 *pcurr = ptr, *pend = ptr + size, tag = 0;
+
+  while( pcurr < pend ) {
+    ak_asn1_get_tag_from_der( &pcurr, &tag );
+    if(( error = ak_asn1_get_length_from_der( &pcurr, &len )) != ak_error_ok )
+      return ak_error_message( error, __func__, "incorrect decoding of data's length" );
+    if( pcurr + len > pend ) return ak_error_wrong_length;
+
+    ( *tlvs )++;
+    if( DATA_STRUCTURE( tag ) == CONSTRUCTED ) {
+      ( *levels )++;
+      if(( error = ak_asn1_arena_count( pcurr, len, tlvs, levels )) != ak_error_ok ) return error;
+    }
+    pcurr += len;
+  }
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Размещение одного уровня ASN.1 дерева в заранее выделенной области памяти.
+    \param asn1 уровень дерева, в который помещаются узлы
+    \param ptr указатель на фрагмент der-последовательности, корректность которого проверена
+    функцией ak_asn1_arena_count()
+    \param size длина фрагмента (в октетах)
+    \param levels указатель на первую свободную структуру уровня дерева
+    \param tlvs указатель на первую свободную структуру узла дерева                               */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_asn1_arena_fill( ak_asn1 asn1, ak_uint8 *ptr, const size_t size,
+                                                                   ak_asn1 *levels, ak_tlv *tlvs )
+{
+  size_t len = 0;
+  ak_tlv tlv = NULL, last = NULL;
+  ak_uint8 *pcurr = ptr, *pend = ptr + size, tag = 0;
+
+  asn1->current = NULL;
+  asn1->count = 0;
+  while( pcurr < pend ) {
+    ak_asn1_get_tag_from_der( &pcurr, &tag );
+    ak_asn1_get_length_from_der( &pcurr, &len );
+
+    tlv = ( *tlvs )++;
+    tlv->tag = tag;
+    tlv->free = ak_false;
+    tlv->prev = last;
+    tlv->next = NULL;
+    if( DATA_STRUCTURE( tag ) == CONSTRUCTED ) {
+     /* длина составного узла, как и в ak_tlv_create_constructed(), вычисляется при кодировании */
+      tlv->len = 0;
+      tlv->data.constructed = ( *levels )++;
+      ak_asn1_arena_fill( tlv->data.constructed, pcurr, len, levels, tlvs );
+    }
+     else {
+      tlv->len = ( ak_uint32 ) len;
+      tlv->data.primitive = pcurr;
+     }
+
+    if( last != NULL ) last->next = tlv;
+    last = tlv;
+    asn1->count++;
+    pcurr += len;
+  }
+ /* как и при добавлении узлов функцией ak_asn1_add_tlv(), текущим становится последний узел */
+  asn1->current = last;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция декодирует der-последовательность, размещая все уровни и узлы ASN.1 дерева в одной
+    области памяти, размер которой определяется за один предварительный проход
+    der-последовательности. Данные примитивных узлов не копируются: узлы содержат указатели
+    на соответствующие фрагменты области памяти `ptr`, которая должна оставаться доступной
+    (например, отображенной в память) до вызова функции ak_asn1_arena_destroy().
+
+    Для чтения значений узлов полученного дерева (доступного по указателю `arena->root`)
+    могут использоваться функции вида `ak_tlv_get_...()`, а также функции перемещения
+    по уровням дерева. Изменять дерево (добавлять или удалять узлы), а также удалять его
+    функциями ak_asn1_delete() или ak_tlv_delete() нельзя.
+
+    \param arena указатель на структуру, в которой размещается дерево
+    \param ptr указатель на область памяти, содержащей der-последовательность
+    \param size длина der-последовательности (в октетах)
+    \return Функция возвращает \ref ak_error_ok (ноль) в случае успеха, в случае неудачи
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_asn1_arena_decode( ak_asn1_arena arena, const ak_pointer ptr, const size_t size )
+{
+  int error = ak_error_ok;
+  size_t tlvs = 0, levels = 1;
+  ak_asn1 lptr = NULL;
+  ak_tlv tptr = NULL;
+
+  if( arena == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                           "using null pointer to asn1 arena" );
+  arena->root = NULL;
+  arena->memory = NULL;
+  arena->size = 0;
+  if( ptr == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                            "using null pointer to der-sequence" );
+ /* определяем количество узлов и уровней дерева */
+  if(( error = ak_asn1_arena_count( ptr, size, &tlvs, &levels )) != ak_error_ok ) return error;
+
+ /* выделяем память сразу под все уровни и узлы */
+  arena->size = levels*sizeof( struct asn1 ) + tlvs*sizeof( struct tlv );
+  if(( arena->memory = malloc( arena->size )) == NULL ) {
+    arena->size = 0;
+    return ak_error_message( ak_error_out_of_memory, __func__,
+                                                      "incorrect memory allocation for asn1 arena" );
+  }
+  lptr = ( ak_asn1 ) arena->memory;
+  tptr = ( ak_tlv )( lptr + levels );
+  arena->root = lptr++;
+  ak_asn1_arena_fill( arena->root, ptr, size, &lptr, &tptr );
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \param arena указатель на структуру, содержащую ASN.1 дерево
+    \return Функция возвращает \ref ak_error_ok (ноль) в случае успеха, в случае неудачи
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_asn1_arena_destroy( ak_asn1_arena arena )
+{
+  if( arena == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                           "using null pointer to asn1 arena" );
+  if( arena->memory != NULL ) free( arena->memory );
+  arena->root = NULL;
+  arena->memory = NULL;
+  arena->size = 0;
+
+ return ak_error_ok;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
  int ak_asn1_evaluate_length( ak_asn1 asn, size_t *total )
 {
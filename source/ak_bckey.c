@@ -4,7 +4,10 @@
 /*  Файл ak_bckey.c                                                                                */
 /*  - содержит реализацию общих функций для алгоритмов блочного шифрования.                        */
 /* ----------------------------------------------------------------------------------------------- */
- #include <libakrypt.h>
+ #include <libakrypt-internal.h>
+#ifdef AK_HAVE_PTHREAD_H
+ #include <pthread.h>
+#endif
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! Функция устанавливает параметры алгоритма блочного шифрования, передаваемые в качестве
@@ -13,6 +16,8 @@
 
     - bkey.encrypt -- алгоритм зашифрования одного блока
     - bkey.decrypt -- алгоритм расшифрования одного блока
+    - bkey.encrypt_blocks -- алгоритм зашифрования последовательности блоков
+    - bkey.decrypt_blocks -- алгоритм расшифрования последовательности блоков
     - bkey.shedule_keys -- алгоритм развертки ключа и генерации раундовых ключей
     - bkey.delete_keys -- функция удаления раундовых ключей
 
@@ -52,9 +57,44 @@
   bkey->ivector_size =  0;
   bkey->encrypt =       NULL;
   bkey->decrypt =       NULL;
+  bkey->encrypt_blocks = NULL;
+  bkey->decrypt_blocks = NULL;
   bkey->schedule_keys = NULL;
   bkey->delete_keys =   NULL;
 
+ return ak_bckey_load_options( bkey );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция считывает значения опций, используемых при зашифровании/расшифровании данных,
+    и сохраняет их в контексте ключа вместе с текущим номером поколения опций.
+    Значения, зависящие от алгоритма блочного шифрования, выбираются по длине блока.
+
+    @param bkey Контекст ключа алгоритма блочного шифрования.
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_bckey_load_options( ak_bckey bkey )
+{
+  ak_uint64 generation = 0;
+
+  if( bkey == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                   "using a null pointer to block cipher context" );
+ /* номер поколения считывается до значений опций: если опции изменятся во время считывания,
+    то сохраненный номер поколения будет устаревшим и опции будут считаны повторно */
+  generation = ak_libakrypt_get_options_generation();
+  bkey->options.oc = (int) ak_libakrypt_get_option_by_index( openssl_compability_option );
+  if( bkey->bsize == 8 ) {
+    bkey->options.acpkm_section_block_count =
+                          ak_libakrypt_get_option_by_index( acpkm_section_magma_block_count_option );
+    bkey->options.cipher_resource = ak_libakrypt_get_option_by_index( magma_cipher_resource_option );
+  } else {
+      bkey->options.acpkm_section_block_count =
+                      ak_libakrypt_get_option_by_index( acpkm_section_kuznechik_block_count_option );
+      bkey->options.cipher_resource =
+                                 ak_libakrypt_get_option_by_index( kuznechik_cipher_resource_option );
+    }
+  bkey->options.generation = generation;
  return ak_error_ok;
 }
 
@@ -86,6 +126,8 @@
   bkey->bsize =            0;
   bkey->encrypt =       NULL;
   bkey->decrypt =       NULL;
+  bkey->encrypt_blocks = NULL;
+  bkey->decrypt_blocks = NULL;
   bkey->schedule_keys = NULL;
   bkey->delete_keys =   NULL;
 
@@ -154,7 +196,7 @@
                                        "using a constant value for secret key with wrong length" );
 
  /* дополнительный переворот ключа для алгоритма Магма (в режиме совместимости с openssl) */
-  if(( ak_libakrypt_get_option_by_name( "openssl_compability" ) == 1 ) &&
+  if(( ak_bckey_get_options( bkey )->oc == 1 ) &&
                                          ( strncmp( bkey->key.oid->name[0], "magma", 5 ) == 0 )) {
     int i = 0;
     ak_uint8 revkey[32];
@@ -305,7 +347,7 @@
     @param rkey Контекст ключа, значение которого дублируется.
 
     @return В случае успеха возвращается значение \ref ak_error_ok. В противном случае
-    возвращается код ошибки.                                                                       */
+    возвращается код ошибки; созданный к этому моменту контекст `bkey` уничтожается.               */
 /* ----------------------------------------------------------------------------------------------- */
  int ak_bckey_create_and_set_bckey( ak_bckey bkey, ak_bckey rkey )
 {
@@ -330,10 +372,22 @@
     ak_error_message( error, __func__, "incorrect unmasking block cipher context" );
     goto  labex;
   }
-  if(( error = ak_bckey_set_key( bkey, rkey->key.key, rkey->key.key_size )) != ak_error_ok ) {
+  if(( ak_bckey_get_options( bkey )->oc == 1 ) &&
+                    ( strncmp( bkey->key.oid->name[0], "magma", 5 ) == 0 ) && ( rkey->key.key_size == 32 )) {
+   /* хранимый ключ Магмы уже перевернут, функция ak_bckey_set_key() перевернет его повторно,
+      поэтому передаем ей исходное значение ключа */
+    size_t i = 0;
+    ak_uint8 revkey[32];
+
+    for( i = 0; i < 32; i++ ) revkey[i] = rkey->key.key[31-i];
+    error = ak_bckey_set_key( bkey, revkey, sizeof( revkey ));
+    ak_ptr_wipe( revkey, sizeof( revkey ), &bkey->key.generator );
+  } else error = ak_bckey_set_key( bkey, rkey->key.key, rkey->key.key_size );
+  rkey->key.set_mask( &rkey->key );
+  if( error != ak_error_ok ) {
     ak_error_message( error, __func__, "incorrect assigning a new key value" );
+    goto labex;
   }
-  rkey->key.set_mask( &rkey->key );
 
  return error;
 
@@ -359,7 +413,6 @@
 {
   size_t blocks = 0;
   int error = ak_error_ok;
-  ak_uint64 *inptr = (ak_uint64 *)in, *outptr = (ak_uint64 *)out;
 
  /* выполняем проверку размера входных данных */
   if( size%bkey->bsize != 0 )
@@ -380,22 +433,14 @@
  /* теперь приступаем к зашифрованию данных */
   switch( bkey->bsize ) {
     case  8: /* шифр с длиной блока 64 бита */
-      do {
-        bkey->encrypt( &bkey->key, inptr++, outptr++ );
-      } while( --blocks > 0 );
-    break;
-
     case 16: /* шифр с длиной блока 128 бит */
-      do {
-        bkey->encrypt( &bkey->key, inptr, outptr );
-        inptr+=2; outptr+=2;
-      } while( --blocks > 0 );
+      bkey->encrypt_blocks( &bkey->key, in, out, blocks );
     break;
     default: return ak_error_message( ak_error_wrong_block_cipher,
                                           __func__ , "incorrect block size of block cipher key" );
   }
  /* перемаскируем ключ */
-  if(( error = bkey->key.set_mask( &bkey->key )) != ak_error_ok )
+  if(( error = ak_skey_remask( &bkey->key, size )) != ak_error_ok )
     ak_error_message( error, __func__ , "wrong remasking of secret key" );
 
  return ak_error_ok;
@@ -416,7 +461,6 @@
 {
   size_t blocks = 0;
   int error = ak_error_ok;
-  ak_uint64 *inptr = (ak_uint64 *)in, *outptr = (ak_uint64 *)out;
 
  /* выполняем проверку размера входных данных */
   if( size%bkey->bsize != 0 )
@@ -437,27 +481,277 @@
  /* теперь приступаем к расшифрованию данных */
   switch( bkey->bsize ) {
     case  8: /* шифр с длиной блока 64 бита */
-      do {
-        bkey->decrypt( &bkey->key, inptr++, outptr++ );
-      } while( --blocks > 0 );
-    break;
-
     case 16: /* шифр с длиной блока 128 бит */
-      do {
-        bkey->decrypt( &bkey->key, inptr, outptr );
-        inptr+=2; outptr+=2;
-      } while( --blocks > 0 );
+      bkey->decrypt_blocks( &bkey->key, in, out, blocks );
     break;
     default: return ak_error_message( ak_error_wrong_block_cipher,
                                           __func__ , "incorrect block size of block cipher key" );
   }
  /* перемаскируем ключ */
-  if(( error = bkey->key.set_mask( &bkey->key )) != ak_error_ok )
+  if(( error = ak_skey_remask( &bkey->key, size )) != ak_error_ok )
     ak_error_message( error, __func__ , "wrong remasking of secret key" );
 
  return ak_error_ok;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Считывание текущего значения счетчика режима гаммирования из синхропосылки ключа.
+
+    @param bkey Контекст ключа алгоритма блочного шифрования.
+    @param oc Значение опции `openssl_compability`.
+    @return Значение счетчика.                                                                     */
+/* ----------------------------------------------------------------------------------------------- */
+ static ak_uint64 ak_bckey_ctr_load( ak_bckey bkey, int oc )
+{
+  if( bkey->bsize == 8 ) {
+   #ifndef AK_LITTLE_ENDIAN
+    return oc ? ((ak_uint64 *)bkey->ivector)[0] : bswap_64( ((ak_uint64 *)bkey->ivector)[0] );
+   #else
+    return oc ? bswap_64( ((ak_uint64 *)bkey->ivector)[0] ) : ((ak_uint64 *)bkey->ivector)[0];
+   #endif
+  }
+ #ifndef AK_LITTLE_ENDIAN
+  return bswap_64( ((ak_uint64 *)bkey->ivector)[oc] );
+ #else
+  return ((ak_uint64 *)bkey->ivector)[oc];
+ #endif
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Сохранение значения счетчика режима гаммирования в синхропосылке ключа.
+
+    @param bkey Контекст ключа алгоритма блочного шифрования.
+    @param oc Значение опции `openssl_compability`.
+    @param x Значение счетчика.                                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_bckey_ctr_store( ak_bckey bkey, int oc, ak_uint64 x )
+{
+  if( bkey->bsize == 8 ) {
+   #ifndef AK_LITTLE_ENDIAN
+    ((ak_uint64 *)bkey->ivector)[0] = oc ? x : bswap_64( x );
+   #else
+    ((ak_uint64 *)bkey->ivector)[0] = oc ? bswap_64( x ) : x;
+   #endif
+    return;
+  }
+                                  /* здесь мы не учитываем знак переноса
+                                     потому что объем данных на одном ключе не должен
+                                     превышать 2^64 блоков (контролируется через ресурс ключа) */
+ #ifdef AK_LITTLE_ENDIAN
+  ((ak_uint64 *)bkey->ivector)[oc] = oc ? bswap_64( x ) : x;
+ #else
+  ((ak_uint64 *)bkey->ivector)[oc] = oc ? x : bswap_64( x );
+ #endif
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Гаммирование последовательности блоков, кратной длине блока.
+
+    Значения счетчика формируются сразу для нескольких блоков, которые
+    зашифровываются одним вызовом функции encrypt_blocks. Синхропосылка ключа
+    используется только для чтения, поэтому функция может одновременно вызываться
+    для непересекающихся фрагментов данных с различными копиями ключа.
+
+    @param bkey Контекст ключа алгоритма блочного шифрования.
+    @param x Значение счетчика для первого обрабатываемого блока.
+    @param inptr Указатель на входные данные.
+    @param outptr Указатель на выходные данные.
+    @param blocks Количество обрабатываемых блоков.
+    @param oc Значение опции `openssl_compability`.
+    @param next Указатель, по которому помещается значение счетчика, следующее за последним
+    использованным.
+    @return В случае возникновения ошибки функция возвращает ее код, в противном случае
+    возвращается \ref ak_error_ok (ноль)                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_bckey_ctr_blocks( ak_bckey bkey, ak_uint64 x, ak_uint64 *inptr,
+                                 ak_uint64 *outptr, size_t blocks, int oc, ak_uint64 *next )
+{
+  size_t i, cnt;
+  ak_uint64 ctr[ ak_bckey_batch_size/sizeof( ak_uint64 )];
+
+  switch( bkey->bsize ) {
+    case  8: /* шифр с длиной блока 64 бита (Магма) */
+      while( blocks > 0 ) {
+          cnt = ak_min( blocks, ak_bckey_batch_size >> 3 );
+          for( i = 0; i < cnt; i++, x++ ) {
+            #ifndef AK_LITTLE_ENDIAN
+             ctr[i] = oc ? x : bswap_64( x );
+            #else
+             ctr[i] = oc ? bswap_64( x ) : x;
+            #endif
+          }
+          bkey->encrypt_blocks( &bkey->key, ctr, ctr, cnt );
+          for( i = 0; i < cnt; i++ ) outptr[i] = inptr[i] ^ ctr[i];
+          outptr += cnt; inptr += cnt;
+          blocks -= cnt;
+      }
+    break;
+
+    case 16: /* шифр с длиной блока 128 бит (Кузнечик) */
+      while( blocks > 0 ) {
+          cnt = ak_min( blocks, ak_bckey_batch_size >> 4 );
+          for( i = 0; i < cnt; i++, x++ ) {
+             ctr[2*i+1-oc] = ((ak_uint64 *)bkey->ivector)[1-oc];
+            #ifdef AK_LITTLE_ENDIAN
+             ctr[2*i+oc] = oc ? bswap_64( x ) : x;
+            #else
+             ctr[2*i+oc] = oc ? x : bswap_64( x );
+            #endif
+          }
+          bkey->encrypt_blocks( &bkey->key, ctr, ctr, cnt );
+          for( i = 0; i < 2*cnt; i++ ) outptr[i] = inptr[i] ^ ctr[i];
+          outptr += 2*cnt; inptr += 2*cnt;
+          blocks -= cnt;
+      }
+    break;
+
+    default: return ak_error_message( ak_error_wrong_block_cipher,
+                                          __func__ , "incorrect block size of block cipher key" );
+  }
+  *next = x;
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Определение количества фрагментов, на которые разбиваются данные при их параллельной
+    обработке, и количества блоков в одном фрагменте.
+
+    Количество блоков во фрагменте кратно количеству блоков, обрабатываемых за один вызов
+    функции encrypt_blocks, а размер фрагмента не меньше величины \ref ak_bckey_thread_min_size.
+    В качестве блока может выступать и более крупная единица данных, например,
+    секция режима `CTR-ACPKM`.
+
+    @param bsize Длина блока (в октетах).
+    @param blocks Общее количество обрабатываемых блоков.
+    @param threads Запрошенное количество потоков.
+    @param per Указатель, по которому помещается количество блоков в одном фрагменте.
+    @return Количество фрагментов (не менее единицы).                                             */
+/* ----------------------------------------------------------------------------------------------- */
+ size_t ak_bckey_split_blocks( size_t bsize, size_t blocks, size_t threads, size_t *per )
+{
+  size_t count, batch = ak_max( 1, ak_bckey_batch_size/bsize ),
+                                                  minimal = ak_max( 1, ak_bckey_thread_min_size/bsize );
+
+  if( threads > ak_bckey_max_threads ) threads = ak_bckey_max_threads;
+  if(( count = blocks/minimal ) > threads ) count = threads;
+  if( count < 2 ) {
+    *per = blocks;
+    return 1;
+  }
+  *per = ((( blocks + count - 1 )/count + batch - 1 )/batch )*batch;
+ return ( blocks + *per - 1 )/( *per );
+}
+
+#ifdef AK_HAVE_PTHREAD_H
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Фрагмент данных, обрабатываемый в режиме гаммирования отдельным потоком. */
+ typedef struct ctr_task {
+  /*! \brief Копия ключа, используемая потоком. */
+   struct bckey key;
+  /*! \brief Значение счетчика для первого блока фрагмента. */
+   ak_uint64 x;
+  /*! \brief Указатель на входные данные. */
+   ak_uint64 *in;
+  /*! \brief Указатель на выходные данные. */
+   ak_uint64 *out;
+  /*! \brief Количество блоков во фрагменте. */
+   size_t blocks;
+  /*! \brief Значение опции `openssl_compability`. */
+   int oc;
+  /*! \brief Код ошибки, возникшей при обработке фрагмента. */
+   int error;
+  /*! \brief Поток, обрабатывающий фрагмент. */
+   pthread_t thread;
+  /*! \brief Флаг того, что поток был успешно запущен. */
+   bool_t started;
+} *ak_ctr_task;
+
+/* ----------------------------------------------------------------------------------------------- */
+ static void *ak_bckey_ctr_task( void *ptr )
+{
+  ak_uint64 next;
+  ak_ctr_task task = ( ak_ctr_task )ptr;
+
+  task->error = ak_bckey_ctr_blocks( &task->key, task->x,
+                                          task->in, task->out, task->blocks, task->oc, &next );
+ return NULL;
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Гаммирование последовательности блоков, кратной длине блока, с помощью нескольких
+    потоков.
+
+    Данные разбиваются на фрагменты, каждый из которых обрабатывается отдельным потоком
+    с использованием собственной копии ключа (копия содержит развернутые раундовые ключи
+    и независимый генератор масок). Первый фрагмент обрабатывается вызывающим потоком
+    с использованием исходного ключа. Значение счетчика для каждого фрагмента вычисляется
+    исходя из его смещения, поэтому результат совпадает с результатом последовательной обработки.
+
+    @param bkey Контекст ключа алгоритма блочного шифрования.
+    @param x Значение счетчика для первого обрабатываемого блока.
+    @param inptr Указатель на входные данные.
+    @param outptr Указатель на выходные данные.
+    @param blocks Количество обрабатываемых блоков.
+    @param oc Значение опции `openssl_compability`.
+    @param threads Максимальное количество используемых потоков.
+    @param next Указатель, по которому помещается значение счетчика, следующее за последним
+    использованным (значение изменяется только в случае успешного завершения).
+    @return В случае возникновения ошибки функция возвращает ее код, в противном случае
+    возвращается \ref ak_error_ok (ноль)                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_bckey_ctr_blocks_threads( ak_bckey bkey, ak_uint64 x, ak_uint64 *inptr,
+                   ak_uint64 *outptr, size_t blocks, int oc, size_t threads, ak_uint64 *next )
+{
+#ifdef AK_HAVE_PTHREAD_H
+  ak_ctr_task tasks = NULL;
+  int error = ak_error_ok;
+  size_t i, per, count, words = bkey->bsize >> 3;
+
+  if(( count = ak_bckey_split_blocks( bkey->bsize, blocks, threads, &per )) < 2 )
+    return ak_bckey_ctr_blocks( bkey, x, inptr, outptr, blocks, oc, next );
+
+  if(( tasks = calloc( count, sizeof( struct ctr_task ))) == NULL )
+    return ak_error_message( ak_error_out_of_memory, __func__,
+                                                     "incorrect memory allocation for thread tasks" );
+ /* создаем копии ключа в вызывающем потоке и запускаем обработку фрагментов;
+    первый фрагмент обрабатывается исходным ключом */
+  for( i = 1; i < count; i++ ) {
+     if(( tasks[i].error = ak_bckey_create_and_set_bckey( &tasks[i].key, bkey )) != ak_error_ok ) {
+      /* неудачно созданная копия уже уничтожена, ниже уничтожаются только предыдущие */
+       ak_error_message( error = tasks[i].error, __func__, "incorrect key duplication" );
+       break;
+     }
+     memcpy( tasks[i].key.ivector, bkey->ivector, sizeof( bkey->ivector ));
+     tasks[i].x = x + i*per;
+     tasks[i].in = inptr + i*per*words;
+     tasks[i].out = outptr + i*per*words;
+     tasks[i].blocks = ak_min( per, blocks - i*per );
+     tasks[i].oc = oc;
+     if( pthread_create( &tasks[i].thread, NULL, ak_bckey_ctr_task, tasks+i ) == 0 )
+       tasks[i].started = ak_true;
+      else ak_bckey_ctr_task( tasks+i ); /* не удалось создать поток - обрабатываем фрагмент сами */
+  }
+  if( error == ak_error_ok )
+    error = ak_bckey_ctr_blocks( bkey, x, inptr, outptr, ak_min( per, blocks ), oc, next );
+
+ /* дожидаемся завершения потоков и уничтожаем копии ключа */
+  while( i-- > 1 ) {
+     if( tasks[i].started ) pthread_join( tasks[i].thread, NULL );
+     if(( tasks[i].error != ak_error_ok ) && ( error == ak_error_ok )) error = tasks[i].error;
+     ak_bckey_destroy( &tasks[i].key );
+  }
+  free( tasks );
+  if( error == ak_error_ok ) *next = x + blocks;
+
+ return error;
+#else
+  (void)threads;
+ return ak_bckey_ctr_blocks( bkey, x, inptr, outptr, blocks, oc, next );
+#endif
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! Поскольку в режиме гаммирования операцией шифрования является сложение открытого текста по
     модулю два с последовательностью, вырабатываемой блочным шифром из заданной синхропосылки,
@@ -510,11 +804,44 @@
 /* ----------------------------------------------------------------------------------------------- */
  int ak_bckey_ctr( ak_bckey bkey, ak_pointer in, ak_pointer out, size_t size,
                                                                      ak_pointer iv, size_t iv_size )
+{
+ return ak_bckey_ctr_parallel( bkey, in, out, size, iv, iv_size, 1 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция реализует режим гаммирования, аналогичный функции ak_bckey_ctr(), однако основной
+    массив данных (кратный длине блока) разбивается на фрагменты, которые обрабатываются
+    одновременно несколькими потоками. Поскольку значения счетчика для различных блоков не зависят
+    друг от друга, результат работы функции совпадает с результатом работы функции ak_bckey_ctr()
+    с теми же параметрами, в том числе и значение синхропосылки, сохраняемое в контексте ключа.
+
+    Каждый поток использует собственную копию ключа, создаваемую в вызывающем потоке.
+    Ресурс исходного ключа уменьшается один раз, до начала обработки данных,
+    а хвост сообщения, не кратный длине блока, обрабатывается вызывающим потоком.
+    Данные небольшого объема (менее \ref ak_bckey_thread_min_size октетов на поток),
+    а также данные при сборке библиотеки без поддержки pthreads, обрабатываются последовательно.
+
+    @param bkey Контекст ключа алгоритма блочного шифрования.
+    @param in Указатель на область памяти, где хранятся входные (открытые) данные.
+    @param out Указатель на область памяти, куда помещаются зашифрованные данные
+    (этот указатель может совпадать с `in`).
+    @param size Размер зашировываемых данных (в байтах).
+    @param iv Указатель на синхропосылку.
+    @param iv_size Длина синхропосылки в байтах.
+    @param threads Максимальное количество потоков, используемых для обработки данных
+    (с учетом вызывающего потока).
+
+    @return В случае возникновения ошибки функция возвращает ее код, в противном случае
+    возвращается \ref ak_error_ok (ноль)                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_bckey_ctr_parallel( ak_bckey bkey, ak_pointer in, ak_pointer out, size_t size,
+                                                   ak_pointer iv, size_t iv_size, size_t threads )
 {
   ak_int64 blocks = (ak_int64)( size/bkey->bsize ),
              tail = (ak_int64)( size%bkey->bsize );
-  ak_uint64 x, yaout[2], *inptr = (ak_uint64 *)in, *outptr = (ak_uint64 *)out;
-  int error = ak_error_ok, oc = (int) ak_libakrypt_get_option_by_name( "openssl_compability" );
+  ak_int64 i;
+  ak_uint64 x = 0, yaout[2], *inptr = (ak_uint64 *)in, *outptr = (ak_uint64 *)out;
+  int error = ak_error_ok, oc = ak_bckey_get_options( bkey )->oc;
 
   if(( oc < 0 ) || ( oc > 1 )) return ak_error_message( ak_error_wrong_option, __func__,
                                                 "wrong value for \"openssl_compability\" option" );
@@ -561,58 +888,15 @@
     }
 
  /* обработка основного массива данных (кратного длине блока) */
-  switch( bkey->bsize ) {
-    case  8: /* шифр с длиной блока 64 бита (Магма) */
-      while( blocks > 0 ) {
-        #ifndef AK_LITTLE_ENDIAN
-          x = oc ? ((ak_uint64 *)bkey->ivector)[0] : bswap_64( ((ak_uint64 *)bkey->ivector)[0] );
-        #else
-          x = oc ? bswap_64( ((ak_uint64 *)bkey->ivector)[0] ) : ((ak_uint64 *)bkey->ivector)[0];
-        #endif
-          bkey->encrypt( &bkey->key, bkey->ivector, yaout );
-          *outptr = *inptr ^ yaout[0];
-          outptr++; inptr++;
-
-        #ifndef AK_LITTLE_ENDIAN
-          ((ak_uint64 *)bkey->ivector)[0] = oc ? ++x : bswap_64( ++x );
-        #else
-          ((ak_uint64 *)bkey->ivector)[0] = oc ? bswap_64( ++x ) : ++x;
-        #endif
-        --blocks;
-      }
-    break;
-
-    case 16: /* шифр с длиной блока 128 бит (Кузнечик) */
-     #ifndef AK_LITTLE_ENDIAN
-      x = bswap_64( ((ak_uint64 *)bkey->ivector)[oc] );
-     #else
-      x = ((ak_uint64 *)bkey->ivector)[oc];
-     #endif
-
-      while( blocks > 0 ) {
-          bkey->encrypt( &bkey->key, bkey->ivector, yaout );
-          *outptr = *inptr ^ yaout[0]; outptr++; inptr++;
-          *outptr = *inptr ^ yaout[1]; outptr++; inptr++;
-
-       /* за элементарное сложение с единицей приходится платить одним разворотом */
-        #ifdef AK_LITTLE_ENDIAN
-         ((ak_uint64 *)bkey->ivector)[oc] = oc ? bswap_64(++x) : ++x;
-        #else
-          ((ak_uint64 *)bkey->ivector)[oc] = oc ? ++x : bswap_64( ++x );
-        #endif                    /* здесь мы не учитываем знак переноса
-                                     потому что объем данных на одном ключе не должен
-                                     превышать 2^64 блоков (контролируется через ресурс ключа) */
-        --blocks;
-      }
-    break;
-
-    default: return ak_error_message( ak_error_wrong_block_cipher,
-                                          __func__ , "incorrect block size of block cipher key" );
-  }
+  if(( error = ak_bckey_ctr_blocks_threads( bkey, ak_bckey_ctr_load( bkey, oc ),
+                            inptr, outptr, ( size_t )blocks, oc, threads, &x )) != ak_error_ok )
+    return error;
+  ak_bckey_ctr_store( bkey, oc, x );
+  inptr += blocks*( ak_int64 )( bkey->bsize >> 3 );
+  outptr += blocks*( ak_int64 )( bkey->bsize >> 3 );
 
  /* обрабатываем хвост сообщения */
   if( tail ) {
-    int i;
     bkey->encrypt( &bkey->key, bkey->ivector, yaout );
     for( i = 0; i < tail; i++ ) /* теперь мы гаммируем tail байт, используя для этого
                                    старшие байты (most significant bytes) зашифрованного счетчика */
@@ -633,7 +917,7 @@
   }
 
  /* перемаскируем ключ */
-  if(( error = bkey->key.set_mask( &bkey->key )) != ak_error_ok )
+  if(( error = ak_skey_remask( &bkey->key, size )) != ak_error_ok )
     ak_error_message( error, __func__ , "wrong remasking of secret key" );
 
  return error;
@@ -646,7 +930,7 @@
    ak_int64 blocks = 0;
    ak_uint64 yaout[2], z = iv_size / bkey->bsize;
    ak_uint64 *inptr = (ak_uint64 *)in, *outptr = (ak_uint64 *)out, *ivector = (ak_uint64 *)bkey->ivector;
-   int error = ak_error_ok, oc = (int) ak_libakrypt_get_option_by_name( "openssl_compability" );
+   int error = ak_error_ok, oc = ak_bckey_get_options( bkey )->oc;
 
    if(( oc < 0 ) || ( oc > 1 )) return ak_error_message( ak_error_wrong_option, __func__,
                                                  "wrong value for \"openssl_compability\" option" );
@@ -707,7 +991,7 @@
                                            __func__ , "incorrect block size of block cipher key" );
    }
   /* перемаскируем ключ */
-   if(( error = bkey->key.set_mask( &bkey->key )) != ak_error_ok )
+   if(( error = ak_skey_remask( &bkey->key, size )) != ak_error_ok )
      ak_error_message( error, __func__ , "wrong remasking of secret key" );
 
   return ak_error_ok;
@@ -717,10 +1001,11 @@
  int ak_bckey_decrypt_cbc( ak_bckey bkey, ak_pointer in, ak_pointer out, size_t size,
                                                                     ak_pointer iv, size_t iv_size )
  {
-  ak_int64 blocks = 0;
-  ak_uint64 yaout[2], z = iv_size / bkey->bsize;
+  ak_int64 blocks = 0, i, cnt;
+  size_t j, words = bkey->bsize >> 3;
+  ak_uint64 yaout[ ak_bckey_batch_size/sizeof( ak_uint64 )], z = iv_size / bkey->bsize;
   ak_uint64 *inptr = (ak_uint64 *)in, *outptr = (ak_uint64 *)out, *ivector = (ak_uint64 *)bkey->ivector;
-  int error = ak_error_ok, oc = (int) ak_libakrypt_get_option_by_name( "openssl_compability" );
+  int error = ak_error_ok, oc = ak_bckey_get_options( bkey )->oc;
 
   if(( oc < 0 ) || ( oc > 1 )) return ak_error_message( ak_error_wrong_option, __func__,
                                                 "wrong value for \"openssl_compability\" option" );
@@ -749,40 +1034,33 @@
                                                              "incorrect length of initial value" );
    memcpy(bkey->ivector, iv, iv_size);
 
- /* теперь приступаем к расшифрованию данных */
+ /* теперь приступаем к расшифрованию данных:
+    блоки расшифровываются группами, после чего складываются с предыдущими блоками шифртекста */
   switch( bkey->bsize ) {
     case  8: /* шифр с длиной блока 64 бита */
-      while( blocks > 0 ) {
-          bkey->decrypt( &bkey->key, inptr, yaout );
-          if( z == 0 ) {
-              ivector = (ak_uint64 *)in;
-          }
-          *outptr = yaout[0] ^ *ivector; outptr++; ivector++;
-          inptr++;
-          --blocks;
-          --z;
-      }
-    break;
-
     case 16: /* шифр с длиной блока 128 бит */
       while( blocks > 0 ) {
-          bkey->decrypt( &bkey->key, inptr, yaout );
-          if( z == 0 ) {
-              ivector = (ak_uint64 *)in;
+          cnt = ak_min( blocks, ( ak_int64 )( ak_bckey_batch_size / bkey->bsize ));
+          bkey->decrypt_blocks( &bkey->key, inptr, yaout, ( size_t )cnt );
+          for( i = 0; i < cnt; i++ ) {
+             if( z == 0 ) {
+                 ivector = (ak_uint64 *)in;
+             }
+             for( j = 0; j < words; j++ ) {
+                *outptr = yaout[( size_t )i*words + j] ^ *ivector; outptr++; ivector++;
+             }
+             --z;
           }
-          *outptr = yaout[0] ^ *ivector; outptr++; ivector++;
-          *outptr = yaout[1] ^ *ivector; outptr++; ivector++;
-          inptr+=2;
-          --blocks;
-          --z;
+          inptr += ( size_t )cnt*words;
+          blocks -= cnt;
       }
-
     break;
+
     default: return ak_error_message( ak_error_wrong_block_cipher,
                                           __func__ , "incorrect block size of block cipher key" );
   }
  /* перемаскируем ключ */
-  if(( error = bkey->key.set_mask( &bkey->key )) != ak_error_ok )
+  if(( error = ak_skey_remask( &bkey->key, size )) != ak_error_ok )
     ak_error_message( error, __func__ , "wrong remasking of secret key" );
 
  return ak_error_ok;
@@ -796,7 +1074,7 @@
   ak_int64 blocks = (ak_int64)( size/bkey->bsize ),
              tail = (ak_int64)( size%bkey->bsize );
   ak_uint64 yaout[2], *inptr = (ak_uint64 *)in, *outptr = (ak_uint64 *)out;
-  int error = ak_error_ok, oc = (int) ak_libakrypt_get_option_by_name( "openssl_compability" );
+  int error = ak_error_ok, oc = ak_bckey_get_options( bkey )->oc;
   unsigned long counter = 0, z = iv_size / bkey->bsize; /* во сколько раз синхрпосылка длиннее блока */
 
   if(( oc < 0 ) || ( oc > 1 )) return ak_error_message( ak_error_wrong_option, __func__,
@@ -880,7 +1158,7 @@
    }
 
   /* перемаскируем ключ */
-   if(( error = bkey->key.set_mask( &bkey->key )) != ak_error_ok )
+   if(( error = ak_skey_remask( &bkey->key, size )) != ak_error_ok )
      ak_error_message( error, __func__ , "wrong remasking of secret key" );
 
   return error;
@@ -894,7 +1172,7 @@
               tail = (ak_int64)( size%bkey->bsize );
    ak_uint8 *vecptr = NULL;
    ak_uint64 yaout[2], *inptr = (ak_uint64 *)in, *outptr = (ak_uint64 *)out;
-   int error = ak_error_ok, oc = (int) ak_libakrypt_get_option_by_name( "openssl_compability" );
+   int error = ak_error_ok, oc = ak_bckey_get_options( bkey )->oc;
    unsigned long i = 0, z = iv_size / bkey->bsize; // во сколько раз синхрпосылка длиннее блока
 
    if(( oc < 0 ) || ( oc > 1 )) return ak_error_message( ak_error_wrong_option, __func__,
@@ -974,7 +1252,7 @@
      memset( bkey->ivector, 0, sizeof( bkey->ivector ));
      bkey->key.flags = bkey->key.flags&( ~key_flag_not_ctr );
      /* перемаскируем ключ */
-     if(( error = bkey->key.set_mask( &bkey->key )) != ak_error_ok )
+     if(( error = ak_skey_remask( &bkey->key, size )) != ak_error_ok )
         ak_error_message( error, __func__ , "wrong remasking of secret key" );
    }
    return error;
@@ -988,7 +1266,7 @@
               tail = (ak_int64)( size%bkey->bsize );
    ak_uint8 *vecptr = NULL;
    ak_uint64 yaout[2], *inptr = (ak_uint64 *)in, *outptr = (ak_uint64 *)out;
-   int error = ak_error_ok, oc = (int) ak_libakrypt_get_option_by_name( "openssl_compability" );
+   int error = ak_error_ok, oc = ak_bckey_get_options( bkey )->oc;
    unsigned long i = 0, z = iv_size / bkey->bsize; // во сколько раз синхрпосылка длиннее блока
 
    if(( oc < 0 ) || ( oc > 1 )) return ak_error_message( ak_error_wrong_option, __func__,
@@ -1068,7 +1346,7 @@
      memset( bkey->ivector, 0, sizeof( bkey->ivector ));
      bkey->key.flags = bkey->key.flags&( ~key_flag_not_ctr );
      /* перемаскируем ключ */
-     if(( error = bkey->key.set_mask( &bkey->key )) != ak_error_ok )
+     if(( error = ak_skey_remask( &bkey->key, size )) != ak_error_ok )
         ak_error_message( error, __func__ , "wrong remasking of secret key" );
    }
    return error;
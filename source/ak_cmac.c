@@ -33,7 +33,7 @@
  int ak_bckey_cmac( ak_bckey bkey, ak_pointer in,
                                           const size_t size, ak_pointer out, const size_t out_size )
 {
-  ak_int64 i = 0, oc = (int) ak_libakrypt_get_option_by_name( "openssl_compability" ),
+  ak_int64 i = 0, oc = ak_bckey_get_options( bkey )->oc,
         #ifdef AK_LITTLE_ENDIAN
            one64[2] = { 0x02, 0x00 },
         #else
@@ -354,7 +354,7 @@
                                                            ak_pointer out, const size_t out_size )
 {
   int error = ak_error_ok;
-  ak_int64 oc = (int) ak_libakrypt_get_option_by_name( "openssl_compability" ),
+  ak_int64 oc = ak_bckey_get_options( bkey )->oc,
         #ifdef AK_LITTLE_ENDIAN
            one64[2] = { 0x02, 0x00 };
         #else
@@ -446,10 +446,50 @@
  return ak_error_ok;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Параметры, передаваемые функции обработки фрагментов файла. */
+ typedef struct cmac_file_state {
+  /*! \brief Контекст ключа алгоритма блочного шифрования. */
+   ak_bckey key;
+  /*! \brief Область памяти для результата. */
+   ak_pointer out;
+  /*! \brief Размер области памяти для результата. */
+   size_t out_size;
+ } *ak_cmac_file_state;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Обработка очередного фрагмента файла (длина всех фрагментов, кроме последнего,
+    кратна 4096 и, следовательно, длине блока алгоритма блочного шифрования). */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_bckey_cmac_file_block( const ak_uint8 *data, const size_t size,
+                                                                 const bool_t last, ak_pointer ptr )
+{
+  size_t qcnt = 0, tail = 0;
+  ak_cmac_file_state st = ( ak_cmac_file_state )ptr;
+
+  if( !last ) return ak_bckey_cmac_update( st->key, ( ak_pointer )data, size );
+
+ /* последний фрагмент: функция ak_bckey_cmac_finalize() должна получить непустой блок */
+  qcnt = size / st->key->bsize;
+  tail = size - qcnt*st->key->bsize;
+  if( tail == 0 ) {
+    if( qcnt > 0 ) { qcnt--; tail = st->key->bsize; }
+     else return ak_error_message( ak_error_read_data, __func__,
+                                                              "unexpected length of input data");
+  }
+  if( qcnt ) ak_bckey_cmac_update( st->key, ( ak_pointer )data, qcnt*st->key->bsize );
+ return ak_bckey_cmac_finalize( st->key,
+                          ( ak_pointer )( data + qcnt*st->key->bsize ), tail, st->out, st->out_size );
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \note Реализация данной функции не использует методы класса \ref mac, поскольку
     функция ak_bckey_cmac_finalize() не может принимать данные нелевой длины.
 
+    Файл обрабатывается фрагментами, длина которых определяется опцией `file_buffer_size`;
+    при установленной опции `use_mmap_for_files` файл отображается в память
+    (см. функцию ak_file_read_by_blocks()).
+
     @param key Контекст ключа алгоритма блочного шифрования.
     @param filename Имя файла, для котрого вычисляется хеш-код.
     @param out Область памяти, куда будет помещен результат. Память должна быть заранее выделена.
@@ -463,9 +503,7 @@
 {
   struct file file;
   int error = ak_error_ok;
-  size_t block_size = 4096; /* оптимальная длина блока для Windows, по-прежнему, не ясна */
-  ak_int64 len = 0, readlen = 0;
-  ak_uint8 *localbuffer = NULL; /* место для локального считывания информации */
+  struct cmac_file_state st;
 
  /* выполняем необходимые проверки */
   if( key == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
@@ -481,40 +519,19 @@
     ak_file_close( &file );
     return ak_bckey_cmac( key, NULL, 0, out, out_size );
   }
- /* готовим область для хранения данных */
-  block_size = ak_max( ( size_t )file.blksize, 512 );
- /* здесь мы выделяем локальный буффер для считывания/обработки данных */
-  if(( localbuffer = ( ak_uint8 * ) ak_aligned_malloc( block_size )) == NULL ) {
-    ak_file_close( &file );
-    return ak_error_message( ak_error_out_of_memory, __func__ ,
-                                                      "memory allocation error for local buffer" );
-  }
 
  /* теперь обрабатываем файл с данными */
   ak_bckey_cmac_clean( key );
-  read_label:
-   readlen += ( len = ( size_t ) ak_file_read( &file, localbuffer, block_size ));
-   if( readlen == file.size ) { /* считан последний большой блок */
-     size_t qcnt = len / key->bsize,
-            tail = len - qcnt*key->bsize;
-     if( tail == 0 ) {
-       if( qcnt > 0 ) { qcnt--; tail = key->bsize; }
-         else {
-           error = ak_error_message( ak_error_read_data, __func__,
-                                                           "unexpected length of input data");
-           goto labex;
-         }
-     }
-     if( qcnt ) ak_bckey_cmac_update( key, localbuffer, qcnt*key->bsize );
-     error = ak_bckey_cmac_finalize(key, localbuffer + qcnt*key->bsize, tail, out, out_size );
-   }
-    else {
-           ak_bckey_cmac_update( key, localbuffer, len );
-           goto read_label;
-         }
-  labex:
-   if( localbuffer != NULL ) ak_aligned_free( localbuffer );
-   ak_file_close( &file );
+  st.key = key;
+  st.out = out;
+  st.out_size = out_size;
+  if(( error = ak_file_read_by_blocks( &file,
+                    ( size_t )ak_libakrypt_get_option_by_index( file_buffer_size_option ),
+                    ( bool_t )ak_libakrypt_get_option_by_index( use_mmap_for_files_option ),
+                                         ak_bckey_cmac_file_block, &st )) != ak_error_ok )
+    ak_error_message_fmt( error, __func__, "incorrect processing of file %s", filename );
+
+  ak_file_close( &file );
  return error;
 }
 
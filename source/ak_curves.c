@@ -4,9 +4,14 @@
 /*  Файл ak_curves.с                                                                               */
 /*  - содержит реализацию функций для работы с эллиптическими кривыми.                             */
 /* ----------------------------------------------------------------------------------------------- */
- #include <libakrypt.h>
+ #include <libakrypt-internal.h>
 
 /* ----------------------------------------------------------------------------------------------- */
+#ifdef AK_HAVE_STDLIB_H
+ #include <stdlib.h>
+#else
+ #error Library cannot be compiled without stdlib.h header
+#endif
 #ifdef AK_HAVE_STRING_H
  #include <string.h>
 #else
@@ -15,6 +20,9 @@
 #ifdef AK_HAVE_STRINGS_H
  #include <strings.h>
 #endif
+#ifdef AK_HAVE_PTHREAD_H
+ #include <pthread.h>
+#endif
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! Функция вычисляет величину \f$\Delta \equiv -16(4a^3 + 27b^2) \pmod{p} \f$, зависящую
@@ -82,7 +90,7 @@
 /* ----------------------------------------------------------------------------------------------- */
  int ak_wcurve_check_order_parameters( ak_wcurve ec )
 {
-  ak_mpzn512 r, s, t;
+  ak_mpzn512 s, t;
   struct random generator;
 
   ak_random_create_lcg( &generator );
@@ -90,9 +98,7 @@
   ak_mpzn_rem( t, t, ec->q, ec->size );
   ak_random_destroy( &generator );
 
-  ak_mpzn_set_ui( r, ec->size, 2 );
-  ak_mpzn_sub( r, ec->q, r, ec->size );
-  ak_mpzn_modpow_montgomery( s, t, r, ec->q, ec->nq, ec->size );
+  ak_mpzn_inverse_montgomery( s, t, ec->r2q, ec->q, ec->nq, ec->size, ak_false );
   ak_mpzn_mul_montgomery( t, s, t, ec->q, ec->nq, ec->size );
 
   ak_mpzn_mul_montgomery( t, t, ec->r2q, ec->q, ec->nq, ec->size );
@@ -577,9 +583,7 @@
    return;
  }
 
- ak_mpzn_set_ui( u, ec->size, 2 );
- ak_mpzn_sub( u, ec->p, u, ec->size );
- ak_mpzn_modpow_montgomery( u, wp->z, u, ec->p, ec->n, ec->size ); // u <- z^{p-2} (mod p)
+ ak_mpzn_inverse_montgomery( u, wp->z, ec->r2, ec->p, ec->n, ec->size, ak_true ); // u <- z^{-1}
  ak_mpzn_mul_montgomery( u, u, one, ec->p, ec->n, ec->size );
 
  ak_mpzn_mul_montgomery( wp->x, wp->x, u, ec->p, ec->n, ec->size );
@@ -630,6 +634,454 @@
   ak_wpoint_set_wpoint( wq, &Q, ec );
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*                 вычисление кратных точек для образующей точки (гребенчатый метод)               */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Количество бит скаляра, обрабатываемых за одну итерацию гребенчатого метода. */
+ #define ak_wpoint_comb_width  (6)
+/*! \brief Количество точек в таблице гребенчатого метода. */
+ #define ak_wpoint_comb_points  ( 1 << ak_wpoint_comb_width )
+/*! \brief Максимальное количество эллиптических кривых, для которых хранятся таблицы. */
+ #define ak_wcurve_comb_cache_size  (16)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Таблица кратных значений образующей точки эллиптической кривой.
+    \details Точка с индексом \f$ i = \sum_{j} i_j2^j \f$ равна \f$ \sum_j i_j[2^{jd}]P \f$,
+    где \f$ d \f$ - расстояние между зубьями гребенки, \f$ P \f$ образующая точка кривой.         */
+/* ----------------------------------------------------------------------------------------------- */
+ typedef struct wcurve_comb {
+  /*! \brief Размер параметров эллиптической кривой (в 64-х битных словах). */
+   ak_uint32 size;
+  /*! \brief Модуль эллиптической кривой. */
+   ak_uint64 p[ak_mpzn512_size];
+  /*! \brief Коэффициент \f$ a \f$ эллиптической кривой. */
+   ak_uint64 a[ak_mpzn512_size];
+  /*! \brief Образующая точка, для которой вычислена таблица. */
+   struct wpoint point;
+  /*! \brief Расстояние между зубьями гребенки (в битах). */
+   size_t spacing;
+  /*! \brief Таблица кратных точек. */
+   struct wpoint table[ak_wpoint_comb_points];
+} *ak_wcurve_comb;
+
+/*! \brief Таблицы кратных точек для используемых эллиптических кривых. */
+ static ak_wcurve_comb ak_wcurve_comb_cache[ak_wcurve_comb_cache_size];
+#ifdef AK_HAVE_PTHREAD_H
+/*! \brief Блокировка, защищающая формирование таблиц кратных точек. */
+ static pthread_mutex_t ak_wcurve_comb_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Формирование таблицы кратных точек для образующей точки эллиптической кривой.
+    @param ec Эллиптическая кривая.
+    @return Функция возвращает указатель на созданную таблицу или NULL в случае ошибки.            */
+/* ----------------------------------------------------------------------------------------------- */
+ static ak_wcurve_comb ak_wcurve_comb_new( ak_wcurve ec )
+{
+  size_t i, j, top;
+  struct wpoint base[ak_wpoint_comb_width];
+  ak_wcurve_comb comb = malloc( sizeof( struct wcurve_comb ));
+
+  if( comb == NULL ) {
+    ak_error_message( ak_error_out_of_memory, __func__,
+                                     "incorrect memory allocation for table of multiple points" );
+    return NULL;
+  }
+  comb->size = ec->size;
+  memcpy( comb->p, ec->p, sizeof( comb->p ));
+  memcpy( comb->a, ec->a, sizeof( comb->a ));
+  ak_wpoint_set_wpoint( &comb->point, &ec->point, ec );
+  comb->spacing = ( 64*ec->size + ak_wpoint_comb_width - 1 )/ak_wpoint_comb_width;
+
+ /* вычисляем точки [2^{jd}]P */
+  ak_wpoint_set_wpoint( base, &ec->point, ec );
+  for( j = 1; j < ak_wpoint_comb_width; j++ ) {
+     ak_wpoint_set_wpoint( base+j, base+j-1, ec );
+     for( i = 0; i < comb->spacing; i++ ) ak_wpoint_double( base+j, ec );
+  }
+ /* вычисляем все суммы этих точек */
+  ak_wpoint_set_as_unit( comb->table, ec );
+  for( i = 1, top = 0; i < ak_wpoint_comb_points; i++ ) {
+     if( i == ( (size_t)2 << top )) top++;
+     ak_wpoint_set_wpoint( comb->table+i, comb->table+( i^( (size_t)1 << top )), ec );
+     ak_wpoint_add( comb->table+i, base+top, ec );
+  }
+
+ return comb;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Поиск (при необходимости, формирование) таблицы кратных точек для эллиптической кривой.
+    \details Кривые сравниваются по значениям параметров, а не по адресам контекстов.
+    @param ec Эллиптическая кривая.
+    @return Функция возвращает указатель на таблицу или NULL, если таблица не может быть
+    сформирована.                                                                                  */
+/* ----------------------------------------------------------------------------------------------- */
+ static ak_wcurve_comb ak_wcurve_comb_get( ak_wcurve ec )
+{
+  size_t idx = 0, len = ec->size*sizeof( ak_uint64 );
+  ak_wcurve_comb comb = NULL;
+
+#ifdef AK_HAVE_PTHREAD_H
+  pthread_mutex_lock( &ak_wcurve_comb_mutex );
+#endif
+  for( idx = 0; idx < ak_wcurve_comb_cache_size; idx++ ) {
+     if(( comb = ak_wcurve_comb_cache[idx] ) == NULL ) {
+       comb = ak_wcurve_comb_cache[idx] = ak_wcurve_comb_new( ec );
+       break;
+     }
+     if(( comb->size == ec->size ) && !memcmp( comb->p, ec->p, len ) &&
+        !memcmp( comb->a, ec->a, len ) && !memcmp( comb->point.x, ec->point.x, len ) &&
+        !memcmp( comb->point.y, ec->point.y, len ) && !memcmp( comb->point.z, ec->point.z, len ))
+       break;
+     comb = NULL;
+  }
+#ifdef AK_HAVE_PTHREAD_H
+  pthread_mutex_unlock( &ak_wcurve_comb_mutex );
+#endif
+
+ return comb;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вызывается при завершении работы с библиотекой.                                        */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_wcurve_comb_cache_destroy( void )
+{
+  size_t idx = 0;
+
+#ifdef AK_HAVE_PTHREAD_H
+  pthread_mutex_lock( &ak_wcurve_comb_mutex );
+#endif
+  for( idx = 0; idx < ak_wcurve_comb_cache_size; idx++ ) {
+     if( ak_wcurve_comb_cache[idx] != NULL ) free( ak_wcurve_comb_cache[idx] );
+     ak_wcurve_comb_cache[idx] = NULL;
+  }
+#ifdef AK_HAVE_PTHREAD_H
+  pthread_mutex_unlock( &ak_wcurve_comb_mutex );
+#endif
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Выбор точки из таблицы без зависящих от индекса ветвлений и обращений к памяти.       */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_wcurve_comb_select( ak_wpoint wq, ak_wcurve_comb comb, ak_uint64 index )
+{
+  size_t i, j;
+  ak_uint64 mask, diff;
+
+  memset( wq, 0, sizeof( struct wpoint ));
+  for( i = 0; i < ak_wpoint_comb_points; i++ ) {
+     diff = i ^ index;
+     mask = (( diff | ( 0 - diff )) >> 63 ) - 1; /* все единицы, если i = index */
+     for( j = 0; j < comb->size; j++ ) {
+        wq->x[j] |= comb->table[i].x[j]&mask;
+        wq->y[j] |= comb->table[i].y[j]&mask;
+        wq->z[j] |= comb->table[i].z[j]&mask;
+     }
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычитание вычетов по модулю p: \f$ z \equiv x - y \pmod{p} \f$ (без ветвлений). */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_wpoint_sub_montgomery( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y,
+                                                                                  ak_wcurve ec )
+{
+  ak_mpznmax t;
+
+  ak_mpzn_sub( t, ec->p, y, ec->size );
+  ak_mpzn_add_montgomery( z, x, t, ec->p, ec->size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Сложение точек с помощью полных формул, не содержащих исключительных случаев.
+
+    Используются соотношения из работы J.Renes, C.Costello and L.Batina
+    <a href=https://eprint.iacr.org/2015/1060>Complete addition formulas for prime order
+    elliptic curves</a>, 2016 (алгоритм 1). Формулы справедливы для любых точек, разность которых
+    не является точкой порядка 2, в частности, для всех точек подгруппы, порождаемой образующей
+    точкой кривой, включая бесконечно удаленную точку и совпадающие слагаемые.
+    В отличие от функции ak_wpoint_add(), последовательность выполняемых операций
+    не зависит от значений складываемых точек.
+
+    @param wp1 Точка \f$ P \f$, в которую помещается результат; первое слагаемое.
+    @param wp2 Точка \f$ Q \f$, второе слагаемое; может совпадать с \f$ P \f$.
+    @param b3 Величина \f$ 3b \f$ в представлении Монтгомери.
+    @param ec Эллиптическая кривая, которой принадлежат складываемые точки.                        */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_wpoint_add_complete( ak_wpoint wp1, ak_wpoint wp2, ak_uint64 *b3, ak_wcurve ec )
+{
+  ak_mpznmax t0, t1, t2, t3, t4, t5, x3, y3, z3;
+  ak_uint64 *p = ec->p, n = ec->n;
+  const size_t size = ec->size;
+
+  ak_mpzn_mul_montgomery( t0, wp1->x, wp2->x, p, n, size );
+  ak_mpzn_mul_montgomery( t1, wp1->y, wp2->y, p, n, size );
+  ak_mpzn_mul_montgomery( t2, wp1->z, wp2->z, p, n, size );
+  ak_mpzn_add_montgomery( t3, wp1->x, wp1->y, p, size );
+  ak_mpzn_add_montgomery( t4, wp2->x, wp2->y, p, size );
+  ak_mpzn_mul_montgomery( t3, t3, t4, p, n, size );
+  ak_mpzn_add_montgomery( t4, t0, t1, p, size );
+  ak_wpoint_sub_montgomery( t3, t3, t4, ec );        /* t3 = x1y2 + x2y1 */
+  ak_mpzn_add_montgomery( t4, wp1->x, wp1->z, p, size );
+  ak_mpzn_add_montgomery( t5, wp2->x, wp2->z, p, size );
+  ak_mpzn_mul_montgomery( t4, t4, t5, p, n, size );
+  ak_mpzn_add_montgomery( t5, t0, t2, p, size );
+  ak_wpoint_sub_montgomery( t4, t4, t5, ec );        /* t4 = x1z2 + x2z1 */
+  ak_mpzn_add_montgomery( t5, wp1->y, wp1->z, p, size );
+  ak_mpzn_add_montgomery( x3, wp2->y, wp2->z, p, size );
+  ak_mpzn_mul_montgomery( t5, t5, x3, p, n, size );
+  ak_mpzn_add_montgomery( x3, t1, t2, p, size );
+  ak_wpoint_sub_montgomery( t5, t5, x3, ec );        /* t5 = y1z2 + y2z1 */
+  ak_mpzn_mul_montgomery( z3, ec->a, t4, p, n, size );
+  ak_mpzn_mul_montgomery( x3, b3, t2, p, n, size );
+  ak_mpzn_add_montgomery( z3, x3, z3, p, size );
+  ak_wpoint_sub_montgomery( x3, t1, z3, ec );
+  ak_mpzn_add_montgomery( z3, t1, z3, p, size );
+  ak_mpzn_mul_montgomery( y3, x3, z3, p, n, size );
+  ak_mpzn_add_montgomery( t1, t0, t0, p, size );
+  ak_mpzn_add_montgomery( t1, t1, t0, p, size );
+  ak_mpzn_mul_montgomery( t2, ec->a, t2, p, n, size );
+  ak_mpzn_mul_montgomery( t4, b3, t4, p, n, size );
+  ak_mpzn_add_montgomery( t1, t1, t2, p, size );
+  ak_wpoint_sub_montgomery( t2, t0, t2, ec );
+  ak_mpzn_mul_montgomery( t2, ec->a, t2, p, n, size );
+  ak_mpzn_add_montgomery( t4, t4, t2, p, size );
+  ak_mpzn_mul_montgomery( t0, t1, t4, p, n, size );
+  ak_mpzn_add_montgomery( y3, y3, t0, p, size );
+  ak_mpzn_mul_montgomery( t0, t5, t4, p, n, size );
+  ak_mpzn_mul_montgomery( x3, t3, x3, p, n, size );
+  ak_wpoint_sub_montgomery( x3, x3, t0, ec );
+  ak_mpzn_mul_montgomery( t0, t3, t1, p, n, size );
+  ak_mpzn_mul_montgomery( z3, t5, z3, p, n, size );
+  ak_mpzn_add_montgomery( z3, z3, t0, p, size );
+
+  memcpy( wp1->x, x3, size*sizeof( ak_uint64 ));
+  memcpy( wp1->y, y3, size*sizeof( ak_uint64 ));
+  memcpy( wp1->z, z3, size*sizeof( ak_uint64 ));
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Для образующей точки \f$ P \f$ эллиптической кривой и заданного целого числа (вычета)
+    \f$ k \f$ функция вычисляет кратную точку \f$ Q = [k]P \f$.
+
+    При вычислении используется гребенчатый метод Лим-Ли с шириной гребенки
+    \ref ak_wpoint_comb_width: вместо \f$ 64n \f$ сложений и удвоений лесенки Монтгомери
+    выполняется около \f$ 64n/w \f$ удвоений и сложений. Таблица кратных точек
+    вычисляется один раз, при первом обращении к кривой, и хранится до вызова функции
+    ak_libakrypt_destroy(). Если таблица не может быть сформирована, используется
+    функция ak_wpoint_pow().
+
+    Выбор точек из таблицы выполняется маскированием, а удвоение и сложение выполняются
+    на каждой итерации с помощью полных формул сложения, которые не содержат ветвлений
+    для бесконечно удаленной точки и совпадающих слагаемых. Тем самым, последовательность
+    операций с точками и адреса обращений к памяти не зависят от значения \f$ k \f$.
+    Отсутствие ветвлений в арифметике вычетов обеспечивается специализированными
+    реализациями умножения Монтгомери для модулей длины 256 и 512 бит, которые используются
+    при наличии у компилятора 128-битного целого типа; в общем случае умножение содержит
+    зависящее от данных условное вычитание модуля.
+
+    \b Для \b информации: функция не приводит результирующую точку \f$ Q \f$ к аффинной форме.
+
+    @param wq Точка \f$ Q \f$, в которую помещается результат.
+    @param k Степень кратности.
+    @param size Размер степени \f$ k \f$ в машинных словах; значение не должно превышать
+    размера параметров кривой.
+    @param ec Эллиптическая кривая, на которой происходят вычисления                               */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_wpoint_pow_base( ak_wpoint wq, ak_uint64 *k, size_t size, ak_wcurve ec )
+{
+  size_t t, j, pos;
+  ak_uint64 index;
+  ak_mpznmax b3;
+  struct wpoint Q, R;
+  ak_wcurve_comb comb = NULL;
+
+  if(( size > ec->size ) || (( comb = ak_wcurve_comb_get( ec )) == NULL )) {
+    ak_wpoint_pow( wq, &ec->point, k, size, ec );
+    return;
+  }
+
+ /* величина 3b, используемая в полных формулах сложения */
+  ak_mpzn_add_montgomery( b3, ec->b, ec->b, ec->p, ec->size );
+  ak_mpzn_add_montgomery( b3, b3, ec->b, ec->p, ec->size );
+
+  ak_wpoint_set_as_unit( &Q, ec );
+  for( t = comb->spacing; t > 0; t-- ) {
+    /* формируем индекс из бит k с номерами t-1, t-1+d, t-1+2d, ... */
+     for( j = 0, index = 0, pos = t-1; j < ak_wpoint_comb_width; j++, pos += comb->spacing )
+        if( pos < 64*size ) index ^= (( k[pos >> 6] >> ( pos&0x3f ))&1 ) << j;
+
+    /* нулевому индексу соответствует бесконечно удаленная точка таблицы,
+       полные формулы обрабатывают ее так же, как и остальные точки */
+     ak_wcurve_comb_select( &R, comb, index );
+     ak_wpoint_add_complete( &Q, &Q, b3, ec );
+     ak_wpoint_add_complete( &Q, &R, b3, ec );
+  }
+  ak_wpoint_set_wpoint( wq, &Q, ec );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*             вычисление суммы кратных точек (метод Штрауса с представлением wNAF)                */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Максимальная длина представления wNAF для вычетов, используемых библиотекой. */
+ #define ak_wpoint_wnaf_max_length  ( 64*ak_mpzn512_size + 1 )
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление представления wNAF целого числа.
+    \details Каждая ненулевая цифра представления нечетна и по модулю не превосходит
+    \f$ 2^{w-1} \f$, за каждой ненулевой цифрой следует не менее \f$ w-1 \f$ нулевых.
+
+    @param naf Массив, в который помещаются цифры (младшие цифры первыми).
+    @param k Целое число.
+    @param size Размер числа \f$ k \f$ в машинных словах.
+    @return Функция возвращает количество цифр представления.                                      */
+/* ----------------------------------------------------------------------------------------------- */
+ static size_t ak_mpzn_wnaf( signed char *naf, ak_uint64 *k, size_t size )
+{
+  ak_uint64 t[ak_mpzn512_size+1], d, carry;
+  size_t i, len = 0;
+  bool_t nonzero = ak_false;
+
+  memcpy( t, k, size*sizeof( ak_uint64 ));
+  t[size] = 0;
+  for( i = 0; i < size; i++ ) if( t[i] ) nonzero = ak_true;
+
+  while( nonzero ) {
+    if( t[0]&1 ) {
+      d = t[0]&(( 1 << ak_wpoint_wnaf_width ) - 1 );
+      if( d >= ( 1 << ( ak_wpoint_wnaf_width - 1 ))) {
+       /* отрицательная цифра: прибавляем 2^w - d */
+        naf[len] = ( signed char )( (int)d - ( 1 << ak_wpoint_wnaf_width ));
+        carry = ( 1 << ak_wpoint_wnaf_width ) - d;
+        for( i = 0; ( i <= size ) && carry; i++ ) {
+           t[i] += carry;
+           carry = ( t[i] < carry );
+        }
+      } else {
+         naf[len] = ( signed char )d;
+         t[0] -= d; /* заем не возникает, поскольку d совпадает с младшими битами t */
+        }
+    } else naf[len] = 0;
+    len++;
+
+   /* сдвигаем t на один бит вправо */
+    for( i = 0, nonzero = ak_false; i <= size; i++ ) {
+       t[i] = ( t[i] >> 1 ) | ( i < size ? ( t[i+1] << 63 ) : 0 );
+       if( t[i] ) nonzero = ak_true;
+    }
+  }
+
+ return len;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет таблицу точек \f$ P, [3]P, [5]P, \ldots, [2^{w-1}-1]P \f$,
+    используемую функцией ak_wpoint_pow2_tables().
+
+    @param table Массив из \ref ak_wpoint_wnaf_points точек, в который помещается результат.
+    @param wp Точка \f$ P \f$.
+    @param ec Эллиптическая кривая, на которой происходят вычисления                               */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_wpoint_set_odd_multiples( ak_wpoint table, ak_wpoint wp, ak_wcurve ec )
+{
+  size_t i;
+  struct wpoint dp;
+
+  ak_wpoint_set_wpoint( &dp, wp, ec );
+  ak_wpoint_double( &dp, ec );
+  ak_wpoint_set_wpoint( table, wp, ec );
+  for( i = 1; i < ak_wpoint_wnaf_points; i++ ) {
+     ak_wpoint_set_wpoint( table+i, table+i-1, ec );
+     ak_wpoint_add( table+i, &dp, ec );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Прибавление к точке кратной точки, заданной цифрой представления wNAF.                */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_wpoint_add_digit( ak_wpoint wr, ak_wpoint table, int digit, ak_wcurve ec )
+{
+  struct wpoint neg;
+
+  if( digit > 0 ) ak_wpoint_add( wr, table + ( digit >> 1 ), ec );
+  if( digit < 0 ) {
+    ak_wpoint_set_wpoint( &neg, table + ( -digit >> 1 ), ec );
+    if( ak_mpzn_cmp_ui( neg.y, ec->size, 0 ) != ak_true )
+      ak_mpzn_sub( neg.y, ec->p, neg.y, ec->size );
+    ak_wpoint_add( wr, &neg, ec );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет точку \f$ R = [k_1]P + [k_2]Q \f$ по заранее вычисленным таблицам
+    нечетных кратных точек \f$ P \f$ и \f$ Q \f$, см. ak_wpoint_set_odd_multiples().
+    Удвоения для обоих слагаемых выполняются совместно (метод Штрауса),
+    сами степени записываются в представлении wNAF.
+
+    \warning Время работы функции зависит от значений \f$ k_1 \f$ и \f$ k_2 \f$, поэтому
+    функция может применяться только для открытых данных, например, при проверке подписи.
+
+    @param wr Точка \f$ R \f$, в которую помещается результат (в проективной форме).
+    @param ptable Таблица нечетных кратных точки \f$ P \f$.
+    @param k1 Степень кратности точки \f$ P \f$.
+    @param qtable Таблица нечетных кратных точки \f$ Q \f$.
+    @param k2 Степень кратности точки \f$ Q \f$.
+    @param size Размер степеней в машинных словах; значение не должно превышать
+    размера параметров кривой.
+    @param ec Эллиптическая кривая, на которой происходят вычисления                               */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_wpoint_pow2_tables( ak_wpoint wr, ak_wpoint ptable, ak_uint64 *k1,
+                                       ak_wpoint qtable, ak_uint64 *k2, size_t size, ak_wcurve ec )
+{
+  struct wpoint R;
+  long long int i;
+  size_t len1, len2;
+  signed char naf1[ak_wpoint_wnaf_max_length], naf2[ak_wpoint_wnaf_max_length];
+
+  len1 = ak_mpzn_wnaf( naf1, k1, size );
+  len2 = ak_mpzn_wnaf( naf2, k2, size );
+
+  ak_wpoint_set_as_unit( &R, ec );
+  for( i = ( long long int )ak_max( len1, len2 ) - 1; i >= 0; i-- ) {
+     ak_wpoint_double( &R, ec );
+     if( i < ( long long int )len1 ) ak_wpoint_add_digit( &R, ptable, naf1[i], ec );
+     if( i < ( long long int )len2 ) ak_wpoint_add_digit( &R, qtable, naf2[i], ec );
+  }
+  ak_wpoint_set_wpoint( wr, &R, ec );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Для заданных точек \f$ P, Q \f$ и целых чисел \f$ k_1, k_2 \f$ функция вычисляет точку
+    \f$ R = [k_1]P + [k_2]Q \f$, выполняя одну общую последовательность удвоений
+    вместо двух независимых вызовов функции ak_wpoint_pow().
+
+    \warning Время работы функции зависит от значений \f$ k_1 \f$ и \f$ k_2 \f$, поэтому
+    функция может применяться только для открытых данных, например, при проверке подписи.
+
+    \b Для \b информации: функция не приводит результирующую точку \f$ R \f$ к аффинной форме;
+    точка \f$ R \f$ может совпадать с \f$ P \f$ или \f$ Q \f$.
+
+    @param wr Точка \f$ R \f$, в которую помещается результат.
+    @param wp Точка \f$ P \f$.
+    @param k1 Степень кратности точки \f$ P \f$.
+    @param wq Точка \f$ Q \f$.
+    @param k2 Степень кратности точки \f$ Q \f$.
+    @param size Размер степеней в машинных словах; значение не должно превышать
+    размера параметров кривой.
+    @param ec Эллиптическая кривая, на которой происходят вычисления                               */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_wpoint_pow2( ak_wpoint wr, ak_wpoint wp, ak_uint64 *k1,
+                                            ak_wpoint wq, ak_uint64 *k2, size_t size, ak_wcurve ec )
+{
+  struct wpoint ptable[ak_wpoint_wnaf_points], qtable[ak_wpoint_wnaf_points];
+
+  ak_wpoint_set_odd_multiples( ptable, wp, ec );
+  ak_wpoint_set_odd_multiples( qtable, wq, ec );
+  ak_wpoint_pow2_tables( wr, ptable, k1, qtable, k2, size, ec );
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! Для заданной точки \f$ P = (x:y:z) \f$ функция проверяет
     что порядок точки действительно есть величина \f$ q \f$, заданная в параметрах
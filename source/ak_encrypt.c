@@ -8,6 +8,9 @@
  #ifdef AK_HAVE_UNISTD_H
   #include <unistd.h>
  #endif
+ #ifdef AK_HAVE_PTHREAD_H
+  #include <pthread.h>
+ #endif
 
 /* ----------------------------------------------------------------------------------------------- */
 /*                                 процедуры зашифрования информации                               */
@@ -31,14 +34,185 @@
                                                     const char *password, const size_t pass_size );
 
  static int ak_encrypt_assign_encryption_keys( ak_aead ctx,
-                               ak_encryption_set set, ak_pointer scheme_key, ak_random generator,
+                       ak_encryption_set set, ak_pointer scheme_key, ak_wpoint wpoint, ak_wpoint upoint,
                                   ak_uint8 *salt, size_t salt_size, ak_uint8 *iv, size_t iv_size,
                                  ak_uint8 *vect, size_t vect_size, ak_uint8 *buffer, size_t head );
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Фрагмент данных, зашифровываемый (расшифровываемый) независимо от остальных фрагментов.
+
+    Ключи шифрования фрагментов образуют последовательную цепочку (ключевая информация
+    очередного фрагмента зависит от ключа доступа к контейнеру, выработанного после предыдущего
+    фрагмента), однако наиболее трудоемкие операции - вычисление кратных точек эллиптической
+    кривой и зашифрование данных - от этой цепочки не зависят и выполняются параллельно.        */
+/* ----------------------------------------------------------------------------------------------- */
+ typedef struct encrypt_fragment {
+  /*! \brief Контекст алгоритма аутентифицированного шифрования фрагмента. */
+   struct aead ctx;
+  /*! \brief Эллиптическая кривая, на которой вычисляются кратные точки. */
+   ak_wcurve wc;
+  /*! \brief Открытый ключ получателя. */
+   ak_wpoint qpoint;
+  /*! \brief Эфемерный секретный ключ фрагмента. */
+   ak_mpznmax xi;
+  /*! \brief Точка, используемая для выработки ключевой информации. */
+   struct wpoint wpoint;
+  /*! \brief Точка, помещаемая в заголовок фрагмента. */
+   struct wpoint upoint;
+  /*! \brief Синхропосылка для зашифрования фрагмента. */
+   ak_uint8 iv[16];
+  /*! \brief Гамма, накладываемая на имитовставку фрагмента. */
+   ak_uint8 mask[16];
+  /*! \brief Ожидаемое значение имитовставки (используется при расшифровании). */
+   ak_uint8 tag[16];
+  /*! \brief Входной файл. */
+   ak_file ifp;
+  /*! \brief Выходной файл. */
+   ak_file ofp;
+  /*! \brief Смещение фрагмента во входном файле. */
+   ak_int64 inoff;
+  /*! \brief Смещение зашифрованных данных фрагмента в выходном файле. */
+   ak_int64 outoff;
+  /*! \brief Длина фрагмента (в октетах). */
+   ak_int64 length;
+  /*! \brief Буффер для считывания и зашифрования данных фрагмента. */
+   ak_uint8 *buffer;
+  /*! \brief Размер буффера (в октетах). */
+   size_t bufsize;
+  /*! \brief Код ошибки, возникшей при обработке фрагмента. */
+   int error;
+#ifdef AK_HAVE_PTHREAD_H
+  /*! \brief Поток, обрабатывающий фрагмент. */
+   pthread_t thread;
+  /*! \brief Флаг того, что поток был успешно запущен. */
+   bool_t started;
+#endif
+} *ak_encrypt_fragment;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Выработка эфемерного секретного ключа фрагмента. */
+ static int ak_encrypt_fragment_set_random( ak_encrypt_fragment frag,
+                                    ak_encryption_set set, ak_pointer scheme_key, ak_random generator )
+{
+  ak_ecies_scheme ecs = (ak_ecies_scheme) scheme_key;
+
+  switch( set->scheme ) {
+    case ecies_scheme:
+      frag->wc = ecs->recipient.vkey.wc;
+      frag->qpoint = &ecs->recipient.vkey.qpoint;
+     return ak_mpzn_set_random_modulo( frag->xi, frag->wc->q, frag->wc->size, generator );
+
+    default:
+     return ak_error_message( ak_error_encrypt_scheme, __func__,
+                                                           "using unsupported encryption scheme" );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление кратных точек, используемых для выработки ключей фрагмента
+    (функция может выполняться в отдельном потоке). */
+ static void *ak_encrypt_fragment_points_task( void *ptr )
+{
+  ak_encrypt_fragment frag = ( ak_encrypt_fragment )ptr;
+
+  ak_wpoint_set_as_unit( &frag->wpoint, frag->wc );
+  ak_wpoint_pow( &frag->wpoint, frag->qpoint, frag->xi, frag->wc->size, frag->wc );
+  ak_wpoint_reduce( &frag->wpoint, frag->wc );
+
+  ak_wpoint_set_as_unit( &frag->upoint, frag->wc );
+  ak_wpoint_pow_base( &frag->upoint, frag->xi, frag->wc->size, frag->wc );
+  ak_wpoint_reduce( &frag->upoint, frag->wc );
+ return NULL;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Зашифрование данных фрагмента и запись их в выходной файл по заданному смещению
+    (функция может выполняться в отдельном потоке). */
+ static void *ak_encrypt_fragment_data_task( void *ptr )
+{
+  ssize_t val = 0;
+  ak_int64 offset = 0;
+  ak_uint8 im[16], *buffer = NULL;
+  ak_encrypt_fragment frag = ( ak_encrypt_fragment )ptr;
+  size_t i, tsize = ak_min( 16, frag->ctx.tag_size );
+
+  if(( frag->error = ak_aead_clean( &frag->ctx, frag->iv, tsize )) != ak_error_ok ) {
+    ak_error_message( frag->error, __func__, "incorrect cleaning of authentication context" );
+    return NULL;
+  }
+  buffer = frag->buffer;
+  for( offset = 0; offset < frag->length; offset += val ) {
+     if(( val = ak_file_read_at( frag->ifp, buffer, ( size_t )ak_min( frag->bufsize,
+                                       frag->length - offset ), frag->inoff + offset )) <= 0 ) {
+       frag->error = ak_error_message( ak_error_undefined_value, __func__,
+                                                             "incorrect loading of input buffer" );
+       break;
+     }
+     if(( frag->error = ak_aead_encrypt_update( &frag->ctx, buffer, buffer, val )) != ak_error_ok ) {
+       ak_error_message( frag->error, __func__, "incorrect update of internal state" );
+       break;
+     }
+     if( ak_file_write_at( frag->ofp, buffer, val, frag->outoff + offset ) != val ) {
+       frag->error = ak_error_message( ak_error_write_data, __func__,
+                                                         "incorrect writing of encrypted data" );
+       break;
+     }
+  }
+  ak_ptr_wipe( buffer, ( size_t )ak_min( ( ak_int64 )frag->bufsize, frag->length ),
+                                          &(( ak_skey )frag->ctx.encryptionKey )->generator );
+  if( frag->error != ak_error_ok ) return NULL;
+
+ /* вычисляем, зашифровываем и сохраняем имитовставку */
+  if(( frag->error = ak_aead_finalize( &frag->ctx, im, tsize )) != ak_error_ok ) {
+    ak_error_message( frag->error, __func__, "incorrect finalize of internal state" );
+    return NULL;
+  }
+  for( i = 0; i < tsize; i++ ) im[i] ^= frag->mask[i];
+  if( ak_file_write_at( frag->ofp, im, tsize, frag->outoff + frag->length ) != ( ssize_t )tsize )
+    frag->error = ak_error_message( ak_error_write_data, __func__,
+                                                        "incorrect writing of authentication code" );
+ return NULL;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Выполнение заданной функции для последовательности фрагментов.
+
+    При сборке с поддержкой pthreads каждый фрагмент, кроме первого, обрабатывается отдельным
+    потоком; первый фрагмент обрабатывается вызывающим потоком. Если поток не удается создать,
+    то фрагмент обрабатывается вызывающим потоком.                                                 */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_encrypt_fragments_run( ak_encrypt_fragment frags,
+                                                   const size_t count, void *(*task)( void * ))
+{
+  size_t i;
+
+#ifdef AK_HAVE_PTHREAD_H
+  for( i = 1; i < count; i++ ) {
+     frags[i].started = ak_false;
+     if( pthread_create( &frags[i].thread, NULL, task, frags+i ) == 0 ) frags[i].started = ak_true;
+      else task( frags+i );
+  }
+  if( count ) task( frags );
+  for( i = 1; i < count; i++ )
+     if( frags[i].started ) pthread_join( frags[i].thread, NULL );
+#else
+  for( i = 0; i < count; i++ ) task( frags+i );
+#endif
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! Для зашифрования данных используется открытый ключ получателя. 
     Для доступа к контейнеру с данными используется пароль.
 
+    Входной файл делится на фрагменты, которые обрабатываются группами. Для каждой группы
+    последовательно (в том же порядке, что и при однопоточной обработке) вырабатываются длины
+    фрагментов и эфемерные ключи, после чего кратные точки эллиптической кривой вычисляются
+    параллельно. Затем последовательно вырабатывается цепочка ключей фрагментов и ключей доступа
+    к контейнеру, а данные фрагментов зашифровываются параллельно и записываются в выходной файл
+    по заранее вычисленным смещениям. Формат контейнера от количества потоков не зависит.
+    Максимальное количество потоков задается опцией `encrypt_file_threads`
+    (значение 1 означает последовательную обработку).
+
     @return В случае успеха функция возвращает ak_error_ok (ноль). В противном случае
     возвращается код ошибки.                                                                       */
 /* ----------------------------------------------------------------------------------------------- */
@@ -46,14 +220,14 @@
                  ak_pointer scheme_key, char *outfile, const size_t outsize, ak_random generator,
                                                     const char *password, const size_t pass_size )
 {
-  struct aead ctx;
   struct bckey kcont;
   struct file ifp, ofp;
   ak_uint8 buffer[4096];
   int error = ak_error_ok;
-  ak_uint8 salt[32], iv[16], vect[32], im[16];
-  size_t len = sizeof( buffer ), head = 0;
-  ak_int64 total = 0, maxlen = 0, value = 0, sum = 0;
+  ak_uint8 salt[32], iv[16], vect[32];
+  ak_encrypt_fragment frags = NULL, frag = NULL;
+  size_t len = sizeof( buffer ), head = 0, tsize = 0, window = 1, created = 0, count = 0, i;
+  ak_int64 total = 0, maxlen = 0, value = 0, sum = 0, inoff = 0, outoff = 0;
 
   /* выполняем многочисленные начальные проверки */
    if( filename == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
@@ -123,12 +297,35 @@
    }
    memcpy( buffer, salt, 14 );
    ak_file_write( &ofp, buffer, len );
-
-  /* создаем ключи шифрования и имитозащиты данных */
-   if(( error = ak_aead_create_oid( &ctx, ak_true, set->mode )) != ak_error_ok ) {
-     ak_error_message( error, __func__, "incorrect intialization of internal aead context" );
+   outoff = len;
+
+  /* создаем контексты фрагментов, обрабатываемых одновременно,
+     а также ключи шифрования и имитозащиты данных */
+   window = ak_min(( size_t )ak_libakrypt_get_option_by_index( encrypt_file_threads_option ),
+                                                                          ak_bckey_max_threads );
+   if( window < 1 ) window = 1;
+   if(( frags = calloc( window, sizeof( struct encrypt_fragment ))) == NULL ) {
+     ak_error_message( error = ak_error_out_of_memory, __func__,
+                                                  "incorrect memory allocation for fragments" );
      goto lab_exit2;
    }
+   for( created = 0; created < window; created++ ) {
+      if(( error = ak_aead_create_oid( &frags[created].ctx, ak_true, set->mode )) != ak_error_ok ) {
+        ak_error_message( error, __func__, "incorrect intialization of internal aead context" );
+        goto lab_exit3;
+      }
+      frags[created].ifp = &ifp;
+      frags[created].ofp = &ofp;
+      frags[created].bufsize =
+                        ( size_t )ak_libakrypt_get_option_by_index( file_buffer_size_option );
+      if(( frags[created].buffer = ak_aligned_malloc( frags[created].bufsize )) == NULL ) {
+        ak_aead_destroy( &frags[created].ctx );
+        ak_error_message( error = ak_error_out_of_memory, __func__,
+                                                 "incorrect memory allocation for fragment buffer" );
+        goto lab_exit3;
+      }
+   }
+   tsize = ak_min( 16, frags[0].ctx.tag_size );
 
   /* выполняем фрагментацию входного файла на фрагменты длины
      от 4096 байт до maxlen, где maxlen определяется
@@ -136,8 +333,8 @@
    total = ifp.size;
    if(( value = set->fraction.value ) == 0 ) value = 10; /* количество фрагментов по-умолчанию */
    if( strstr( set->mode->name[0], "kuznechik" ) != NULL )
-     maxlen = 16*ak_libakrypt_get_option_by_name( "kuznechik_cipher_resource" );
-    else maxlen = 8*ak_libakrypt_get_option_by_name( "magma_cipher_resource" );
+     maxlen = 16*ak_libakrypt_get_option_by_index( kuznechik_cipher_resource_option );
+    else maxlen = 8*ak_libakrypt_get_option_by_index( magma_cipher_resource_option );
 
    if( set->fraction.mechanism == count_fraction ) {
      maxlen = ak_max( 4096, ak_min( total/value, maxlen ));
@@ -148,93 +345,104 @@
 
   /* основной цикл разбиения входных данных */
    while( total > 0 ) {
-     ak_int64 current = maxlen, val = 0, crt = 0;
-     if( set->fraction.mechanism == random_size_fraction ) {
-       ak_random_ptr( generator, &current, 4 ); /* нам хватит 4х октетов */
-       current %= ifp.size;
-       if( current > maxlen ) current = maxlen; /* не очень большая */
-       current = ak_max( 4096, current );     /* не очень маленькая */
-     }
-     current = ak_min( current, total );
-     if(((total - current) > 0 ) && ((total - current) < 4096 )) current = total;
-
-    /* теперь мы можем зашифровать фрагмент входных данных,
-       длина которого определена значением current.
-       начинаем с того, что вырабатываем ключи и заголовок фрагмента */
-     memset( buffer, 0, sizeof( buffer ));
-     if(( error = ak_encrypt_assign_encryption_keys( &ctx, set, scheme_key,
-                      generator, vect, 32, iv, 16, salt, 32, buffer, head )) != ak_error_ok ) {
-        ak_error_message( error, __func__, "incorrect creation of input data encryption keys" );
-        break;
-     }
 
-    /* добавляем в буффер значение current, зашифровываем его и сохраняем в файл (head = len + 8) */
-     buffer[head -8] = ( current >> 56 )&0xFF;
-     buffer[head -7] = ( current >> 48 )&0xFF;
-     buffer[head -6] = ( current >> 40 )&0xFF;
-     buffer[head -5] = ( current >> 32 )&0xFF;
-     buffer[head -4] = ( current >> 24 )&0xFF;
-     buffer[head -3] = ( current >> 16 )&0xFF;
-     buffer[head -2] = ( current >>  8 )&0xFF;
-     buffer[head -1] = current&0xFF;
-
-     ak_bckey_ctr( &kcont, buffer, buffer, head, NULL, 0 );
-     ak_file_write( &ofp, buffer, head );
-
-    /* только теперь шифруем входящие даные */
-     if(( error = ak_aead_clean( &ctx, iv, ak_min( 16, ctx.tag_size ))) != ak_error_ok ) {
-       ak_error_message( error, __func__, "incorrect cleaning of authentication context" );
-       break;
+    /* 1. определяем длины очередной группы фрагментов и вырабатываем эфемерные ключи */
+     for( count = 0; ( count < window ) && ( total > 0 ); count++ ) {
+        ak_int64 current = maxlen;
+        if( set->fraction.mechanism == random_size_fraction ) {
+          ak_random_ptr( generator, &current, 4 ); /* нам хватит 4х октетов */
+          current %= ifp.size;
+          if( current > maxlen ) current = maxlen; /* не очень большая */
+          current = ak_max( 4096, current );     /* не очень маленькая */
+        }
+        current = ak_min( current, total );
+        if(((total - current) > 0 ) && ((total - current) < 4096 )) current = total;
+
+        frag = frags + count;
+        frag->inoff = inoff;
+        frag->outoff = outoff + head;
+        frag->length = current;
+        frag->error = ak_error_ok;
+        if(( error = ak_encrypt_fragment_set_random( frag,
+                                                  set, scheme_key, generator )) != ak_error_ok ) {
+          ak_error_message( error, __func__, "incorrect generation of ephemeral key" );
+          goto lab_exit3;
+        }
+        inoff += current;
+        outoff += head + current + tsize;
+        total -= current;
      }
 
-     crt = current;
-     while( crt > 0 ) {
-       if(( val = ak_file_read( &ifp, buffer, ak_min( sizeof( buffer ), crt ))) == 0 ) {
-         error = ak_error_message( ak_error_undefined_value, __func__,
-                                                             "incorrect loading of input buffer" );
-         break;
-       }
-       if(( error = ak_aead_encrypt_update( &ctx, buffer, buffer, val )) != ak_error_ok ) {
-         ak_error_message( error, __func__, "incorrect update of internal state" );
-         break;
-       }
-       ak_file_write( &ofp, buffer, val );
-       crt -= val;
-     }
-    /* проверяем, что цикл завершен успешно */
-     if( error != ak_error_ok ) break;
-     if(( error = ak_aead_finalize( &ctx, im, ak_min( 16, ctx.tag_size ))) != ak_error_ok ) {
-       ak_error_message( error, __func__, "incorrect finalize of internal state" );
-       break;
-     }
+    /* 2. вычисляем кратные точки для всех фрагментов группы */
+     ak_encrypt_fragments_run( frags, count, ak_encrypt_fragment_points_task );
+
+    /* 3. вырабатываем ключи и заголовки фрагментов, а также ключи доступа к контейнеру */
+     for( i = 0; i < count; i++ ) {
+        frag = frags + i;
+        memset( buffer, 0, sizeof( buffer ));
+        if(( error = ak_encrypt_assign_encryption_keys( &frag->ctx, set, scheme_key,
+                                           &frag->wpoint, &frag->upoint, vect, 32, frag->iv, 16,
+                                                          salt, 32, buffer, head )) != ak_error_ok ) {
+          ak_error_message( error, __func__, "incorrect creation of input data encryption keys" );
+          goto lab_exit3;
+        }
+
+       /* добавляем в буффер значение длины фрагмента,
+          зашифровываем его и сохраняем в файл (head = len + 8) */
+        buffer[head -8] = ( frag->length >> 56 )&0xFF;
+        buffer[head -7] = ( frag->length >> 48 )&0xFF;
+        buffer[head -6] = ( frag->length >> 40 )&0xFF;
+        buffer[head -5] = ( frag->length >> 32 )&0xFF;
+        buffer[head -4] = ( frag->length >> 24 )&0xFF;
+        buffer[head -3] = ( frag->length >> 16 )&0xFF;
+        buffer[head -2] = ( frag->length >>  8 )&0xFF;
+        buffer[head -1] = frag->length&0xFF;
+
+        ak_bckey_ctr( &kcont, buffer, buffer, head, NULL, 0 );
+        if( ak_file_write_at( &ofp, buffer, head, frag->outoff - head ) != ( ssize_t )head ) {
+          ak_error_message( error = ak_error_write_data, __func__,
+                                                          "incorrect writing of fragment's header" );
+          goto lab_exit3;
+        }
 
-    /* вырабатываем новое значение ключа для доступа к контейнеру */
-     if(( error = ak_encrypt_assign_container_key( &kcont,
+       /* вырабатываем новое значение ключа для доступа к контейнеру
+          и гамму для зашифрования имитовставки */
+        if(( error = ak_encrypt_assign_container_key( &kcont,
                               salt, 32, iv, 8, vect, 32, password, pass_size )) != ak_error_ok ) {
-       ak_error_message( error, __func__, "incorrect assign value of container's secret key" );
-       break;
+          ak_error_message( error, __func__, "incorrect assign value of container's secret key" );
+          goto lab_exit3;
+        }
+        memset( frag->mask, 0, sizeof( frag->mask ));
+        ak_bckey_ctr( &kcont, frag->mask, frag->mask, tsize, iv, 8 );
      }
 
-    /* зашифровываем и сохраняем имитоставку */
-     ak_bckey_ctr( &kcont, im, im, ak_min( 16, ctx.tag_size ), iv, 8 );
-     ak_file_write( &ofp, im, ak_min( 16, ctx.tag_size ) );
-
-    /* уточняем оставшуюся длину входных данных */
-     total -= current;
-     sum += current;
+    /* 4. зашифровываем данные фрагментов группы */
+     ak_encrypt_fragments_run( frags, count, ak_encrypt_fragment_data_task );
+     for( i = 0; i < count; i++ ) {
+        if( frags[i].error != ak_error_ok ) {
+          ak_error_message( error = frags[i].error, __func__, "incorrect encryption of fragment" );
+          goto lab_exit3;
+        }
+        sum += frags[i].length;
+     }
    }
    if( sum != ifp.size ) ak_error_message( error = ak_error_wrong_length, __func__,
                          "the length of encrypted data is not equal to the length of plain data" );
 
   /* очищием файловые дескрипторы, ключевые контексты, промежуточные данные и выходим */
-   ak_aead_destroy( &ctx );
+  lab_exit3:
+   for( i = 0; i < created; i++ ) {
+      ak_aead_destroy( &frags[i].ctx );
+      ak_aligned_free( frags[i].buffer );
+   }
+   ak_ptr_wipe( frags, window*sizeof( struct encrypt_fragment ), &kcont.key.generator );
+   free( frags );
 
   lab_exit2:
    ak_file_close( &ofp );
    ak_file_close( &ifp );
 
   lab_exit:
-   ak_ptr_wipe( &ctx, sizeof( struct aead ), &kcont.key.generator );
    ak_ptr_wipe( salt, sizeof( salt ), &kcont.key.generator );
    ak_ptr_wipe( iv, sizeof( iv ), &kcont.key.generator );
    ak_ptr_wipe( vect, sizeof( vect ), &kcont.key.generator );
@@ -408,13 +616,11 @@
 
 /* ----------------------------------------------------------------------------------------------- */
  static int ak_encrypt_assign_encryption_keys( ak_aead ctx,
-                               ak_encryption_set set, ak_pointer scheme_key, ak_random generator,
+                       ak_encryption_set set, ak_pointer scheme_key, ak_wpoint wpoint, ak_wpoint upoint,
                                   ak_uint8 *salt, size_t salt_size, ak_uint8 *iv, size_t iv_size,
                                  ak_uint8 *vect, size_t vect_size, ak_uint8 *buffer, size_t head )
 {
-  ak_mpznmax xi;
   size_t cnt = 0;
-  struct wpoint U, W;
   ak_wcurve wc = NULL;
   struct kdf_state state;
   int error = ak_error_ok;
@@ -430,14 +636,9 @@
                                                        "using unexpected length of chunk header" );
          break;
        }
-      /* вырабатываем случайное число */
-       ak_mpzn_set_random_modulo( xi, wc->q, wc->size, generator );
-      /* вырабатываем точку W, которая будет использована для генерации ключевой информации */
-       ak_wpoint_set_as_unit( &W, wc );
-       ak_wpoint_pow( &W, &ecs->recipient.vkey.qpoint, xi, wc->size, wc );
-       ak_wpoint_reduce( &W, wc );
-       ak_mpzn_to_little_endian( W.x, wc->size, buffer, cnt, ak_true );
-       ak_mpzn_to_little_endian( W.y, wc->size, buffer + cnt, cnt, ak_true );
+      /* точка W, вычисленная заранее, используется для генерации ключевой информации */
+       ak_mpzn_to_little_endian( wpoint->x, wc->size, buffer, cnt, ak_true );
+       ak_mpzn_to_little_endian( wpoint->y, wc->size, buffer + cnt, cnt, ak_true );
 
       /* вырабатываем необходимую производную информацию */
        if(( error = ak_kdf_state_create( &state, buffer, 2*cnt,
@@ -466,12 +667,9 @@
          ak_error_message( error, __func__, "incorrect assigning of secret keys" );
          break;
        }
-      /* вырабатываем точку U, которая будет помещена в buffer */
-       ak_wpoint_set_as_unit( &U, wc );
-       ak_wpoint_pow( &U, &wc->point, xi, wc->size, wc );
-       ak_wpoint_reduce( &U, wc );
-       ak_mpzn_to_little_endian( U.x, wc->size, buffer, cnt, ak_true );
-       ak_mpzn_to_little_endian( U.y, wc->size, buffer +cnt, cnt, ak_true );
+      /* точка U, вычисленная заранее, помещается в buffer */
+       ak_mpzn_to_little_endian( upoint->x, wc->size, buffer, cnt, ak_true );
+       ak_mpzn_to_little_endian( upoint->y, wc->size, buffer +cnt, cnt, ak_true );
       break;
 
     default:
@@ -489,6 +687,54 @@
   scheme_t scheme, ak_signkey key, ak_uint8 *salt, size_t salt_size, ak_uint8 *iv, size_t iv_size,
                                  ak_uint8 *vect, size_t vect_size, ak_uint8 *buffer, size_t head );
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Расшифрование данных фрагмента, запись их в выходной файл по заданному смещению
+    и проверка имитовставки (функция может выполняться в отдельном потоке). */
+ static void *ak_decrypt_fragment_data_task( void *ptr )
+{
+  ssize_t val = 0;
+  ak_int64 offset = 0;
+  ak_uint8 im[16], *buffer = NULL;
+  ak_encrypt_fragment frag = ( ak_encrypt_fragment )ptr;
+  size_t tsize = ak_min( 16, frag->ctx.tag_size );
+
+  if(( frag->error = ak_aead_clean( &frag->ctx, frag->iv, tsize )) != ak_error_ok ) {
+    ak_error_message( frag->error, __func__, "incorrect cleaning of aead context" );
+    return NULL;
+  }
+  buffer = frag->buffer;
+  for( offset = 0; offset < frag->length; offset += val ) {
+     if(( val = ak_file_read_at( frag->ifp, buffer, ( size_t )ak_min( frag->bufsize,
+                                       frag->length - offset ), frag->inoff + offset )) <= 0 ) {
+       frag->error = ak_error_message( ak_error_undefined_value, __func__,
+                                                             "incorrect loading of input buffer" );
+       break;
+     }
+     if(( frag->error = ak_aead_decrypt_update( &frag->ctx, buffer, buffer, val )) != ak_error_ok ) {
+       ak_error_message( frag->error, __func__, "incorrect update of internal state" );
+       break;
+     }
+     if( ak_file_write_at( frag->ofp, buffer, val, frag->outoff + offset ) != val ) {
+       frag->error = ak_error_message( ak_error_write_data, __func__,
+                                                           "incorrect writing of decrypted data" );
+       break;
+     }
+  }
+  ak_ptr_wipe( buffer, ( size_t )ak_min( ( ak_int64 )frag->bufsize, frag->length ),
+                                          &(( ak_skey )frag->ctx.encryptionKey )->generator );
+  if( frag->error != ak_error_ok ) return NULL;
+
+ /* вычисляем и проверяем имитовставку */
+  if(( frag->error = ak_aead_finalize( &frag->ctx, im, tsize )) != ak_error_ok ) {
+    ak_error_message( frag->error, __func__, "incorrect finalize of internal state" );
+    return NULL;
+  }
+  if( memcmp( im, frag->tag, tsize ) != 0 )
+    frag->error = ak_error_message( ak_error_not_equal_data, __func__,
+                                               "incorrect authentiction code for decrypted data" );
+ return NULL;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*!
   \param filename Имя расшифровываемого файла
@@ -504,6 +750,12 @@
   Если значение `outfile_size` отлично от нуля, то оно задает размер области памяти,
   в которую помещается считываемое из контенера имя файла.
 
+  Заголовки фрагментов, ключи шифрования и ключи доступа к контейнеру образуют последовательную
+  цепочку и вырабатываются последовательно для группы фрагментов, количество которых
+  определяется опцией `encrypt_file_threads`. После этого
+  данные фрагментов группы расшифровываются параллельно и записываются в выходной файл
+  по заранее вычисленным смещениям.
+
   \return  В случае успеха возвращается ноль (ak_error_ok). В противном случае,
    возвращается код ошибки.                                                                        */
 /* ----------------------------------------------------------------------------------------------- */
@@ -512,7 +764,6 @@
 {
   size_t len;
   scheme_t scheme;
-  struct aead ctx;
   ak_asn1 asn, seq;
   ak_uint32 head = 0;
   struct bckey kcont;
@@ -522,7 +773,10 @@
   int error = ak_error_ok;
   ak_pointer ptr, skey = NULL;
   ak_oid mode = NULL, params = NULL;
-  ak_uint8 salt[32], iv[16], vect[32], im[16];
+  ak_uint8 salt[32], iv[16], vect[32];
+  ak_encrypt_fragment frags = NULL, frag = NULL;
+  size_t tsize = 0, window = 1, created = 0, count = 0, i;
+  ak_int64 inoff = 0, outoff = 0;
 
   /* проверяем корректность аргументов функции */
    if( filename == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
@@ -547,8 +801,10 @@
                                                         "wrong reading the first part of header" );
      goto lab_exit;
    }
-   if(( error = ak_bckey_create_kuznechik( &kcont )) != ak_error_ok )
-     return ak_error_message( error, __func__, "incorrect creation of container's secret key" );
+   if(( error = ak_bckey_create_kuznechik( &kcont )) != ak_error_ok ) {
+     ak_error_message( error, __func__, "incorrect creation of container's secret key" );
+     goto lab_exit;
+   }
 
    if(( error = ak_encrypt_assign_container_key( &kcont, /* устанавливаем первичное значение ключа */
                               salt, 14, iv, 8, vect, 32, password, pass_size )) != ak_error_ok ) {
@@ -565,7 +821,11 @@
      ak_error_message( error = ak_error_wrong_length, __func__, "incorrect length of the header" );
      goto lab_exit2;
    }
-   ak_file_read( &ifp, buffer, len );
+   if( ak_file_read( &ifp, buffer, len ) != ( ssize_t )len ) {
+     ak_error_message( error = ak_error_read_data, __func__,
+                                                       "wrong reading the second part of header" );
+     goto lab_exit2;
+   }
    if(( error = ak_bckey_ctr( &kcont, buffer, buffer, len, NULL, 0 )) != ak_error_ok ) {
      ak_error_message( error, __func__, "incorrect decryption of the second part of the header" );
      goto lab_exit2;
@@ -579,7 +839,8 @@
    ak_asn1_first( asn );
    if(( DATA_STRUCTURE( asn->current->tag ) != CONSTRUCTED ) ||
         ( TAG_NUMBER( asn->current->tag ) != TSEQUENCE )) {
-     ak_error_message( error, __func__, "header has not a main sequence" );
+     ak_error_message( error = ak_error_invalid_asn1_tag, __func__,
+                                                                "header has not a main sequence" );
      goto lab_exit3;
    }
 
@@ -587,7 +848,8 @@
    ak_asn1_first( seq = asn->current->data.constructed );
    ak_tlv_get_uint32( seq->current, &scheme );
    if( !ak_encrypt_file_is_scheme_valid( scheme )) {
-     ak_error_message( error, __func__, "encrypted file use an unsupported encryption scheme" );
+     ak_error_message( error = ak_error_encrypt_scheme, __func__,
+                                             "encrypted file use an unsupported encryption scheme" );
      goto lab_exit3;
    }
   /* b. считываем секретный ключ для расшифрования */
@@ -620,6 +882,11 @@
      ak_error_message( error, __func__, "wrong reading of local header length" );
      goto lab_exit3;
    }
+   if(( head < 8 ) || ( head > sizeof( buffer ))) {
+     ak_error_message( error = ak_error_wrong_length, __func__,
+                                                          "unexpected length of local header" );
+     goto lab_exit3;
+   }
 
   /* открываем файл для записи расшифрованных данных */
    if(( error = ak_file_create_to_write( &ofp, outfile )) != ak_error_ok ) {
@@ -627,102 +894,125 @@
      goto lab_exit3;
    }
 
-  /* начинаем основной цикл опробования фрагментов шифрованного файла */
-   total = ifp.size -16 -len;
-  /* создаем ключи шифрования и имитозащиты данных */
-   if(( error = ak_aead_create_oid( &ctx, ak_true, mode )) != ak_error_ok ) {
-     ak_error_message( error, __func__, "incorrect intialization of secret keys" );
+  /* создаем контексты фрагментов, обрабатываемых одновременно,
+     а также ключи шифрования и имитозащиты данных */
+   window = ak_min(( size_t )ak_libakrypt_get_option_by_index( encrypt_file_threads_option ),
+                                                                          ak_bckey_max_threads );
+   if( window < 1 ) window = 1;
+   if(( frags = calloc( window, sizeof( struct encrypt_fragment ))) == NULL ) {
+     ak_error_message( error = ak_error_out_of_memory, __func__,
+                                                  "incorrect memory allocation for fragments" );
      goto lab_exit4;
    }
+   for( created = 0; created < window; created++ ) {
+      if(( error = ak_aead_create_oid( &frags[created].ctx, ak_true, mode )) != ak_error_ok ) {
+        ak_error_message( error, __func__, "incorrect intialization of secret keys" );
+        goto lab_exit4;
+      }
+      frags[created].ifp = &ifp;
+      frags[created].ofp = &ofp;
+      frags[created].bufsize =
+                        ( size_t )ak_libakrypt_get_option_by_index( file_buffer_size_option );
+      if(( frags[created].buffer = ak_aligned_malloc( frags[created].bufsize )) == NULL ) {
+        ak_aead_destroy( &frags[created].ctx );
+        ak_error_message( error = ak_error_out_of_memory, __func__,
+                                                 "incorrect memory allocation for fragment buffer" );
+        goto lab_exit4;
+      }
+   }
+   tsize = ak_min( 16, frags[0].ctx.tag_size );
 
+  /* начинаем основной цикл опробования фрагментов шифрованного файла */
+   inoff = 16 + len;
+   total = ifp.size -16 -len;
    while( total > 0 ) {
-    ak_uint64 crt, val, current = 0;
-   /* 1. получаем значения из локального заголовка (заголовка фрагмента) */
-    if( total < head ) { /* проверяем, что данных достаточно */
-      ak_error_message( ak_error_wrong_length, __func__, "unexpected length of encrypted file" );
-      goto lab_exit4;
-    }
-    if( ak_file_read( &ifp, buffer, head ) != head ) {
-      ak_error_message( ak_error_access_file, __func__, "wrong reading of fragment's header" );
-      goto lab_exit4;
-    }
-    ak_bckey_ctr( &kcont, buffer, buffer, head, NULL, 0 );
-    current =  buffer[head -1];
-    current += ((ak_uint64)(buffer[head -2]) << 8 );
-    current += ((ak_uint64)(buffer[head -3]) << 16 );
-    current += ((ak_uint64)(buffer[head -4]) << 24 );
-    current += ((ak_uint64)(buffer[head -5]) << 32 );
-    current += ((ak_uint64)(buffer[head -6]) << 40 );
-    current += ((ak_uint64)(buffer[head -7]) << 48 );
-    current += ((ak_uint64)(buffer[head -8]) << 56 );
-
-    if( current > ( total -head -ak_min( 16, ctx.tag_size ))) {
-      ak_error_message( ak_error_wrong_length, __func__, "wrong reading of fragment's length" );
-      goto lab_exit4;
-    }
-
-   /* 2. вырабатываем производные ключи шифрования и имитозащиты */
-    if(( error = ak_decrypt_assign_encryption_keys( &ctx, mode, scheme, skey,
-                      vect, 32, iv, 16, salt, 32, buffer, head )) != ak_error_ok ) {
-      ak_error_message( error, __func__, "incorrect creation of input data encryption keys" );
-      goto lab_exit4;
-    }
-
-   /* выполняем процедуру расшифрования данных */
-    if(( error = ak_aead_clean( &ctx, iv, ak_min( 16, ctx.tag_size ))) != ak_error_ok ) {
-      ak_error_message( error, __func__, "incorrect cleaning of aead context" );
-      break;
-    }
 
-    crt = current;
-    while( crt > 0 ) {
-       if(( val = ak_file_read( &ifp, buffer, ak_min( sizeof( buffer ), crt ))) == 0 ) {
-         error = ak_error_message( ak_error_undefined_value, __func__,
-                                                             "incorrect loading of input buffer" );
-         break;
-       }
-       if(( error = ak_aead_decrypt_update( &ctx, buffer, buffer, val )) != ak_error_ok ) {
-         ak_error_message( error, __func__, "incorrect update of internal state" );
-         break;
-       }
-       ak_file_write( &ofp, buffer, val );
-       crt -= val;
-    }
-
-   /* проверяем, что цикл завершен успешно */
-    if( error != ak_error_ok ) break;
-    if(( error = ak_aead_finalize( &ctx, im, ak_min( 16, ctx.tag_size ))) != ak_error_ok ) {
-      ak_error_message( error, __func__, "incorrect finalize of internal state" );
-      break;
-    }
+    /* 1. последовательно разбираем заголовки очередной группы фрагментов,
+          вырабатываем ключи фрагментов и ключи доступа к контейнеру */
+     for( count = 0; ( count < window ) && ( total > 0 ); count++ ) {
+        ak_uint64 current = 0;
 
-   /* изменяем ключ контейнера и разбираемся с имитоставкой */
-    if(( error = ak_encrypt_assign_container_key( &kcont,
-                              salt, 32, iv, 8, vect, 32, password, pass_size )) != ak_error_ok ) {
-      ak_error_message( error, __func__, "incorrect assign value of container's secret key" );
-      break;
-    }
+        frag = frags + count;
+        if( total < head + tsize ) { /* проверяем, что данных достаточно */
+          ak_error_message( error = ak_error_wrong_length, __func__,
+                                                             "unexpected length of encrypted file" );
+          goto lab_exit4;
+        }
+        if( ak_file_read_at( &ifp, buffer, head, inoff ) != ( ssize_t )head ) {
+          ak_error_message( error = ak_error_access_file, __func__,
+                                                              "wrong reading of fragment's header" );
+          goto lab_exit4;
+        }
+        ak_bckey_ctr( &kcont, buffer, buffer, head, NULL, 0 );
+        current =  buffer[head -1];
+        current += ((ak_uint64)(buffer[head -2]) << 8 );
+        current += ((ak_uint64)(buffer[head -3]) << 16 );
+        current += ((ak_uint64)(buffer[head -4]) << 24 );
+        current += ((ak_uint64)(buffer[head -5]) << 32 );
+        current += ((ak_uint64)(buffer[head -6]) << 40 );
+        current += ((ak_uint64)(buffer[head -7]) << 48 );
+        current += ((ak_uint64)(buffer[head -8]) << 56 );
+
+        if( current > ( total -head -tsize )) {
+          ak_error_message( error = ak_error_wrong_length, __func__,
+                                                              "wrong reading of fragment's length" );
+          goto lab_exit4;
+        }
 
-    ak_file_read( &ifp, buffer, ak_min( 16, ctx.tag_size ));
-    if(( error = ak_bckey_ctr( &kcont, buffer,
-                                   buffer, ak_min( 16, ctx.tag_size ), iv, 8 )) != ak_error_ok ) {
-      ak_error_message( error, __func__, "data decryption error" );
-      break;
-    }
+       /* вырабатываем производные ключи шифрования и имитозащиты */
+        if(( error = ak_decrypt_assign_encryption_keys( &frag->ctx, mode, scheme, skey,
+                                vect, 32, frag->iv, 16, salt, 32, buffer, head )) != ak_error_ok ) {
+          ak_error_message( error, __func__, "incorrect creation of input data encryption keys" );
+          goto lab_exit4;
+        }
 
-    if( memcmp( im, buffer, ak_min( 16, ctx.tag_size)) != 0 ) {
-      ak_error_message( error = ak_error_not_equal_data, __func__,
-                                               "incorrect authentiction code for decrypted data" );
-      break;
-    }
+       /* изменяем ключ контейнера и расшифровываем имитоставку */
+        if(( error = ak_encrypt_assign_container_key( &kcont,
+                              salt, 32, iv, 8, vect, 32, password, pass_size )) != ak_error_ok ) {
+          ak_error_message( error, __func__, "incorrect assign value of container's secret key" );
+          goto lab_exit4;
+        }
+        if( ak_file_read_at( &ifp, frag->tag, tsize,
+                                         inoff + head + ( ak_int64 )current ) != ( ssize_t )tsize ) {
+          ak_error_message( error = ak_error_access_file, __func__,
+                                                "wrong reading of fragment's authentication code" );
+          goto lab_exit4;
+        }
+        if(( error = ak_bckey_ctr( &kcont, frag->tag, frag->tag, tsize, iv, 8 )) != ak_error_ok ) {
+          ak_error_message( error, __func__, "data decryption error" );
+          goto lab_exit4;
+        }
+
+       /* уточняем размер оставшихся данных и переходим к следующему фрагменту */
+        frag->inoff = inoff + head;
+        frag->outoff = outoff;
+        frag->length = ( ak_int64 )current;
+        frag->error = ak_error_ok;
+        inoff += head + current + tsize;
+        outoff += current;
+        total -= ( current + head + tsize );
+     }
 
-   /* уточняем размер оставшихся данных и переходм к следующему фрагменту */
-    total -= (current + head + ak_min( 16, ctx.tag_size));
+    /* 2. расшифровываем данные фрагментов группы и проверяем имитовставки */
+     ak_encrypt_fragments_run( frags, count, ak_decrypt_fragment_data_task );
+     for( i = 0; i < count; i++ ) {
+        if( frags[i].error != ak_error_ok ) {
+          ak_error_message( error = frags[i].error, __func__, "incorrect decryption of fragment" );
+          goto lab_exit4;
+        }
+     }
    } /* конец while( total > 0) */
 
  /* очищием файловые дескрипторы, ключевые контексты, промежуточные данные и выходим */
   lab_exit4:
-   ak_aead_destroy( &ctx );
+   if( frags != NULL ) {
+     for( i = 0; i < created; i++ ) {
+        ak_aead_destroy( &frags[i].ctx );
+        ak_aligned_free( frags[i].buffer );
+     }
+     ak_ptr_wipe( frags, window*sizeof( struct encrypt_fragment ), &kcont.key.generator );
+     free( frags );
+   }
    ak_file_close( &ofp );
    if( error != ak_error_ok ) {
     #ifdef AK_HAVE_UNISTD_H
@@ -737,6 +1027,10 @@
    if( asn ) ak_asn1_delete( asn );
 
   lab_exit2:
+   ak_ptr_wipe( salt, sizeof( salt ), &kcont.key.generator );
+   ak_ptr_wipe( iv, sizeof( iv ), &kcont.key.generator );
+   ak_ptr_wipe( vect, sizeof( vect ), &kcont.key.generator );
+   ak_ptr_wipe( buffer, sizeof( buffer ), &kcont.key.generator );
    ak_bckey_destroy( &kcont );
 
   lab_exit:
@@ -24,6 +24,9 @@
 #ifdef AK_HAVE_FNMATCH_H
  #include <fnmatch.h>
 #endif
+#ifdef AK_HAVE_PTHREAD_H
+ #include <pthread.h>
+#endif
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! \param filename Имя, для которого проводится проверка
@@ -382,6 +385,70 @@
  #endif
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция считывает данные, начиная с заданного смещения от начала файла. Текущая позиция
+    файла при этом не используется, поэтому функция может одновременно вызываться несколькими
+    потоками для одного и того же файлового дескриптора.
+
+    @param file Дескриптор файла.
+    @param buffer Указатель на область памяти, в которую помещаются данные.
+    @param size Количество считываемых октетов.
+    @param offset Смещение (в октетах) от начала файла.
+    @return Количество считанных октетов. В случае ошибки возвращается -1.                         */
+/* ----------------------------------------------------------------------------------------------- */
+ ssize_t ak_file_read_at( ak_file file, ak_pointer buffer, size_t size, ak_int64 offset )
+{
+ #ifdef AK_HAVE_WINDOWS_H
+  OVERLAPPED ov;
+  DWORD dwBytesReaden = 0;
+
+  memset( &ov, 0, sizeof( OVERLAPPED ));
+  ov.Offset = ( DWORD )( offset&0xFFFFFFFF );
+  ov.OffsetHigh = ( DWORD )( offset >> 32 );
+  if( ReadFile( file->hFile, buffer, ( DWORD )size,  &dwBytesReaden, &ov ) == FALSE ) {
+    ak_error_message( ak_error_read_data, __func__, "unable to read from file");
+    return -1;
+  } else return ( ssize_t ) dwBytesReaden;
+ #else
+  ssize_t rb = pread( file->fd, buffer, size, ( off_t )offset );
+  if( rb == -1 ) ak_error_message_fmt( ak_error_read_data, __func__,
+                                               "unable to read from file (%s)", strerror( errno ));
+  return rb;
+ #endif
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция записывает данные, начиная с заданного смещения от начала файла. Текущая позиция
+    файла при этом не используется, поэтому функция может одновременно вызываться несколькими
+    потоками для одного и того же файлового дескриптора (для непересекающихся областей файла).
+
+    @param file Дескриптор файла.
+    @param buffer Указатель на записываемые данные.
+    @param size Количество записываемых октетов.
+    @param offset Смещение (в октетах) от начала файла.
+    @return Количество записанных октетов. В случае ошибки возвращается -1.                        */
+/* ----------------------------------------------------------------------------------------------- */
+ ssize_t ak_file_write_at( ak_file file, ak_const_pointer buffer, size_t size, ak_int64 offset )
+{
+ #ifdef AK_HAVE_WINDOWS_H
+  OVERLAPPED ov;
+  DWORD dwBytesWritten = 0;
+
+  memset( &ov, 0, sizeof( OVERLAPPED ));
+  ov.Offset = ( DWORD )( offset&0xFFFFFFFF );
+  ov.OffsetHigh = ( DWORD )( offset >> 32 );
+  if( WriteFile( file->hFile, buffer, ( DWORD )size,  &dwBytesWritten, &ov ) == FALSE ) {
+    ak_error_message( ak_error_write_data, __func__, "unable to write to file");
+    return -1;
+  } else return ( ssize_t ) dwBytesWritten;
+ #else
+  ssize_t wb = pwrite( file->fd, buffer, size, ( off_t )offset );
+  if( wb == -1 ) ak_error_message_fmt( ak_error_write_data, __func__,
+                                                "unable to write to file (%s)", strerror( errno ));
+  return wb;
+ #endif
+}
+
 /* ----------------------------------------------------------------------------------------------- */
  ssize_t ak_file_printf( ak_file outfile, const char *format, ... )
 {
@@ -445,6 +512,268 @@
  #endif
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Считывание заданного количества октетов с заданного смещения (с учетом неполного чтения).
+
+    \return Количество считанных октетов. В случае ошибки возвращается -1.                         */
+/* ----------------------------------------------------------------------------------------------- */
+ static ssize_t ak_file_read_full_at( ak_file file, ak_uint8 *buffer, size_t size, ak_int64 offset )
+{
+  ssize_t val = 0;
+  size_t done = 0;
+
+  while( done < size ) {
+    if(( val = ak_file_read_at( file, buffer + done, size - done, offset + done )) < 0 ) return -1;
+    if( val == 0 ) break;
+    done += ( size_t )val;
+  }
+ return ( ssize_t )done;
+}
+
+#ifdef AK_HAVE_PTHREAD_H
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Контекст потока, выполняющего упреждающее считывание фрагментов файла.
+    \details Поток создается один раз для всего файла и считывает очередной фрагмент по запросу,
+    передаваемому функцией ak_file_prefetch_post(); результат считывания забирается функцией
+    ak_file_prefetch_wait(). Доступ к полям запроса защищен мьютексом `mutex`.                  */
+ typedef struct file_prefetch {
+  /*! \brief Дескриптор считываемого файла. */
+   ak_file file;
+  /*! \brief Область памяти, в которую помещаются считанные данные. */
+   ak_uint8 *buffer;
+  /*! \brief Количество считываемых октетов. */
+   size_t size;
+  /*! \brief Смещение фрагмента от начала файла. */
+   ak_int64 offset;
+  /*! \brief Количество реально считанных октетов. */
+   ssize_t result;
+  /*! \brief Флаг наличия запроса, который еще не выполнен потоком. */
+   bool_t request;
+  /*! \brief Флаг завершения работы потока. */
+   bool_t stop;
+  /*! \brief Мьютекс, защищающий поля запроса. */
+   pthread_mutex_t mutex;
+  /*! \brief Условная переменная, сигнализирующая о появлении запроса или его выполнении. */
+   pthread_cond_t cond;
+  /*! \brief Поток, выполняющий считывание. */
+   pthread_t thread;
+ } *ak_file_prefetch;
+
+/* ----------------------------------------------------------------------------------------------- */
+ static void *ak_file_prefetch_task( void *ptr )
+{
+  ssize_t result = 0;
+  ak_file_prefetch pf = ( ak_file_prefetch )ptr;
+
+  pthread_mutex_lock( &pf->mutex );
+  do{
+     while( !pf->request && !pf->stop ) pthread_cond_wait( &pf->cond, &pf->mutex );
+     if( pf->stop ) break;
+     pthread_mutex_unlock( &pf->mutex );
+     result = ak_file_read_full_at( pf->file, pf->buffer, pf->size, pf->offset );
+     pthread_mutex_lock( &pf->mutex );
+     pf->result = result;
+     pf->request = ak_false;
+     pthread_cond_broadcast( &pf->cond );
+  } while( ak_true );
+  pthread_mutex_unlock( &pf->mutex );
+
+ return NULL;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Запуск потока упреждающего считывания.
+    \return Функция возвращает \ref ak_true, если поток создан. В противном случае
+    возвращается \ref ak_false и считывание должно выполняться вызывающим потоком.               */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_file_prefetch_start( ak_file_prefetch pf, ak_file file )
+{
+  pf->file = file;
+  pf->request = pf->stop = ak_false;
+  if( pthread_mutex_init( &pf->mutex, NULL ) != 0 ) return ak_false;
+  if( pthread_cond_init( &pf->cond, NULL ) != 0 ) {
+    pthread_mutex_destroy( &pf->mutex );
+    return ak_false;
+  }
+  if( pthread_create( &pf->thread, NULL, ak_file_prefetch_task, pf ) != 0 ) {
+    pthread_cond_destroy( &pf->cond );
+    pthread_mutex_destroy( &pf->mutex );
+    return ak_false;
+  }
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Передача потоку запроса на считывание фрагмента файла. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_file_prefetch_post( ak_file_prefetch pf,
+                                           ak_uint8 *buffer, const size_t size, ak_int64 offset )
+{
+  pthread_mutex_lock( &pf->mutex );
+  pf->buffer = buffer;
+  pf->size = size;
+  pf->offset = offset;
+  pf->result = -1;
+  pf->request = ak_true;
+  pthread_cond_broadcast( &pf->cond );
+  pthread_mutex_unlock( &pf->mutex );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Ожидание выполнения запроса на считывание фрагмента файла.
+    \return Количество считанных октетов или -1 в случае ошибки чтения.                           */
+/* ----------------------------------------------------------------------------------------------- */
+ static ssize_t ak_file_prefetch_wait( ak_file_prefetch pf )
+{
+  ssize_t result = 0;
+
+  pthread_mutex_lock( &pf->mutex );
+  while( pf->request ) pthread_cond_wait( &pf->cond, &pf->mutex );
+  result = pf->result;
+  pthread_mutex_unlock( &pf->mutex );
+
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Завершение потока упреждающего считывания (после выполнения текущего запроса). */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_file_prefetch_stop( ak_file_prefetch pf )
+{
+  pthread_mutex_lock( &pf->mutex );
+  pf->stop = ak_true;
+  pthread_cond_broadcast( &pf->cond );
+  pthread_mutex_unlock( &pf->mutex );
+  pthread_join( pf->thread, NULL );
+  pthread_cond_destroy( &pf->cond );
+  pthread_mutex_destroy( &pf->mutex );
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция последовательно передает пользовательской функции содержимое файла фрагментами,
+    длина которых определяется значением `bufsize` (округляется вверх до величины, кратной 4096).
+    Длина каждого фрагмента, кроме последнего, равна указанной величине; признак последнего
+    фрагмента передается пользовательской функции третьим аргументом. Для файла нулевой длины
+    пользовательская функция вызывается один раз для фрагмента нулевой длины.
+
+    Если флаг `use_mmap` истиннен и операционная система поддерживает отображение файлов в память,
+    то файл отображается в память целиком (с указанием последовательного характера доступа),
+    и пользовательской функции передаются указатели непосредственно на отображенную память.
+    В противном случае (а также в случае, когда отобразить файл не удалось) данные считываются
+    в два выровненных буффера: при сборке с поддержкой pthreads для файла, состоящего из
+    нескольких фрагментов, создается один поток, который считывает очередной фрагмент
+    одновременно с обработкой предыдущего фрагмента. Если поток создать не удалось,
+    то фрагменты считываются последовательно вызывающим потоком.
+
+    Текущая позиция файла при чтении не используется и не изменяется.
+
+    @param file Дескриптор файла, открытого на чтение.
+    @param bufsize Длина фрагмента (в октетах).
+    @param use_mmap Флаг использования отображения файла в память.
+    @param function Пользовательская функция, обрабатывающая фрагменты файла;
+    ненулевое значение, возвращаемое функцией, прерывает чтение.
+    @param ptr Указатель на данные, передаваемые в пользовательскую функцию.
+    @return В случае успеха возвращается \ref ak_error_ok. В случае возникновения ошибки
+    возвращается ее код.                                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_file_read_by_blocks( ak_file file, const size_t bufsize, const bool_t use_mmap,
+                                                 ak_file_read_blocks_function *function, ak_pointer ptr )
+{
+  size_t len = 0, nlen = 0, block = 0;
+  ak_int64 offset = 0, next = 0;
+  int idx = 0, error = ak_error_ok;
+  ak_uint8 *buffer = NULL;
+  ssize_t result = 0;
+  bool_t last = ak_false;
+ #ifdef AK_HAVE_PTHREAD_H
+  struct file_prefetch pf;
+  bool_t started = ak_false, posted = ak_false;
+ #endif
+
+  if( file == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                             "using null pointer to file context" );
+  if( function == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                          "using null pointer to block function" );
+  if( file->size == 0 ) return function( ( const ak_uint8 * )"", 0, ak_true, ptr );
+
+  block = ak_max( ak_max( bufsize, 4096 ), ( size_t )file->blksize );
+  block = ( block + 4095 )&~( size_t )4095;
+
+ #ifdef AK_HAVE_SYSMMAN_H
+ /* обработка файла, отображенного в память */
+  if( use_mmap && (( ak_uint64 )file->size <= ( ak_uint64 )(( size_t )-1 ))) {
+    if( ak_file_mmap( file, NULL, ( size_t )file->size,
+                                                    PROT_READ, MAP_PRIVATE, 0 ) != MAP_FAILED ) {
+     #ifdef MADV_SEQUENTIAL
+      madvise( file->addr, ( size_t )file->size, MADV_SEQUENTIAL );
+     #endif
+      for( offset = 0; offset < file->size; offset += len ) {
+         len = ( size_t )ak_min( ( ak_int64 )block, file->size - offset );
+         last = (( offset + ( ak_int64 )len ) == file->size );
+         if(( error = function( ( const ak_uint8 * )file->addr + offset,
+                                                              len, last, ptr )) != ak_error_ok ) break;
+      }
+      ak_file_unmap( file );
+      file->addr = NULL;
+      return error;
+    }
+   /* если отобразить файл не удалось, то используем обычное чтение */
+    file->addr = NULL;
+    ak_error_set_value( ak_error_ok );
+  }
+ #else
+  (void)use_mmap;
+ #endif
+
+ /* обработка файла с помощью двух буфферов */
+  if(( buffer = ( ak_uint8 * ) ak_aligned_malloc( block << 1 )) == NULL )
+    return ak_error_message( ak_error_out_of_memory, __func__,
+                                                       "memory allocation error for file buffer" );
+  len = ( size_t )ak_min( ( ak_int64 )block, file->size );
+  if( ak_file_read_full_at( file, buffer, len, 0 ) != ( ssize_t )len ) {
+    ak_aligned_free( buffer );
+    return ak_error_message( ak_error_read_data, __func__, "incorrect reading of file fragment" );
+  }
+ #ifdef AK_HAVE_PTHREAD_H
+  if( file->size > ( ak_int64 )block ) started = ak_file_prefetch_start( &pf, file );
+ #endif
+
+  do{
+     next = offset + ( ak_int64 )len;
+     last = ( next == file->size );
+     nlen = last ? 0 : ( size_t )ak_min( ( ak_int64 )block, file->size - next );
+    #ifdef AK_HAVE_PTHREAD_H
+     posted = ( started && !last );
+     if( posted ) ak_file_prefetch_post( &pf, buffer + ( idx^1 )*block, nlen, next );
+    #endif
+     error = function( buffer + idx*block, len, last, ptr );
+    #ifdef AK_HAVE_PTHREAD_H
+     if( posted ) result = ak_file_prefetch_wait( &pf );
+    #endif
+     if(( error != ak_error_ok ) || last ) break;
+
+    #ifdef AK_HAVE_PTHREAD_H
+     if( !posted )
+    #endif
+     result = ak_file_read_full_at( file, buffer + ( idx^1 )*block, nlen, next );
+     if( result != ( ssize_t )nlen ) {
+       error = ak_error_message( ak_error_read_data, __func__,
+                                                             "incorrect reading of file fragment" );
+       break;
+     }
+     offset = next;
+     len = nlen;
+     idx ^= 1;
+  } while( ak_true );
+
+ #ifdef AK_HAVE_PTHREAD_H
+  if( started ) ak_file_prefetch_stop( &pf );
+ #endif
+  ak_aligned_free( buffer );
+ return error;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! Функция обрабатывает только префикс файла.
     В случае появления внутри строки символов вида .. их обработка не производится.
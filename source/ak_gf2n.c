@@ -5,10 +5,10 @@
 /*  Файл ak_gf2n.c                                                                                 */
 /*  - содержит реализацию функций умножения элементов конечных полей характеристики 2.             */
 /* ----------------------------------------------------------------------------------------------- */
- #include <libakrypt.h>
+ #include <libakrypt-internal.h>
 
 /* ----------------------------------------------------------------------------------------------- */
-#ifdef AK_HAVE_BUILTIN_CLMULEPI64
+#if defined( AK_HAVE_BUILTIN_CLMULEPI64 ) || defined( AK_HAVE_BUILTIN_CLMULEPI64_TARGET )
  #include <wmmintrin.h>
 #endif
 #ifdef _MSC_VER
@@ -787,6 +787,219 @@ void ak_gf512_mul_pcmulqdq( ak_pointer z, ak_pointer a, ak_pointer b )
 
 #endif
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет сумму попарных произведений элементов конечного поля \f$ \mathbb F_{2^{64}}\f$
+    и добавляет ее к значению `z`, т.е. вычисляет \f$ z = z \oplus \sum_{i=0}^{count-1} x_iy_i \f$.
+    Используется последовательное умножение с приведением по модулю после каждого шага алгоритма.
+
+    @param z Указатель на накапливаемую сумму (один элемент поля).
+    @param x Указатель на массив из `count` элементов поля.
+    @param y Указатель на массив из `count` элементов поля.
+    @param count Количество слагаемых.                                                             */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_gf64_mul_sum_uint64( ak_pointer z, ak_pointer x, ak_pointer y, const size_t count )
+{
+  size_t i;
+  ak_uint64 h;
+
+  for( i = 0; i < count; i++ ) {
+     ak_gf64_mul_uint64( &h, (ak_uint64 *)x + i, (ak_uint64 *)y + i );
+     ((ak_uint64 *)z)[0] ^= h;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет сумму попарных произведений элементов конечного поля
+    \f$ \mathbb F_{2^{128}}\f$ и добавляет ее к значению `z`, т.е. вычисляет
+    \f$ z = z \oplus \sum_{i=0}^{count-1} x_iy_i \f$.
+    Используется последовательное умножение с приведением по модулю после каждого шага алгоритма.
+
+    @param z Указатель на накапливаемую сумму (один элемент поля).
+    @param x Указатель на массив из `count` элементов поля.
+    @param y Указатель на массив из `count` элементов поля.
+    @param count Количество слагаемых.                                                             */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_gf128_mul_sum_uint64( ak_pointer z, ak_pointer x, ak_pointer y, const size_t count )
+{
+  size_t i;
+  ak_uint64 h[2];
+
+  for( i = 0; i < count; i++ ) {
+     ak_gf128_mul_uint64( h, (ak_uint64 *)x + 2*i, (ak_uint64 *)y + 2*i );
+     ((ak_uint64 *)z)[0] ^= h[0];
+     ((ak_uint64 *)z)[1] ^= h[1];
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+#if defined( AK_HAVE_BUILTIN_CLMULEPI64_TARGET ) && defined( AK_LITTLE_ENDIAN )
+/*! Функция вычисляет \f$ z = z \oplus \sum_{i=0}^{count-1} x_iy_i \f$ в поле
+    \f$ \mathbb F_{2^{64}}\f$ с помощью команды PCLMULQDQ.
+
+    Произведения многочленов не приводятся по модулю, а складываются в 128-битном накопителе.
+    Поскольку приведение линейно, оно выполняется один раз для всей суммы, и результат совпадает
+    с результатом функции ak_gf64_mul_sum_uint64().                                               */
+/* ----------------------------------------------------------------------------------------------- */
+ __attribute__((target("pclmul")))
+ static void ak_gf64_mul_sum_pcmulqdq( ak_pointer z, ak_pointer x, ak_pointer y, const size_t count )
+{
+  size_t i;
+  ak_uint64 r[2];
+  const __m128i gm = _mm_set_epi64x( 0, 0x1B );
+  __m128i acc = _mm_setzero_si128(), hm, tm;
+
+ /* накопление произведений без приведения */
+  for( i = 0; i < count; i++ )
+     acc = _mm_xor_si128( acc, _mm_clmulepi64_si128(
+                                         _mm_loadl_epi64( (__m128i *)((ak_uint64 *)x + i )),
+                                         _mm_loadl_epi64( (__m128i *)((ak_uint64 *)y + i )), 0x00 ));
+
+ /* однократное приведение: x^{64} = x^4 + x^3 + x + 1. Каждое произведение, а значит и их
+    сумма, имеет степень не выше 126, т.е. старшая часть накопителя H может содержать до 63 бит
+    (степень не выше 62). Произведение H на x^4 + x^3 + x + 1 имеет степень не выше 66,
+    поэтому после первого умножения за пределы 64 бит выходят не более 3 бит; второе умножение
+    дает многочлен степени не выше 6, и приведение завершается */
+  hm = _mm_unpackhi_epi64( acc, _mm_setzero_si128( ));
+  tm = _mm_clmulepi64_si128( hm, gm, 0x00 );
+  acc = _mm_xor_si128( acc, tm );
+  hm = _mm_unpackhi_epi64( tm, _mm_setzero_si128( ));
+  acc = _mm_xor_si128( acc, _mm_clmulepi64_si128( hm, gm, 0x00 ));
+
+  _mm_storeu_si128( (__m128i *)r, acc );
+  ((ak_uint64 *)z)[0] ^= r[0];
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет \f$ z = z \oplus \sum_{i=0}^{count-1} x_iy_i \f$ в поле
+    \f$ \mathbb F_{2^{128}}\f$ с помощью команды PCLMULQDQ.
+
+    Произведения многочленов (по четыре умножения 64-битных половин на каждое слагаемое)
+    не приводятся по модулю, а складываются в 256-битном накопителе. Приведение выполняется
+    один раз для всей суммы, и результат совпадает с результатом функции
+    ak_gf128_mul_sum_uint64().                                                                     */
+/* ----------------------------------------------------------------------------------------------- */
+ __attribute__((target("pclmul")))
+ static void ak_gf128_mul_sum_pcmulqdq( ak_pointer z, ak_pointer x, ak_pointer y, const size_t count )
+{
+  size_t i;
+  ak_uint64 c[2], d[2], x3, dv;
+  __m128i am, bm, lo = _mm_setzero_si128(), hi = _mm_setzero_si128(), mid = _mm_setzero_si128();
+
+ /* накопление произведений без приведения */
+  for( i = 0; i < count; i++ ) {
+     am = _mm_loadu_si128( (__m128i *)((ak_uint64 *)x + 2*i ));
+     bm = _mm_loadu_si128( (__m128i *)((ak_uint64 *)y + 2*i ));
+     lo = _mm_xor_si128( lo, _mm_clmulepi64_si128( am, bm, 0x00 ));
+     hi = _mm_xor_si128( hi, _mm_clmulepi64_si128( am, bm, 0x11 ));
+     mid = _mm_xor_si128( mid, _mm_clmulepi64_si128( am, bm, 0x10 ));
+     mid = _mm_xor_si128( mid, _mm_clmulepi64_si128( am, bm, 0x01 ));
+  }
+ /* сумма равна d*x^{128} + c */
+  lo = _mm_xor_si128( lo, _mm_slli_si128( mid, 8 ));
+  hi = _mm_xor_si128( hi, _mm_srli_si128( mid, 8 ));
+  _mm_storeu_si128( (__m128i *)c, lo );
+  _mm_storeu_si128( (__m128i *)d, hi );
+
+ /* однократное приведение (x^{128} = x^7 + x^2 + x + 1) */
+  x3 = d[1];
+  dv = d[0] ^ (x3 >> 63) ^ (x3 >> 62) ^ (x3 >> 57);
+  ((ak_uint64 *)z)[0] ^= c[0] ^ dv ^ (dv << 1) ^ (dv << 2) ^ (dv << 7);
+  ((ak_uint64 *)z)[1] ^= c[1] ^ x3 ^ (x3 << 1) ^ (x3 << 2) ^ (x3 << 7)
+                                                         ^ (dv >> 63) ^ (dv >> 62) ^ (dv >> 57);
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка того, что процессор поддерживает команду PCLMULQDQ. */
+ static bool_t ak_gf2n_pcmulqdq_is_supported( void )
+{
+ #ifdef AK_HAVE_BUILTIN_CPU_SUPPORTS
+  __builtin_cpu_init();
+  if( __builtin_cpu_supports( "pclmul" )) return ak_true;
+ #endif
+ return ak_false;
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка возможности использования переносимой реализации (всегда успешна). */
+ static bool_t ak_gf2n_generic_is_supported( void ) { return ak_true; }
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Описание одной из реализаций накопления сумм произведений в конечных полях. */
+ static const struct gf2n_kernel {
+  /*! \brief Имя реализации. */
+   const char *name;
+  /*! \brief Функция проверки того, что реализация поддерживается процессором. */
+   bool_t (*is_supported)( void );
+  /*! \brief Накопление суммы произведений в поле \f$ \mathbb F_{2^{64}}\f$. */
+   void (*mul_sum64)( ak_pointer , ak_pointer , ak_pointer , const size_t );
+  /*! \brief Накопление суммы произведений в поле \f$ \mathbb F_{2^{128}}\f$. */
+   void (*mul_sum128)( ak_pointer , ak_pointer , ak_pointer , const size_t );
+ } gf2n_kernels[] = {
+#if defined( AK_HAVE_BUILTIN_CLMULEPI64_TARGET ) && defined( AK_LITTLE_ENDIAN )
+  { "pcmulqdq", ak_gf2n_pcmulqdq_is_supported,
+    ak_gf64_mul_sum_pcmulqdq, ak_gf128_mul_sum_pcmulqdq },
+#endif
+  { "generic", ak_gf2n_generic_is_supported, ak_gf64_mul_sum_uint64, ak_gf128_mul_sum_uint64 }
+ };
+
+/*! \brief Количество реализаций, скомпилированных в библиотеку. */
+ #define ak_gf2n_kernels_count ( sizeof( gf2n_kernels )/sizeof( struct gf2n_kernel ))
+
+/*! \brief Реализация, используемая для накопления сумм произведений
+    (по умолчанию - переносимая реализация). */
+ static const struct gf2n_kernel *gf2n_selected_kernel = gf2n_kernels + ak_gf2n_kernels_count -1;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет \f$ z = z \oplus \sum_{i=0}^{count-1} x_iy_i \f$ в поле
+    \f$ \mathbb F_{2^{64}}\f$ с помощью реализации, выбранной функцией ak_gf2n_select_kernel().
+
+    @param z Указатель на накапливаемую сумму (один элемент поля).
+    @param x Указатель на массив из `count` элементов поля.
+    @param y Указатель на массив из `count` элементов поля.
+    @param count Количество слагаемых.                                                             */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_gf64_mul_sum( ak_pointer z, ak_pointer x, ak_pointer y, const size_t count )
+{
+  gf2n_selected_kernel->mul_sum64( z, x, y, count );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет \f$ z = z \oplus \sum_{i=0}^{count-1} x_iy_i \f$ в поле
+    \f$ \mathbb F_{2^{128}}\f$ с помощью реализации, выбранной функцией ak_gf2n_select_kernel().
+
+    @param z Указатель на накапливаемую сумму (один элемент поля).
+    @param x Указатель на массив из `count` элементов поля.
+    @param y Указатель на массив из `count` элементов поля.
+    @param count Количество слагаемых.                                                             */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_gf128_mul_sum( ak_pointer z, ak_pointer x, ak_pointer y, const size_t count )
+{
+  gf2n_selected_kernel->mul_sum128( z, x, y, count );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция выбирает первую из скомпилированных реализаций функций ak_gf64_mul_sum() и
+    ak_gf128_mul_sum(), поддерживаемую процессором.
+
+    \return Функция возвращает \ref ak_error_ok.                                                   */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_gf2n_select_kernel( void )
+{
+  size_t idx = 0;
+
+  for( idx = 0; idx < ak_gf2n_kernels_count; idx++ )
+     if( gf2n_kernels[idx].is_supported()) {
+       gf2n_selected_kernel = gf2n_kernels + idx;
+       break;
+     }
+
+  if( ak_log_get_level() >= ak_log_maximum )
+    ak_error_message_fmt( ak_error_ok, __func__,
+                      "finite field accumulation uses %s implementation", gf2n_selected_kernel->name );
+ return ak_error_ok;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Тестирование операции умножения в поле \f$ \mathbb F_{2^{64}}\f$. */
  static bool_t ak_gf64_multiplication_test( void )
@@ -1136,6 +1349,52 @@ void ak_gf512_mul_pcmulqdq( ak_pointer z, ak_pointer a, ak_pointer b )
  return ak_true;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Тестирование накопления сумм произведений всеми реализациями, поддерживаемыми
+    процессором, путем сравнения с последовательным умножением элементов поля. */
+ static bool_t ak_gf2n_mul_sum_test( void )
+{
+ size_t idx, i, count;
+ ak_uint64 x[32], y[32], s64, r64, s128[2], r128[2], h[2], v = 0x9e3779b97f4a7c15LL;
+
+ /* формируем псевдослучайные данные */
+  for( i = 0; i < 32; i++ ) {
+     v ^= v << 13; v ^= v >> 7; v ^= v << 17; x[i] = v;
+     v ^= v << 13; v ^= v >> 7; v ^= v << 17; y[i] = v;
+  }
+
+  for( idx = 0; idx < ak_gf2n_kernels_count; idx++ ) {
+     if( !gf2n_kernels[idx].is_supported()) continue;
+     for( count = 0; count <= 16; count++ ) {
+       /* поле из 2^{64} элементов */
+        s64 = r64 = x[31];
+        for( i = 0; i < count; i++ ) {
+           ak_gf64_mul_uint64( h, x+i, y+i );
+           s64 ^= h[0];
+        }
+        gf2n_kernels[idx].mul_sum64( &r64, x, y, count );
+        if( s64 != r64 ) {
+          ak_error_message_fmt( ak_error_not_equal_data, __func__,
+                       "wrong %s sum of %u products in GF(2^64)", gf2n_kernels[idx].name, (unsigned int)count );
+          return ak_false;
+        }
+       /* поле из 2^{128} элементов */
+        s128[0] = r128[0] = y[30]; s128[1] = r128[1] = y[31];
+        for( i = 0; i < count; i++ ) {
+           ak_gf128_mul_uint64( h, x+2*i, y+2*i );
+           s128[0] ^= h[0]; s128[1] ^= h[1];
+        }
+        gf2n_kernels[idx].mul_sum128( r128, x, y, count );
+        if(( s128[0] != r128[0] ) || ( s128[1] != r128[1] )) {
+          ak_error_message_fmt( ak_error_not_equal_data, __func__,
+                      "wrong %s sum of %u products in GF(2^128)", gf2n_kernels[idx].name, (unsigned int)count );
+          return ak_false;
+        }
+     }
+  }
+ return ak_true;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
  bool_t ak_libakrypt_test_gfn_multiplication( void )
 {
@@ -1182,6 +1441,14 @@ void ak_gf512_mul_pcmulqdq( ak_pointer z, ak_pointer a, ak_pointer b )
       ak_error_message( ak_error_get_value(), __func__ , "multiplication test in GF(2^512) is OK");
 
 
+ if( ak_gf2n_mul_sum_test( ) != ak_true ) {
+   ak_error_message( ak_error_get_value(), __func__ , "incorrect accumulation of products test");
+   return ak_false;
+ } else
+    if( audit >= ak_log_maximum )
+      ak_error_message( ak_error_get_value(), __func__ , "accumulation of products test is OK");
+
+
  if( audit >= ak_log_maximum )
    ak_error_message( ak_error_ok, __func__ ,
                                         "testing the Galois fileds arithmetic ended successfully");
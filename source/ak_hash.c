@@ -5,6 +5,12 @@
 /*  - содержит реализацию алгоритмов итерационного сжатия                                          */
 /* ----------------------------------------------------------------------------------------------- */
  #include <libakrypt-internal.h>
+#ifdef AK_HAVE_PTHREAD_H
+ #include <pthread.h>
+#endif
+#ifdef AK_HAVE_BUILTIN_MM512_GF2P8MUL
+ #include <immintrin.h>
+#endif
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Итерационные константы для алгоритма Стрибог (ГОСТ Р 34.11-2012). */
@@ -1135,64 +1141,319 @@
 /* ----------------------------------------------------------------------------------------------- */
 /*                            Реализация функции хеширования Стрибог                               */
 /* ----------------------------------------------------------------------------------------------- */
-/*! \brief Преобразование LPS.
-    \note Мы предполагаем, что данные содержат 64 байта.                                           */
+/*! \brief Вычисление i-го слова результата преобразования LPS.
+    \details Массив `a` содержит 64 октета, к которым применяется преобразование;
+    i-е слово результата зависит от i-х октетов каждого из восьми слов массива.                    */
+/* ----------------------------------------------------------------------------------------------- */
+ #define streebog_lps_word( a, i ) ( \
+   streebog_Areverse_expand_with_pi[0][a[i   ]] ^ streebog_Areverse_expand_with_pi[1][a[i+ 8]] ^ \
+   streebog_Areverse_expand_with_pi[2][a[i+16]] ^ streebog_Areverse_expand_with_pi[3][a[i+24]] ^ \
+   streebog_Areverse_expand_with_pi[4][a[i+32]] ^ streebog_Areverse_expand_with_pi[5][a[i+40]] ^ \
+   streebog_Areverse_expand_with_pi[6][a[i+48]] ^ streebog_Areverse_expand_with_pi[7][a[i+56]] )
+
 /* ----------------------------------------------------------------------------------------------- */
- static inline void ak_hash_context_streebog_lps( ak_uint64 *result, const ak_uint64 *data )
+/*! \brief Преобразования X и LPS, выполняемые вместе: result = LPS( x ^ y ).
+    \note Мы предполагаем, что массивы содержат по 64 байта; массив `result` может совпадать
+    с любым из массивов `x` и `y`.                                                                 */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_hash_context_streebog_xlps( ak_uint64 *result,
+                                                           const ak_uint64 *x, const ak_uint64 *y )
 {
-  size_t idx = 0, idx2 = 0;
-  const unsigned char *a = ( const unsigned char*) data; /* приводим к массиву байт */
-
-  /* Все три преобразования вместе                           */
-  /* (этот очень короткий код был предложен Павлом Лебедевым */
-  for( idx = 0; idx < 8; idx++ ) {
-    ak_uint64 sidx = idx, c = 0;
-    for( idx2 = 0; idx2 < 8; idx2++, sidx += 8 ) {
-      c ^= streebog_Areverse_expand_with_pi[idx2][a[sidx]];
-      }
-    result[idx] = c;
+  ak_uint64 b[8];
+  const ak_uint8 *a = ( const ak_uint8 *)b; /* приводим к массиву байт */
+
+  b[0] = x[0] ^ y[0]; b[1] = x[1] ^ y[1]; b[2] = x[2] ^ y[2]; b[3] = x[3] ^ y[3];
+  b[4] = x[4] ^ y[4]; b[5] = x[5] ^ y[5]; b[6] = x[6] ^ y[6]; b[7] = x[7] ^ y[7];
+
+  /* все три преобразования вместе (этот очень короткий код был предложен Павлом Лебедевым) */
+  result[0] = streebog_lps_word( a, 0 ); result[1] = streebog_lps_word( a, 1 );
+  result[2] = streebog_lps_word( a, 2 ); result[3] = streebog_lps_word( a, 3 );
+  result[4] = streebog_lps_word( a, 4 ); result[5] = streebog_lps_word( a, 5 );
+  result[6] = streebog_lps_word( a, 6 ); result[7] = streebog_lps_word( a, 7 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вектор из нулей, используемый вместо счетчика при вычислении последних двух значений
+    функции сжатия. */
+ static const ak_uint64 streebog_zero[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Преобразование G, переносимая реализация.
+    \details Раундовые ключи и промежуточные значения хранятся в двух массивах из восьми слов,
+    преобразование X выполняется вместе с преобразованием LPS.
+
+    @param h Текущее значение хеш-кода (64 октета), изменяется функцией.
+    @param n Значение счетчика длины (64 октета).
+    @param m Обрабатываемый блок сообщения (64 октета).                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_hash_streebog_generic_g( ak_uint64 *h, const ak_uint64 *n, const ak_uint64 *m )
+{
+   int idx = 0;
+   ak_uint64 K[8], T[8];
+
+   ak_hash_context_streebog_xlps( K, h, n ); /* K - ключ K1 */
+   ak_hash_context_streebog_xlps( T, m, K );
+   ak_hash_context_streebog_xlps( K, K, streebog_c[0] );
+   for( idx = 1; idx < 12; idx++ ) {
+      ak_hash_context_streebog_xlps( T, T, K ); /* преобразуем текст */
+      ak_hash_context_streebog_xlps( K, K, streebog_c[idx] ); /* новый ключ */
+   }
+  /* изменяем значение переменной h */
+   h[0] ^= T[0] ^ K[0] ^ m[0]; h[1] ^= T[1] ^ K[1] ^ m[1];
+   h[2] ^= T[2] ^ K[2] ^ m[2]; h[3] ^= T[3] ^ K[3] ^ m[3];
+   h[4] ^= T[4] ^ K[4] ^ m[4]; h[5] ^= T[5] ^ K[5] ^ m[5];
+   h[6] ^= T[6] ^ K[6] ^ m[6]; h[7] ^= T[7] ^ K[7] ^ m[7];
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Максимальное количество сообщений, обрабатываемых одновременно. */
+ #define ak_hash_streebog_lanes_max (4)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Преобразование G для нескольких независимых сообщений, переносимая реализация.
+    \details Раунды преобразования G выполняются одновременно для всех сообщений, что позволяет
+    процессору совмещать обращения к таблицам, относящиеся к различным сообщениям.
+
+    @param lanes Количество сообщений (от 2 до \ref ak_hash_streebog_lanes_max).
+    @param h Массив указателей на текущие значения хеш-кодов, изменяемые функцией.
+    @param n Массив указателей на значения счетчиков длины.
+    @param m Массив указателей на обрабатываемые блоки сообщений.                                  */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_hash_streebog_generic_gx( const size_t lanes,
+                                ak_uint64 **h, const ak_uint64 **n, const ak_uint64 **m )
+{
+   size_t idx = 0, i = 0, j = 0;
+   ak_uint64 K[ak_hash_streebog_lanes_max][8], T[ak_hash_streebog_lanes_max][8];
+
+   for( i = 0; i < lanes; i++ ) {
+      ak_hash_context_streebog_xlps( K[i], h[i], n[i] );
+      ak_hash_context_streebog_xlps( T[i], m[i], K[i] );
+      ak_hash_context_streebog_xlps( K[i], K[i], streebog_c[0] );
+   }
+   for( idx = 1; idx < 12; idx++ ) {
+      for( i = 0; i < lanes; i++ ) ak_hash_context_streebog_xlps( T[i], T[i], K[i] );
+      for( i = 0; i < lanes; i++ ) ak_hash_context_streebog_xlps( K[i], K[i], streebog_c[idx] );
+   }
+   for( i = 0; i < lanes; i++ )
+      for( j = 0; j < 8; j++ ) h[i][j] ^= T[i][j] ^ K[i][j] ^ m[i][j];
+}
+
+#ifdef AK_HAVE_BUILTIN_MM512_GF2P8MUL
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Матрицы линейного преобразования L в формате команды `gf2p8affineqb`.
+    \details Элемент `[j][k]` задает отображение j-го октета слова в k-й октет результата.
+    Значения вычисляются функцией ak_hash_streebog_select_kernel() по таблицам
+    streebog_Areverse_expand_with_pi.                                                              */
+/* ----------------------------------------------------------------------------------------------- */
+ static ak_uint64 streebog_gfni_matrix[8][8];
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление матриц линейного преобразования L.
+    \details Таблица `streebog_Areverse_expand_with_pi[j]` содержит образы значений нелинейной
+    перестановки; образ j-го октета, равного \f$ 2^i \f$, выбирается из нее по индексу
+    \f$ \pi^{-1}(2^i) \f$. i-й бит k-го октета этого образа определяет i-й столбец
+    матрицы `[j][k]`.                                                                              */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_hash_streebog_gfni_init_matrix( void )
+{
+  int i = 0, j = 0, k = 0, r = 0, u = 0;
+  ak_uint64 image[8];
+
+  for( j = 0; j < 8; j++ ) {
+     for( i = 0; i < 8; i++ ) {
+        for( u = 0; gost_pi[u] != ( 1 << i ); u++ );
+        image[i] = streebog_Areverse_expand_with_pi[j][u];
+     }
+     for( k = 0; k < 8; k++ ) {
+        streebog_gfni_matrix[j][k] = 0;
+        for( r = 0; r < 8; r++ )
+           for( i = 0; i < 8; i++ )
+              streebog_gfni_matrix[j][k] ^= (( image[i] >> ( 8*k + r ))&1 ) << ( 8*( 7-r ) + i );
+     }
   }
 }
 
 /* ----------------------------------------------------------------------------------------------- */
-/*! \brief Преобразование X.
-    \note Мы предполагаем, что данные содержат 64 байта.                                           */
+/*! \brief Перестановка октетов, транспонирующая матрицу 8x8 (преобразование P). */
+ static const ak_uint8 streebog_gfni_transpose[64] = {
+   0,  8, 16, 24, 32, 40, 48, 56,  1,  9, 17, 25, 33, 41, 49, 57,
+   2, 10, 18, 26, 34, 42, 50, 58,  3, 11, 19, 27, 35, 43, 51, 59,
+   4, 12, 20, 28, 36, 44, 52, 60,  5, 13, 21, 29, 37, 45, 53, 61,
+   6, 14, 22, 30, 38, 46, 54, 62,  7, 15, 23, 31, 39, 47, 55, 63
+ };
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Преобразование LPS над 64 октетами, размещенными в одном векторном регистре.
+
+    Нелинейная перестановка вычисляется командами `vpermi2b` по таблице, размещенной в четырех
+    регистрах. Далее j-е слово размножается по всему регистру, и в k-м слове регистра к нему
+    применяется матрица `[j][k]`; в результате k-е слово содержит k-е октеты всех слов
+    результата, и одна перестановка октетов возвращает их на место.
+
+    @param x Преобразуемые данные.
+    @param tab Нелинейная перестановка, размещенная в четырех регистрах.
+    @param mat Матрицы линейного преобразования (по восемь матриц в регистре).
+    @param transpose Перестановка, транспонирующая матрицу октетов.
+    @return Результат преобразования.                                                              */
+/* ----------------------------------------------------------------------------------------------- */
+ __attribute__((target("avx512bw,avx512vbmi,gfni")))
+ static inline __m512i ak_hash_streebog_avx512_lps( __m512i x, const __m512i *tab,
+                                                             const __m512i *mat, __m512i transpose )
+{
+  int j = 0;
+  __m512i y = _mm512_setzero_si512();
+
+  x = _mm512_mask_blend_epi8( _mm512_movepi8_mask( x ),
+                                              _mm512_permutex2var_epi8( tab[0], x, tab[1] ),
+                                              _mm512_permutex2var_epi8( tab[2], x, tab[3] ));
+  for( j = 0; j < 8; j++ )
+     y = _mm512_xor_si512( y, _mm512_gf2p8affine_epi64_epi8(
+                                _mm512_permutexvar_epi64( _mm512_set1_epi64( j ), x ), mat[j], 0 ));
+ return _mm512_permutexvar_epi8( transpose, y );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Преобразование G с использованием команд AVX-512 и GFNI
+    (см. описание функции ak_hash_streebog_generic_g()). */
 /* ----------------------------------------------------------------------------------------------- */
- static inline void ak_hash_context_streebog_x( ak_uint64 *r, const ak_uint64 *k, const ak_uint64 *a )
+ __attribute__((target("avx512bw,avx512vbmi,gfni")))
+ static void ak_hash_streebog_avx512_g( ak_uint64 *h, const ak_uint64 *n, const ak_uint64 *m )
 {
   int idx = 0;
-  for( idx = 0; idx < 8; idx++ ) r[idx] = k[idx] ^ a[idx];
+  __m512i tab[4], mat[8], transpose, hx, mx, K, T;
+
+  for( idx = 0; idx < 4; idx++ ) tab[idx] = _mm512_loadu_si512( gost_pi + 64*idx );
+  for( idx = 0; idx < 8; idx++ ) mat[idx] = _mm512_loadu_si512( streebog_gfni_matrix[idx] );
+  transpose = _mm512_loadu_si512( streebog_gfni_transpose );
+
+  hx = _mm512_loadu_si512( h );
+  mx = _mm512_loadu_si512( m );
+  K = ak_hash_streebog_avx512_lps( _mm512_xor_si512( hx, _mm512_loadu_si512( n )),
+                                                                          tab, mat, transpose );
+  T = mx;
+  for( idx = 0; idx < 12; idx++ ) {
+     T = ak_hash_streebog_avx512_lps( _mm512_xor_si512( T, K ), tab, mat, transpose );
+     K = ak_hash_streebog_avx512_lps( _mm512_xor_si512( K,
+                                   _mm512_loadu_si512( streebog_c[idx] )), tab, mat, transpose );
+  }
+ /* вычисляем h ^ T ^ K ^ m одной командой */
+  _mm512_storeu_si512( h, _mm512_xor_si512( _mm512_ternarylogic_epi64( hx, T, K, 0x96 ), mx ));
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Преобразование G для нескольких независимых сообщений с использованием команд AVX-512
+    и GFNI (см. описание функции ak_hash_streebog_generic_gx()).
+    \details Состояние каждого сообщения размещается в своей паре регистров; раунды для разных
+    сообщений не зависят друг от друга и перекрывают задержки команд перестановки.                 */
+/* ----------------------------------------------------------------------------------------------- */
+ __attribute__((target("avx512bw,avx512vbmi,gfni")))
+ static void ak_hash_streebog_avx512_gx( const size_t lanes,
+                                ak_uint64 **h, const ak_uint64 **n, const ak_uint64 **m )
+{
+  size_t idx = 0, i = 0;
+  __m512i tab[4], mat[8], transpose, c,
+          K[ak_hash_streebog_lanes_max], T[ak_hash_streebog_lanes_max];
+
+  for( idx = 0; idx < 4; idx++ ) tab[idx] = _mm512_loadu_si512( gost_pi + 64*idx );
+  for( idx = 0; idx < 8; idx++ ) mat[idx] = _mm512_loadu_si512( streebog_gfni_matrix[idx] );
+  transpose = _mm512_loadu_si512( streebog_gfni_transpose );
+
+  for( i = 0; i < lanes; i++ ) {
+     K[i] = ak_hash_streebog_avx512_lps( _mm512_xor_si512( _mm512_loadu_si512( h[i] ),
+                                          _mm512_loadu_si512( n[i] )), tab, mat, transpose );
+     T[i] = _mm512_loadu_si512( m[i] );
+  }
+  for( idx = 0; idx < 12; idx++ ) {
+     c = _mm512_loadu_si512( streebog_c[idx] );
+     for( i = 0; i < lanes; i++ ) {
+        T[i] = ak_hash_streebog_avx512_lps( _mm512_xor_si512( T[i], K[i] ), tab, mat, transpose );
+        K[i] = ak_hash_streebog_avx512_lps( _mm512_xor_si512( K[i], c ), tab, mat, transpose );
+     }
+  }
+  for( i = 0; i < lanes; i++ )
+     _mm512_storeu_si512( h[i], _mm512_xor_si512( _mm512_ternarylogic_epi64(
+                 _mm512_loadu_si512( h[i] ), T[i], K[i], 0x96 ), _mm512_loadu_si512( m[i] )));
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка того, что процессор поддерживает команды AVX-512 (BW, VBMI) и GFNI. */
+ static bool_t ak_hash_streebog_avx512_is_supported( void )
+{
+ #ifdef AK_HAVE_BUILTIN_CPU_SUPPORTS
+  __builtin_cpu_init();
+  if( __builtin_cpu_supports( "avx512bw" ) && __builtin_cpu_supports( "avx512vbmi" ) &&
+                                                  __builtin_cpu_supports( "gfni" )) return ak_true;
+ #endif
+ return ak_false;
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка возможности использования переносимой реализации (всегда успешна). */
+ static bool_t ak_hash_streebog_generic_is_supported( void ) { return ak_true; }
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Описание одной из реализаций функции сжатия Стрибог. */
+ static const struct streebog_kernel {
+  /*! \brief Имя реализации. */
+   const char *name;
+  /*! \brief Функция проверки того, что реализация поддерживается процессором. */
+   bool_t (*is_supported)( void );
+  /*! \brief Преобразование G. */
+   void (*g)( ak_uint64 * , const ak_uint64 * , const ak_uint64 * );
+  /*! \brief Преобразование G для нескольких независимых сообщений. */
+   void (*gx)( const size_t , ak_uint64 ** , const ak_uint64 ** , const ak_uint64 ** );
+ } streebog_kernels[] = {
+#ifdef AK_HAVE_BUILTIN_MM512_GF2P8MUL
+  { "avx512", ak_hash_streebog_avx512_is_supported,
+                                         ak_hash_streebog_avx512_g, ak_hash_streebog_avx512_gx },
+#endif
+  { "generic", ak_hash_streebog_generic_is_supported,
+                                       ak_hash_streebog_generic_g, ak_hash_streebog_generic_gx }
+ };
+
+/*! \brief Количество реализаций, скомпилированных в библиотеку. */
+ #define ak_hash_streebog_kernels_count \
+                                        ( sizeof( streebog_kernels )/sizeof( struct streebog_kernel ))
+
+/*! \brief Реализация, используемая функцией хеширования Стрибог
+    (по умолчанию - переносимая табличная реализация). */
+ static const struct streebog_kernel *streebog_selected_kernel =
+                                            streebog_kernels + ak_hash_streebog_kernels_count -1;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция последовательно перебирает реализации функции сжатия, скомпилированные в библиотеку,
+    и выбирает первую из них, поддерживаемую процессором.
+
+    \return Функция возвращает \ref ak_error_ok.                                                   */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_hash_streebog_select_kernel( void )
+{
+  size_t idx = 0;
+
+ #ifdef AK_HAVE_BUILTIN_MM512_GF2P8MUL
+  ak_hash_streebog_gfni_init_matrix();
+ #endif
+  for( idx = 0; idx < ak_hash_streebog_kernels_count; idx++ )
+     if( streebog_kernels[idx].is_supported()) {
+       streebog_selected_kernel = streebog_kernels + idx;
+       break;
+     }
+
+  if( ak_log_get_level() >= ak_log_maximum )
+    ak_error_message_fmt( ak_error_ok, __func__, "streebog hash function uses %s implementation",
+                                                                     streebog_selected_kernel->name );
+ return ak_error_ok;
+}
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Преобразование G
-    \note Мы предполагаем, что массивы n и m содержат по 64 байта.                                 */
+    \note Мы предполагаем, что массивы n и m содержат по 64 байта; если n равен NULL,
+    то вместо счетчика используется нулевой вектор.                                                */
 /* ----------------------------------------------------------------------------------------------- */
  static inline void ak_hash_context_streebog_g( ak_streebog ctx, ak_uint64 *n, const ak_uint64 *m )
 {
-   int idx = 0;
-   ak_uint64 K[8], T[8], B[8];
-
-       if( n != NULL ) {
-         ak_hash_context_streebog_x( B, ctx->h, n );
-         ak_hash_context_streebog_lps( K, B );
-       }
-        else
-         ak_hash_context_streebog_lps( K, ctx->h );
-
-       /* K - ключ K1 */
-       for( idx = 0; idx < 8; idx++ ) T[idx] = m[idx]; /* memcpy( T, m, 64 ); */
-
-       for( idx = 0; idx < 12; idx++ ) {
-          ak_hash_context_streebog_x( B, T, K );
-          ak_hash_context_streebog_lps( T, B ); /* преобразуем текст */
-
-          ak_hash_context_streebog_x( B, K, streebog_c[idx] );
-          ak_hash_context_streebog_lps( K, B );   /* новый ключ */
-       }
-       /* изменяем значение переменной h */
-       for ( idx = 0; idx < 8; idx++ ) ctx->h[idx] ^= T[idx] ^ K[idx] ^ m[idx];
+  streebog_selected_kernel->g( ctx->h, n == NULL ? streebog_zero : n, m );
 }
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -1222,26 +1483,24 @@
  static inline void ak_hash_context_streebog_sadd( ak_streebog ctx,  const ak_uint64 *data )
 {
    int i = 0;
-   ak_uint64 carry = 0;
-   for( i = 0; i < 8; i++ )
-   {
+   ak_uint64 carry = 0, sum, val;
+
+  /* перенос вычисляется без ветвлений: сравнения компилируются в команды setc/adc */
+   for( i = 0; i < 8; i++ ) {
     #ifdef AK_LITTLE_ENDIAN
-      if( carry ) {
-                    ctx->sigma[i] ++;
-                    if( ctx->sigma[i] ) carry = 0;
-      }
-      ctx->sigma[i] += data[i];
-      if( ctx->sigma[i] < data[i] ) carry = 1;
+      val = data[i];
+      sum = ctx->sigma[i] + val;
+      val = ( sum < val );
+      sum += carry;
+      carry = val | ( sum < carry );
+      ctx->sigma[i] = sum;
     #else
-      ak_uint64 val_data = bswap_64( data[i] ),
-               val_sigma = bswap_64( ctx->sigma[i] );
-      if( carry ) {
-                    val_sigma++;
-                    if( val_sigma ) carry = 0;
-      }
-      val_sigma += val_data;
-      if( val_sigma < val_data ) carry = 1;
-      ctx->sigma[i] = bswap_64( val_sigma );
+      val = bswap_64( data[i] );
+      sum = bswap_64( ctx->sigma[i] ) + val;
+      val = ( sum < val );
+      sum += carry;
+      carry = val | ( sum < carry );
+      ctx->sigma[i] = bswap_64( sum );
     #endif
    }
 }
@@ -1318,6 +1577,191 @@
  return result;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*                     Древовидное хеширование на основе функций Стрибог                           */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Хеширование области памяти произвольной длины функцией Стрибог.
+    \param hsize Длина хеш-кода (32 или 64 октета).
+    \param in Указатель на входные данные.
+    \param size Длина входных данных (в октетах).
+    \param out Область памяти, куда помещается хеш-код.                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_hash_tree_streebog( const size_t hsize,
+                                         const ak_uint8 *in, const size_t size, ak_uint8 *out )
+{
+  struct streebog sx;
+  size_t full = ( size >> 6 ) << 6;
+
+  sx.hsize = hsize;
+  ak_hash_context_streebog_clean( &sx );
+  if( full ) ak_hash_context_streebog_update( &sx, ( ak_pointer )in, full );
+  ak_hash_context_streebog_finalize( &sx, ( ak_pointer )( in + full ), size - full, out, hsize );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Завершение вычисления хеш-кода листа: к данным листа дописывается октет 0x00.
+    \note Контекст листа не изменяется, длина данных size должна быть менее 64 октетов.          */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_hash_tree_leaf_finalize( ak_streebog leaf,
+                                         const ak_uint8 *in, const size_t size, ak_uint8 *out )
+{
+  ak_uint8 m[64];
+  struct streebog sx;
+
+  memcpy( &sx, leaf, sizeof( struct streebog ));
+  if( size ) memcpy( m, in, size );
+  m[size] = 0x00;
+  if( size == 63 ) {
+    ak_hash_context_streebog_update( &sx, m, 64 );
+    ak_hash_context_streebog_finalize( &sx, NULL, 0, out, sx.hsize );
+  } else ak_hash_context_streebog_finalize( &sx, m, size+1, out, sx.hsize );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление хеш-кода внутренней вершины дерева: H( left || right || 0x01 ). */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_hash_tree_node( const size_t hsize,
+                                   const ak_uint8 *left, const ak_uint8 *right, ak_uint8 *out )
+{
+  ak_uint8 m[129];
+
+  memcpy( m, left, hsize );
+  memcpy( m+hsize, right, hsize );
+  m[hsize << 1] = 0x01;
+  ak_hash_tree_streebog( hsize, m, ( hsize << 1 )+1, out );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Добавление хеш-кода очередного листа в дерево.
+    \details Вершины незавершенных поддеревьев хранятся по уровням, так что уровень l занят
+    тогда и только тогда, когда l-й бит количества листьев равен единице; добавление листа
+    выполняется аналогично прибавлению единицы к двоичному счетчику.                               */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_hash_tree_push( ak_streebog_tree tx, const ak_uint8 *digest )
+{
+  ak_uint8 d[64];
+  size_t level = 0;
+  ak_uint64 n = tx->count;
+
+  memcpy( d, digest, tx->leaf.hsize );
+  while( n&1 ) {
+    ak_hash_tree_node( tx->leaf.hsize, tx->nodes[level], d, d );
+    level++; n >>= 1;
+  }
+  memcpy( tx->nodes[level], d, tx->leaf.hsize );
+  tx->count++;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление хеш-кода вершины дерева.
+    \details Вершины незавершенных поддеревьев объединяются, начиная с нижнего уровня;
+    результатом является значение H( top || total || leaf_size || 0x02 ), где
+    длина данных total и длина листа leaf_size записываются восемью октетами (младшие вперед). */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_hash_tree_root( ak_streebog_tree tx,
+                                     const ak_uint64 total, ak_uint8 *out, const size_t out_size )
+{
+  size_t i, level = 0, hsize = tx->leaf.hsize;
+  ak_uint64 n = tx->count;
+  ak_uint8 m[81], acc[64];
+  bool_t empty = ak_true;
+
+  for( level = 0; n; level++, n >>= 1 ) {
+     if(( n&1 ) == 0 ) continue;
+     if( empty ) {
+       memcpy( acc, tx->nodes[level], hsize );
+       empty = ak_false;
+     } else ak_hash_tree_node( hsize, tx->nodes[level], acc, acc );
+  }
+  memcpy( m, acc, hsize );
+  for( i = 0; i < 8; i++ ) {
+     m[hsize+i] = ( ak_uint8 )( total >> ( i << 3 ));
+     m[hsize+8+i] = ( ak_uint8 )( tx->leaf_size >> ( i << 3 ));
+  }
+  m[hsize+16] = 0x02;
+  ak_hash_tree_streebog( hsize, m, hsize+17, acc );
+  memcpy( out, acc, ak_min( hsize, out_size ));
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Закрытие заполненного листа и добавление его хеш-кода в дерево. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_hash_tree_close_leaf( ak_streebog_tree tx )
+{
+  ak_uint8 d[64];
+
+  ak_hash_tree_leaf_finalize( &tx->leaf, NULL, 0, d );
+  ak_hash_tree_push( tx, d );
+  ak_hash_context_streebog_clean( &tx->leaf );
+  tx->filled = 0;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_hash_context_tree_clean( ak_pointer tctx )
+{
+  ak_streebog_tree tx = ( ak_streebog_tree ) tctx;
+  if( tx == NULL ) return ak_error_null_pointer;
+
+  tx->filled = 0;
+  tx->count = 0;
+  memset( tx->nodes, 0, sizeof( tx->nodes ));
+ return ak_hash_context_streebog_clean( &tx->leaf );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Обновление состояния контекста древовидного хеширования.
+    \details Заполненный лист закрывается только при поступлении новых данных, поэтому данные,
+    длина которых кратна длине листа, не порождают пустой последний лист.                        */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_hash_context_tree_update( ak_pointer tctx, const ak_pointer in, const size_t size )
+{
+  size_t len = 0, rest = size;
+  ak_uint8 *ptr = ( ak_uint8 *) in;
+  ak_streebog_tree tx = ( ak_streebog_tree ) tctx;
+
+  if( tx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                "using null pointer to internal tree context" );
+  if(( !size ) || ( in == NULL )) return ak_error_ok;
+  if( size&0x3f ) return ak_error_message( ak_error_wrong_length, __func__,
+                                      "data length is not a multiple of the length of the block" );
+  while( rest ) {
+    if( tx->filled == tx->leaf_size ) ak_hash_tree_close_leaf( tx );
+    len = ( size_t )ak_min( ( ak_uint64 )rest, tx->leaf_size - tx->filled );
+    ak_hash_context_streebog_update( &tx->leaf, ptr, len );
+    tx->filled += len;
+    ptr += len; rest -= len;
+  }
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_hash_context_tree_finalize( ak_pointer tctx,
+                   const ak_pointer in, const size_t size, ak_pointer out, const size_t out_size )
+{
+  ak_uint8 d[64];
+  ak_uint64 total = 0;
+  struct streebog_tree tx; /* копия текущего состояния контекста */
+  ak_streebog_tree cx = ( ak_streebog_tree ) tctx;
+
+  if( cx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                "using null pointer to internal tree context" );
+  if( out == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                   "using null pointer to externl result buffer" );
+  if( size >= 64 ) return ak_error_message( ak_error_wrong_length, __func__,
+                                                                      "input length is too huge" );
+  total = cx->count*cx->leaf_size + cx->filled + size;
+
+ /* при финализации мы изменяем копию существующей структуры */
+  memcpy( &tx, cx, sizeof( struct streebog_tree ));
+  if(( tx.filled == tx.leaf_size ) && size ) ak_hash_tree_close_leaf( &tx );
+  ak_hash_tree_leaf_finalize( &tx.leaf, ( const ak_uint8 *) in, size, d );
+  ak_hash_tree_push( &tx, d );
+  ak_hash_tree_root( &tx, total, out, out_size );
+
+ return ak_error_ok;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*                               Реализация функция класса hash                                    */
 /* ----------------------------------------------------------------------------------------------- */
@@ -1370,6 +1814,125 @@
   return ak_hash_context_streebog_clean( &hctx->data.sctx );
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Инициализация контекста древовидного хеширования с заданной длиной хеш-кода. */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_hash_create_tree_streebog( ak_hash hctx, const size_t hsize, const char *name )
+{
+  int error = ak_error_ok;
+  ak_streebog_tree tx = NULL;
+
+  if( hctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                            "using null pointer to hash context" );
+  if(( hctx->oid = ak_oid_find_by_name( name )) == NULL )
+    return ak_error_message_fmt( ak_error_wrong_oid, __func__,
+                                                "incorrect internal search of %s identifier", name );
+ /* вершины поддеревьев занимают несколько килобайт, поэтому внутренние данные размещаются
+    в динамической памяти и не увеличивают размер структуры hash */
+  if(( tx = malloc( sizeof( struct streebog_tree ))) == NULL )
+    return ak_error_message( ak_error_out_of_memory, __func__,
+                                             "incorrect memory allocation for tree context" );
+  memset( tx, 0, sizeof( struct streebog_tree ));
+  tx->leaf.hsize = hsize;
+  tx->leaf_size = ak_streebog_tree_leaf_size;
+  hctx->data.sctx.hsize = hsize;
+  if(( error = ak_mac_create( &hctx->mctx, 64, tx,
+                                             ak_hash_context_tree_clean,
+                                             ak_hash_context_tree_update,
+                                             ak_hash_context_tree_finalize )) != ak_error_ok ) {
+    free( tx );
+    return ak_error_message( error, __func__, "incorrect initialization of internal mac context" );
+  }
+
+  return ak_hash_context_tree_clean( tx );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция инициализирует контекст древовидного (Меркле) хеширования, в котором хеш-коды
+    листьев длины \ref ak_streebog_tree_leaf_size октетов и внутренних вершин дерева вычисляются
+    с помощью функции Стрибог256. Хеш-коды листьев могут вычисляться независимо, что позволяет
+    хешировать большие файлы с помощью нескольких потоков (см. функцию ak_hash_file()).
+
+    @param hctx Контекст функции хеширования
+    @return Функция возвращает код ошибки или \ref ak_error_ok (в случае успеха)                   */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_hash_create_tree_streebog256( ak_hash hctx )
+{
+  return ak_hash_create_tree_streebog( hctx, 32, "tree-streebog256" );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция инициализирует контекст древовидного (Меркле) хеширования на основе
+    функции Стрибог512, см. функцию ak_hash_create_tree_streebog256().
+
+    @param hctx Контекст функции хеширования
+    @return Функция возвращает код ошибки или \ref ak_error_ok (в случае успеха)                   */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_hash_create_tree_streebog512( ak_hash hctx )
+{
+  return ak_hash_create_tree_streebog( hctx, 64, "tree-streebog512" );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция копирует внутреннее состояние контекста, обработавшего ровно один блок данных
+    длины 64 октета (например, маскированное значение ключа алгоритма HMAC). Сохраненное состояние
+    может быть многократно восстановлено с помощью функции ak_hash_set_state(), что позволяет
+    не обрабатывать этот блок повторно.
+
+    @param hctx Контекст функции хеширования
+    @param state Структура, в которую помещается состояние
+    @return Функция возвращает код ошибки или \ref ak_error_ok (в случае успеха)                   */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_hash_get_state( ak_hash hctx, ak_streebog state )
+{
+  if(( hctx == NULL ) || ( state == NULL )) return ak_error_message( ak_error_null_pointer,
+                                                                    __func__, "using null pointer" );
+  if( hctx->mctx.length != 0 ) return ak_error_message( ak_error_wrong_length, __func__,
+                                                     "using hash context with non-empty buffer" );
+  if( hctx->mctx.update == ak_hash_context_streebog_update ) {
+    memcpy( state, &hctx->data.sctx, sizeof( struct streebog ));
+    return ak_error_ok;
+  }
+  if( hctx->mctx.update == ak_hash_context_tree_update ) {
+    ak_streebog_tree tx = hctx->mctx.ctx;
+    if(( tx->count != 0 ) || ( tx->filled != 64 ))
+      return ak_error_message( ak_error_wrong_length, __func__,
+                                              "using tree context with wrong amount of data" );
+    memcpy( state, &tx->leaf, sizeof( struct streebog ));
+    return ak_error_ok;
+  }
+
+ return ak_error_message( ak_error_undefined_function, __func__,
+                                                            "using hash context of unknown type" );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция восстанавливает состояние контекста, сохраненное функцией ak_hash_get_state().
+
+    @param hctx Контекст функции хеширования
+    @param state Сохраненное состояние
+    @return Функция возвращает код ошибки или \ref ak_error_ok (в случае успеха)                   */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_hash_set_state( ak_hash hctx, const ak_streebog state )
+{
+  if(( hctx == NULL ) || ( state == NULL )) return ak_error_message( ak_error_null_pointer,
+                                                                    __func__, "using null pointer" );
+  if( hctx->mctx.update == ak_hash_context_streebog_update )
+    memcpy( &hctx->data.sctx, state, sizeof( struct streebog ));
+   else {
+     if( hctx->mctx.update != ak_hash_context_tree_update )
+       return ak_error_message( ak_error_undefined_function, __func__,
+                                                            "using hash context of unknown type" );
+     ak_streebog_tree tx = hctx->mctx.ctx;
+     memcpy( &tx->leaf, state, sizeof( struct streebog ));
+     tx->filled = 64;
+     tx->count = 0;
+   }
+  hctx->mctx.length = 0;
+
+ return ak_error_ok;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! @param hctx Контекст функции хеширования
     @param oid OID алгоритма бесключевого хеширования.
@@ -1415,7 +1978,11 @@
   if( hctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
                                                        "destroying null pointer to hash context" );
   hctx->oid = NULL;
-  memset( &hctx->data.sctx, 0, sizeof( struct streebog ));
+  memset( &hctx->data, 0, sizeof( hctx->data ));
+  if(( hctx->mctx.update == ak_hash_context_tree_update ) && ( hctx->mctx.ctx != NULL )) {
+    memset( hctx->mctx.ctx, 0, sizeof( struct streebog_tree ));
+    free( hctx->mctx.ctx );
+  }
   if( ak_mac_destroy( &hctx->mctx ) != ak_error_ok )
     ak_error_message( ak_error_get_value(), __func__,
                                                     "incorrect cleaning of internal mac context" );
@@ -1476,6 +2043,119 @@
  return ak_mac_ptr( &hctx->mctx, in, size, out, out_size );
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция обрабатывает части сообщений, длины которых кратны длине блока (64 октета);
+    обработка остатков сообщений и получение результата выполняются вызывающей функцией.
+
+    \note Контексты должны быть различными, их внутренние буфферы должны быть пусты
+    (например, после вызова функции ak_hash_clean()). Одновременно обрабатывается до
+    \ref ak_hash_streebog_lanes_max сообщений: цепочки преобразований LPS одного сообщения
+    зависят друг от друга, а перемежение раундов для различных сообщений позволяет процессору
+    выполнять их параллельно. Обработанное сообщение заменяется следующим сообщением массива.
+
+    @param hctx Массив указателей на контексты функции хеширования
+    @param in Массив указателей на обрабатываемые сообщения
+    @param size Массив длин сообщений (в октетах)
+    @param count Количество сообщений
+
+    @return В случае успеха функция возвращает ноль (\ref ak_error_ok). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_hash_update_multi( ak_hash *hctx, const ak_pointer *in,
+                                                         const size_t *size, const size_t count )
+{
+  size_t idx = 0, jdx = 0, next = 0, lanes = 0, rest[ak_hash_streebog_lanes_max];
+  ak_streebog cx[ak_hash_streebog_lanes_max];
+  ak_uint64 *h[ak_hash_streebog_lanes_max];
+  const ak_uint64 *n[ak_hash_streebog_lanes_max], *dt[ak_hash_streebog_lanes_max];
+
+  if(( hctx == NULL ) || ( in == NULL ) || ( size == NULL ))
+    return ak_error_message( ak_error_null_pointer, __func__, "using null pointer to arrays" );
+  for( idx = 0; idx < count; idx++ ) {
+     if( hctx[idx] == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                            "using null pointer to hash context" );
+     if( hctx[idx]->mctx.update != ak_hash_context_streebog_update )
+       return ak_error_message( ak_error_undefined_function, __func__,
+                                                          "using hash context of unknown type" );
+     if( hctx[idx]->mctx.length != 0 ) return ak_error_message( ak_error_wrong_length, __func__,
+                                                     "using hash context with non-empty buffer" );
+     if(( in[idx] == NULL ) && ( size[idx] != 0 ))
+       return ak_error_message( ak_error_null_pointer, __func__, "using null pointer to data" );
+  }
+
+  do{
+    /* дополняем набор обрабатываемых сообщений теми, что содержат целые блоки */
+     while(( lanes < ak_hash_streebog_lanes_max ) && ( next < count )) {
+        if(( rest[lanes] = size[next] >> 6 ) != 0 ) {
+          cx[lanes] = &hctx[next]->data.sctx;
+          h[lanes] = cx[lanes]->h;
+          n[lanes] = cx[lanes]->n;
+          dt[lanes] = ( const ak_uint64 *) in[next];
+          lanes++;
+        }
+        next++;
+     }
+     if( !lanes ) break;
+
+    /* обрабатываем по одному блоку каждого сообщения */
+     if( lanes == 1 ) streebog_selected_kernel->g( h[0], n[0], dt[0] );
+       else streebog_selected_kernel->gx( lanes, h, n, dt );
+     for( idx = 0, jdx = 0; idx < lanes; idx++ ) {
+        ak_hash_context_streebog_add( cx[idx], 512 );
+        ak_hash_context_streebog_sadd( cx[idx], dt[idx] );
+        if( --rest[idx] == 0 ) continue; /* сообщение обработано */
+        cx[jdx] = cx[idx]; h[jdx] = h[idx]; n[jdx] = n[idx];
+        dt[jdx] = dt[idx] + 8; rest[jdx] = rest[idx];
+        jdx++;
+     }
+     lanes = jdx;
+  } while( lanes || ( next < count ));
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет хеш-коды нескольких независимых сообщений, причем каждое сообщение
+    обрабатывается своим контекстом, см. ak_hash_update_multi(). Результат совпадает
+    с результатом последовательных вызовов функции ak_hash_ptr() для каждого сообщения.
+
+    @param hctx Массив указателей на различные контексты функции хеширования
+    @param in Массив указателей на входные данные для которых вычисляются хеш-коды.
+    @param size Массив длин входных данных (в октетах).
+    @param out Массив указателей на области памяти, куда будут помещены результаты.
+    @param out_size Размер каждой из областей памяти (в октетах).
+    @param count Количество сообщений.
+
+    @return В случае успеха функция возвращает ноль (\ref ak_error_ok). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_hash_ptr_multi( ak_hash *hctx, const ak_pointer *in, const size_t *size,
+                                       ak_pointer *out, const size_t out_size, const size_t count )
+{
+  size_t idx = 0, full = 0;
+  int error = ak_error_ok;
+
+  if(( hctx == NULL ) || ( in == NULL ) || ( size == NULL ) || ( out == NULL ))
+    return ak_error_message( ak_error_null_pointer, __func__, "using null pointer to arrays" );
+  if( !count ) return ak_error_message( ak_error_zero_length, __func__,
+                                                                "using zero number of messages" );
+  for( idx = 0; idx < count; idx++ )
+     if(( error = ak_hash_clean( hctx[idx] )) != ak_error_ok )
+       return ak_error_message( error, __func__, "incorrect cleaning of hash context" );
+
+  if(( error = ak_hash_update_multi( hctx, in, size, count )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect updating of hash contexts" );
+
+  for( idx = 0; idx < count; idx++ ) {
+     full = ( size[idx] >> 6 ) << 6;
+     if(( error = ak_hash_finalize( hctx[idx], full ? ( ak_uint8 *)in[idx] + full : in[idx],
+                                  size[idx] - full, out[idx], out_size )) != ak_error_ok )
+       return ak_error_message( error, __func__, "incorrect finalizing of hash context" );
+  }
+
+ return ak_error_ok;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! @param hctx Контекст функции хеширования
     @param filename Имя файла, для котрого вычисляется хеш-код.
@@ -1489,9 +2169,29 @@
 /* ----------------------------------------------------------------------------------------------- */
  int ak_hash_file( ak_hash hctx, const char * filename, ak_pointer out, const size_t out_size )
 {
+  struct file file;
+  ak_uint8 tail[64];
+  size_t tail_size = 0;
+  int error = ak_error_ok;
+
   if( hctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
                                                             "using null pointer to hash context" );
- return ak_mac_file( &hctx->mctx, filename, out, out_size );
+  if( !ak_hash_is_tree( hctx )) return ak_mac_file( &hctx->mctx, filename, out, out_size );
+
+ /* листья древовидного хеширования обрабатываются несколькими потоками */
+  if( filename == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                                "use a null pointer to filename" );
+  if(( error = ak_file_open_to_read( &file, filename )) != ak_error_ok )
+    return ak_error_message_fmt( error, __func__, "incorrect access to file %s", filename );
+  if(( error = ak_hash_clean( hctx )) == ak_error_ok )
+    if(( error = ak_hash_tree_update_file( hctx, &file, tail, &tail_size )) == ak_error_ok )
+      error = ak_hash_finalize( hctx, tail, tail_size, out, out_size );
+  if( error != ak_error_ok )
+    ak_error_message_fmt( error, __func__, "incorrect processing of file %s", filename );
+
+  ak_hash_clean( hctx );
+  ak_file_close( &file );
+ return error;
 }
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -1542,6 +2242,658 @@
  return ak_mac_finalize( &hctx->mctx, in, size, out, out_size );
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*                        Многопоточное древовидное хеширование файлов                             */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Получение указателя на фрагмент файла.
+    \details Если файл отображен в память, то возвращается указатель на отображенную память,
+    в противном случае фрагмент считывается в буффер.
+    \return Указатель на данные или NULL в случае ошибки чтения.                                   */
+/* ----------------------------------------------------------------------------------------------- */
+ static const ak_uint8 *ak_hash_tree_read( ak_file file, const ak_uint8 *data,
+                                           const ak_uint64 offset, const size_t size, ak_uint8 *buffer )
+{
+  ssize_t val = 0;
+  size_t done = 0;
+
+  if( data != NULL ) return data + offset;
+  while( done < size ) {
+    if(( val = ak_file_read_at( file, buffer + done,
+                                         size - done, ( ak_int64 )( offset + done ))) <= 0 ) {
+      if( val == 0 ) ak_error_message( ak_error_read_data, __func__, "unexpected end of file" );
+      return NULL;
+    }
+    done += ( size_t )val;
+  }
+ return buffer;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Фрагмент файла, хеш-коды листьев которого вычисляются отдельным потоком. */
+ typedef struct tree_task {
+  /*! \brief Длина хеш-кода (в октетах). */
+   size_t hsize;
+  /*! \brief Длина листа (в октетах). */
+   ak_uint64 leaf_size;
+  /*! \brief Дескриптор файла. */
+   ak_file file;
+  /*! \brief Указатель на отображенный в память файл (NULL, если файл считывается). */
+   const ak_uint8 *data;
+  /*! \brief Смещение начала фрагмента от начала файла. */
+   ak_uint64 offset;
+  /*! \brief Длина фрагмента (в октетах). */
+   ak_uint64 size;
+  /*! \brief Указатель на область памяти для хеш-кодов листьев фрагмента. */
+   ak_uint8 *out;
+  /*! \brief Код ошибки, возникшей при обработке фрагмента. */
+   int error;
+ #ifdef AK_HAVE_PTHREAD_H
+  /*! \brief Поток, обрабатывающий фрагмент. */
+   pthread_t thread;
+  /*! \brief Флаг того, что поток был успешно запущен. */
+   bool_t started;
+ #endif
+} *ak_tree_task;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление хеш-кодов последовательных листьев фрагмента файла.
+    \details Фрагмент нулевой длины рассматривается как один пустой лист.                          */
+/* ----------------------------------------------------------------------------------------------- */
+ static void *ak_hash_tree_task( void *ptr )
+{
+  struct streebog sx;
+  size_t len = 0, full = 0;
+  ak_uint64 done = 0;
+  ak_uint8 *buffer = NULL, *out = NULL;
+  const ak_uint8 *in = NULL;
+  ak_tree_task task = ( ak_tree_task )ptr;
+
+  if(( task->data == NULL ) && (( buffer = malloc( task->leaf_size )) == NULL )) {
+    task->error = ak_error_message( ak_error_out_of_memory, __func__,
+                                                           "incorrect memory allocation for leaf" );
+    return NULL;
+  }
+  out = task->out;
+  do {
+     len = ( size_t )ak_min( task->leaf_size, task->size - done );
+     if(( in = ak_hash_tree_read( task->file, task->data,
+                                               task->offset + done, len, buffer )) == NULL ) {
+       task->error = ak_error_read_data;
+       break;
+     }
+     sx.hsize = task->hsize;
+     ak_hash_context_streebog_clean( &sx );
+     if(( full = ( len >> 6 ) << 6 ) != 0 )
+       ak_hash_context_streebog_update( &sx, ( ak_pointer )in, full );
+     ak_hash_tree_leaf_finalize( &sx, in + full, len - full, out );
+     out += task->hsize;
+     done += len;
+  } while( done < task->size );
+
+  if( buffer != NULL ) free( buffer );
+ return NULL;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление хеш-кодов листьев, составляющих заданный фрагмент файла.
+
+    Листья распределяются между потоками непрерывными группами; первая группа обрабатывается
+    вызывающим потоком. Если поток создать не удалось, то группа обрабатывается вызывающим
+    потоком. Хеш-коды помещаются в массив out в порядке следования листьев.
+
+    @param hsize Длина хеш-кода (в октетах).
+    @param leaf_size Длина листа (в октетах).
+    @param file Дескриптор файла.
+    @param data Указатель на отображенный в память файл или NULL.
+    @param offset Смещение первого листа от начала файла.
+    @param size Длина фрагмента; все листья, кроме, быть может, последнего, имеют длину leaf_size.
+    @param out Массив для хеш-кодов листьев.
+    @param threads Максимальное количество используемых потоков.
+    @return В случае возникновения ошибки функция возвращает ее код, в противном случае
+    возвращается \ref ak_error_ok (ноль)                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_hash_tree_leaves( const size_t hsize, const ak_uint64 leaf_size, ak_file file,
+                                      const ak_uint8 *data, const ak_uint64 offset,
+                                      const ak_uint64 size, ak_uint8 *out, const size_t threads )
+{
+  size_t i, count;
+  int error = ak_error_ok;
+  ak_tree_task tasks = NULL;
+  ak_uint64 leaves = size ? ( size + leaf_size - 1 )/leaf_size : 1, per;
+
+  per = ( leaves + ak_max( threads, 1 ) - 1 )/ak_max( threads, 1 );
+  count = ( size_t )(( leaves + per - 1 )/per );
+  if(( tasks = calloc( count, sizeof( struct tree_task ))) == NULL )
+    return ak_error_message( ak_error_out_of_memory, __func__,
+                                                  "incorrect memory allocation for thread tasks" );
+  for( i = 0; i < count; i++ ) {
+     tasks[i].hsize = hsize;
+     tasks[i].leaf_size = leaf_size;
+     tasks[i].file = file;
+     tasks[i].data = data;
+     tasks[i].offset = offset + i*per*leaf_size;
+     tasks[i].size = ak_min( per*leaf_size, size - i*per*leaf_size );
+     tasks[i].out = out + i*per*hsize;
+  }
+
+ #ifdef AK_HAVE_PTHREAD_H
+  for( i = 1; i < count; i++ ) {
+     if( pthread_create( &tasks[i].thread, NULL, ak_hash_tree_task, tasks+i ) == 0 )
+       tasks[i].started = ak_true;
+      else ak_hash_tree_task( tasks+i ); /* не удалось создать поток - обрабатываем фрагмент сами */
+  }
+  ak_hash_tree_task( tasks );
+  for( i = 1; i < count; i++ )
+     if( tasks[i].started ) pthread_join( tasks[i].thread, NULL );
+ #else
+  for( i = 0; i < count; i++ ) ak_hash_tree_task( tasks+i );
+ #endif
+
+  for( i = 0; i < count; i++ )
+     if( tasks[i].error != ak_error_ok ) { error = tasks[i].error; break; }
+  free( tasks );
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Последовательная обработка фрагмента файла, длина которого кратна 64 октетам. */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_hash_tree_update_range( ak_streebog_tree tx, ak_file file, const ak_uint8 *data,
+                                        ak_uint64 offset, ak_uint64 size, ak_uint8 *buffer )
+{
+  size_t len = 0;
+  const ak_uint8 *in = NULL;
+
+  while( size ) {
+    len = ( size_t )ak_min( size, tx->leaf_size );
+    if(( in = ak_hash_tree_read( file, data, offset, len, buffer )) == NULL )
+      return ak_error_read_data;
+    ak_hash_context_tree_update( tx, ( ak_pointer )in, len );
+    offset += len; size -= len;
+  }
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! @param hctx Контекст функции хеширования.
+    @return Функция возвращает \ref ak_true, если контекст реализует древовидное хеширование. */
+/* ----------------------------------------------------------------------------------------------- */
+ bool_t ak_hash_is_tree( ak_hash hctx )
+{
+  if( hctx == NULL ) return ak_false;
+ return ( hctx->mctx.update == ak_hash_context_tree_update );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция обрабатывает содержимое файла, продолжая вычисления с текущего состояния контекста
+    (внутренний буффер контекста должен быть пуст). Текущий лист дополняется последовательно,
+    хеш-коды последующих полных листьев вычисляются несколькими потоками (их количество
+    определяется опцией `tree_hash_threads`), последний лист файла остается открытым.
+    Остаток файла, длина которого меньше 64 октетов, помещается в tail и должен быть передан
+    функции ak_hash_finalize() (или функции финализации использующего контекст алгоритма).
+
+    @param hctx Контекст древовидного хеширования.
+    @param file Дескриптор файла, открытого на чтение.
+    @param tail Буффер длины 64 октета для остатка файла.
+    @param tail_size Указатель, по которому помещается длина остатка.
+    @return В случае успеха функция возвращает ноль (\ref ak_error_ok). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_hash_tree_update_file( ak_hash hctx, ak_file file, ak_uint8 *tail, size_t *tail_size )
+{
+  size_t threads = 0, batch = 0, jdx = 0;
+  ak_uint64 idx = 0, cnt = 0, first = 0, full = 0, rest = 0, offset = 0;
+  ak_uint8 *buffer = NULL, *digests = NULL;
+  const ak_uint8 *data = NULL, *in = NULL;
+  int error = ak_error_ok;
+  ak_streebog_tree tx = NULL;
+
+  if(( hctx == NULL ) || ( file == NULL ) || ( tail == NULL ) || ( tail_size == NULL ))
+    return ak_error_message( ak_error_null_pointer, __func__, "using null pointer" );
+  if( !ak_hash_is_tree( hctx )) return ak_error_message( ak_error_undefined_function,
+                                                  __func__, "using hash context of unknown type" );
+  if( hctx->mctx.length != 0 ) return ak_error_message( ak_error_wrong_length, __func__,
+                                                     "using hash context with non-empty buffer" );
+  tx = hctx->mctx.ctx;
+  *tail_size = 0;
+  if( file->size <= 0 ) return ak_error_ok;
+
+  threads = ( size_t )ak_libakrypt_get_option_by_index( tree_hash_threads_option );
+  batch = threads << 2;
+
+ /* отображаем файл в память, а если не получилось, то считываем его фрагментами */
+ #ifdef AK_HAVE_SYSMMAN_H
+  if( ak_libakrypt_get_option_by_index( use_mmap_for_files_option ) &&
+                                  (( ak_uint64 )file->size <= ( ak_uint64 )(( size_t )-1 ))) {
+    if(( data = ak_file_mmap( file, NULL, ( size_t )file->size,
+                                                    PROT_READ, MAP_PRIVATE, 0 )) == MAP_FAILED ) {
+      data = NULL;
+      ak_error_set_value( ak_error_ok );
+    }
+  }
+ #endif
+  if(( data == NULL ) && (( buffer = malloc( tx->leaf_size )) == NULL )) {
+    error = ak_error_message( ak_error_out_of_memory, __func__,
+                                                       "memory allocation error for file buffer" );
+    goto labex;
+  }
+
+ /* определяем длину дополнения текущего листа и количество полных листьев,
+    хеш-коды которых могут быть вычислены независимо */
+  first = ( tx->filled == tx->leaf_size ) ? 0 :
+                                 ak_min( tx->leaf_size - tx->filled, ( ak_uint64 )file->size );
+  rest = ( ak_uint64 )file->size - first;
+  full = rest ? ( rest - 1 )/tx->leaf_size : 0; /* последний лист остается открытым */
+
+  if( full ) {
+    if(( digests = malloc( batch*tx->leaf.hsize )) == NULL ) {
+      error = ak_error_message( ak_error_out_of_memory, __func__,
+                                                     "memory allocation error for leaf digests" );
+      goto labex;
+    }
+    if(( error = ak_hash_tree_update_range( tx, file, data, 0, first, buffer )) != ak_error_ok )
+      goto labex;
+    ak_hash_tree_close_leaf( tx );
+    for( idx = 0; idx < full; idx += cnt ) {
+       cnt = ak_min( batch, full - idx );
+       if(( error = ak_hash_tree_leaves( tx->leaf.hsize, tx->leaf_size, file, data,
+                                         first + idx*tx->leaf_size, cnt*tx->leaf_size,
+                                                           digests, threads )) != ak_error_ok )
+         goto labex;
+       for( jdx = 0; jdx < cnt; jdx++ ) ak_hash_tree_push( tx, digests + jdx*tx->leaf.hsize );
+    }
+    offset = first + full*tx->leaf_size;
+  }
+
+ /* последний лист обрабатываем последовательно */
+  rest = ( ak_uint64 )file->size - offset;
+  *tail_size = ( size_t )( rest&0x3f );
+  if(( error = ak_hash_tree_update_range( tx, file, data,
+                                      offset, rest - *tail_size, buffer )) != ak_error_ok ) goto labex;
+  if( *tail_size ) {
+    if(( in = ak_hash_tree_read( file, data,
+                  ( ak_uint64 )file->size - *tail_size, *tail_size, tail )) == NULL ) {
+      error = ak_error_read_data;
+      goto labex;
+    }
+    if( in != tail ) memcpy( tail, in, *tail_size );
+  }
+
+  labex:
+   if( error != ak_error_ok ) ak_error_message( error, __func__, "incorrect processing of file" );
+ #ifdef AK_HAVE_SYSMMAN_H
+   if( data != NULL ) {
+     ak_file_unmap( file );
+     file->addr = NULL;
+   }
+ #endif
+   if( buffer != NULL ) free( buffer );
+   if( digests != NULL ) free( digests );
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Заголовок файла, содержащего хеш-коды листьев. */
+ typedef struct tree_leaves_header {
+  /*! \brief Сигнатура файла. */
+   ak_uint8 magic[8];
+  /*! \brief Контрольное значение для определения порядка следования октетов. */
+   ak_uint32 order;
+  /*! \brief Длина хеш-кода листа (в октетах). */
+   ak_uint32 hsize;
+  /*! \brief Длина листа (в октетах). */
+   ak_uint64 leaf_size;
+  /*! \brief Длина хешируемого файла (в октетах). */
+   ak_uint64 file_size;
+} *ak_tree_leaves_header;
+
+/*! \brief Сигнатура файла, содержащего хеш-коды листьев. */
+ static const char *ak_hash_tree_leaves_magic = "aktree01";
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Количество листьев в файле заданной длины. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline ak_uint64 ak_hash_tree_leaves_count( const ak_uint64 size, const ak_uint64 leaf_size )
+{
+ return size ? ( size + leaf_size - 1 )/leaf_size : 1;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Считывание файла, содержащего хеш-коды листьев.
+
+    Функция проверяет, что заголовок файла соответствует контексту хеширования, выделяет память
+    для хеш-кодов всех листьев и помещает в нее сохраненные хеш-коды.
+
+    @param hctx Контекст древовидного хеширования.
+    @param leaves Имя файла, содержащего хеш-коды листьев.
+    @param hdr Заголовок, в который помещается считанное значение.
+    @param digests Указатель, по которому помещается адрес выделенной памяти.
+    @param stored Указатель, по которому помещается количество сохраненных хеш-кодов.
+    @return В случае успеха функция возвращает ноль (\ref ak_error_ok). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_hash_tree_load_leaves( ak_hash hctx, const char *leaves,
+                      ak_tree_leaves_header hdr, ak_uint8 **digests, ak_uint64 *stored )
+{
+  struct file fp;
+  ak_uint64 count = 0, avail = 0;
+  int error = ak_error_ok;
+  size_t hsize = hctx->data.sctx.hsize;
+
+  *digests = NULL;
+  *stored = 0;
+  if(( error = ak_file_open_to_read( &fp, leaves )) != ak_error_ok ) return error;
+  if(( fp.size < ( ak_int64 )sizeof( struct tree_leaves_header )) ||
+     ( ak_file_read( &fp, hdr, sizeof( struct tree_leaves_header ))
+                                             != ( ssize_t )sizeof( struct tree_leaves_header ))) {
+    error = ak_error_wrong_length;
+    goto labex;
+  }
+  if(( memcmp( hdr->magic, ak_hash_tree_leaves_magic, sizeof( hdr->magic )) != 0 ) ||
+     ( hdr->order != 0x01020304 ) || ( hdr->hsize != hsize ) ||
+     ( hdr->leaf_size != (( ak_streebog_tree )hctx->mctx.ctx )->leaf_size )) {
+    error = ak_error_undefined_value;
+    goto labex;
+  }
+
+  count = ak_hash_tree_leaves_count( hdr->file_size, hdr->leaf_size );
+  if(( count > (( size_t )-1 )/hsize ) || (( *digests = malloc( count*hsize )) == NULL )) {
+    error = ak_error_out_of_memory;
+    goto labex;
+  }
+  avail = (( ak_uint64 )fp.size - sizeof( struct tree_leaves_header ))/hsize;
+  *stored = ak_min( avail, count );
+  if( ak_file_read( &fp, *digests, *stored*hsize ) != ( ssize_t )( *stored*hsize )) {
+    free( *digests );
+    *digests = NULL;
+    *stored = 0;
+    error = ak_error_read_data;
+  }
+
+  labex:
+   ak_file_close( &fp );
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление хеш-кода вершины дерева по хеш-кодам всех его листьев. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_hash_tree_root_from_leaves( ak_hash hctx, const ak_uint8 *digests,
+                       const ak_uint64 count, const ak_uint64 total, ak_pointer out, const size_t out_size )
+{
+  ak_uint64 idx = 0;
+  ak_streebog_tree tx = hctx->mctx.ctx;
+
+  ak_hash_context_tree_clean( tx );
+  for( idx = 0; idx < count; idx++ ) ak_hash_tree_push( tx, digests + idx*tx->leaf.hsize );
+  ak_hash_tree_root( tx, total, out, out_size );
+  ak_hash_context_tree_clean( tx );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет хеш-код файла с помощью древовидного хеширования и сохраняет хеш-коды
+    листьев в отдельном файле. Результат совпадает с результатом функции ak_hash_file().
+
+    Файл с хеш-кодами листьев дописывается после обработки каждой группы листьев. Если при
+    вызове функции такой файл уже существует, соответствует контексту хеширования и длине
+    хешируемого файла, то сохраненные в нем хеш-коды используются повторно, а вычисления
+    продолжаются со следующего листа; это позволяет возобновить прерванное хеширование
+    большого файла.
+
+    \note Сохраненные хеш-коды не проверяются: для проверки соответствия файла сохраненным
+    хеш-кодам следует использовать функцию ak_hash_tree_file_check_leaves().
+
+    @param hctx Контекст древовидного хеширования.
+    @param filename Имя хешируемого файла.
+    @param leaves Имя файла, в котором сохраняются хеш-коды листьев.
+    @param out Область памяти, куда будет помещен результат.
+    @param out_size Размер области памяти (в октетах), в которую будет помещен результат.
+    @return В случае успеха функция возвращает ноль (\ref ak_error_ok). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_hash_tree_file_leaves( ak_hash hctx, const char *filename,
+                                         const char *leaves, ak_pointer out, const size_t out_size )
+{
+  struct file file, fp;
+  struct tree_leaves_header hdr;
+  const ak_uint8 *data = NULL;
+  ak_uint8 *digests = NULL;
+  ak_uint64 idx = 0, cnt = 0, count = 0, stored = 0, leaf_size = 0;
+  size_t hsize = 0, threads = 0, batch = 0;
+  int error = ak_error_ok;
+
+  if(( hctx == NULL ) || ( filename == NULL ) || ( leaves == NULL ) || ( out == NULL ))
+    return ak_error_message( ak_error_null_pointer, __func__, "using null pointer" );
+  if( !ak_hash_is_tree( hctx )) return ak_error_message( ak_error_undefined_function,
+                                                  __func__, "using hash context of unknown type" );
+  if(( error = ak_file_open_to_read( &file, filename )) != ak_error_ok )
+    return ak_error_message_fmt( error, __func__, "incorrect access to file %s", filename );
+
+  hsize = hctx->data.sctx.hsize;
+  leaf_size = (( ak_streebog_tree )hctx->mctx.ctx )->leaf_size;
+  count = ak_hash_tree_leaves_count(( ak_uint64 )file.size, leaf_size );
+  threads = ( size_t )ak_libakrypt_get_option_by_index( tree_hash_threads_option );
+  batch = threads << 2;
+
+ /* используем ранее сохраненные хеш-коды, если они соответствуют файлу */
+  if(( ak_hash_tree_load_leaves( hctx, leaves, &hdr, &digests, &stored ) != ak_error_ok ) ||
+                                                 ( hdr.file_size != ( ak_uint64 )file.size )) {
+    if( digests != NULL ) free( digests );
+    digests = NULL;
+    stored = 0;
+    ak_error_set_value( ak_error_ok );
+  }
+  if(( digests == NULL ) && (( count > (( size_t )-1 )/hsize ) ||
+                                               (( digests = malloc( count*hsize )) == NULL ))) {
+    ak_file_close( &file );
+    return ak_error_message( ak_error_out_of_memory, __func__,
+                                                     "memory allocation error for leaf digests" );
+  }
+
+ /* формируем файл с хеш-кодами заново, переписывая в него сохраненные значения */
+  memset( &hdr, 0, sizeof( struct tree_leaves_header ));
+  memcpy( hdr.magic, ak_hash_tree_leaves_magic, sizeof( hdr.magic ));
+  hdr.order = 0x01020304;
+  hdr.hsize = ( ak_uint32 )hsize;
+  hdr.leaf_size = leaf_size;
+  hdr.file_size = ( ak_uint64 )file.size;
+  if(( error = ak_file_create_to_write( &fp, leaves )) != ak_error_ok ) {
+    ak_error_message_fmt( error, __func__, "incorrect creation of file %s", leaves );
+    goto labex;
+  }
+  if(( ak_file_write( &fp, &hdr, sizeof( hdr )) != ( ssize_t )sizeof( hdr )) ||
+     ( stored && ( ak_file_write( &fp, digests, stored*hsize ) != ( ssize_t )( stored*hsize )))) {
+    error = ak_error_message_fmt( ak_error_write_data, __func__,
+                                                         "incorrect writing to file %s", leaves );
+    goto labex2;
+  }
+
+ #ifdef AK_HAVE_SYSMMAN_H
+  if( file.size && ak_libakrypt_get_option_by_index( use_mmap_for_files_option ) &&
+                                   (( ak_uint64 )file.size <= ( ak_uint64 )(( size_t )-1 ))) {
+    if(( data = ak_file_mmap( &file, NULL, ( size_t )file.size,
+                                                    PROT_READ, MAP_PRIVATE, 0 )) == MAP_FAILED ) {
+      data = NULL;
+      ak_error_set_value( ak_error_ok );
+    }
+  }
+ #endif
+
+ /* вычисляем недостающие хеш-коды группами листьев */
+  for( idx = stored; idx < count; idx += cnt ) {
+     cnt = ak_min( batch, count - idx );
+     if(( error = ak_hash_tree_leaves( hsize, leaf_size, &file, data, idx*leaf_size,
+                          ak_min( cnt*leaf_size, ( ak_uint64 )file.size - idx*leaf_size ),
+                                               digests + idx*hsize, threads )) != ak_error_ok ) {
+       ak_error_message_fmt( error, __func__, "incorrect processing of file %s", filename );
+       break;
+     }
+     if( ak_file_write( &fp, digests + idx*hsize, cnt*hsize ) != ( ssize_t )( cnt*hsize )) {
+       error = ak_error_message_fmt( ak_error_write_data, __func__,
+                                                         "incorrect writing to file %s", leaves );
+       break;
+     }
+  }
+  if( error == ak_error_ok )
+    ak_hash_tree_root_from_leaves( hctx, digests, count, ( ak_uint64 )file.size, out, out_size );
+
+ #ifdef AK_HAVE_SYSMMAN_H
+  if( data != NULL ) {
+    ak_file_unmap( &file );
+    file.addr = NULL;
+  }
+ #endif
+  labex2:
+   ak_file_close( &fp );
+  labex:
+   free( digests );
+   ak_file_close( &file );
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция заново вычисляет хеш-коды заданного диапазона листьев файла и сравнивает их
+    с сохраненными функцией ak_hash_tree_file_leaves() значениями. Это позволяет проверять
+    целостность большого файла частями, а также определять место его искажения.
+
+    @param hctx Контекст древовидного хеширования.
+    @param filename Имя проверяемого файла.
+    @param leaves Имя файла, содержащего хеш-коды листьев.
+    @param first Номер первого проверяемого листа (листья нумеруются с нуля).
+    @param count Количество проверяемых листьев; нулевое значение, как и значение,
+    превышающее количество листьев, означает проверку всех листьев, начиная с first.
+    @param damaged Указатель, по которому, в случае несовпадения, помещается номер первого
+    искаженного листа (может принимать значение NULL).
+    @return Функция возвращает \ref ak_error_ok, если все хеш-коды совпали,
+    и \ref ak_error_not_equal_data, если найден искаженный лист.
+    В остальных случаях возвращается код ошибки.                                                   */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_hash_tree_file_check_leaves( ak_hash hctx, const char *filename, const char *leaves,
+                                     const size_t first, const size_t count, size_t *damaged )
+{
+  struct file file;
+  struct tree_leaves_header hdr;
+  const ak_uint8 *data = NULL;
+  ak_uint8 *digests = NULL, *computed = NULL;
+  ak_uint64 idx = 0, cnt = 0, jdx = 0, total = 0, last = 0, stored = 0;
+  size_t hsize = 0, threads = 0, batch = 0;
+  int error = ak_error_ok;
+
+  if(( hctx == NULL ) || ( filename == NULL ) || ( leaves == NULL ))
+    return ak_error_message( ak_error_null_pointer, __func__, "using null pointer" );
+  if( !ak_hash_is_tree( hctx )) return ak_error_message( ak_error_undefined_function,
+                                                  __func__, "using hash context of unknown type" );
+  if(( error = ak_hash_tree_load_leaves( hctx, leaves, &hdr, &digests, &stored )) != ak_error_ok )
+    return ak_error_message_fmt( error, __func__, "incorrect reading of file %s", leaves );
+  if(( error = ak_file_open_to_read( &file, filename )) != ak_error_ok ) {
+    free( digests );
+    return ak_error_message_fmt( error, __func__, "incorrect access to file %s", filename );
+  }
+
+  hsize = hdr.hsize;
+  total = ak_hash_tree_leaves_count( hdr.file_size, hdr.leaf_size );
+  if( hdr.file_size != ( ak_uint64 )file.size ) {
+    error = ak_error_message_fmt( ak_error_wrong_length, __func__,
+                              "the length of file %s differs from the stored value", filename );
+    goto labex;
+  }
+  if( first >= total ) {
+    error = ak_error_message( ak_error_wrong_index, __func__, "using wrong index of first leaf" );
+    goto labex;
+  }
+  last = (( count == 0 ) || ( count > total - first )) ? total : first + count;
+  if( stored < last ) {
+    error = ak_error_message_fmt( ak_error_wrong_length, __func__,
+                                          "file %s does not contain all required digests", leaves );
+    goto labex;
+  }
+
+  threads = ( size_t )ak_libakrypt_get_option_by_index( tree_hash_threads_option );
+  batch = threads << 2;
+  if(( computed = malloc( batch*hsize )) == NULL ) {
+    error = ak_error_message( ak_error_out_of_memory, __func__,
+                                                     "memory allocation error for leaf digests" );
+    goto labex;
+  }
+ #ifdef AK_HAVE_SYSMMAN_H
+  if( file.size && ak_libakrypt_get_option_by_index( use_mmap_for_files_option ) &&
+                                   (( ak_uint64 )file.size <= ( ak_uint64 )(( size_t )-1 ))) {
+    if(( data = ak_file_mmap( &file, NULL, ( size_t )file.size,
+                                                    PROT_READ, MAP_PRIVATE, 0 )) == MAP_FAILED ) {
+      data = NULL;
+      ak_error_set_value( ak_error_ok );
+    }
+  }
+ #endif
+
+  for( idx = first; idx < last; idx += cnt ) {
+     cnt = ak_min( batch, last - idx );
+     if(( error = ak_hash_tree_leaves( hsize, hdr.leaf_size, &file, data, idx*hdr.leaf_size,
+                      ak_min( cnt*hdr.leaf_size, hdr.file_size - idx*hdr.leaf_size ),
+                                                          computed, threads )) != ak_error_ok ) {
+       ak_error_message_fmt( error, __func__, "incorrect processing of file %s", filename );
+       break;
+     }
+     for( jdx = 0; jdx < cnt; jdx++ )
+        if( memcmp( computed + jdx*hsize, digests + ( idx + jdx )*hsize, hsize ) != 0 ) {
+          if( damaged != NULL ) *damaged = ( size_t )( idx + jdx );
+          error = ak_error_not_equal_data;
+          break;
+        }
+     if( error != ak_error_ok ) break;
+  }
+
+ #ifdef AK_HAVE_SYSMMAN_H
+  if( data != NULL ) {
+    ak_file_unmap( &file );
+    file.addr = NULL;
+  }
+ #endif
+  labex:
+   if( computed != NULL ) free( computed );
+   free( digests );
+   ak_file_close( &file );
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет хеш-код файла только по сохраненным функцией ak_hash_tree_file_leaves()
+    хеш-кодам листьев, без обращения к самому файлу.
+
+    @param hctx Контекст древовидного хеширования.
+    @param leaves Имя файла, содержащего хеш-коды листьев.
+    @param out Область памяти, куда будет помещен результат.
+    @param out_size Размер области памяти (в октетах), в которую будет помещен результат.
+    @return В случае успеха функция возвращает ноль (\ref ak_error_ok). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_hash_tree_leaves_root( ak_hash hctx, const char *leaves, ak_pointer out, const size_t out_size )
+{
+  struct tree_leaves_header hdr;
+  ak_uint8 *digests = NULL;
+  ak_uint64 stored = 0, count = 0;
+  int error = ak_error_ok;
+
+  if(( hctx == NULL ) || ( leaves == NULL ) || ( out == NULL ))
+    return ak_error_message( ak_error_null_pointer, __func__, "using null pointer" );
+  if( !ak_hash_is_tree( hctx )) return ak_error_message( ak_error_undefined_function,
+                                                  __func__, "using hash context of unknown type" );
+  if(( error = ak_hash_tree_load_leaves( hctx, leaves, &hdr, &digests, &stored )) != ak_error_ok )
+    return ak_error_message_fmt( error, __func__, "incorrect reading of file %s", leaves );
+
+  count = ak_hash_tree_leaves_count( hdr.file_size, hdr.leaf_size );
+  if( stored != count ) error = ak_error_message_fmt( ak_error_wrong_length, __func__,
+                                                "file %s does not contain all digests", leaves );
+   else ak_hash_tree_root_from_leaves( hctx, digests, count, hdr.file_size, out, out_size );
+  free( digests );
+
+ return error;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*                          Функции тестирования алгоритмов работы                                 */
 /* ----------------------------------------------------------------------------------------------- */
@@ -1610,6 +2962,54 @@
    0xBA, 0x3A, 0x71, 0x5C, 0x1B, 0xCD, 0x81, 0xCB, 0x8E, 0x9F, 0x90, 0xBF, 0x4C, 0x1C, 0x1A, 0x8A
  };
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Тестирование всех реализаций функции сжатия, поддерживаемых процессором, путем
+    сравнения с переносимой реализацией. */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_libakrypt_test_streebog_kernels( void )
+{
+  size_t idx, i, j, count, lanes;
+  ak_uint64 h[ak_hash_streebog_lanes_max][8], n[ak_hash_streebog_lanes_max][8],
+            m[ak_hash_streebog_lanes_max][8], r[ak_hash_streebog_lanes_max][8],
+            s[8], v = 0x9e3779b97f4a7c15LL, *hp[ak_hash_streebog_lanes_max];
+  const ak_uint64 *np[ak_hash_streebog_lanes_max], *mp[ak_hash_streebog_lanes_max];
+
+  for( idx = 0; idx < ak_hash_streebog_kernels_count; idx++ ) {
+     if( !streebog_kernels[idx].is_supported()) continue;
+     for( count = 0; count < 32; count++ ) {
+       /* формируем псевдослучайные данные */
+        for( j = 0; j < ak_hash_streebog_lanes_max; j++ ) {
+           for( i = 0; i < 8; i++ ) {
+              v ^= v << 13; v ^= v >> 7; v ^= v << 17; h[j][i] = v;
+              v ^= v << 13; v ^= v >> 7; v ^= v << 17; n[j][i] = v;
+              v ^= v << 13; v ^= v >> 7; v ^= v << 17; m[j][i] = v;
+           }
+          /* последние итерации используют нулевой счетчик */
+           if(( count+j )&1 ) memset( n[j], 0, sizeof( n[j] ));
+           memcpy( r[j], h[j], sizeof( h[j] ));
+           ak_hash_streebog_generic_g( r[j], n[j], m[j] );
+           hp[j] = h[j]; np[j] = n[j]; mp[j] = m[j];
+        }
+       /* сообщения обрабатываются по одному, а затем по несколько одновременно */
+        memcpy( s, h[0], sizeof( s ));
+        streebog_kernels[idx].g( s, n[0], m[0] );
+        lanes = 2 + count%( ak_hash_streebog_lanes_max - 1 );
+        streebog_kernels[idx].gx( lanes, hp, np, mp );
+        for( j = 0; j < lanes; j++ )
+           if(( memcmp( r[j], h[j], sizeof( r[j] )) != 0 ) || ( memcmp( r[0], s, sizeof( s )))) {
+             ak_error_message_fmt( ak_error_not_equal_data, __func__,
+                            "wrong %s compression function (%u messages)",
+                                             streebog_kernels[idx].name, (unsigned int) lanes );
+             return ak_false;
+           }
+     }
+     if( ak_log_get_level() >= ak_log_maximum )
+       ak_error_message_fmt( ak_error_ok, __func__,
+                                  "testing of %s implementation is Ok", streebog_kernels[idx].name );
+  }
+ return ak_true;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*!  @return Если тестирование прошло успешно возвращается \ref ak_true (истина). В противном
      случае возвращается \ref ak_false.                                                            */
@@ -1627,6 +3027,13 @@
  /* буффер длиной 32 байта (256 бит) для хранения результата */
   ak_uint8 buffer[512], out[32], out2[32], *ptr = buffer;
 
+ /* сравниваем реализации функции сжатия */
+  if( !ak_libakrypt_test_streebog_kernels( )) {
+    ak_error_message( ak_error_get_value(), __func__ ,
+                                         "incorrect testing of streebog compression function" );
+    return ak_false;
+  }
+
  /* инициализируем контекст функции хешиирования */
   if(( error = ak_hash_create_streebog256( &ctx )) != ak_error_ok ) {
     ak_error_message( error, __func__ , "wrong initialization of streenbog256 context" );
@@ -18,8 +18,87 @@
  #error Library cannot be compiled without string.h header
 #endif
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Формирование блока, содержащего значение ключа, сложенное с заданной константой. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_hmac_internal_mask_key( ak_hmac hctx, ak_uint8 *buffer, const ak_uint8 pad )
+{
+  size_t idx = 0, jdx = 0, len = 0;
+
+  len = ak_min( hctx->mctx.bsize, jdx = hctx->key.key_size );
+  for( idx = 0; idx < len; idx++, jdx++ ) {
+     buffer[idx] = hctx->key.key[idx] ^ pad;
+     buffer[idx] ^= hctx->key.key[jdx];
+  }
+  for( ; idx < hctx->mctx.bsize; idx++ ) buffer[idx] = pad;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление состояний функции хеширования после обработки ключа, сложенного
+    с константами ipad и opad.
+
+    Состояния сохраняются в контексте и восстанавливаются при каждом вычислении имитовставки,
+    поэтому значение ключа используется только один раз после его присвоения.
+    \param hctx Контекст алгоритма HMAC выработки имитовставки.
+    \return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_hmac_internal_precompute( ak_hmac hctx )
+{
+  struct hash second;
+  int error = ak_error_ok;
+  ak_uint8 buffer[64]; /* буффер для хранения промежуточных значений */
+
+ /* состояние после обработки ключа, сложенного с константой ipad */
+  ak_hmac_internal_mask_key( hctx, buffer, 0x36 );
+  if(( error = ak_hash_clean( &hctx->ctx )) != ak_error_ok ) {
+    ak_error_message( error, __func__, "wrong cleaning of hash function context" );
+    goto labex;
+  }
+  if(( error = ak_hash_update( &hctx->ctx, buffer, hctx->mctx.bsize )) != ak_error_ok ) {
+    ak_error_message( error, __func__, "invalid 1st step iteration for hmac key context" );
+    goto labex;
+  }
+  if(( error = ak_hash_get_state( &hctx->ctx, &hctx->istate )) != ak_error_ok ) {
+    ak_error_message( error, __func__, "incorrect saving of hash function state" );
+    goto labex;
+  }
+
+ /* состояние после обработки ключа, сложенного с константой opad;
+    для алгоритма nmac используется вторая функция хеширования */
+  ak_hmac_internal_mask_key( hctx, buffer, 0x5C );
+  if( hctx->nmac_second_hash_oid ) {
+    if(( error = (( ak_function_hash_create *)
+                   hctx->nmac_second_hash_oid->func.first.create )( &second )) != ak_error_ok ) {
+      ak_error_message( error, __func__, "wrong creation of second hash function context" );
+      goto labex;
+    }
+    if(( error = ak_hash_update( &second, buffer, hctx->mctx.bsize )) == ak_error_ok )
+      error = ak_hash_get_state( &second, &hctx->ostate );
+    ak_hash_destroy( &second );
+  } else {
+     if(( error = ak_hash_clean( &hctx->ctx )) == ak_error_ok )
+       if(( error = ak_hash_update( &hctx->ctx, buffer, hctx->mctx.bsize )) == ak_error_ok )
+         error = ak_hash_get_state( &hctx->ctx, &hctx->ostate );
+    }
+  if( error != ak_error_ok ) {
+    ak_error_message( error, __func__, "invalid 2nd step iteration for hmac key context" );
+    goto labex;
+  }
+  hctx->precomputed = ak_true;
+
+  labex:
+  /* очищаем буффер и перемаскируем ключ */
+   ak_ptr_wipe( buffer, sizeof( buffer ), &hctx->key.generator );
+   ak_skey_remask( &hctx->key, hctx->mctx.bsize );
+ return error;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Очистка контекста алгоритма hmac.
+    \details Контекст функции хеширования приводится в состояние, соответствующее обработанному
+    ключу, сложенному с константой ipad; при первом вызове после присвоения ключу значения это
+    состояние вычисляется, при последующих - восстанавливается копированием.
     \param ctx Контекст алгоритма HMAC выработки имитовставки.
     \return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
     возвращается код ошибки.                                                                       */
@@ -28,8 +107,6 @@
 {
   int error = ak_error_ok;
   ak_hmac hctx = ( ak_hmac ) ctx;
-  size_t idx = 0, jdx = 0, len = 0;
-  ak_uint8 buffer[64]; /* буффер для хранения промежуточных значений */
 
   if( ctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
                                                       "using a null pointer to hmac key context" );
@@ -40,30 +117,15 @@
   if( hctx->key.resource.value.counter <= 1 ) return ak_error_message( ak_error_low_key_resource,
                                             __func__, "using hmac key context with low resource" );
                       /* нам надо два раза использовать ключ => ресурс должен быть не менее двух */
-  if( hctx->mctx.bsize > sizeof( buffer )) return ak_error_message( ak_error_wrong_length,
+  if( hctx->mctx.bsize > 64 ) return ak_error_message( ak_error_wrong_length,
                                             __func__, "using hash function with huge block size" );
+  if( !hctx->precomputed )
+    if(( error = ak_hmac_internal_precompute( hctx )) != ak_error_ok )
+      return ak_error_message( error, __func__, "incorrect precomputation of hmac states" );
 
- /* фомируем маскированное значение ключа */
-  len = ak_min( hctx->mctx.bsize, jdx = hctx->key.key_size );
-  for( idx = 0; idx < len; idx++, jdx++ ) {
-     buffer[idx] = hctx->key.key[idx] ^ 0x36;
-     buffer[idx] ^= hctx->key.key[jdx];
-  }
-  for( ; idx < hctx->mctx.bsize; idx++ ) buffer[idx] = 0x36;
-
- /* инициализируем начальное состояние контекста хеширования */
-  if(( error = ak_hash_clean( &hctx->ctx )) != ak_error_ok )
-    return ak_error_message( error, __func__, "wrong cleaning of hash function context" );
-
- /* обновляем состояние контекста хеширования */
-  if(( error = ak_hash_update( &hctx->ctx, buffer, hctx->mctx.bsize )) != ak_error_ok )
-    ak_error_message( error, __func__, "invalid 1st step iteration for hmac key context" );
-
- /* очищаем буффер */
-  ak_ptr_wipe( buffer, sizeof( buffer ), &hctx->key.generator );
-
- /* перемаскируем ключ и меняем его ресурс */
-  hctx->key.set_mask( &hctx->key );
+ /* восстанавливаем состояние контекста хеширования */
+  if(( error = ak_hash_set_state( &hctx->ctx, &hctx->istate )) != ak_error_ok )
+    return ak_error_message( error, __func__, "invalid 1st step iteration for hmac key context" );
   hctx->key.resource.value.counter--; /* мы использовали ключ один раз */
 
  return error;
@@ -112,9 +174,7 @@
 {
   int error = ak_error_ok;
   ak_hmac hctx = ( ak_hmac ) ctx;
-  size_t idx = 0, jdx = 0, len = 0;
-  ak_uint8 temporary[128]; /* первый буффер для хранения промежуточных значений */
-  ak_uint8 keybuffer[128]; /* второй буффер для хранения промежуточных значений */
+  ak_uint8 temporary[64]; /* буффер для хранения промежуточных значений */
 
  /* выполняем проверки */
   if( hctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
@@ -128,51 +188,26 @@
  /* проверяем наличие ключа (ресурс проверен при вызове clean) */
   if( !((hctx->key.flags)&key_flag_set_key )) return ak_error_message( ak_error_key_value,
                                                __func__ , "using hmac key with unassigned value" );
+  if( !hctx->precomputed ) return ak_error_message( ak_error_not_ready, __func__ ,
+                                                       "using hmac context without cleaning" );
  /* обрабатываем хвост предыдущих данных */
   memset( temporary, 0, sizeof( temporary ));
   if(( error = ak_hash_finalize( &hctx->ctx, in, size, temporary,
                                                             sizeof( temporary ))) != ak_error_ok )
     return ak_error_message( error, __func__ , "wrong updating of finalized data" );
 
- /* фомируем маскированное значение ключа */
-  len = ak_min( hctx->mctx.bsize, jdx = hctx->key.key_size );
-  for( idx = 0; idx < len; idx++ , jdx++ ) {
-     keybuffer[idx] = hctx->key.key[idx] ^ 0x5C;
-     keybuffer[idx] ^= hctx->key.key[jdx];
-  }
-  for( ; idx < hctx->mctx.bsize; idx++ ) keybuffer[idx] = 0x5C;
-
-
- /* различие с nmac в последней функции хеширования */
-  if( hctx->nmac_second_hash_oid ) {
-    ak_hash_destroy( &hctx->ctx );
-    hctx->nmac_second_hash_oid->func.first.create( &hctx->ctx );
-  }
-
- /* возвращаем контекст хеширования в начальное состояние */
-  if(( error = ak_hash_clean( &hctx->ctx )) != ak_error_ok )
-    return ak_error_message( error, __func__, "wrong cleaning of hash function context" );
-
- /* обновляем состояние контекста хеширования */
-  if(( error = ak_hash_update( &hctx->ctx, keybuffer, hctx->mctx.bsize )) != ak_error_ok )
+ /* восстанавливаем состояние после обработки ключа, сложенного с константой opad
+    (для nmac это состояние второй функции хеширования) */
+  if(( error = ak_hash_set_state( &hctx->ctx, &hctx->ostate )) != ak_error_ok )
     return ak_error_message( error, __func__, "invalid 1st step iteration for hmac key context" );
-
- /* очищаем буффер */
-  ak_ptr_wipe( keybuffer, sizeof( keybuffer ), &hctx->key.generator );
-
- /* ресурс ключа */
-  hctx->key.set_mask( &hctx->key );
   hctx->key.resource.value.counter--; /* мы использовали ключ один раз */
 
  /* последний update/finalize и возврат результата */
-  error = ak_hash_finalize( &hctx->ctx, temporary, hctx->ctx.data.sctx.hsize, out, out_size );
-
-  if( hctx->nmac_second_hash_oid ) {
-    ak_hash_destroy( &hctx->ctx );
-    ak_hash_create_streebog512( &hctx->ctx );
-  }
+  error = ak_hash_finalize( &hctx->ctx, temporary, hctx->ostate.hsize, out, out_size );
+  memset( temporary, 0, sizeof( temporary ));
 
  /* очищаем контекст функции хеширования, ключ не трогаем */
+  hctx->ctx.data.sctx.hsize = hctx->istate.hsize;
   ak_hash_clean( &hctx->ctx );
  return error;
 }
@@ -233,6 +268,8 @@
   hctx->key.oid = oid;
  /* устанавливаем указатель на второй алгоритм хеширования */
   hctx->nmac_second_hash_oid = NULL;
+ /* состояния функции хеширования будут вычислены после присвоения ключу значения */
+  hctx->precomputed = ak_false;
 
  return error;
 }
@@ -253,6 +290,22 @@
  int ak_hmac_create_streebog512( ak_hmac hctx )
 { return ak_hmac_create_oid( hctx, ak_oid_find_by_name( "hmac-streebog512" )); }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \param hctx Контекст алгоритма HMAC выработки имитовставки.
+    \return В случае успешного завершения функций возвращает \ref ak_error_ok. В случае
+    возникновения ошибки возвращеется ее код.                                                      */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_hmac_create_tree_streebog256( ak_hmac hctx )
+{ return ak_hmac_create_oid( hctx, ak_oid_find_by_name( "hmac-tree-streebog256" )); }
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \param hctx Контекст алгоритма HMAC выработки имитовставки.
+    \return В случае успешного завершения функций возвращает \ref ak_error_ok. В случае
+    возникновения ошибки возвращеется ее код.                                                      */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_hmac_create_tree_streebog512( ak_hmac hctx )
+{ return ak_hmac_create_oid( hctx, ak_oid_find_by_name( "hmac-tree-streebog512" )); }
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \param hctx Контекст алгоритма NMAC выработки имитовставки.
     \return В случае успешного завершения функций возвращает \ref ak_error_ok. В случае
@@ -276,6 +329,9 @@
   int error = ak_error_ok;
   if( hctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
                                                             "using null pointer to hmac context" );
+  hctx->precomputed = ak_false;
+  memset( &hctx->istate, 0, sizeof( struct streebog ));
+  memset( &hctx->ostate, 0, sizeof( struct streebog ));
   if(( error = ak_hash_destroy( &hctx->ctx )) != ak_error_ok )
     ak_error_message( error, __func__, "incorrect destroying of hash context" );
   if(( error = ak_skey_destroy( &hctx->key )) != ak_error_ok )
@@ -303,6 +359,8 @@
   int error = ak_error_ok;
   if( hctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
                                                             "using null pointer to hmac context" );
+ /* ранее вычисленные состояния функции хеширования более не действительны */
+  hctx->precomputed = ak_false;
  /* вспоминаем, что если ключ длиннее, чем длина входного блока хэш-функции, то в качестве
                                                                       ключа используется его хэш */
   if( size > hctx->mctx.bsize ) {
@@ -350,6 +408,8 @@
   int error = ak_error_ok;
   if( hctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
                                                         "using null pointer to hmac context" );
+ /* ранее вычисленные состояния функции хеширования более не действительны */
+  hctx->precomputed = ak_false;
   if(( error = ak_skey_set_key_random( &hctx->key, generator )) != ak_error_ok )
     return ak_error_message( error, __func__ , "incorrect assigning a secret key value" );
 
@@ -385,6 +445,8 @@
   int error = ak_error_ok;
   if( hctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
                                                         "using null pointer to hmac context" );
+ /* ранее вычисленные состояния функции хеширования более не действительны */
+  hctx->precomputed = ak_false;
   if(( error = ak_skey_set_key_from_password( &hctx->key,
                                           pass, pass_size, salt, salt_size )) != ak_error_ok )
     return ak_error_message( error, __func__ , "incorrect assigning a secret key value" );
@@ -465,6 +527,62 @@
  return ak_mac_ptr( &hctx->mctx, in, size, out, out_size );
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет имитовставки для нескольких независимых сообщений, каждое из которых
+    обрабатывается своим ключом, см. ak_hash_update_multi(). Результат совпадает
+    с результатом последовательных вызовов функции ak_hmac_ptr() для каждого сообщения.
+
+    \param hctx Массив указателей на различные контексты алгоритма HMAC.
+    \param in Массив указателей на входные данные для которых вычисляются имитовставки.
+    \param size Массив длин входных данных (в октетах).
+    \param out Массив указателей на области памяти, куда будут помещены результаты.
+    \param out_size Размер каждой из областей памяти (в октетах).
+    \param count Количество сообщений.
+
+    \return В случае успеха функция возвращает ноль (\ref ak_error_ok). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_hmac_ptr_multi( ak_hmac *hctx, const ak_pointer *in, const size_t *size,
+                                       ak_pointer *out, const size_t out_size, const size_t count )
+{
+  ak_hash *lanes = NULL;
+  size_t idx = 0, full = 0;
+  int error = ak_error_ok;
+
+  if(( hctx == NULL ) || ( in == NULL ) || ( size == NULL ) || ( out == NULL ))
+    return ak_error_message( ak_error_null_pointer, __func__, "using null pointer to arrays" );
+  if( !count ) return ak_error_message( ak_error_zero_length, __func__,
+                                                                "using zero number of messages" );
+  if(( lanes = malloc( count*sizeof( ak_hash ))) == NULL )
+    return ak_error_message( ak_error_out_of_memory, __func__,
+                                                        "incorrect memory allocation for lanes" );
+ /* обрабатываем первый блок (ключ, сложенный с константой ipad) */
+  for( idx = 0; idx < count; idx++ ) {
+     if(( error = ak_hmac_clean( hctx[idx] )) != ak_error_ok ) {
+       ak_error_message( error, __func__, "incorrect cleaning of hmac context" );
+       goto exit;
+     }
+     lanes[idx] = &hctx[idx]->ctx;
+  }
+ /* обрабатываем целые блоки сообщений */
+  if(( error = ak_hash_update_multi( lanes, in, size, count )) != ak_error_ok ) {
+    ak_error_message( error, __func__, "incorrect updating of hash contexts" );
+    goto exit;
+  }
+ /* обрабатываем хвосты сообщений и вычисляем результат */
+  for( idx = 0; idx < count; idx++ ) {
+     full = ( size[idx] >> 6 ) << 6;
+     if(( error = ak_hmac_finalize( hctx[idx], full ? ( ak_uint8 *)in[idx] + full : in[idx],
+                                  size[idx] - full, out[idx], out_size )) != ak_error_ok ) {
+       ak_error_message( error, __func__, "incorrect finalizing of hmac context" );
+       goto exit;
+     }
+  }
+
+  exit: free( lanes );
+ return error;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \param hctx Контекст алгоритма HMAC выработки имитовставки.
     \param filename Имя файла, для котрого вычисляется имитовставка.
@@ -479,9 +597,29 @@
  int ak_hmac_file( ak_hmac hctx, const char * filename,
                                                            ak_pointer out, const size_t out_size )
 {
+  struct file file;
+  ak_uint8 tail[64];
+  size_t tail_size = 0;
+  int error = ak_error_ok;
+
   if( hctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
                                                             "using null pointer to hash context" );
- return ak_mac_file( &hctx->mctx, filename, out, out_size );
+  if( !ak_hash_is_tree( &hctx->ctx )) return ak_mac_file( &hctx->mctx, filename, out, out_size );
+
+ /* для древовидного хеширования содержимое файла передается непосредственно во внутренний
+    контекст хеширования, уже обработавший маскированное значение ключа */
+  if( filename == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                                "use a null pointer to filename" );
+  if(( error = ak_file_open_to_read( &file, filename )) != ak_error_ok )
+    return ak_error_message_fmt( error, __func__, "incorrect access to file %s", filename );
+  if(( error = ak_mac_clean( &hctx->mctx )) == ak_error_ok )
+    if(( error = ak_hash_tree_update_file( &hctx->ctx, &file, tail, &tail_size )) == ak_error_ok )
+      error = ak_mac_finalize( &hctx->mctx, tail, tail_size, out, out_size );
+  if( error != ak_error_ok )
+    ak_error_message_fmt( error, __func__, "incorrect processing of file %s", filename );
+
+  ak_file_close( &file );
+ return error;
 }
 
 
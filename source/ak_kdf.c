@@ -326,7 +326,7 @@
                                                   + максимальное количество ключей (8 октетов) */
       state->number = 0;
       state->max = ( ak_uint64 )count;
-      resource = ak_libakrypt_get_option_by_name( "magma_cipher_resource" );
+      resource = ak_libakrypt_get_option_by_index( magma_cipher_resource_option );
       if( state->max*( 1+ state->state_size / state->block_size ) > resource ) {
         ak_error_message_fmt( error = ak_error_low_key_resource, __func__,
                   "the expected number of derivative keys is very large (must be less than %ld)",
@@ -351,7 +351,7 @@
                                                   + максимальное количество ключей (8 октетов) */
       state->number = 0;
       state->max = ( ak_uint64 )count;
-      resource = ak_libakrypt_get_option_by_name( "kuznechik_cipher_resource" );
+      resource = ak_libakrypt_get_option_by_index( kuznechik_cipher_resource_option );
       if( state->max*( 1+ state->state_size / state->block_size ) > resource ) {
         ak_error_message_fmt( error = ak_error_low_key_resource, __func__,
                   "the expected number of derivative keys is very large (must be less than %ld)",
@@ -377,7 +377,7 @@
                                                   + максимальное количество ключей (8 октетов) */
       state->number = 0;
       state->max = ( ak_uint64 )count;
-      resource = ak_libakrypt_get_option_by_name( "hmac_key_count_resource" );
+      resource = ak_libakrypt_get_option_by_index( hmac_key_count_resource_option );
       if( 2*state->max > resource ) {
         ak_error_message_fmt( error = ak_error_low_key_resource, __func__,
                    "the expected number of derivative keys is very large (must be less than %ld)",
@@ -403,7 +403,7 @@
                                                   + максимальное количество ключей (8 октетов) */
       state->number = 0;
       state->max = ( ak_uint64 )count;
-      resource = ak_libakrypt_get_option_by_name( "hmac_key_count_resource" );
+      resource = ak_libakrypt_get_option_by_index( hmac_key_count_resource_option );
       if( 2*state->max > resource ) {
         ak_error_message_fmt( error = ak_error_low_key_resource, __func__,
                    "the expected number of derivative keys is very large (must be less than %ld)",
@@ -429,7 +429,7 @@
                                                   + максимальное количество ключей (8 октетов) */
       state->number = 0;
       state->max = ( ak_uint64 )count;
-      resource = ak_libakrypt_get_option_by_name( "hmac_key_count_resource" );
+      resource = ak_libakrypt_get_option_by_index( hmac_key_count_resource_option );
       if( 2*state->max > resource ) {
         ak_error_message_fmt( error = ak_error_low_key_resource, __func__,
                    "the expected number of derivative keys is very large (must be less than %ld)",
@@ -6,12 +6,18 @@
 /*    регламентированного ГОСТ Р 34.12-2015                                                        */
 /* ----------------------------------------------------------------------------------------------- */
  #include <libakrypt-internal.h>
+ #ifdef AK_HAVE_BUILTIN_XOR_SI128
+  #include <emmintrin.h>
+ #endif
+ #if defined( AK_HAVE_BUILTIN_MM256_GF2P8MUL ) || defined( AK_HAVE_BUILTIN_MM512_GF2P8MUL )
+  #include <immintrin.h>
+ #endif
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Нелинейное биективное преобразование байт, используемое в алгоритмах
     Стрибог (ГОСТ Р 34.11-2012) и Кузнечик (ГОСТ Р 34.12-2015). */
 /* ---------------------------------------------------------------------------------------------- */
- static const sbox gost_pi = {
+ const sbox gost_pi = {
    0xFC, 0xEE, 0xDD, 0x11, 0xCF, 0x6E, 0x31, 0x16, 0xFB, 0xC4, 0xFA, 0xDA, 0x23, 0xC5, 0x04, 0x4D,
    0xE9, 0x77, 0xF0, 0xDB, 0x93, 0x2E, 0x99, 0xBA, 0x17, 0x36, 0xF1, 0xBB, 0x14, 0xCD, 0x5F, 0xC1,
    0xF9, 0x18, 0x65, 0x5A, 0xE2, 0x5C, 0xEF, 0x21, 0x81, 0x1C, 0x3C, 0x42, 0x8B, 0x01, 0x8E, 0x4F,
@@ -227,7 +233,7 @@
  int ak_bckey_kuznechik_init_tables( const linear_register reg,
                                                           const sbox pi, ak_kuznechik_params par )
 {
-  int i, j, l, oc = (int) ak_libakrypt_get_option_by_name( "openssl_compability" );
+  int i, j, l, oc = (int) ak_libakrypt_get_option_by_index( openssl_compability_option );
 
   if(( oc < 0 ) || ( oc > 1 )) return ak_error_message( ak_error_wrong_option, __func__,
                                                 "wrong value for \"openssl_compability\" option" );
@@ -258,6 +264,100 @@
  return ak_error_ok;
 }
 
+#if defined( AK_HAVE_BUILTIN_MM256_GF2P8MUL ) || defined( AK_HAVE_BUILTIN_MM512_GF2P8MUL )
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Параметры алгоритма Кузнечик для реализаций, использующих команды GFNI.
+    \details Команды GFNI выполняют умножение в поле, определяемом многочленом
+    \f$ x^8 + x^4 + x^3 + x + 1\f$, тогда как ГОСТ Р 34.12-2015 использует многочлен
+    \f$ x^8 + x^7 + x^6 + x + 1\f$. Поэтому состояние шифра переводится изоморфизмом
+    \f$ \varphi \f$ в поле GFNI, и все преобразования выполняются над образами байт:
+    таблицы замен заменяются на \f$ \varphi\pi\varphi^{-1} \f$, а коэффициенты линейного
+    преобразования - на их образы. Строки таблиц продублированы для двух 128-ми битных
+    половин векторного регистра.                                                                   */
+/* ----------------------------------------------------------------------------------------------- */
+ static struct kuznechik_gfni_params {
+  /*! \brief Матрица изоморфизма в формате команды `gf2p8affineqb`. */
+   ak_uint64 phi;
+  /*! \brief Матрица обратного изоморфизма. */
+   ak_uint64 phinv;
+  /*! \brief Образ нелинейной перестановки (строка `h` содержит значения для старшей тетрады `h`). */
+   ak_uint8 pi[16][32];
+  /*! \brief Образ обратной нелинейной перестановки. */
+   ak_uint8 pinv[16][32];
+  /*! \brief Образы столбцов матрицы линейного преобразования. */
+   ak_uint8 L[16][32];
+  /*! \brief Образы столбцов обратной матрицы линейного преобразования. */
+   ak_uint8 Linv[16][32];
+ } kuznechik_gfni_parameters;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Умножение элементов поля, определяемого многочленом \f$ x^8 + x^4 + x^3 + x + 1\f$. */
+/* ----------------------------------------------------------------------------------------------- */
+ static ak_uint8 ak_kuznechik_gfni_mul( ak_uint8 x, ak_uint8 y )
+{
+  ak_uint8 z = 0;
+  while( y ) {
+    if( y&0x1 ) z ^= x;
+    x = ((ak_uint8)(x << 1)) ^ ( x & 0x80 ? 0x1B : 0x00 );
+    y >>= 1;
+  }
+ return z;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Формирование матрицы линейного отображения байт для команды `gf2p8affineqb`:
+    i-й бит результата определяется байтом матрицы с номером 7-i. */
+/* ----------------------------------------------------------------------------------------------- */
+ static ak_uint64 ak_kuznechik_gfni_matrix( const ak_uint8 *map )
+{
+  int i = 0, r = 0;
+  ak_uint64 matrix = 0;
+
+  for( r = 0; r < 8; r++ ) {
+     ak_uint64 row = 0;
+     for( i = 0; i < 8; i++ ) row |= (( ak_uint64 )(( map[1 << i] >> r )&1 )) << i;
+     matrix |= row << 8*( 7-r );
+  }
+ return matrix;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вычисляет параметры реализаций, использующих команды GFNI.
+    \param par Параметры алгоритма, содержащие таблицу замен и матрицы линейного преобразования. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_kuznechik_gfni_init_tables( ak_kuznechik_params par )
+{
+  int i = 0, j = 0;
+  ak_uint8 beta = 0, y = 0, power[8], phi[256], phinv[256];
+  struct kuznechik_gfni_params *gp = &kuznechik_gfni_parameters;
+
+ /* ищем корень многочлена x^8 + x^7 + x^6 + x + 1 в поле GFNI */
+  for( beta = 2; beta != 0; beta++ ) {
+     for( y = 1, i = 0; i < 8; i++ ) y = ak_kuznechik_gfni_mul( y, beta );
+     for( power[0] = 1, i = 1; i < 8; i++ ) power[i] = ak_kuznechik_gfni_mul( power[i-1], beta );
+     if(( y ^ power[7] ^ power[6] ^ power[1] ^ power[0] ) == 0 ) break;
+  }
+
+ /* изоморфизм переводит степени образующего элемента в степени найденного корня */
+  for( i = 0; i < 256; i++ ) {
+     for( y = 0, j = 0; j < 8; j++ ) if(( i >> j )&1 ) y ^= power[j];
+     phi[i] = y;
+     phinv[y] = ( ak_uint8 )i;
+  }
+  gp->phi = ak_kuznechik_gfni_matrix( phi );
+  gp->phinv = ak_kuznechik_gfni_matrix( phinv );
+
+  for( i = 0; i < 16; i++ ) {
+     for( j = 0; j < 32; j++ ) {
+        gp->pi[i][j] = phi[par->pi[phinv[16*i + ( j&15 )]]];
+        gp->pinv[i][j] = phi[par->pinv[phinv[16*i + ( j&15 )]]];
+        gp->L[i][j] = phi[par->L[j&15][i]];
+        gp->Linv[i][j] = phi[par->Linv[j&15][i]];
+     }
+  }
+}
+#endif
+
 /* ----------------------------------------------------------------------------------------------- */
  int ak_bckey_kuznechik_init_gost_tables( void )
 {
@@ -267,6 +367,9 @@
   if( error != ak_error_ok )
     return ak_error_message( error, __func__,
                                            "generation of GOST R 34.12-2015 parameters is wrong" );
+ #if defined( AK_HAVE_BUILTIN_MM256_GF2P8MUL ) || defined( AK_HAVE_BUILTIN_MM512_GF2P8MUL )
+  ak_kuznechik_gfni_init_tables( &kuznechik_parameters );
+ #endif
   if( audit >= ak_log_maximum ) return ak_error_message( ak_error_ok, __func__ ,
                                               "generation of GOST R 34.12-2015 parameters is Ok" );
  return ak_error_ok;
@@ -313,7 +416,7 @@
   ak_uint8 reverse[64];
   int i = 0, j = 0, l = 0, kdx = 2;
   ak_uint64 a0[2], a1[2], c[2], t[2], idx = 0;
-  ak_int64 oc = ak_libakrypt_get_option_by_name( "openssl_compability" );
+  ak_int64 oc = ak_libakrypt_get_option_by_index( openssl_compability_option );
   ak_uint64 *ekey = NULL, *mkey = NULL, *dkey = NULL, *xkey = NULL, *rkey = NULL, *lkey = NULL;
 
  /* выполняем стандартные проверки */
@@ -670,6 +773,826 @@
   (( ak_uint64 *) out)[1] = x[1] ^ xkey[1];
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*                  реализация одновременного шифрования нескольких блоков                         */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Количество блоков, преобразуемых одновременно (чередуемых) в многоблочных функциях. */
+ #define ak_kuznechik_lanes  (2)
+
+/*! \brief Обработка октета с номером `k` в каждом из двух одновременно преобразуемых блоков. */
+ #define kuznechik_lanes_lookup( tab, l, k ) \
+   t0 ^= tab[l][b0[k]][0]; s0 ^= tab[l][b0[k]][1]; \
+   t1 ^= tab[l][b1[k]][0]; s1 ^= tab[l][b1[k]][1];
+
+/*! \brief Линейное и нелинейное преобразования одного раунда для двух блоков.
+    Порядок октетов определяется флагом совместимости `oc`. */
+ #define kuznechik_lanes_round( tab ) \
+   t0 = s0 = t1 = s1 = 0; \
+   kuznechik_lanes_lookup( tab,  0, oc ? 15 :  0 ) \
+   kuznechik_lanes_lookup( tab,  1, oc ? 14 :  1 ) \
+   kuznechik_lanes_lookup( tab,  2, oc ? 13 :  2 ) \
+   kuznechik_lanes_lookup( tab,  3, oc ? 12 :  3 ) \
+   kuznechik_lanes_lookup( tab,  4, oc ? 11 :  4 ) \
+   kuznechik_lanes_lookup( tab,  5, oc ? 10 :  5 ) \
+   kuznechik_lanes_lookup( tab,  6, oc ?  9 :  6 ) \
+   kuznechik_lanes_lookup( tab,  7, oc ?  8 :  7 ) \
+   kuznechik_lanes_lookup( tab,  8, oc ?  7 :  8 ) \
+   kuznechik_lanes_lookup( tab,  9, oc ?  6 :  9 ) \
+   kuznechik_lanes_lookup( tab, 10, oc ?  5 : 10 ) \
+   kuznechik_lanes_lookup( tab, 11, oc ?  4 : 11 ) \
+   kuznechik_lanes_lookup( tab, 12, oc ?  3 : 12 ) \
+   kuznechik_lanes_lookup( tab, 13, oc ?  2 : 13 ) \
+   kuznechik_lanes_lookup( tab, 14, oc ?  1 : 14 ) \
+   kuznechik_lanes_lookup( tab, 15, oc ?  0 : 15 )
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция реализует алгоритм зашифрования двух независимых блоков.
+
+    Раунды для обоих блоков выполняются одновременно, что позволяет процессору совмещать
+    обращения к таблицам, относящиеся к различным блокам, и не ждать завершения вычислений
+    над одним блоком перед началом обработки следующего.
+
+    @param skey Контекст секретного ключа.
+    @param in Указатель на два блока входной информации.
+    @param out Указатель на два блока выходной информации.
+    @param oc Флаг совместимости с библиотекой openssl.                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_kuznechik_encrypt_lanes( ak_skey skey, ak_uint64 *in, ak_uint64 *out,
+                                                                                  const int oc )
+{
+  int i = 0;
+  ak_uint64 *ekey = ( ak_uint64 *)skey->data;
+  ak_uint64 *mkey = ( ak_uint64 *)skey->data + 40;
+  ak_uint64 t0, s0, t1, s1, x0[2], x1[2];
+  ak_uint8 *b0 = ( ak_uint8 *)x0, *b1 = ( ak_uint8 *)x1;
+
+  x0[0] = in[0]; x0[1] = in[1];
+  x1[0] = in[2]; x1[1] = in[3];
+  for( i = 0; i < 18; i += 2 ) {
+     x0[0] ^= ekey[i]; x0[0] ^= mkey[i]; x0[1] ^= ekey[i+1]; x0[1] ^= mkey[i+1];
+     x1[0] ^= ekey[i]; x1[0] ^= mkey[i]; x1[1] ^= ekey[i+1]; x1[1] ^= mkey[i+1];
+     kuznechik_lanes_round( kuznechik_parameters.enc )
+     x0[0] = t0; x0[1] = s0;
+     x1[0] = t1; x1[1] = s1;
+  }
+  x0[0] ^= ekey[18]; x0[1] ^= ekey[19];
+  x1[0] ^= ekey[18]; x1[1] ^= ekey[19];
+  out[0] = x0[0] ^ mkey[18]; out[1] = x0[1] ^ mkey[19];
+  out[2] = x1[0] ^ mkey[18]; out[3] = x1[1] ^ mkey[19];
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция реализует алгоритм расшифрования двух независимых блоков.
+
+    @param skey Контекст секретного ключа.
+    @param in Указатель на два блока входной информации.
+    @param out Указатель на два блока выходной информации.
+    @param oc Флаг совместимости с библиотекой openssl.                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_kuznechik_decrypt_lanes( ak_skey skey, ak_uint64 *in, ak_uint64 *out,
+                                                                                  const int oc )
+{
+  int i = 0;
+  ak_uint64 *dkey = ( ak_uint64 *)skey->data + 20;
+  ak_uint64 *xkey = ( ak_uint64 *)skey->data + 60;
+  ak_uint64 t0, s0, t1, s1, x0[2], x1[2];
+  ak_uint8 *b0 = ( ak_uint8 *)x0, *b1 = ( ak_uint8 *)x1;
+
+  x0[0] = in[0]; x0[1] = in[1];
+  x1[0] = in[2]; x1[1] = in[3];
+  for( i = 0; i < 16; i++ ) {
+     b0[i] = kuznechik_parameters.pi[b0[i]];
+     b1[i] = kuznechik_parameters.pi[b1[i]];
+  }
+  for( i = 19; i > 1; i -= 2 ) {
+     kuznechik_lanes_round( kuznechik_parameters.dec )
+     x0[1] = s0; x0[1] ^= dkey[i]; x0[1] ^= xkey[i];
+     x1[1] = s1; x1[1] ^= dkey[i]; x1[1] ^= xkey[i];
+     x0[0] = t0; x0[0] ^= dkey[i-1]; x0[0] ^= xkey[i-1];
+     x1[0] = t1; x1[0] ^= dkey[i-1]; x1[0] ^= xkey[i-1];
+  }
+  for( i = 0; i < 16; i++ ) {
+     b0[i] = kuznechik_parameters.pinv[b0[i]];
+     b1[i] = kuznechik_parameters.pinv[b1[i]];
+  }
+  x0[0] ^= dkey[0]; x0[1] ^= dkey[1];
+  x1[0] ^= dkey[0]; x1[1] ^= dkey[1];
+  out[0] = x0[0] ^ xkey[0]; out[1] = x0[1] ^ xkey[1];
+  out[2] = x1[0] ^ xkey[0]; out[3] = x1[1] ^ xkey[1];
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция реализует алгоритм зашифрования последовательности блоков информации
+    шифром Кузнечик (согласно ГОСТ Р 34.12-2015).
+
+    @param skey Контекст секретного ключа.
+    @param in Указатель на последовательность блоков входной информации.
+    @param out Указатель на последовательность блоков выходной информации
+    (этот указатель может совпадать с `in`).
+    @param blocks Количество обрабатываемых блоков.                                                */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_kuznechik_encrypt_blocks_with_mask( ak_skey skey,
+                                                  ak_pointer in, ak_pointer out, size_t blocks )
+{
+  ak_uint64 *inptr = ( ak_uint64 *)in, *outptr = ( ak_uint64 *)out;
+
+  for( ; blocks >= ak_kuznechik_lanes; blocks -= ak_kuznechik_lanes ) {
+     ak_kuznechik_encrypt_lanes( skey, inptr, outptr, 0 );
+     inptr += 2*ak_kuznechik_lanes; outptr += 2*ak_kuznechik_lanes;
+  }
+  for( ; blocks > 0; blocks--, inptr += 2, outptr += 2 )
+     ak_kuznechik_encrypt_with_mask( skey, inptr, outptr );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция реализует алгоритм расшифрования последовательности блоков информации
+    шифром Кузнечик (согласно ГОСТ Р 34.12-2015).                                                  */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_kuznechik_decrypt_blocks_with_mask( ak_skey skey,
+                                                  ak_pointer in, ak_pointer out, size_t blocks )
+{
+  ak_uint64 *inptr = ( ak_uint64 *)in, *outptr = ( ak_uint64 *)out;
+
+  for( ; blocks >= ak_kuznechik_lanes; blocks -= ak_kuznechik_lanes ) {
+     ak_kuznechik_decrypt_lanes( skey, inptr, outptr, 0 );
+     inptr += 2*ak_kuznechik_lanes; outptr += 2*ak_kuznechik_lanes;
+  }
+  for( ; blocks > 0; blocks--, inptr += 2, outptr += 2 )
+     ak_kuznechik_decrypt_with_mask( skey, inptr, outptr );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция реализует алгоритм зашифрования последовательности блоков информации
+    шифром Кузнечик в режиме совместимости с библиотекой openssl.                                  */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_kuznechik_encrypt_blocks_with_mask_oc( ak_skey skey,
+                                                  ak_pointer in, ak_pointer out, size_t blocks )
+{
+  ak_uint64 *inptr = ( ak_uint64 *)in, *outptr = ( ak_uint64 *)out;
+
+  for( ; blocks >= ak_kuznechik_lanes; blocks -= ak_kuznechik_lanes ) {
+     ak_kuznechik_encrypt_lanes( skey, inptr, outptr, 1 );
+     inptr += 2*ak_kuznechik_lanes; outptr += 2*ak_kuznechik_lanes;
+  }
+  for( ; blocks > 0; blocks--, inptr += 2, outptr += 2 )
+     ak_kuznechik_encrypt_with_mask_oc( skey, inptr, outptr );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция реализует алгоритм расшифрования последовательности блоков информации
+    шифром Кузнечик в режиме совместимости с библиотекой openssl.                                  */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_kuznechik_decrypt_blocks_with_mask_oc( ak_skey skey,
+                                                  ak_pointer in, ak_pointer out, size_t blocks )
+{
+  ak_uint64 *inptr = ( ak_uint64 *)in, *outptr = ( ak_uint64 *)out;
+
+  for( ; blocks >= ak_kuznechik_lanes; blocks -= ak_kuznechik_lanes ) {
+     ak_kuznechik_decrypt_lanes( skey, inptr, outptr, 1 );
+     inptr += 2*ak_kuznechik_lanes; outptr += 2*ak_kuznechik_lanes;
+  }
+  for( ; blocks > 0; blocks--, inptr += 2, outptr += 2 )
+     ak_kuznechik_decrypt_with_mask_oc( skey, inptr, outptr );
+}
+
+#ifdef AK_HAVE_BUILTIN_XOR_SI128
+/* ----------------------------------------------------------------------------------------------- */
+/*                  реализация многоблочных функций с использованием команд SSE2                   */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Количество блоков, одновременно обрабатываемых SSE2 реализацией алгоритма Кузнечик. */
+ #define ak_kuznechik_sse2_lanes (4)
+
+/*! \brief Сложение 128-ми битного регистра со строкой развернутой таблицы,
+    определяемой l-м байтом (с учетом порядка k) каждого из обрабатываемых блоков. */
+ #define kuznechik_sse2_lookup( tab, l, k ) \
+   for( j = 0; j < ak_kuznechik_sse2_lanes; j++ ) \
+      y[j] = _mm_xor_si128( y[j], \
+                         _mm_loadu_si128(( const __m128i *)kuznechik_parameters.tab[l][b[j][k]] ));
+
+/*! \brief Один раунд преобразования LS (или обратного к нему) для всех обрабатываемых блоков. */
+ #define kuznechik_sse2_round( tab ) \
+   for( j = 0; j < ak_kuznechik_sse2_lanes; j++ ) { \
+      _mm_storeu_si128(( __m128i *)b[j], x[j] ); y[j] = _mm_setzero_si128(); \
+   } \
+   kuznechik_sse2_lookup( tab,  0, oc ? 15 :  0 ) \
+   kuznechik_sse2_lookup( tab,  1, oc ? 14 :  1 ) \
+   kuznechik_sse2_lookup( tab,  2, oc ? 13 :  2 ) \
+   kuznechik_sse2_lookup( tab,  3, oc ? 12 :  3 ) \
+   kuznechik_sse2_lookup( tab,  4, oc ? 11 :  4 ) \
+   kuznechik_sse2_lookup( tab,  5, oc ? 10 :  5 ) \
+   kuznechik_sse2_lookup( tab,  6, oc ?  9 :  6 ) \
+   kuznechik_sse2_lookup( tab,  7, oc ?  8 :  7 ) \
+   kuznechik_sse2_lookup( tab,  8, oc ?  7 :  8 ) \
+   kuznechik_sse2_lookup( tab,  9, oc ?  6 :  9 ) \
+   kuznechik_sse2_lookup( tab, 10, oc ?  5 : 10 ) \
+   kuznechik_sse2_lookup( tab, 11, oc ?  4 : 11 ) \
+   kuznechik_sse2_lookup( tab, 12, oc ?  3 : 12 ) \
+   kuznechik_sse2_lookup( tab, 13, oc ?  2 : 13 ) \
+   kuznechik_sse2_lookup( tab, 14, oc ?  1 : 14 ) \
+   kuznechik_sse2_lookup( tab, 15, oc ?  0 : 15 )
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция реализует алгоритм зашифрования четырех независимых блоков.
+
+    Каждая строка развернутой таблицы занимает ровно 128 бит, поэтому ее сложение с
+    текущим значением блока выполняется одной командой, а преобразования четырех блоков
+    выполняются одновременно.
+
+    @param skey Контекст секретного ключа.
+    @param in Указатель на четыре блока входной информации.
+    @param out Указатель на четыре блока выходной информации.
+    @param oc Флаг совместимости с библиотекой openssl.                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_kuznechik_sse2_encrypt_lanes( ak_skey skey, ak_uint64 *in,
+                                                                ak_uint64 *out, const int oc )
+{
+  int i = 0, j = 0;
+  ak_uint64 *ekey = ( ak_uint64 *)skey->data;
+  ak_uint64 *mkey = ( ak_uint64 *)skey->data + 40;
+  ak_uint8 b[ak_kuznechik_sse2_lanes][16];
+  __m128i k, m, x[ak_kuznechik_sse2_lanes], y[ak_kuznechik_sse2_lanes];
+
+  for( j = 0; j < ak_kuznechik_sse2_lanes; j++ )
+     x[j] = _mm_loadu_si128(( const __m128i *)( in + 2*j ));
+  for( i = 0; i < 18; i += 2 ) {
+     k = _mm_loadu_si128(( const __m128i *)( ekey + i ));
+     m = _mm_loadu_si128(( const __m128i *)( mkey + i ));
+     for( j = 0; j < ak_kuznechik_sse2_lanes; j++ ) x[j] = _mm_xor_si128( _mm_xor_si128( x[j], k ), m );
+     kuznechik_sse2_round( enc )
+     for( j = 0; j < ak_kuznechik_sse2_lanes; j++ ) x[j] = y[j];
+  }
+  k = _mm_loadu_si128(( const __m128i *)( ekey + 18 ));
+  m = _mm_loadu_si128(( const __m128i *)( mkey + 18 ));
+  for( j = 0; j < ak_kuznechik_sse2_lanes; j++ )
+     _mm_storeu_si128(( __m128i *)( out + 2*j ), _mm_xor_si128( _mm_xor_si128( x[j], k ), m ));
+ /* очищаем стек */
+  memset( b, 0, sizeof( b ));
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция реализует алгоритм расшифрования четырех независимых блоков.
+
+    @param skey Контекст секретного ключа.
+    @param in Указатель на четыре блока входной информации.
+    @param out Указатель на четыре блока выходной информации.
+    @param oc Флаг совместимости с библиотекой openssl.                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_kuznechik_sse2_decrypt_lanes( ak_skey skey, ak_uint64 *in,
+                                                                ak_uint64 *out, const int oc )
+{
+  int i = 0, j = 0, l = 0;
+  ak_uint64 *dkey = ( ak_uint64 *)skey->data + 20;
+  ak_uint64 *xkey = ( ak_uint64 *)skey->data + 60;
+  ak_uint8 b[ak_kuznechik_sse2_lanes][16];
+  __m128i k, m, x[ak_kuznechik_sse2_lanes], y[ak_kuznechik_sse2_lanes];
+
+  memcpy( b, in, sizeof( b ));
+  for( j = 0; j < ak_kuznechik_sse2_lanes; j++ ) {
+     for( l = 0; l < 16; l++ ) b[j][l] = kuznechik_parameters.pi[b[j][l]];
+     x[j] = _mm_loadu_si128(( const __m128i *)b[j] );
+  }
+  for( i = 19; i > 2; i -= 2 ) {
+     kuznechik_sse2_round( dec )
+     k = _mm_loadu_si128(( const __m128i *)( dkey + i - 1 ));
+     m = _mm_loadu_si128(( const __m128i *)( xkey + i - 1 ));
+     for( j = 0; j < ak_kuznechik_sse2_lanes; j++ ) x[j] = _mm_xor_si128( _mm_xor_si128( y[j], k ), m );
+  }
+  k = _mm_loadu_si128(( const __m128i *)dkey );
+  m = _mm_loadu_si128(( const __m128i *)xkey );
+  for( j = 0; j < ak_kuznechik_sse2_lanes; j++ ) {
+     _mm_storeu_si128(( __m128i *)b[j], x[j] );
+     for( l = 0; l < 16; l++ ) b[j][l] = kuznechik_parameters.pinv[b[j][l]];
+     x[j] = _mm_loadu_si128(( const __m128i *)b[j] );
+     _mm_storeu_si128(( __m128i *)( out + 2*j ), _mm_xor_si128( _mm_xor_si128( x[j], k ), m ));
+  }
+ /* очищаем стек */
+  memset( b, 0, sizeof( b ));
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Многоблочное зашифрование с использованием команд SSE2. */
+ static void ak_kuznechik_sse2_encrypt_blocks( ak_skey skey, ak_pointer in, ak_pointer out,
+                                                                                  size_t blocks )
+{
+  ak_uint64 *inptr = ( ak_uint64 *)in, *outptr = ( ak_uint64 *)out;
+
+  for( ; blocks >= ak_kuznechik_sse2_lanes; blocks -= ak_kuznechik_sse2_lanes ) {
+     ak_kuznechik_sse2_encrypt_lanes( skey, inptr, outptr, 0 );
+     inptr += 2*ak_kuznechik_sse2_lanes; outptr += 2*ak_kuznechik_sse2_lanes;
+  }
+  ak_kuznechik_encrypt_blocks_with_mask( skey, inptr, outptr, blocks );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Многоблочное зашифрование с использованием команд SSE2
+    (режим совместимости с openssl). */
+ static void ak_kuznechik_sse2_encrypt_blocks_oc( ak_skey skey, ak_pointer in, ak_pointer out,
+                                                                                  size_t blocks )
+{
+  ak_uint64 *inptr = ( ak_uint64 *)in, *outptr = ( ak_uint64 *)out;
+
+  for( ; blocks >= ak_kuznechik_sse2_lanes; blocks -= ak_kuznechik_sse2_lanes ) {
+     ak_kuznechik_sse2_encrypt_lanes( skey, inptr, outptr, 1 );
+     inptr += 2*ak_kuznechik_sse2_lanes; outptr += 2*ak_kuznechik_sse2_lanes;
+  }
+  ak_kuznechik_encrypt_blocks_with_mask_oc( skey, inptr, outptr, blocks );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Многоблочное расшифрование с использованием команд SSE2. */
+ static void ak_kuznechik_sse2_decrypt_blocks( ak_skey skey, ak_pointer in, ak_pointer out,
+                                                                                  size_t blocks )
+{
+  ak_uint64 *inptr = ( ak_uint64 *)in, *outptr = ( ak_uint64 *)out;
+
+  for( ; blocks >= ak_kuznechik_sse2_lanes; blocks -= ak_kuznechik_sse2_lanes ) {
+     ak_kuznechik_sse2_decrypt_lanes( skey, inptr, outptr, 0 );
+     inptr += 2*ak_kuznechik_sse2_lanes; outptr += 2*ak_kuznechik_sse2_lanes;
+  }
+  ak_kuznechik_decrypt_blocks_with_mask( skey, inptr, outptr, blocks );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Многоблочное расшифрование с использованием команд SSE2
+    (режим совместимости с openssl). */
+ static void ak_kuznechik_sse2_decrypt_blocks_oc( ak_skey skey, ak_pointer in, ak_pointer out,
+                                                                                  size_t blocks )
+{
+  ak_uint64 *inptr = ( ak_uint64 *)in, *outptr = ( ak_uint64 *)out;
+
+  for( ; blocks >= ak_kuznechik_sse2_lanes; blocks -= ak_kuznechik_sse2_lanes ) {
+     ak_kuznechik_sse2_decrypt_lanes( skey, inptr, outptr, 1 );
+     inptr += 2*ak_kuznechik_sse2_lanes; outptr += 2*ak_kuznechik_sse2_lanes;
+  }
+  ak_kuznechik_decrypt_blocks_with_mask_oc( skey, inptr, outptr, blocks );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка того, что процессор поддерживает команды SSE2. */
+ static bool_t ak_kuznechik_sse2_is_supported( void )
+{
+ #ifdef AK_HAVE_BUILTIN_CPU_SUPPORTS
+  __builtin_cpu_init();
+  if( __builtin_cpu_supports( "sse2" )) return ak_true;
+  return ak_false;
+ #else
+  return ak_true;
+ #endif
+}
+#endif
+
+#if defined( AK_HAVE_BUILTIN_MM256_GF2P8MUL ) || defined( AK_HAVE_BUILTIN_MM512_GF2P8MUL )
+/* ----------------------------------------------------------------------------------------------- */
+/*                 бестабличные реализации многоблочных функций (команды GFNI)                     */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Количество векторных регистров, обрабатываемых одновременно (чередуемых). */
+ #define ak_kuznechik_gfni_groups (2)
+
+/*! \brief Перестановка, обращающая порядок байт в каждой 128-ми битной половине регистра
+    (используется в режиме совместимости с openssl). */
+ static const ak_uint8 kuznechik_gfni_reverse[32] = {
+   15, 14, 13, 12, 11, 10,  9,  8,  7,  6,  5,  4,  3,  2,  1,  0,
+   15, 14, 13, 12, 11, 10,  9,  8,  7,  6,  5,  4,  3,  2,  1,  0
+ };
+#endif
+
+#ifdef AK_HAVE_BUILTIN_MM256_GF2P8MUL
+/*! \brief Количество блоков, обрабатываемых за один вызов AVX2 реализации. */
+ #define ak_kuznechik_gfni_lanes ( 2*ak_kuznechik_gfni_groups )
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Нелинейное преобразование байт двух блоков без обращений к памяти по секретным адресам.
+
+    Для каждой из шестнадцати возможных старших тетрад `h` из байт вычитается величина `16h`;
+    после сложения с насыщением с константой `0x70` старший бит остается нулевым только у тех
+    байт, старшая тетрада которых совпадала с `h`. Команда `pshufb` выбирает для них значение из
+    строки `h` таблицы по младшей тетраде и обнуляет все остальные байты.
+
+    @param x Образы байт двух блоков.
+    @param tab Строки образа таблицы замен.
+    @return Результат преобразования.                                                              */
+/* ----------------------------------------------------------------------------------------------- */
+ __attribute__((target("avx2,gfni")))
+ static inline __m256i ak_kuznechik_gfni_sbox( __m256i x, ak_uint8 (*tab)[32] )
+{
+  int h = 0;
+  const __m256i step = _mm256_set1_epi8( 0x10 ), bias = _mm256_set1_epi8( 0x70 );
+  __m256i r = _mm256_setzero_si256();
+
+  for( h = 0; h < 16; h++ ) {
+     r = _mm256_xor_si256( r, _mm256_shuffle_epi8(
+                     _mm256_loadu_si256(( const __m256i *)tab[h] ), _mm256_adds_epu8( x, bias )));
+     x = _mm256_sub_epi8( x, step );
+  }
+ return r;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Линейное преобразование двух блоков: j-й байт каждого блока размножается по всему
+    блоку и умножается командой `gf2p8mulb` на образ j-го столбца матрицы.
+
+    @param x Образы байт двух блоков.
+    @param col Образы столбцов матрицы линейного преобразования.
+    @return Результат преобразования.                                                              */
+/* ----------------------------------------------------------------------------------------------- */
+ __attribute__((target("avx2,gfni")))
+ static inline __m256i ak_kuznechik_gfni_linear( __m256i x, ak_uint8 (*col)[32] )
+{
+  int j = 0;
+  __m256i r = _mm256_setzero_si256();
+
+  for( j = 0; j < 16; j++ )
+     r = _mm256_xor_si256( r, _mm256_gf2p8mul_epi8( _mm256_shuffle_epi8( x,
+                     _mm256_set1_epi8(( char )j )), _mm256_loadu_si256(( const __m256i *)col[j] )));
+ return r;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция преобразования четырех блоков с использованием команд AVX2 и GFNI.
+
+    Раундовые ключи и маски, переведенные изоморфизмом в поле GFNI, вычисляются один раз для
+    всей последовательности блоков и передаются функции в массиве `rkey`
+    (ключ и маска для каждого из десяти раундов).
+
+    @param rkey Образы раундовых ключей и масок.
+    @param in Указатель на четыре блока входной информации.
+    @param out Указатель на четыре блока выходной информации.
+    @param decrypt Флаг расшифрования.
+    @param oc Флаг совместимости с библиотекой openssl.                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ __attribute__((target("avx2,gfni")))
+ static inline void ak_kuznechik_gfni_lanes_transform( const __m256i *rkey, ak_uint64 *in,
+                                                    ak_uint64 *out, const int decrypt, const int oc )
+{
+  int i = 0, g = 0;
+  struct kuznechik_gfni_params *gp = &kuznechik_gfni_parameters;
+  const __m256i reverse = _mm256_loadu_si256(( const __m256i *)kuznechik_gfni_reverse ),
+                phi = _mm256_set1_epi64x(( long long )gp->phi ),
+                phinv = _mm256_set1_epi64x(( long long )gp->phinv );
+  __m256i x[ak_kuznechik_gfni_groups];
+
+  for( g = 0; g < ak_kuznechik_gfni_groups; g++ ) {
+     x[g] = _mm256_loadu_si256(( const __m256i *)( in + 4*g ));
+     if( oc ) x[g] = _mm256_shuffle_epi8( x[g], reverse );
+     x[g] = _mm256_gf2p8affine_epi64_epi8( x[g], phi, 0 );
+  }
+  if( decrypt ) {
+    for( g = 0; g < ak_kuznechik_gfni_groups; g++ )
+       x[g] = _mm256_xor_si256( _mm256_xor_si256( x[g], rkey[18] ), rkey[19] );
+    for( i = 16; i >= 0; i -= 2 ) {
+       for( g = 0; g < ak_kuznechik_gfni_groups; g++ ) {
+          x[g] = ak_kuznechik_gfni_sbox( ak_kuznechik_gfni_linear( x[g], gp->Linv ), gp->pinv );
+          x[g] = _mm256_xor_si256( _mm256_xor_si256( x[g], rkey[i] ), rkey[i+1] );
+       }
+    }
+  } else {
+      for( i = 0; i < 18; i += 2 ) {
+         for( g = 0; g < ak_kuznechik_gfni_groups; g++ ) {
+            x[g] = _mm256_xor_si256( _mm256_xor_si256( x[g], rkey[i] ), rkey[i+1] );
+            x[g] = ak_kuznechik_gfni_linear( ak_kuznechik_gfni_sbox( x[g], gp->pi ), gp->L );
+         }
+      }
+      for( g = 0; g < ak_kuznechik_gfni_groups; g++ )
+         x[g] = _mm256_xor_si256( _mm256_xor_si256( x[g], rkey[18] ), rkey[19] );
+    }
+  for( g = 0; g < ak_kuznechik_gfni_groups; g++ ) {
+     x[g] = _mm256_gf2p8affine_epi64_epi8( x[g], phinv, 0 );
+     if( oc ) x[g] = _mm256_shuffle_epi8( x[g], reverse );
+     _mm256_storeu_si256(( __m256i *)( out + 4*g ), x[g] );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция преобразования последовательности блоков с использованием команд AVX2 и GFNI.
+
+    Остаток, содержащий менее четырех блоков, дополняется до четырех блоков во временном буфере,
+    поэтому таблицы в памяти не используются ни для одного блока.                                  */
+/* ----------------------------------------------------------------------------------------------- */
+ __attribute__((target("avx2,gfni")))
+ static inline void ak_kuznechik_gfni_transform_blocks( ak_skey skey, ak_pointer in,
+                                     ak_pointer out, size_t blocks, const int decrypt, const int oc )
+{
+  int i = 0;
+  ak_uint64 *inptr = ( ak_uint64 *)in, *outptr = ( ak_uint64 *)out;
+  ak_uint64 buffer[2*ak_kuznechik_gfni_lanes];
+  __m256i rkey[20];
+  const __m256i reverse = _mm256_loadu_si256(( const __m256i *)kuznechik_gfni_reverse ),
+                phi = _mm256_set1_epi64x(( long long )kuznechik_gfni_parameters.phi );
+
+ /* ключи и маски переводятся в поле GFNI по отдельности, что возможно в силу линейности
+    изоморфизма; значения ключей в явном виде не вычисляются */
+  for( i = 0; i < 20; i++ ) {
+     rkey[i] = _mm256_broadcastsi128_si256( _mm_loadu_si128(( const __m128i *)
+                              (( ak_uint64 *)skey->data + ( i&1 ? 40 : 0 ) + 2*( i >> 1 ))));
+     if( oc ) rkey[i] = _mm256_shuffle_epi8( rkey[i], reverse );
+     rkey[i] = _mm256_gf2p8affine_epi64_epi8( rkey[i], phi, 0 );
+  }
+
+  for( ; blocks >= ak_kuznechik_gfni_lanes; blocks -= ak_kuznechik_gfni_lanes ) {
+     ak_kuznechik_gfni_lanes_transform( rkey, inptr, outptr, decrypt, oc );
+     inptr += 2*ak_kuznechik_gfni_lanes; outptr += 2*ak_kuznechik_gfni_lanes;
+  }
+  if( blocks > 0 ) {
+    memset( buffer, 0, sizeof( buffer ));
+    memcpy( buffer, inptr, 16*blocks );
+    ak_kuznechik_gfni_lanes_transform( rkey, buffer, buffer, decrypt, oc );
+    memcpy( outptr, buffer, 16*blocks );
+  }
+ /* очищаем стек; обычный вызов memset() для неиспользуемых далее массивов
+    может быть удален компилятором */
+  ak_ptr_wipe( rkey, sizeof( rkey ), &skey->generator );
+  ak_ptr_wipe( buffer, sizeof( buffer ), &skey->generator );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Многоблочное зашифрование с использованием команд AVX2 и GFNI. */
+ __attribute__((target("avx2,gfni")))
+ static void ak_kuznechik_gfni_encrypt_blocks( ak_skey skey, ak_pointer in, ak_pointer out,
+                                                                                  size_t blocks )
+{
+  ak_kuznechik_gfni_transform_blocks( skey, in, out, blocks, 0, 0 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Многоблочное зашифрование с использованием команд AVX2 и GFNI
+    (режим совместимости с openssl). */
+ __attribute__((target("avx2,gfni")))
+ static void ak_kuznechik_gfni_encrypt_blocks_oc( ak_skey skey, ak_pointer in, ak_pointer out,
+                                                                                  size_t blocks )
+{
+  ak_kuznechik_gfni_transform_blocks( skey, in, out, blocks, 0, 1 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Многоблочное расшифрование с использованием команд AVX2 и GFNI. */
+ __attribute__((target("avx2,gfni")))
+ static void ak_kuznechik_gfni_decrypt_blocks( ak_skey skey, ak_pointer in, ak_pointer out,
+                                                                                  size_t blocks )
+{
+  ak_kuznechik_gfni_transform_blocks( skey, in, out, blocks, 1, 0 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Многоблочное расшифрование с использованием команд AVX2 и GFNI
+    (режим совместимости с openssl). */
+ __attribute__((target("avx2,gfni")))
+ static void ak_kuznechik_gfni_decrypt_blocks_oc( ak_skey skey, ak_pointer in, ak_pointer out,
+                                                                                  size_t blocks )
+{
+  ak_kuznechik_gfni_transform_blocks( skey, in, out, blocks, 1, 1 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка того, что процессор поддерживает команды AVX2 и GFNI. */
+ static bool_t ak_kuznechik_gfni_is_supported( void )
+{
+ #ifdef AK_HAVE_BUILTIN_CPU_SUPPORTS
+  __builtin_cpu_init();
+  if( __builtin_cpu_supports( "avx2" ) && __builtin_cpu_supports( "gfni" )) return ak_true;
+ #endif
+ return ak_false;
+}
+#endif
+
+#ifdef AK_HAVE_BUILTIN_MM512_GF2P8MUL
+/*! \brief Количество блоков, обрабатываемых за один вызов AVX-512 реализации. */
+ #define ak_kuznechik_avx512_lanes ( 4*ak_kuznechik_gfni_groups )
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Нелинейное преобразование байт четырех блоков.
+
+    Таблица замен целиком размещается в четырех регистрах: команда `vpermi2b` выбирает значения
+    для байт с нулевым и единичным старшим битом из первой и второй половин таблицы, а нужный
+    результат определяется маской, составленной из старших бит байт.
+
+    @param x Образы байт четырех блоков.
+    @param tab Образ таблицы замен, размещенный в четырех регистрах.
+    @return Результат преобразования.                                                              */
+/* ----------------------------------------------------------------------------------------------- */
+ __attribute__((target("avx512bw,avx512vbmi,gfni")))
+ static inline __m512i ak_kuznechik_avx512_sbox( __m512i x, const __m512i *tab )
+{
+ return _mm512_mask_blend_epi8( _mm512_movepi8_mask( x ),
+                                            _mm512_permutex2var_epi8( tab[0], x, tab[1] ),
+                                            _mm512_permutex2var_epi8( tab[2], x, tab[3] ));
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Линейное преобразование четырех блоков (см. описание функции
+    ak_kuznechik_gfni_linear()). */
+/* ----------------------------------------------------------------------------------------------- */
+ __attribute__((target("avx512bw,avx512vbmi,gfni")))
+ static inline __m512i ak_kuznechik_avx512_linear( __m512i x, const __m512i *col )
+{
+  int j = 0;
+  __m512i r = _mm512_setzero_si512();
+
+  for( j = 0; j < 16; j++ )
+     r = _mm512_xor_si512( r, _mm512_gf2p8mul_epi8(
+                                 _mm512_shuffle_epi8( x, _mm512_set1_epi8(( char )j )), col[j] ));
+ return r;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция преобразования последовательности блоков с использованием команд AVX-512
+    и GFNI (см. описание функции ak_kuznechik_gfni_transform_blocks()).
+
+    Образы таблицы замен и столбцов матрицы загружаются в регистры один раз для всей
+    последовательности блоков.                                                                     */
+/* ----------------------------------------------------------------------------------------------- */
+ __attribute__((target("avx512bw,avx512vbmi,gfni")))
+ static inline void ak_kuznechik_avx512_transform_blocks( ak_skey skey, ak_pointer in,
+                                     ak_pointer out, size_t blocks, const int decrypt, const int oc )
+{
+  int i = 0, g = 0;
+  ak_uint64 *inptr = ( ak_uint64 *)in, *outptr = ( ak_uint64 *)out;
+  ak_uint64 buffer[2*ak_kuznechik_avx512_lanes];
+  struct kuznechik_gfni_params *gp = &kuznechik_gfni_parameters;
+  ak_uint8 (*sbox)[32] = decrypt ? gp->pinv : gp->pi,
+           (*matrix)[32] = decrypt ? gp->Linv : gp->L;
+  const __m512i reverse = _mm512_broadcast_i32x4(
+                                      _mm_loadu_si128(( const __m128i *)kuznechik_gfni_reverse )),
+                phi = _mm512_set1_epi64(( long long )gp->phi ),
+                phinv = _mm512_set1_epi64(( long long )gp->phinv );
+  __m512i tab[4], col[16], rkey[20], x[ak_kuznechik_gfni_groups];
+
+  for( i = 0; i < 4; i++ ) tab[i] = _mm512_inserti64x4( _mm512_castsi256_si512(
+       _mm256_set_m128i( _mm_loadu_si128(( const __m128i *)sbox[4*i+1] ),
+                         _mm_loadu_si128(( const __m128i *)sbox[4*i] ))),
+       _mm256_set_m128i( _mm_loadu_si128(( const __m128i *)sbox[4*i+3] ),
+                         _mm_loadu_si128(( const __m128i *)sbox[4*i+2] )), 1 );
+  for( i = 0; i < 16; i++ )
+     col[i] = _mm512_broadcast_i32x4( _mm_loadu_si128(( const __m128i *)matrix[i] ));
+  for( i = 0; i < 20; i++ ) {
+     rkey[i] = _mm512_broadcast_i32x4( _mm_loadu_si128(( const __m128i *)
+                              (( ak_uint64 *)skey->data + ( i&1 ? 40 : 0 ) + 2*( i >> 1 ))));
+     if( oc ) rkey[i] = _mm512_shuffle_epi8( rkey[i], reverse );
+     rkey[i] = _mm512_gf2p8affine_epi64_epi8( rkey[i], phi, 0 );
+  }
+
+  while( blocks > 0 ) {
+    ak_uint64 *src = inptr, *dst = outptr;
+    size_t count = blocks < ak_kuznechik_avx512_lanes ? blocks : ak_kuznechik_avx512_lanes;
+
+    if( count < ak_kuznechik_avx512_lanes ) { /* остаток дополняется во временном буфере */
+      memset( buffer, 0, sizeof( buffer ));
+      memcpy( buffer, inptr, 16*count );
+      src = dst = buffer;
+    }
+    for( g = 0; g < ak_kuznechik_gfni_groups; g++ ) {
+       x[g] = _mm512_loadu_si512(( const __m512i *)( src + 8*g ));
+       if( oc ) x[g] = _mm512_shuffle_epi8( x[g], reverse );
+       x[g] = _mm512_gf2p8affine_epi64_epi8( x[g], phi, 0 );
+    }
+    if( decrypt ) {
+      for( g = 0; g < ak_kuznechik_gfni_groups; g++ )
+         x[g] = _mm512_xor_si512( _mm512_xor_si512( x[g], rkey[18] ), rkey[19] );
+      for( i = 16; i >= 0; i -= 2 ) {
+         for( g = 0; g < ak_kuznechik_gfni_groups; g++ ) {
+            x[g] = ak_kuznechik_avx512_sbox( ak_kuznechik_avx512_linear( x[g], col ), tab );
+            x[g] = _mm512_xor_si512( _mm512_xor_si512( x[g], rkey[i] ), rkey[i+1] );
+         }
+      }
+    } else {
+        for( i = 0; i < 18; i += 2 ) {
+           for( g = 0; g < ak_kuznechik_gfni_groups; g++ ) {
+              x[g] = _mm512_xor_si512( _mm512_xor_si512( x[g], rkey[i] ), rkey[i+1] );
+              x[g] = ak_kuznechik_avx512_linear( ak_kuznechik_avx512_sbox( x[g], tab ), col );
+           }
+        }
+        for( g = 0; g < ak_kuznechik_gfni_groups; g++ )
+           x[g] = _mm512_xor_si512( _mm512_xor_si512( x[g], rkey[18] ), rkey[19] );
+      }
+    for( g = 0; g < ak_kuznechik_gfni_groups; g++ ) {
+       x[g] = _mm512_gf2p8affine_epi64_epi8( x[g], phinv, 0 );
+       if( oc ) x[g] = _mm512_shuffle_epi8( x[g], reverse );
+       _mm512_storeu_si512(( __m512i *)( dst + 8*g ), x[g] );
+    }
+    if( dst == buffer ) memcpy( outptr, buffer, 16*count );
+    inptr += 2*count; outptr += 2*count; blocks -= count;
+  }
+ /* очищаем стек; обычный вызов memset() для неиспользуемых далее массивов
+    может быть удален компилятором */
+  ak_ptr_wipe( rkey, sizeof( rkey ), &skey->generator );
+  ak_ptr_wipe( buffer, sizeof( buffer ), &skey->generator );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Многоблочное зашифрование с использованием команд AVX-512 и GFNI. */
+ __attribute__((target("avx512bw,avx512vbmi,gfni")))
+ static void ak_kuznechik_avx512_encrypt_blocks( ak_skey skey, ak_pointer in, ak_pointer out,
+                                                                                  size_t blocks )
+{
+  ak_kuznechik_avx512_transform_blocks( skey, in, out, blocks, 0, 0 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Многоблочное зашифрование с использованием команд AVX-512 и GFNI
+    (режим совместимости с openssl). */
+ __attribute__((target("avx512bw,avx512vbmi,gfni")))
+ static void ak_kuznechik_avx512_encrypt_blocks_oc( ak_skey skey, ak_pointer in, ak_pointer out,
+                                                                                  size_t blocks )
+{
+  ak_kuznechik_avx512_transform_blocks( skey, in, out, blocks, 0, 1 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Многоблочное расшифрование с использованием команд AVX-512 и GFNI. */
+ __attribute__((target("avx512bw,avx512vbmi,gfni")))
+ static void ak_kuznechik_avx512_decrypt_blocks( ak_skey skey, ak_pointer in, ak_pointer out,
+                                                                                  size_t blocks )
+{
+  ak_kuznechik_avx512_transform_blocks( skey, in, out, blocks, 1, 0 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Многоблочное расшифрование с использованием команд AVX-512 и GFNI
+    (режим совместимости с openssl). */
+ __attribute__((target("avx512bw,avx512vbmi,gfni")))
+ static void ak_kuznechik_avx512_decrypt_blocks_oc( ak_skey skey, ak_pointer in, ak_pointer out,
+                                                                                  size_t blocks )
+{
+  ak_kuznechik_avx512_transform_blocks( skey, in, out, blocks, 1, 1 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка того, что процессор поддерживает команды AVX-512 (BW, VBMI) и GFNI. */
+ static bool_t ak_kuznechik_avx512_is_supported( void )
+{
+ #ifdef AK_HAVE_BUILTIN_CPU_SUPPORTS
+  __builtin_cpu_init();
+  if( __builtin_cpu_supports( "avx512bw" ) && __builtin_cpu_supports( "avx512vbmi" ) &&
+                                                  __builtin_cpu_supports( "gfni" )) return ak_true;
+ #endif
+ return ak_false;
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка возможности использования переносимой реализации (всегда успешна). */
+ static bool_t ak_kuznechik_generic_is_supported( void ) { return ak_true; }
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Перечень реализаций, скомпилированных в библиотеку.
+    \details Реализации перечисляются в порядке убывания скорости; последней всегда
+    указывается переносимая табличная реализация, которая используется в случае, когда
+    процессор не поддерживает ни одну из остальных реализаций. Реализация avx512 при длине
+    данных от одного килобайта более чем в два раза быстрее реализации sse2. Реализация gfni,
+    использующая 256-битные регистры, медленнее sse2, поэтому при автоматическом выборе
+    не используется, но проверяется вместе с остальными реализациями.                              */
+/* ----------------------------------------------------------------------------------------------- */
+ static const struct bckey_kernel kuznechik_kernels[] = {
+#ifdef AK_HAVE_BUILTIN_MM512_GF2P8MUL
+  { "avx512", ak_kuznechik_avx512_is_supported,
+    { ak_kuznechik_avx512_encrypt_blocks, ak_kuznechik_avx512_encrypt_blocks_oc },
+    { ak_kuznechik_avx512_decrypt_blocks, ak_kuznechik_avx512_decrypt_blocks_oc }},
+#endif
+#ifdef AK_HAVE_BUILTIN_XOR_SI128
+  { "sse2", ak_kuznechik_sse2_is_supported,
+    { ak_kuznechik_sse2_encrypt_blocks, ak_kuznechik_sse2_encrypt_blocks_oc },
+    { ak_kuznechik_sse2_decrypt_blocks, ak_kuznechik_sse2_decrypt_blocks_oc }},
+#endif
+#ifdef AK_HAVE_BUILTIN_MM256_GF2P8MUL
+  { "gfni", ak_kuznechik_gfni_is_supported,
+    { ak_kuznechik_gfni_encrypt_blocks, ak_kuznechik_gfni_encrypt_blocks_oc },
+    { ak_kuznechik_gfni_decrypt_blocks, ak_kuznechik_gfni_decrypt_blocks_oc }},
+#endif
+  { "generic", ak_kuznechik_generic_is_supported,
+    { ak_kuznechik_encrypt_blocks_with_mask, ak_kuznechik_encrypt_blocks_with_mask_oc },
+    { ak_kuznechik_decrypt_blocks_with_mask, ak_kuznechik_decrypt_blocks_with_mask_oc }}
+ };
+
+/*! \brief Количество реализаций, скомпилированных в библиотеку. */
+ #define ak_kuznechik_kernels_count ( sizeof( kuznechik_kernels )/sizeof( struct bckey_kernel ))
+
+/*! \brief Реализация, используемая при создании ключей алгоритма Кузнечик
+    (по умолчанию - переносимая табличная реализация). */
+ static const struct bckey_kernel *kuznechik_selected_kernel =
+                                                  kuznechik_kernels + ak_kuznechik_kernels_count -1;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция последовательно перебирает реализации, скомпилированные в библиотеку, и выбирает
+    первую из них, поддерживаемую процессором. Выбранная реализация используется всеми
+    ключами, создаваемыми после вызова функции.
+
+    \return Функция возвращает \ref ak_error_ok.                                                   */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_bckey_kuznechik_select_kernel( void )
+{
+  size_t idx = 0;
+
+  for( idx = 0; idx < ak_kuznechik_kernels_count; idx++ )
+     if( kuznechik_kernels[idx].is_supported()) {
+       kuznechik_selected_kernel = kuznechik_kernels + idx;
+       break;
+     }
+
+  if( ak_log_get_level() >= ak_log_maximum )
+    ak_error_message_fmt( ak_error_ok, __func__,
+                   "kuznechik block cipher uses %s implementation", kuznechik_selected_kernel->name );
+ return ak_error_ok;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! После инициализации устанавливаются обработчики (функции класса). Однако само значение
     ключу не присваивается - поле `bkey->key` остается неопределенным.
@@ -679,7 +1602,7 @@
 /* ----------------------------------------------------------------------------------------------- */
  int ak_bckey_create_kuznechik( ak_bckey bkey )
 {
-  int error = ak_error_ok, oc = (int) ak_libakrypt_get_option_by_name( "openssl_compability" );
+  int error = ak_error_ok, oc = (int) ak_libakrypt_get_option_by_index( openssl_compability_option );
 
   if( bkey == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
                                                "using null pointer to block cipher key context" );
@@ -711,6 +1634,8 @@
     bkey->encrypt = ak_kuznechik_encrypt_with_mask;
     bkey->decrypt = ak_kuznechik_decrypt_with_mask;
   }
+  bkey->encrypt_blocks = kuznechik_selected_kernel->encrypt[oc];
+  bkey->decrypt_blocks = kuznechik_selected_kernel->decrypt[oc];
  return error;
 }
 
@@ -723,7 +1648,7 @@
   ak_uint8 out[16];
   struct kuznechik_params parameters;
   int error = ak_error_ok, audit = ak_log_get_level(),
-      oc = (int) ak_libakrypt_get_option_by_name( "openssl_compability" );
+      oc = (int) ak_libakrypt_get_option_by_index( openssl_compability_option );
 
   ak_uint8 esum[16] = {
                  0x5b,0x80,0x54,0xb3,0x4e,0x81,0x09,0x94,0xcc,0x83,0x8b,0x8e,0x53,0xba,0x9d,0x18 };
@@ -834,7 +1759,7 @@
   ak_uint8 myout[256];
   bool_t result = ak_true;
   int error = ak_error_ok, audit = ak_log_get_level(),
-      oc = (int) ak_libakrypt_get_option_by_name( "openssl_compability" );
+      oc = (int) ak_libakrypt_get_option_by_index( openssl_compability_option );
 
  /* тестовый ключ из ГОСТ Р 34.13-2015, приложение А.1 */
   ak_uint8 key[32] = {
@@ -1187,11 +2112,89 @@
  return result;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция проверяет корректность всех реализаций многоблочных функций алгоритма Кузнечик,
+    скомпилированных в библиотеку и поддерживаемых процессором.
+    \details Результаты работы каждой реализации сравниваются с результатами однократного
+    применения базовых функций зашифрования/расшифрования, проверенных ранее на
+    контрольных примерах из ГОСТ Р 34.12-2015. Количество обрабатываемых блоков выбрано так,
+    чтобы задействовать как одновременную обработку блоков, так и обработку остатка.
+
+    @return Если тестирование прошло успешно возвращается истина (\ref ak_true),
+    в противном случае возвращается ложь (\ref ak_false).                                          */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_libakrypt_test_kuznechik_kernels( void )
+{
+  size_t i = 0, idx = 0;
+  struct bckey bkey;
+  bool_t result = ak_true;
+  ak_uint8 in[176], out[176], myout[176];
+  int error = ak_error_ok, audit = ak_log_get_level(),
+      oc = (int) ak_libakrypt_get_option_by_index( openssl_compability_option );
+  ak_uint8 key[32] = {
+    0xef,0xcd,0xab,0x89,0x67,0x45,0x23,0x01,0x10,0x32,0x54,0x76,0x98,0xba,0xdc,0xfe,
+    0x77,0x66,0x55,0x44,0x33,0x22,0x11,0x00,0xff,0xee,0xdd,0xcc,0xbb,0xaa,0x99,0x88
+  };
+
+  if(( oc < 0 ) || ( oc > 1 )) {
+    ak_error_message( ak_error_wrong_option, __func__,
+                                                "wrong value for \"openssl_compability\" option" );
+    return ak_false;
+  }
+  if(( error = ak_bckey_create_kuznechik( &bkey )) != ak_error_ok ) {
+    ak_error_message( error, __func__, "incorrect initialization of kuznechik secret key context");
+    return ak_false;
+  }
+  if(( error = ak_bckey_set_key( &bkey, key, sizeof( key ))) != ak_error_ok ) {
+    ak_error_message( error, __func__, "wrong creation of test key" );
+    result = ak_false;
+    goto exit;
+  }
+
+ /* вычисляем эталонное значение с помощью базовой функции зашифрования */
+  for( i = 0; i < sizeof( in ); i++ ) in[i] = ( ak_uint8 )( 29*i + 7 );
+  for( i = 0; i < sizeof( in ); i += 16 ) bkey.encrypt( &bkey.key, in+i, out+i );
+
+  for( idx = 0; idx < ak_kuznechik_kernels_count; idx++ ) {
+     if( !kuznechik_kernels[idx].is_supported()) {
+       if( audit >= ak_log_maximum ) ak_error_message_fmt( ak_error_ok, __func__,
+                      "%s implementation is not supported by processor", kuznechik_kernels[idx].name );
+       continue;
+     }
+
+     memset( myout, 0, sizeof( myout ));
+     kuznechik_kernels[idx].encrypt[oc]( &bkey.key, in, myout, sizeof( in ) >> 4 );
+     if( !ak_ptr_is_equal_with_log( myout, out, sizeof( out ))) {
+       ak_error_message_fmt( ak_error_not_equal_data, __func__ ,
+                      "wrong encryption with %s implementation", kuznechik_kernels[idx].name );
+       result = ak_false;
+       goto exit;
+     }
+     kuznechik_kernels[idx].decrypt[oc]( &bkey.key, myout, myout, sizeof( in ) >> 4 );
+     if( !ak_ptr_is_equal_with_log( myout, in, sizeof( in ))) {
+       ak_error_message_fmt( ak_error_not_equal_data, __func__ ,
+                      "wrong decryption with %s implementation", kuznechik_kernels[idx].name );
+       result = ak_false;
+       goto exit;
+     }
+     if( audit >= ak_log_maximum ) ak_error_message_fmt( ak_error_ok, __func__,
+                          "testing of %s implementation is Ok", kuznechik_kernels[idx].name );
+  }
+
+  exit:
+  if(( error = ak_bckey_destroy( &bkey )) != ak_error_ok ) {
+    ak_error_message( error, __func__, "wrong destruction of secret key" );
+    return ak_false;
+  }
+
+ return result;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
  bool_t ak_libakrypt_test_kuznechik( void )
 {
   int audit = audit = ak_log_get_level();
-  int oc = (int) ak_libakrypt_get_option_by_name( "openssl_compability" );
+  int oc = (int) ak_libakrypt_get_option_by_index( openssl_compability_option );
 
  /* мы тестируем алгоритм Магма в двух режимах совместимисти,
     вызывая для этого функцию тестирования дважды
@@ -1211,6 +2214,11 @@
                                                    "incorrect testing of kuznechik block cipher" );
     return ak_false;
   }
+  if( !ak_libakrypt_test_kuznechik_kernels( )) {
+    ak_error_message( ak_error_get_value(), __func__,
+                                    "incorrect testing of kuznechik block cipher implementations" );
+    return ak_false;
+  }
 
  /* 2. потом запускаем тестирование в режиме совместимости с openssl */
    ak_libakrypt_set_openssl_compability( ak_true );
@@ -1227,6 +2235,11 @@
                                                    "incorrect testing of kuznechik block cipher" );
     return ak_false;
   }
+  if( !ak_libakrypt_test_kuznechik_kernels( )) {
+    ak_error_message( ak_error_get_value(), __func__,
+                                    "incorrect testing of kuznechik block cipher implementations" );
+    return ak_false;
+  }
 
  /* 3. восстанавливаем первоначальное состояние */
    ak_libakrypt_set_openssl_compability( oc );
@@ -374,6 +374,36 @@
      return ak_false;
    }
 
+ /* выбираем реализацию алгоритма Кузнечик, поддерживаемую процессором */
+   if(( error = ak_bckey_kuznechik_select_kernel()) != ak_error_ok ) {
+     ak_error_message( error, __func__, "incorrect selection of kuznechik implementation" );
+     return ak_false;
+   }
+
+ /* выбираем реализацию алгоритма Магма, поддерживаемую процессором */
+   if(( error = ak_bckey_magma_select_kernel()) != ak_error_ok ) {
+     ak_error_message( error, __func__, "incorrect selection of magma implementation" );
+     return ak_false;
+   }
+
+ /* выбираем реализацию функции хеширования Стрибог, поддерживаемую процессором */
+   if(( error = ak_hash_streebog_select_kernel()) != ak_error_ok ) {
+     ak_error_message( error, __func__, "incorrect selection of streebog implementation" );
+     return ak_false;
+   }
+
+ /* строим индексы для быстрого поиска идентификаторов криптографических механизмов */
+   if(( error = ak_oid_create_index()) != ak_error_ok ) {
+     ak_error_message( error, __func__, "incorrect creation of object identifiers index" );
+     return ak_false;
+   }
+
+ /* выбираем реализацию арифметики конечных полей, поддерживаемую процессором */
+   if(( error = ak_gf2n_select_kernel()) != ak_error_ok ) {
+     ak_error_message( error, __func__, "incorrect selection of finite field implementation" );
+     return ak_false;
+   }
+
  /* в случае, когда компилируются сетевые функции, инициализируем работу с сокетами */
 #ifdef AK_HAVE_WINDOWS_H
   #ifdef LIBAKRYPT_NETWORK
@@ -418,6 +448,12 @@
   if( error != ak_error_ok )
     ak_error_message( error, __func__ , "before destroing library holds an error(s)" );
 
+ /* удаляем таблицы кратных точек эллиптических кривых */
+  ak_wcurve_comb_cache_destroy();
+
+ /* останавливаем вывод сообщений через кольцевые буфферы и освобождаем их память */
+  ak_log_ring_destroy();
+
 #ifdef AK_HAVE_WINDOWS_H
   #ifdef LIBAKRYPT_NETWORK
     if( WSACleanup() != 0 )
@@ -186,10 +186,43 @@
  return error;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Параметры, передаваемые функции обработки фрагментов файла. */
+ typedef struct mac_file_state {
+  /*! \brief Контекст итерационного сжатия. */
+   ak_mac mctx;
+  /*! \brief Область памяти для результата. */
+   ak_pointer out;
+  /*! \brief Размер области памяти для результата. */
+   size_t out_size;
+ } *ak_mac_file_state;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Обработка очередного фрагмента файла (длина всех фрагментов, кроме последнего,
+    кратна 4096 и, следовательно, длине блока входных данных). */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_mac_file_block( const ak_uint8 *data, const size_t size,
+                                                                 const bool_t last, ak_pointer ptr )
+{
+  size_t qcnt = 0, tail = 0;
+  ak_mac_file_state st = ( ak_mac_file_state )ptr;
+
+  if( !last ) return ak_mac_update( st->mctx, ( ak_pointer )data, size );
+  qcnt = size / st->mctx->bsize;
+  tail = size - qcnt*st->mctx->bsize;
+  if( qcnt ) ak_mac_update( st->mctx, ( ak_pointer )data, qcnt*st->mctx->bsize );
+ return ak_mac_finalize( st->mctx,
+                        ( ak_pointer )( data + qcnt*st->mctx->bsize ), tail, st->out, st->out_size );
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! Функция вычисляет результат сжимающего отображения для заданного файла и помещает
     его в область памяти, на которую указывает out.
 
+    Файл обрабатывается фрагментами, длина которых определяется опцией `file_buffer_size`;
+    при установленной опции `use_mmap_for_files` файл отображается в память
+    (см. функцию ak_file_read_by_blocks()).
+
     @param mctx Указатель на контекст итерационного сжатия.
     @param filename имя сжимаемого файла
     @param out Область памяти, куда будет помещен результат. Память должна быть заранее выделена.
@@ -202,11 +235,9 @@
 /* ----------------------------------------------------------------------------------------------- */
  int ak_mac_file( ak_mac mctx, const char* filename, ak_pointer out, const size_t out_size )
 {
-  size_t len = 0;
   struct file file;
   int error = ak_error_ok;
-  size_t block_size = 4096; /* оптимальная длина блока для Windows пока не ясна */
-  ak_uint8 *localbuffer = NULL; /* место для локального считывания информации */
+  struct mac_file_state st;
 
  /* выполняем необходимые проверки */
   if( mctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
@@ -225,31 +256,20 @@
     return ak_mac_finalize( mctx, "", 0, out, out_size );
   }
 
- /* готовим область для хранения данных */
-  block_size = ak_max( ( size_t )file.blksize, mctx->bsize );
- /* здесь мы выделяем локальный буффер для считывания/обработки данных */
-  if(( localbuffer = ( ak_uint8 * ) ak_aligned_malloc( block_size )) == NULL ) {
-    ak_file_close( &file );
-    return ak_error_message( ak_error_out_of_memory, __func__ ,
-                                                      "memory allocation error for local buffer" );
-  }
  /* теперь обрабатываем файл с данными */
-  read_label: len = ( size_t ) ak_file_read( &file, localbuffer, block_size );
-  if( len == block_size ) {
-    ak_mac_update( mctx, localbuffer, block_size ); /* добавляем считанные данные */
-    goto read_label;
-  } else {
-           size_t qcnt = len / mctx->bsize,
-                  tail = len - qcnt*mctx->bsize;
-           if( qcnt ) ak_mac_update( mctx, localbuffer, qcnt*mctx->bsize );
-           error = ak_mac_finalize( mctx,
-                                             localbuffer + qcnt*mctx->bsize, tail, out, out_size );
-         }
+  st.mctx = mctx;
+  st.out = out;
+  st.out_size = out_size;
+  if(( error = ak_file_read_by_blocks( &file,
+                    ( size_t )ak_libakrypt_get_option_by_index( file_buffer_size_option ),
+                    ( bool_t )ak_libakrypt_get_option_by_index( use_mmap_for_files_option ),
+                                               ak_mac_file_block, &st )) != ak_error_ok )
+    ak_error_message_fmt( error, __func__, "incorrect processing of file %s", filename );
+
  /* очищаем за собой данные, содержащиеся в контексте */
   ak_mac_clean( mctx );
  /* закрываем данные */
   ak_file_close( &file );
-  ak_aligned_free( localbuffer );
  return error;
 }
 
@@ -7,6 +7,12 @@
 /*    регламентированного ГОСТ Р 34.12-2015                                                        */
 /* ----------------------------------------------------------------------------------------------- */
  #include <libakrypt-internal.h>
+ #ifdef AK_HAVE_BUILTIN_SHUFFLE_EPI8
+  #include <tmmintrin.h>
+ #endif
+ #ifdef AK_HAVE_BUILTIN_MM256_SHUFFLE_EPI8
+  #include <immintrin.h>
+ #endif
 
 /* о масированной реализации Магмы смотри
    S. V. Matveev, “GOST 28147-89 masking against side channel attacks”,
@@ -639,6 +645,625 @@
 #endif
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*                  реализация одновременного шифрования нескольких блоков                         */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Количество блоков, преобразуемых одновременно (чередуемых) в многоблочных функциях. */
+ #define ak_magma_lanes  (4)
+
+/*! \brief Порядок использования раундовых ключей при зашифровании (индекс 0 не используется). */
+ static const ak_uint8 magma_encrypt_order[33] = { 0,
+   7, 6, 5, 4, 3, 2, 1, 0, 7, 6, 5, 4, 3, 2, 1, 0, 7, 6, 5, 4, 3, 2, 1, 0, 0, 1, 2, 3, 4, 5, 6, 7 };
+
+/*! \brief Порядок использования раундовых ключей при расшифровании (индекс 0 не используется). */
+ static const ak_uint8 magma_decrypt_order[33] = { 0,
+   7, 6, 5, 4, 3, 2, 1, 0, 0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7 };
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция реализует преобразование `cnt` (не более четырех) независимых блоков
+    маскированным алгоритмом ГОСТ 34.12-2015 (Магма).
+
+    Для каждого блока вырабатывается собственная случайная траектория, при этом все траектории
+    вырабатываются одним обращением к генератору. Раунды для всех блоков выполняются одновременно.
+
+    @param skey Контекст секретного ключа.
+    @param in Указатель на последовательность блоков входной информации.
+    @param out Указатель на последовательность блоков выходной информации.
+    @param cnt Количество обрабатываемых блоков.
+    @param order Порядок использования раундовых ключей.
+    @param oc Флаг совместимости с библиотекой openssl.                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_magma_random_walk_lanes( ak_skey skey, ak_uint32 *in, ak_uint32 *out,
+                                         const size_t cnt, const ak_uint8 *order, const int oc )
+{
+  size_t i, j;
+  ak_uint8 m[ak_magma_lanes][34];
+  ak_uint32 mv[ak_magma_lanes], n3[ak_magma_lanes], n4[ak_magma_lanes], p;
+  ak_uint32 (*kp)[8] = ((struct magma_encrypted_keys *)skey->data)->inkey;
+  ak_uint32 (*mp)[8] = ((struct magma_encrypted_keys *)skey->data)->inmask;
+
+ /* вырабатываем случайные траектории для всех блоков */
+  skey->generator.random( &skey->generator, mv, cnt*sizeof( ak_uint32 ));
+
+ /* формируем векторы раундовых поворотов и начинаем движение */
+  for( j = 0; j < cnt; j++ ) {
+     if( oc ) {
+       m[j][0] = m[j][1] = m[j][32] = m[j][33] = 0;
+       for( i = 1; i < 31; i++ ) m[j][i+1] = (ak_uint8)(( mv[j] >> i) & 0x01 );
+      #ifdef AK_LITTLE_ENDIAN
+       n4[j] = bswap_32( in[2*j] )^( m[j][1] * 0xffffffff );
+       n3[j] = bswap_32( in[2*j+1] );
+      #else
+       n4[j] = in[2*j]^( m[j][1] * 0xffffffff );
+       n3[j] = in[2*j+1];
+      #endif
+     }
+      else {
+       m[j][0] = m[j][33] = 0;
+       for( i = 0; i < 32; i++ ) m[j][i+1] = (ak_uint8)(( mv[j] >> i) & 0x01 );
+      #ifdef AK_LITTLE_ENDIAN
+       n3[j] = in[2*j]^( m[j][1] * 0xffffffff );
+       n4[j] = in[2*j+1];
+      #else
+       n3[j] = bswap_32( in[2*j] )^( m[j][1] * 0xffffffff );
+       n4[j] = bswap_32( in[2*j+1] );
+      #endif
+     }
+  }
+
+  for( i = 1; i < 33; i += 2 ) {
+     for( j = 0; j < cnt; j++ ) {
+        p = n3[j]; p -= mp[m[j][i]][order[i]]; p += kp[m[j][i]][order[i]] + m[j][i];
+        n4[j] ^= ak_magma_gostf_boxes( p, m[j][i+1] ^ m[j][i-1], m[j][i] );
+     }
+     for( j = 0; j < cnt; j++ ) {
+        p = n4[j]; p -= mp[m[j][i+1]][order[i+1]]; p += kp[m[j][i+1]][order[i+1]] + m[j][i+1];
+        n3[j] ^= ak_magma_gostf_boxes( p, m[j][i+2] ^ m[j][i], m[j][i+1] );
+     }
+  }
+
+  for( j = 0; j < cnt; j++ ) {
+     if( oc ) {
+      #ifdef AK_LITTLE_ENDIAN
+       out[2*j+1] = bswap_32( n4[j] )^( m[j][32] * 0xffffffff ); out[2*j] = bswap_32( n3[j] );
+      #else
+       out[2*j+1] = n4[j]^( m[j][32] * 0xffffffff ); out[2*j] = n3[j];
+      #endif
+     }
+      else {
+      #ifdef AK_LITTLE_ENDIAN
+       out[2*j] = n4[j]^( m[j][32] * 0xffffffff ); out[2*j+1] = n3[j];
+      #else
+       out[2*j] = bswap_32( n4[j] )^( m[j][32] * 0xffffffff ); out[2*j+1] = bswap_32( n3[j] );
+      #endif
+     }
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция преобразования последовательности блоков, разбивающая ее на группы
+    из четырех блоков.                                                                             */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_magma_random_walk_blocks( ak_skey skey, ak_pointer in, ak_pointer out,
+                                         size_t blocks, const ak_uint8 *order, const int oc )
+{
+  ak_uint32 *inptr = ( ak_uint32 *)in, *outptr = ( ak_uint32 *)out;
+
+  for( ; blocks >= ak_magma_lanes; blocks -= ak_magma_lanes ) {
+     ak_magma_random_walk_lanes( skey, inptr, outptr, ak_magma_lanes, order, oc );
+     inptr += 2*ak_magma_lanes; outptr += 2*ak_magma_lanes;
+  }
+  if( blocks ) ak_magma_random_walk_lanes( skey, inptr, outptr, blocks, order, oc );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция зашифрования последовательности блоков алгоритмом ГОСТ 34.12-2015 (Магма).
+
+    @param skey Контекст секретного ключа.
+    @param in Указатель на последовательность блоков входной информации.
+    @param out Указатель на последовательность блоков выходной информации
+    (этот указатель может совпадать с `in`).
+    @param blocks Количество обрабатываемых блоков.                                                */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_magma_encrypt_blocks_with_random_walk( ak_skey skey,
+                                                  ak_pointer in, ak_pointer out, size_t blocks )
+{
+  ak_magma_random_walk_blocks( skey, in, out, blocks, magma_encrypt_order, 0 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция расшифрования последовательности блоков алгоритмом ГОСТ 34.12-2015 (Магма). */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_magma_decrypt_blocks_with_random_walk( ak_skey skey,
+                                                  ak_pointer in, ak_pointer out, size_t blocks )
+{
+  ak_magma_random_walk_blocks( skey, in, out, blocks, magma_decrypt_order, 0 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция зашифрования последовательности блоков алгоритмом ГОСТ 34.12-2015 (Магма)
+    в режиме совместимости с библиотекой openssl.                                                  */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_magma_encrypt_blocks_with_random_walk_oc( ak_skey skey,
+                                                  ak_pointer in, ak_pointer out, size_t blocks )
+{
+  ak_magma_random_walk_blocks( skey, in, out, blocks, magma_encrypt_order, 1 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция расшифрования последовательности блоков алгоритмом ГОСТ 34.12-2015 (Магма)
+    в режиме совместимости с библиотекой openssl.                                                  */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_magma_decrypt_blocks_with_random_walk_oc( ak_skey skey,
+                                                  ak_pointer in, ak_pointer out, size_t blocks )
+{
+  ak_magma_random_walk_blocks( skey, in, out, blocks, magma_decrypt_order, 1 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*                  векторные реализации многоблочных функций (команды SSSE3 и AVX2)               */
+/* ----------------------------------------------------------------------------------------------- */
+#if defined( AK_HAVE_BUILTIN_SHUFFLE_EPI8 ) || defined( AK_HAVE_BUILTIN_MM256_SHUFFLE_EPI8 )
+/*! \brief Таблицы замен алгоритма Магма, разложенные на 4-х битные узлы.
+    \details Первый индекс определяет, инвертируется ли вход узла (так же, как первый индекс
+    массива `magma_boxes`), второй - номер узла. Узлы с нечетными номерами преобразуют
+    старшие половины байт, поэтому их значения сразу сдвинуты на четыре бита влево.
+    Такое представление позволяет вычислять значения замен командой `pshufb`
+    одновременно для всех байт векторного регистра.                                                */
+/* ----------------------------------------------------------------------------------------------- */
+ static const ak_uint8 magma_nibble_boxes[2][8][16] = {
+  {
+   { 0x0C, 0x04, 0x06, 0x02, 0x0A, 0x05, 0x0B, 0x09, 0x0E, 0x08, 0x0D, 0x07, 0x00, 0x03, 0x0F, 0x01 },
+   { 0x60, 0x80, 0x20, 0x30, 0x90, 0xA0, 0x50, 0xC0, 0x10, 0xE0, 0x40, 0x70, 0xB0, 0xD0, 0x00, 0xF0 },
+   { 0x0B, 0x03, 0x05, 0x08, 0x02, 0x0F, 0x0A, 0x0D, 0x0E, 0x01, 0x07, 0x04, 0x0C, 0x09, 0x06, 0x00 },
+   { 0xC0, 0x80, 0x20, 0x10, 0xD0, 0x40, 0xF0, 0x60, 0x70, 0x00, 0xA0, 0x50, 0x30, 0xE0, 0x90, 0xB0 },
+   { 0x07, 0x0F, 0x05, 0x0A, 0x08, 0x01, 0x06, 0x0D, 0x00, 0x09, 0x03, 0x0E, 0x0B, 0x04, 0x02, 0x0C },
+   { 0x50, 0xD0, 0xF0, 0x60, 0x90, 0x20, 0xC0, 0xA0, 0xB0, 0x70, 0x80, 0x10, 0x40, 0x30, 0xE0, 0x00 },
+   { 0x08, 0x0E, 0x02, 0x05, 0x06, 0x09, 0x01, 0x0C, 0x0F, 0x04, 0x0B, 0x00, 0x0D, 0x0A, 0x03, 0x07 },
+   { 0x10, 0x70, 0xE0, 0xD0, 0x00, 0x50, 0x80, 0x30, 0x40, 0xF0, 0xA0, 0x60, 0x90, 0xC0, 0xB0, 0x20 }
+  },
+  {
+   { 0x01, 0x0F, 0x03, 0x00, 0x07, 0x0D, 0x08, 0x0E, 0x09, 0x0B, 0x05, 0x0A, 0x02, 0x06, 0x04, 0x0C },
+   { 0xF0, 0x00, 0xD0, 0xB0, 0x70, 0x40, 0xE0, 0x10, 0xC0, 0x50, 0xA0, 0x90, 0x30, 0x20, 0x80, 0x60 },
+   { 0x00, 0x06, 0x09, 0x0C, 0x04, 0x07, 0x01, 0x0E, 0x0D, 0x0A, 0x0F, 0x02, 0x08, 0x05, 0x03, 0x0B },
+   { 0xB0, 0x90, 0xE0, 0x30, 0x50, 0xA0, 0x00, 0x70, 0x60, 0xF0, 0x40, 0xD0, 0x10, 0x20, 0x80, 0xC0 },
+   { 0x0C, 0x02, 0x04, 0x0B, 0x0E, 0x03, 0x09, 0x00, 0x0D, 0x06, 0x01, 0x08, 0x0A, 0x05, 0x0F, 0x07 },
+   { 0x00, 0xE0, 0x30, 0x40, 0x10, 0x80, 0x70, 0xB0, 0xA0, 0xC0, 0x20, 0x90, 0x60, 0xF0, 0xD0, 0x50 },
+   { 0x07, 0x03, 0x0A, 0x0D, 0x00, 0x0B, 0x04, 0x0F, 0x0C, 0x01, 0x09, 0x06, 0x05, 0x02, 0x0E, 0x08 },
+   { 0x20, 0xB0, 0xC0, 0x90, 0x60, 0xA0, 0xF0, 0x40, 0x30, 0x80, 0x50, 0x00, 0xD0, 0xE0, 0x70, 0x10 }
+  }
+ };
+
+/*! \brief Количество векторных регистров, обрабатываемых одновременно (чередуемых). */
+ #define ak_magma_simd_groups (2)
+#endif
+
+#ifdef AK_HAVE_BUILTIN_SHUFFLE_EPI8
+/*! \brief Количество блоков, обрабатываемых за один вызов SSSE3 реализации. */
+ #define ak_magma_ssse3_lanes ( 4*ak_magma_simd_groups )
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Один такт шифрующего преобразования для четырех блоков, размещенных в векторном регистре.
+
+    Для каждого блока выбор таблицы замен (с инвертированным входом или без него) выполняется
+    наложением маски, поэтому значение, подаваемое на вход таблиц, остается маскированным так же,
+    как и в реализации, обрабатывающей один блок.
+
+    @param x Маскированные значения половин блоков.
+    @param min Маска инвертирования входа таблиц замен (все единицы или все нули для каждого блока).
+    @param mout Маска инвертирования выхода таблиц замен.
+    @param tab Таблицы 4-х битных узлов замены.
+    @return Результат криптографического преобразования.                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ __attribute__((target("ssse3")))
+ static inline __m128i ak_magma_ssse3_gostf( __m128i x, __m128i min, __m128i mout,
+                                                                            const __m128i *tab )
+{
+  int k = 0;
+  const __m128i nib = _mm_set1_epi8( 0x0f );
+  __m128i lo = _mm_and_si128( x, nib ), hi = _mm_and_si128( _mm_srli_epi16( x, 4 ), nib );
+  __m128i pos, r0 = _mm_setzero_si128(), r1 = _mm_setzero_si128();
+
+  for( k = 0; k < 4; k++ ) {
+     pos = _mm_set1_epi32( 0xff << 8*k );
+     r0 = _mm_or_si128( r0, _mm_and_si128( pos, _mm_or_si128(
+                   _mm_shuffle_epi8( tab[2*k], lo ), _mm_shuffle_epi8( tab[2*k+1], hi ))));
+     r1 = _mm_or_si128( r1, _mm_and_si128( pos, _mm_or_si128(
+                   _mm_shuffle_epi8( tab[8+2*k], lo ), _mm_shuffle_epi8( tab[9+2*k], hi ))));
+  }
+  x = _mm_xor_si128( _mm_or_si128( _mm_andnot_si128( min, r0 ), _mm_and_si128( min, r1 )), mout );
+ return _mm_or_si128( _mm_slli_epi32( x, 11 ), _mm_srli_epi32( x, 21 ));
+}
+
+/*! \brief Половина раунда сети Фейстеля для всех векторных регистров: значение `x`
+    используется для вычисления такта, результат складывается с `y`. */
+ #define ak_magma_ssse3_round( x, y, i ) \
+   k0 = _mm_set1_epi32( (int) kp[0][order[i]] ); k1 = _mm_set1_epi32( (int) kp[1][order[i]] ); \
+   q0 = _mm_set1_epi32( (int) mp[0][order[i]] ); q1 = _mm_set1_epi32( (int) mp[1][order[i]] ); \
+   for( g = 0; g < ak_magma_simd_groups; g++ ) { \
+      mnext = ( i < 32 ) ? _mm_srai_epi32( _mm_slli_epi32( v[g], 31-i ), 31 ) : _mm_setzero_si128(); \
+      p = _mm_sub_epi32( x[g], \
+                      _mm_or_si128( _mm_andnot_si128( mcur[g], q0 ), _mm_and_si128( mcur[g], q1 ))); \
+      p = _mm_add_epi32( p, \
+                      _mm_or_si128( _mm_andnot_si128( mcur[g], k0 ), _mm_and_si128( mcur[g], k1 ))); \
+      y[g] = _mm_xor_si128( y[g], ak_magma_ssse3_gostf( _mm_sub_epi32( p, mcur[g] ), \
+                                                mcur[g], _mm_xor_si128( mnext, mprev[g] ), tab )); \
+      mprev[g] = mcur[g]; mcur[g] = mnext; \
+   }
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция преобразования восьми блоков маскированным алгоритмом Магма
+    с использованием команд SSSE3.
+
+    Половины блоков транспонируются так, что каждый 32-х битный элемент векторного регистра
+    содержит половину одного из блоков. Для каждого блока, как и в базовой реализации,
+    вырабатывается собственная случайная траектория.
+
+    @param skey Контекст секретного ключа.
+    @param in Указатель на восемь блоков входной информации.
+    @param out Указатель на восемь блоков выходной информации.
+    @param order Порядок использования раундовых ключей.
+    @param oc Флаг совместимости с библиотекой openssl.                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ __attribute__((target("ssse3")))
+ static inline void ak_magma_ssse3_random_walk_lanes( ak_skey skey, ak_uint32 *in,
+                                          ak_uint32 *out, const ak_uint8 *order, const int oc )
+{
+  int i = 0, g = 0;
+  ak_uint32 mv[ak_magma_ssse3_lanes];
+  ak_uint32 (*kp)[8] = ((struct magma_encrypted_keys *)skey->data)->inkey;
+  ak_uint32 (*mp)[8] = ((struct magma_encrypted_keys *)skey->data)->inmask;
+  const __m128i bswap = _mm_set_epi8( 12,13,14,15, 8,9,10,11, 4,5,6,7, 0,1,2,3 );
+  __m128i tab[16], e, o, p, k0, k1, q0, q1, mnext;
+  __m128i n3[ak_magma_simd_groups], n4[ak_magma_simd_groups], v[ak_magma_simd_groups],
+          mprev[ak_magma_simd_groups], mcur[ak_magma_simd_groups];
+
+  for( i = 0; i < 16; i++ ) tab[i] = _mm_loadu_si128(( const __m128i *)magma_nibble_boxes[i>>3][i&7] );
+
+ /* вырабатываем случайные траектории для всех блоков */
+  skey->generator.random( &skey->generator, mv, sizeof( mv ));
+
+ /* транспонируем блоки и начинаем движение */
+  for( g = 0; g < ak_magma_simd_groups; g++ ) {
+     v[g] = _mm_loadu_si128(( const __m128i *)( mv + 4*g ));
+     if( oc ) v[g] = _mm_and_si128( v[g], _mm_set1_epi32( 0x7ffffffe ));
+     e = _mm_loadu_si128(( const __m128i *)( in + 8*g ));
+     o = _mm_loadu_si128(( const __m128i *)( in + 8*g + 4 ));
+     p = _mm_castps_si128( _mm_shuffle_ps( _mm_castsi128_ps( e ), _mm_castsi128_ps( o ), 0x88 ));
+     o = _mm_castps_si128( _mm_shuffle_ps( _mm_castsi128_ps( e ), _mm_castsi128_ps( o ), 0xdd ));
+     mprev[g] = _mm_setzero_si128();
+     mcur[g] = _mm_srai_epi32( _mm_slli_epi32( v[g], 31 ), 31 );
+     if( oc ) {
+       n4[g] = _mm_xor_si128( _mm_shuffle_epi8( p, bswap ), mcur[g] );
+       n3[g] = _mm_shuffle_epi8( o, bswap );
+     } else {
+         n3[g] = _mm_xor_si128( p, mcur[g] );
+         n4[g] = o;
+       }
+  }
+
+  for( i = 1; i < 33; i += 2 ) {
+     ak_magma_ssse3_round( n3, n4, i )
+     ak_magma_ssse3_round( n4, n3, i+1 )
+  }
+
+ /* возвращаем блоки к исходному размещению */
+  for( g = 0; g < ak_magma_simd_groups; g++ ) {
+     if( oc ) {
+       e = _mm_shuffle_epi8( n3[g], bswap );
+       o = _mm_xor_si128( _mm_shuffle_epi8( n4[g], bswap ), mprev[g] );
+     } else {
+         e = _mm_xor_si128( n4[g], mprev[g] );
+         o = n3[g];
+       }
+     _mm_storeu_si128(( __m128i *)( out + 8*g ), _mm_unpacklo_epi32( e, o ));
+     _mm_storeu_si128(( __m128i *)( out + 8*g + 4 ), _mm_unpackhi_epi32( e, o ));
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция преобразования последовательности блоков с использованием команд SSSE3;
+    остаток, содержащий менее восьми блоков, обрабатывается базовой реализацией.                   */
+/* ----------------------------------------------------------------------------------------------- */
+ __attribute__((target("ssse3")))
+ static inline void ak_magma_ssse3_random_walk_blocks( ak_skey skey, ak_pointer in, ak_pointer out,
+                                          size_t blocks, const ak_uint8 *order, const int oc )
+{
+  ak_uint32 *inptr = ( ak_uint32 *)in, *outptr = ( ak_uint32 *)out;
+
+  for( ; blocks >= ak_magma_ssse3_lanes; blocks -= ak_magma_ssse3_lanes ) {
+     ak_magma_ssse3_random_walk_lanes( skey, inptr, outptr, order, oc );
+     inptr += 2*ak_magma_ssse3_lanes; outptr += 2*ak_magma_ssse3_lanes;
+  }
+  ak_magma_random_walk_blocks( skey, inptr, outptr, blocks, order, oc );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Многоблочное зашифрование с использованием команд SSSE3. */
+ __attribute__((target("ssse3")))
+ static void ak_magma_ssse3_encrypt_blocks( ak_skey skey, ak_pointer in, ak_pointer out,
+                                                                                  size_t blocks )
+{
+  ak_magma_ssse3_random_walk_blocks( skey, in, out, blocks, magma_encrypt_order, 0 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Многоблочное расшифрование с использованием команд SSSE3. */
+ __attribute__((target("ssse3")))
+ static void ak_magma_ssse3_decrypt_blocks( ak_skey skey, ak_pointer in, ak_pointer out,
+                                                                                  size_t blocks )
+{
+  ak_magma_ssse3_random_walk_blocks( skey, in, out, blocks, magma_decrypt_order, 0 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Многоблочное зашифрование с использованием команд SSSE3
+    (режим совместимости с openssl). */
+ __attribute__((target("ssse3")))
+ static void ak_magma_ssse3_encrypt_blocks_oc( ak_skey skey, ak_pointer in, ak_pointer out,
+                                                                                  size_t blocks )
+{
+  ak_magma_ssse3_random_walk_blocks( skey, in, out, blocks, magma_encrypt_order, 1 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Многоблочное расшифрование с использованием команд SSSE3
+    (режим совместимости с openssl). */
+ __attribute__((target("ssse3")))
+ static void ak_magma_ssse3_decrypt_blocks_oc( ak_skey skey, ak_pointer in, ak_pointer out,
+                                                                                  size_t blocks )
+{
+  ak_magma_ssse3_random_walk_blocks( skey, in, out, blocks, magma_decrypt_order, 1 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка того, что процессор поддерживает команды SSSE3. */
+ static bool_t ak_magma_ssse3_is_supported( void )
+{
+ #ifdef AK_HAVE_BUILTIN_CPU_SUPPORTS
+  __builtin_cpu_init();
+  if( __builtin_cpu_supports( "ssse3" )) return ak_true;
+ #endif
+ return ak_false;
+}
+#endif
+
+#ifdef AK_HAVE_BUILTIN_MM256_SHUFFLE_EPI8
+/*! \brief Количество блоков, обрабатываемых за один вызов AVX2 реализации. */
+ #define ak_magma_avx2_lanes ( 8*ak_magma_simd_groups )
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Один такт шифрующего преобразования для восьми блоков, размещенных
+    в векторном регистре (см. описание функции ak_magma_ssse3_gostf()). */
+/* ----------------------------------------------------------------------------------------------- */
+ __attribute__((target("avx2")))
+ static inline __m256i ak_magma_avx2_gostf( __m256i x, __m256i min, __m256i mout,
+                                                                            const __m256i *tab )
+{
+  int k = 0;
+  const __m256i nib = _mm256_set1_epi8( 0x0f );
+  __m256i lo = _mm256_and_si256( x, nib ), hi = _mm256_and_si256( _mm256_srli_epi16( x, 4 ), nib );
+  __m256i pos, r0 = _mm256_setzero_si256(), r1 = _mm256_setzero_si256();
+
+  for( k = 0; k < 4; k++ ) {
+     pos = _mm256_set1_epi32( 0xff << 8*k );
+     r0 = _mm256_or_si256( r0, _mm256_and_si256( pos, _mm256_or_si256(
+             _mm256_shuffle_epi8( tab[2*k], lo ), _mm256_shuffle_epi8( tab[2*k+1], hi ))));
+     r1 = _mm256_or_si256( r1, _mm256_and_si256( pos, _mm256_or_si256(
+             _mm256_shuffle_epi8( tab[8+2*k], lo ), _mm256_shuffle_epi8( tab[9+2*k], hi ))));
+  }
+  x = _mm256_xor_si256(
+            _mm256_or_si256( _mm256_andnot_si256( min, r0 ), _mm256_and_si256( min, r1 )), mout );
+ return _mm256_or_si256( _mm256_slli_epi32( x, 11 ), _mm256_srli_epi32( x, 21 ));
+}
+
+/*! \brief Половина раунда сети Фейстеля для всех векторных регистров
+    (см. описание макроса ak_magma_ssse3_round). */
+ #define ak_magma_avx2_round( x, y, i ) \
+   k0 = _mm256_set1_epi32( (int) kp[0][order[i]] ); k1 = _mm256_set1_epi32( (int) kp[1][order[i]] ); \
+   q0 = _mm256_set1_epi32( (int) mp[0][order[i]] ); q1 = _mm256_set1_epi32( (int) mp[1][order[i]] ); \
+   for( g = 0; g < ak_magma_simd_groups; g++ ) { \
+      mnext = ( i < 32 ) ? \
+               _mm256_srai_epi32( _mm256_slli_epi32( v[g], 31-i ), 31 ) : _mm256_setzero_si256(); \
+      p = _mm256_sub_epi32( x[g], \
+           _mm256_or_si256( _mm256_andnot_si256( mcur[g], q0 ), _mm256_and_si256( mcur[g], q1 ))); \
+      p = _mm256_add_epi32( p, \
+           _mm256_or_si256( _mm256_andnot_si256( mcur[g], k0 ), _mm256_and_si256( mcur[g], k1 ))); \
+      y[g] = _mm256_xor_si256( y[g], ak_magma_avx2_gostf( _mm256_sub_epi32( p, mcur[g] ), \
+                                             mcur[g], _mm256_xor_si256( mnext, mprev[g] ), tab )); \
+      mprev[g] = mcur[g]; mcur[g] = mnext; \
+   }
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция преобразования шестнадцати блоков маскированным алгоритмом Магма
+    с использованием команд AVX2 (см. описание функции ak_magma_ssse3_random_walk_lanes()).
+
+    Команды AVX2 переставляют элементы независимо в каждой 128-ми битной половине регистра,
+    поэтому после транспонирования блоки размещаются в элементах регистра в порядке
+    0, 1, 4, 5, 2, 3, 6, 7; обратное преобразование восстанавливает исходный порядок.              */
+/* ----------------------------------------------------------------------------------------------- */
+ __attribute__((target("avx2")))
+ static inline void ak_magma_avx2_random_walk_lanes( ak_skey skey, ak_uint32 *in,
+                                          ak_uint32 *out, const ak_uint8 *order, const int oc )
+{
+  int i = 0, g = 0;
+  ak_uint32 mv[ak_magma_avx2_lanes];
+  ak_uint32 (*kp)[8] = ((struct magma_encrypted_keys *)skey->data)->inkey;
+  ak_uint32 (*mp)[8] = ((struct magma_encrypted_keys *)skey->data)->inmask;
+  const __m256i bswap = _mm256_broadcastsi128_si256(
+                                  _mm_set_epi8( 12,13,14,15, 8,9,10,11, 4,5,6,7, 0,1,2,3 ));
+  __m256i tab[16], e, o, p, k0, k1, q0, q1, mnext;
+  __m256i n3[ak_magma_simd_groups], n4[ak_magma_simd_groups], v[ak_magma_simd_groups],
+          mprev[ak_magma_simd_groups], mcur[ak_magma_simd_groups];
+
+  for( i = 0; i < 16; i++ ) tab[i] = _mm256_broadcastsi128_si256(
+                             _mm_loadu_si128(( const __m128i *)magma_nibble_boxes[i>>3][i&7] ));
+
+ /* вырабатываем случайные траектории для всех блоков */
+  skey->generator.random( &skey->generator, mv, sizeof( mv ));
+
+ /* транспонируем блоки и начинаем движение */
+  for( g = 0; g < ak_magma_simd_groups; g++ ) {
+     v[g] = _mm256_loadu_si256(( const __m256i *)( mv + 8*g ));
+     if( oc ) v[g] = _mm256_and_si256( v[g], _mm256_set1_epi32( 0x7ffffffe ));
+     e = _mm256_loadu_si256(( const __m256i *)( in + 16*g ));
+     o = _mm256_loadu_si256(( const __m256i *)( in + 16*g + 8 ));
+     p = _mm256_castps_si256( _mm256_shuffle_ps(
+                                       _mm256_castsi256_ps( e ), _mm256_castsi256_ps( o ), 0x88 ));
+     o = _mm256_castps_si256( _mm256_shuffle_ps(
+                                       _mm256_castsi256_ps( e ), _mm256_castsi256_ps( o ), 0xdd ));
+     mprev[g] = _mm256_setzero_si256();
+     mcur[g] = _mm256_srai_epi32( _mm256_slli_epi32( v[g], 31 ), 31 );
+     if( oc ) {
+       n4[g] = _mm256_xor_si256( _mm256_shuffle_epi8( p, bswap ), mcur[g] );
+       n3[g] = _mm256_shuffle_epi8( o, bswap );
+     } else {
+         n3[g] = _mm256_xor_si256( p, mcur[g] );
+         n4[g] = o;
+       }
+  }
+
+  for( i = 1; i < 33; i += 2 ) {
+     ak_magma_avx2_round( n3, n4, i )
+     ak_magma_avx2_round( n4, n3, i+1 )
+  }
+
+ /* возвращаем блоки к исходному размещению */
+  for( g = 0; g < ak_magma_simd_groups; g++ ) {
+     if( oc ) {
+       e = _mm256_shuffle_epi8( n3[g], bswap );
+       o = _mm256_xor_si256( _mm256_shuffle_epi8( n4[g], bswap ), mprev[g] );
+     } else {
+         e = _mm256_xor_si256( n4[g], mprev[g] );
+         o = n3[g];
+       }
+     _mm256_storeu_si256(( __m256i *)( out + 16*g ), _mm256_unpacklo_epi32( e, o ));
+     _mm256_storeu_si256(( __m256i *)( out + 16*g + 8 ), _mm256_unpackhi_epi32( e, o ));
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция преобразования последовательности блоков с использованием команд AVX2;
+    остаток, содержащий менее шестнадцати блоков, обрабатывается базовой реализацией.              */
+/* ----------------------------------------------------------------------------------------------- */
+ __attribute__((target("avx2")))
+ static inline void ak_magma_avx2_random_walk_blocks( ak_skey skey, ak_pointer in, ak_pointer out,
+                                          size_t blocks, const ak_uint8 *order, const int oc )
+{
+  ak_uint32 *inptr = ( ak_uint32 *)in, *outptr = ( ak_uint32 *)out;
+
+  for( ; blocks >= ak_magma_avx2_lanes; blocks -= ak_magma_avx2_lanes ) {
+     ak_magma_avx2_random_walk_lanes( skey, inptr, outptr, order, oc );
+     inptr += 2*ak_magma_avx2_lanes; outptr += 2*ak_magma_avx2_lanes;
+  }
+  ak_magma_random_walk_blocks( skey, inptr, outptr, blocks, order, oc );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Многоблочное зашифрование с использованием команд AVX2. */
+ __attribute__((target("avx2")))
+ static void ak_magma_avx2_encrypt_blocks( ak_skey skey, ak_pointer in, ak_pointer out,
+                                                                                  size_t blocks )
+{
+  ak_magma_avx2_random_walk_blocks( skey, in, out, blocks, magma_encrypt_order, 0 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Многоблочное расшифрование с использованием команд AVX2. */
+ __attribute__((target("avx2")))
+ static void ak_magma_avx2_decrypt_blocks( ak_skey skey, ak_pointer in, ak_pointer out,
+                                                                                  size_t blocks )
+{
+  ak_magma_avx2_random_walk_blocks( skey, in, out, blocks, magma_decrypt_order, 0 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Многоблочное зашифрование с использованием команд AVX2
+    (режим совместимости с openssl). */
+ __attribute__((target("avx2")))
+ static void ak_magma_avx2_encrypt_blocks_oc( ak_skey skey, ak_pointer in, ak_pointer out,
+                                                                                  size_t blocks )
+{
+  ak_magma_avx2_random_walk_blocks( skey, in, out, blocks, magma_encrypt_order, 1 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Многоблочное расшифрование с использованием команд AVX2
+    (режим совместимости с openssl). */
+ __attribute__((target("avx2")))
+ static void ak_magma_avx2_decrypt_blocks_oc( ak_skey skey, ak_pointer in, ak_pointer out,
+                                                                                  size_t blocks )
+{
+  ak_magma_avx2_random_walk_blocks( skey, in, out, blocks, magma_decrypt_order, 1 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка того, что процессор поддерживает команды AVX2. */
+ static bool_t ak_magma_avx2_is_supported( void )
+{
+ #ifdef AK_HAVE_BUILTIN_CPU_SUPPORTS
+  __builtin_cpu_init();
+  if( __builtin_cpu_supports( "avx2" )) return ak_true;
+ #endif
+ return ak_false;
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка возможности использования переносимой реализации (всегда успешна). */
+ static bool_t ak_magma_generic_is_supported( void ) { return ak_true; }
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Перечень реализаций, скомпилированных в библиотеку.
+    \details Реализации перечисляются в порядке убывания предпочтения; последней всегда
+    указывается переносимая табличная реализация.                                                  */
+/* ----------------------------------------------------------------------------------------------- */
+ static const struct bckey_kernel magma_kernels[] = {
+#ifdef AK_HAVE_BUILTIN_MM256_SHUFFLE_EPI8
+  { "avx2", ak_magma_avx2_is_supported,
+    { ak_magma_avx2_encrypt_blocks, ak_magma_avx2_encrypt_blocks_oc },
+    { ak_magma_avx2_decrypt_blocks, ak_magma_avx2_decrypt_blocks_oc }},
+#endif
+#ifdef AK_HAVE_BUILTIN_SHUFFLE_EPI8
+  { "ssse3", ak_magma_ssse3_is_supported,
+    { ak_magma_ssse3_encrypt_blocks, ak_magma_ssse3_encrypt_blocks_oc },
+    { ak_magma_ssse3_decrypt_blocks, ak_magma_ssse3_decrypt_blocks_oc }},
+#endif
+  { "generic", ak_magma_generic_is_supported,
+    { ak_magma_encrypt_blocks_with_random_walk, ak_magma_encrypt_blocks_with_random_walk_oc },
+    { ak_magma_decrypt_blocks_with_random_walk, ak_magma_decrypt_blocks_with_random_walk_oc }}
+ };
+
+/*! \brief Количество реализаций, скомпилированных в библиотеку. */
+ #define ak_magma_kernels_count ( sizeof( magma_kernels )/sizeof( struct bckey_kernel ))
+
+/*! \brief Реализация, используемая при создании ключей алгоритма Магма
+    (по умолчанию - переносимая табличная реализация). */
+ static const struct bckey_kernel *magma_selected_kernel =
+                                                          magma_kernels + ak_magma_kernels_count -1;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция последовательно перебирает реализации, скомпилированные в библиотеку, и выбирает
+    первую из них, поддерживаемую процессором.
+
+    \return Функция возвращает \ref ak_error_ok.                                                   */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_bckey_magma_select_kernel( void )
+{
+  size_t idx = 0;
+
+  for( idx = 0; idx < ak_magma_kernels_count; idx++ )
+     if( magma_kernels[idx].is_supported()) {
+       magma_selected_kernel = magma_kernels + idx;
+       break;
+     }
+
+  if( ak_log_get_level() >= ak_log_maximum )
+    ak_error_message_fmt( ak_error_ok, __func__,
+                           "magma block cipher uses %s implementation", magma_selected_kernel->name );
+ return ak_error_ok;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Функция уничтожения развернутых ключей для маскированной магмы
 
@@ -914,7 +1539,7 @@
 /* ----------------------------------------------------------------------------------------------- */
  int ak_bckey_create_magma( ak_bckey bkey )
 {
-  int error = ak_error_ok, oc = (int) ak_libakrypt_get_option_by_name( "openssl_compability" );
+  int error = ak_error_ok, oc = (int) ak_libakrypt_get_option_by_index( openssl_compability_option );
 
   if( bkey == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
                                                "using null pointer to block cipher key context" );
@@ -951,6 +1576,8 @@
     bkey->encrypt = ak_magma_encrypt_with_random_walk;
     bkey->decrypt = ak_magma_decrypt_with_random_walk;
   }
+  bkey->encrypt_blocks = magma_selected_kernel->encrypt[oc];
+  bkey->decrypt_blocks = magma_selected_kernel->decrypt[oc];
   return error;
 }
 
@@ -1105,7 +1732,7 @@
   ak_uint8 myout[256];
   bool_t result = ak_true;
   int error = ak_error_ok, audit = ak_log_get_level(),
-      oc = (int) ak_libakrypt_get_option_by_name( "openssl_compability" );
+      oc = (int) ak_libakrypt_get_option_by_index( openssl_compability_option );
 
  /* Проверка используемого режима совместимости */
   if(( oc < 0 ) || ( oc > 1 )) {
@@ -1444,10 +2071,88 @@
  return result;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция проверяет корректность всех реализаций многоблочных функций алгоритма Магма,
+    скомпилированных в библиотеку и поддерживаемых процессором.
+    \details Результаты работы каждой реализации сравниваются с результатами однократного
+    применения базовых функций зашифрования/расшифрования, проверенных ранее на
+    контрольных примерах из ГОСТ Р 34.12-2015.
+
+    @return Если тестирование прошло успешно возвращается истина (\ref ak_true),
+    в противном случае возвращается ложь (\ref ak_false).                                          */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_libakrypt_test_magma_kernels( void )
+{
+  size_t i = 0, idx = 0;
+  struct bckey bkey;
+  bool_t result = ak_true;
+  ak_uint8 in[296], out[296], myout[296];
+  int error = ak_error_ok, audit = ak_log_get_level(),
+      oc = (int) ak_libakrypt_get_option_by_index( openssl_compability_option );
+  ak_uint8 key[32] = {
+     0xff, 0xfe, 0xfd, 0xfc, 0xfb, 0xfa, 0xf9, 0xf8, 0xf7, 0xf6, 0xf5, 0xf4, 0xf3, 0xf2, 0xf1, 0xf0,
+     0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+  };
+
+  if(( oc < 0 ) || ( oc > 1 )) {
+    ak_error_message( ak_error_wrong_option, __func__,
+                                                "wrong value for \"openssl_compability\" option" );
+    return ak_false;
+  }
+  if(( error = ak_bckey_create_magma( &bkey )) != ak_error_ok ) {
+    ak_error_message( error, __func__, "incorrect initialization of magma secret key context");
+    return ak_false;
+  }
+  if(( error = ak_bckey_set_key( &bkey, key, sizeof( key ))) != ak_error_ok ) {
+    ak_error_message( error, __func__, "wrong creation of test key" );
+    result = ak_false;
+    goto exit;
+  }
+
+ /* вычисляем эталонное значение с помощью базовой функции зашифрования;
+    количество блоков (37) задействует все векторные реализации и обработку остатка */
+  for( i = 0; i < sizeof( in ); i++ ) in[i] = ( ak_uint8 )( 29*i + 7 );
+  for( i = 0; i < sizeof( in ); i += 8 ) bkey.encrypt( &bkey.key, in+i, out+i );
+
+  for( idx = 0; idx < ak_magma_kernels_count; idx++ ) {
+     if( !magma_kernels[idx].is_supported()) {
+       if( audit >= ak_log_maximum ) ak_error_message_fmt( ak_error_ok, __func__,
+                          "%s implementation is not supported by processor", magma_kernels[idx].name );
+       continue;
+     }
+
+     memset( myout, 0, sizeof( myout ));
+     magma_kernels[idx].encrypt[oc]( &bkey.key, in, myout, sizeof( in ) >> 3 );
+     if( !ak_ptr_is_equal_with_log( myout, out, sizeof( out ))) {
+       ak_error_message_fmt( ak_error_not_equal_data, __func__ ,
+                              "wrong encryption with %s implementation", magma_kernels[idx].name );
+       result = ak_false;
+       goto exit;
+     }
+     magma_kernels[idx].decrypt[oc]( &bkey.key, myout, myout, sizeof( in ) >> 3 );
+     if( !ak_ptr_is_equal_with_log( myout, in, sizeof( in ))) {
+       ak_error_message_fmt( ak_error_not_equal_data, __func__ ,
+                              "wrong decryption with %s implementation", magma_kernels[idx].name );
+       result = ak_false;
+       goto exit;
+     }
+     if( audit >= ak_log_maximum ) ak_error_message_fmt( ak_error_ok, __func__,
+                                  "testing of %s implementation is Ok", magma_kernels[idx].name );
+  }
+
+  exit:
+  if(( error = ak_bckey_destroy( &bkey )) != ak_error_ok ) {
+    ak_error_message( error, __func__, "wrong destruction of secret key" );
+    return ak_false;
+  }
+
+ return result;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
  bool_t ak_libakrypt_test_magma( void )
 {
- int oc = (int) ak_libakrypt_get_option_by_name( "openssl_compability" );
+ int oc = (int) ak_libakrypt_get_option_by_index( openssl_compability_option );
 
  /* мы тестируем алгоритм Магма в двух режимах совместимисти,
     вызывая для этого функцию тестирования дважды
@@ -1459,6 +2164,11 @@
                                             "incorrect testing of magma algorithm in base mode" );
      return ak_false;
    }
+   if( ak_libakrypt_test_magma_kernels() != ak_true ) {
+     ak_error_message( ak_error_get_value(), __func__ ,
+                                        "incorrect testing of magma block cipher implementations" );
+     return ak_false;
+   }
 
  /* потом запускаем тестирование в режиме совместимости с openssl */
    ak_libakrypt_set_openssl_compability( ak_true );
@@ -1467,6 +2177,11 @@
                          "incorrect testing of magma algorithm in mode with openssl compability" );
      return ak_false;
    }
+   if( ak_libakrypt_test_magma_kernels() != ak_true ) {
+     ak_error_message( ak_error_get_value(), __func__ ,
+                                        "incorrect testing of magma block cipher implementations" );
+     return ak_false;
+   }
 
  /* восстанавливаем первоначальное состояние */
    ak_libakrypt_set_openssl_compability( oc );
@@ -116,6 +116,52 @@
 
 #endif
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция обрабатывает несколько последовательных блоков данных, участвующих
+    в выработке имитовставки.
+
+    Значения множителей H вырабатываются сразу для всех блоков одним вызовом функции
+    зашифрования последовательности блоков, после чего сумма произведений в конечном поле
+    вычисляется функцией ak_gf128_mul_sum() (ak_gf64_mul_sum()) с однократным приведением
+    по модулю для всего фрагмента.
+
+    @param ctx Контекст внутреннего состояния алгоритма.
+    @param authenticationKey Ключ, используемый для шифрования значений счетчика Z.
+    @param data Указатель на обрабатываемые данные.
+    @param blocks Количество блоков; значение не должно превосходить
+    величины `ak_bckey_batch_size/authenticationKey->bsize`.                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_mgm_hash_blocks( ak_mgm_ctx ctx, ak_bckey authenticationKey,
+                                                         ak_pointer data, const size_t blocks )
+{
+  size_t i;
+  ak_uint64 z[ ak_bckey_batch_size/sizeof( ak_uint64 )], *dptr = ( ak_uint64 *)data;
+
+  if( authenticationKey->bsize&0x10 ) { /* 128-битный шифр */
+    for( i = 0; i < blocks; i++ ) {
+       z[2*i] = ctx->zcount.q[0]; z[2*i+1] = ctx->zcount.q[1];
+      #ifdef AK_LITTLE_ENDIAN
+       ctx->zcount.q[1]++;
+      #else
+       ctx->zcount.q[1] = bswap_64( bswap_64( ctx->zcount.q[1] ) + 1 );
+      #endif
+    }
+    authenticationKey->encrypt_blocks( &authenticationKey->key, z, z, blocks );
+    ak_gf128_mul_sum( ctx->sum.q, z, dptr, blocks );
+  } else { /* 64-битный шифр */
+      for( i = 0; i < blocks; i++ ) {
+         z[i] = ctx->zcount.q[0];
+        #ifdef AK_LITTLE_ENDIAN
+         ctx->zcount.w[1]++;
+        #else
+         ctx->zcount.w[1] = bswap_32( bswap_32( ctx->zcount.w[1] ) + 1 );
+        #endif
+      }
+      authenticationKey->encrypt_blocks( &authenticationKey->key, z, z, blocks );
+      ak_gf64_mul_sum( ctx->sum.q, z, dptr, blocks );
+    }
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! Функция обрабатывает очередной блок дополнительных данных и
     обновляет внутреннее состояние переменных алгоритма MGM, участвующих в алгоритме
@@ -143,7 +189,7 @@
   ak_bckey authenticationKey = akey;
   ak_uint8 temp[16], *aptr = (ak_uint8 *)adata;
   ssize_t absize = ( ssize_t ) authenticationKey->bsize;
-  ssize_t resource = 0,
+  ssize_t resource = 0, cnt = 0,
           tail = ( ssize_t ) adata_size%absize,
           blocks = ( ssize_t ) adata_size/absize;
 
@@ -163,7 +209,10 @@
  if( absize == 16 ) { /* обработка 128-битным шифром */
 
    ctx->abitlen += ( blocks  << 7 );
-   for( ; blocks > 0; blocks--, aptr += 16 ) { astep128( aptr ); }
+   for( ; blocks > 0; blocks -= cnt, aptr += cnt << 4 ) {
+      cnt = ak_min( blocks, ak_bckey_batch_size >> 4 );
+      ak_mgm_hash_blocks( ctx, authenticationKey, aptr, ( size_t )cnt );
+   }
    if( tail ) {
     memset( temp, 0, 16 );
     memcpy( temp+absize-tail, aptr, (size_t)tail );
@@ -176,7 +225,10 @@
  } else { /* обработка 64-битным шифром */
 
    ctx->abitlen += ( blocks << 6 );
-   for( ; blocks > 0; blocks--, aptr += 8 ) { astep64( aptr ); }
+   for( ; blocks > 0; blocks -= cnt, aptr += cnt << 3 ) {
+      cnt = ak_min( blocks, ak_bckey_batch_size >> 3 );
+      ak_mgm_hash_blocks( ctx, authenticationKey, aptr, ( size_t )cnt );
+   }
    if( tail ) {
     memset( temp, 0, 8 );
     memcpy( temp+absize-tail, aptr, (size_t)tail );
@@ -314,30 +366,48 @@
 }
 
 /* ----------------------------------------------------------------------------------------------- */
-#ifdef AK_LITTLE_ENDIAN
- #define estep64  encryptionKey->encrypt( &encryptionKey->key, &ctx->ycount, &e ); \
-                  outp[0] = inp[0] ^ e.q[0]; \
-                  ctx->ycount.w[0]++;
+/*! \brief Функция зашифровывает (расшифровывает) несколько последовательных блоков данных.
 
- #define estep128 encryptionKey->encrypt( &encryptionKey->key, &ctx->ycount, &e ); \
-                  outp[0] = inp[0] ^ e.q[0]; \
-                  outp[1] = inp[1] ^ e.q[1]; \
-                  ctx->ycount.q[0]++;
+    Значения счетчика Y вырабатываются сразу для всех блоков и зашифровываются одним вызовом
+    функции зашифрования последовательности блоков.
 
-#else
- #define estep64  encryptionKey->encrypt( &encryptionKey->key, &ctx->ycount, &e ); \
-                  outp[0] = inp[0] ^ e.q[0]; \
-                  ctx->ycount.w[0] = bswap_32( ctx->ycount.w[0] ); \
-                  ctx->ycount.w[0]++; \
-                  ctx->ycount.w[0] = bswap_32( ctx->ycount.w[0] );
-
- #define estep128 encryptionKey->encrypt( &encryptionKey->key, &ctx->ycount, &e ); \
-                  outp[0] = inp[0] ^ e.q[0]; \
-                  outp[1] = inp[1] ^ e.q[1]; \
-                  ctx->ycount.q[0] = bswap_64( ctx->ycount.q[0] ); \
-                  ctx->ycount.q[0]++; \
-                  ctx->ycount.q[0] = bswap_64( ctx->ycount.q[0] );
-#endif
+    @param ctx Контекст внутреннего состояния алгоритма.
+    @param encryptionKey Ключ, используемый для шифрования значений счетчика Y.
+    @param inp Указатель на входные данные.
+    @param outp Указатель на выходные данные.
+    @param blocks Количество блоков; значение не должно превосходить
+    величины `ak_bckey_batch_size/encryptionKey->bsize`.                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_mgm_gamma_blocks( ak_mgm_ctx ctx, ak_bckey encryptionKey,
+                                           ak_uint64 *inp, ak_uint64 *outp, const size_t blocks )
+{
+  size_t i;
+  ak_uint64 e[ ak_bckey_batch_size/sizeof( ak_uint64 )];
+
+  if( encryptionKey->bsize&0x10 ) { /* 128-битный шифр */
+    for( i = 0; i < blocks; i++ ) {
+       e[2*i] = ctx->ycount.q[0]; e[2*i+1] = ctx->ycount.q[1];
+      #ifdef AK_LITTLE_ENDIAN
+       ctx->ycount.q[0]++;
+      #else
+       ctx->ycount.q[0] = bswap_64( bswap_64( ctx->ycount.q[0] ) + 1 );
+      #endif
+    }
+    encryptionKey->encrypt_blocks( &encryptionKey->key, e, e, blocks );
+    for( i = 0; i < 2*blocks; i++ ) outp[i] = inp[i] ^ e[i];
+  } else { /* 64-битный шифр */
+      for( i = 0; i < blocks; i++ ) {
+         e[i] = ctx->ycount.q[0];
+        #ifdef AK_LITTLE_ENDIAN
+         ctx->ycount.w[0]++;
+        #else
+         ctx->ycount.w[0] = bswap_32( bswap_32( ctx->ycount.w[0] ) + 1 );
+        #endif
+      }
+      encryptionKey->encrypt_blocks( &encryptionKey->key, e, e, blocks );
+      for( i = 0; i < blocks; i++ ) outp[i] = inp[i] ^ e[i];
+    }
+}
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! Функция зашифровывает очередной фрагмент данных и
@@ -366,7 +436,7 @@
   size_t i = 0, absize = 0;
   ak_bckey encryptionKey = ekey;
   ak_bckey authenticationKey = akey;
-  size_t resource = 0, tail, blocks;
+  size_t resource = 0, tail, blocks, cnt;
   ak_uint64 *inp = (ak_uint64 *)in, *outp = (ak_uint64 *)out;
 
  /* проверяем возможность обновления */
@@ -418,8 +488,9 @@
 
     if( absize&0x10 ) { /* режим работы для 128-битного шифра */
      /* основная часть */
-      for( ; blocks > 0; blocks--, inp += 2, outp += 2 ) {
-         estep128;
+      for( ; blocks > 0; blocks -= cnt, inp += cnt << 1, outp += cnt << 1 ) {
+         cnt = ak_min( blocks, ak_bckey_batch_size >> 4 );
+         ak_mgm_gamma_blocks( ctx, encryptionKey, inp, outp, cnt );
       }
       /* хвост */
       if( tail ) {
@@ -433,8 +504,9 @@
 
     } else { /* режим работы для 64-битного шифра */
        /* основная часть */
-        for( ; blocks > 0; blocks--, inp++, outp++ ) {
-           estep64;
+        for( ; blocks > 0; blocks -= cnt, inp += cnt, outp += cnt ) {
+           cnt = ak_min( blocks, ak_bckey_batch_size >> 3 );
+           ak_mgm_gamma_blocks( ctx, encryptionKey, inp, outp, cnt );
         }
        /* хвост */
         if( tail ) {
@@ -455,9 +527,10 @@
 
   if( absize&0x10 ) { /* режим работы для 128-битного шифра */
    /* основная часть */
-    for( ; blocks > 0; blocks--, inp += 2, outp += 2 ) {
-      estep128;
-      astep128( outp );
+    for( ; blocks > 0; blocks -= cnt, inp += cnt << 1, outp += cnt << 1 ) {
+      cnt = ak_min( blocks, ak_bckey_batch_size >> 4 );
+      ak_mgm_gamma_blocks( ctx, encryptionKey, inp, outp, cnt );
+      ak_mgm_hash_blocks( ctx, authenticationKey, outp, cnt );
     }
    /* хвост */
     if( tail ) {
@@ -475,9 +548,10 @@
   } else { /* режим работы для 64-битного шифра */
 
     /* основная часть */
-     for( ; blocks > 0; blocks--, inp++, outp++ ) {
-        estep64;
-        astep64( outp );
+     for( ; blocks > 0; blocks -= cnt, inp += cnt, outp += cnt ) {
+        cnt = ak_min( blocks, ak_bckey_batch_size >> 3 );
+        ak_mgm_gamma_blocks( ctx, encryptionKey, inp, outp, cnt );
+        ak_mgm_hash_blocks( ctx, authenticationKey, outp, cnt );
      }
     /* хвост */
      if( tail ) {
@@ -525,7 +599,7 @@
   ak_uint128 e, h;
   size_t i = 0, absize = encryptionKey->bsize;
   ak_uint64 *inp = (ak_uint64 *)in, *outp = (ak_uint64 *)out;
-  size_t resource = 0,
+  size_t resource = 0, cnt = 0,
          tail = size%absize,
          blocks = size/absize;
 
@@ -560,8 +634,9 @@
                                     /* это полная копия кода, содержащегося в функции .. _encryption_ ... */
     if( absize&0x10 ) { /* режим работы для 128-битного шифра */
      /* основная часть */
-      for( ; blocks > 0; blocks--, inp += 2, outp += 2 ) {
-         estep128;
+      for( ; blocks > 0; blocks -= cnt, inp += cnt << 1, outp += cnt << 1 ) {
+         cnt = ak_min( blocks, ak_bckey_batch_size >> 4 );
+         ak_mgm_gamma_blocks( ctx, encryptionKey, inp, outp, cnt );
       }
       /* хвост */
       if( tail ) {
@@ -575,8 +650,9 @@
 
     } else { /* режим работы для 64-битного шифра */
        /* основная часть */
-        for( ; blocks > 0; blocks--, inp++, outp++ ) {
-           estep64;
+        for( ; blocks > 0; blocks -= cnt, inp += cnt, outp += cnt ) {
+           cnt = ak_min( blocks, ak_bckey_batch_size >> 3 );
+           ak_mgm_gamma_blocks( ctx, encryptionKey, inp, outp, cnt );
         }
        /* хвост */
         if( tail ) {
@@ -593,9 +669,10 @@
 
      if( absize&0x10 ) { /* режим работы для 128-битного шифра */
       /* основная часть */
-      for( ; blocks > 0; blocks--, inp += 2, outp += 2 ) {
-         astep128( inp );
-         estep128;
+      for( ; blocks > 0; blocks -= cnt, inp += cnt << 1, outp += cnt << 1 ) {
+         cnt = ak_min( blocks, ak_bckey_batch_size >> 4 );
+         ak_mgm_hash_blocks( ctx, authenticationKey, inp, cnt );
+         ak_mgm_gamma_blocks( ctx, encryptionKey, inp, outp, cnt );
       }
       /* хвост */
       if( tail ) {
@@ -613,9 +690,10 @@
 
     } else { /* режим работы для 64-битного шифра */
       /* основная часть */
-       for( ; blocks > 0; blocks--, inp++, outp++ ) {
-          astep64( inp );
-          estep64;
+       for( ; blocks > 0; blocks -= cnt, inp += cnt, outp += cnt ) {
+          cnt = ak_min( blocks, ak_bckey_batch_size >> 3 );
+          ak_mgm_hash_blocks( ctx, authenticationKey, inp, cnt );
+          ak_mgm_gamma_blocks( ctx, encryptionKey, inp, outp, cnt );
        }
        /* хвост */
        if( tail ) {
@@ -45,6 +45,12 @@
    __asm__ ("mulq %3" : "=a,a" (w0), "=d,d" (w1) : "%0,0" (u), "r,m" (v))
 #endif
 
+/* ----------------------------------------------------------------------------------------------- */
+#ifdef AK_HAVE_BUILTIN_UINT128
+ __extension__ typedef unsigned __int128 ak_mpzn_uint128;
+ __extension__ typedef __int128 ak_mpzn_int128;
+#endif
+
 /* ----------------------------------------------------------------------------------------------- */
 #ifndef LIBAKRYPT_HAVE_ASM_CODE
  /* очень хочется, чтобы здесь была реализация метода А.А. Карацубы для двух 64-х битных чисел */
@@ -682,7 +688,9 @@
      cy += av > bv;
      z[i] = av;
   }
-  if( t[size] != cy ) memcpy( z, t, size*sizeof( ak_uint64 ));
+ // выбираем результат без ветвления: маска отлична от нуля, если вычитать модуль не следовало
+  cy = ( ak_uint64 )0 - ( ak_uint64 )( t[size] != cy );
+  for( i = 0; i < size; i++ ) z[i] = ( z[i]&~cy )|( t[i]&cy );
 }
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -716,27 +724,14 @@
     cy += av > bv;
     z[i] = av;
    }
-   if( t[size] != cy ) memcpy( z, t, size*sizeof( ak_uint64 ));
+   cy = ( ak_uint64 )0 - ( ak_uint64 )( t[size] != cy );
+   for( i = 0; i < size; i++ ) z[i] = ( z[i]&~cy )|( t[i]&cy );
 }
 
 /* ----------------------------------------------------------------------------------------------- */
-/*! Функция умножает два вычета x и y в представлении Монтгомери, после чего приводит полученное
-    произведение по модулю p, то есть для \f$ x \equiv x_0r \pmod{p} \f$ и
-    \f$ y \equiv y_0r \pmod{p} \f$ функция вычисляет значение,
-    удовлетворяющее сравнению \f$ z \equiv x_0y_0r \pmod{p}\f$.
-    Результат помещается в переменную z. Указатель на z может совпадать с одним из указателей на
-    перемножаемые вычеты.
-
-    @param z Указатель на вычет, в который помещается результат
-    @param x Левый аргумент опреации сложения
-    @param y Правый аргумент операции сложения
-    @param p Модуль, по которому производятся вычисления
-    @param n0 Константа, используемая в вычислениях. Представляет собой младшее слово
-    числа n, удовлетворяющего равенству \f$ rs - np = 1\f$.
-    @param size Размер модуля в словах (значение константы \ref ak_mpzn256_size или
-                                                                          \ref ak_mpzn512_size).   */
+/*! \brief Умножение Монтгомери для модулей произвольной длины (не более ak_mpznmax_size слов). */
 /* ----------------------------------------------------------------------------------------------- */
- inline void ak_mpzn_mul_montgomery( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y,
+ static void ak_mpzn_mul_montgomery_generic( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y,
                                                ak_uint64 *p, ak_uint64 n0, const size_t size )
 {
   size_t i = 0, j = 0, ij = 0;
@@ -795,6 +790,102 @@
   if( cy != t[2*size] ) memcpy( z, t+size, size*sizeof( ak_uint64 ));
 }
 
+#ifdef AK_HAVE_BUILTIN_UINT128
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Умножение Монтгомери с чередованием умножения и редукции (метод CIOS).
+
+    Функция вызывается только с константным значением size, что позволяет компилятору полностью
+    развернуть циклы и разместить промежуточные значения в регистрах. Произведения слов
+    вычисляются с использованием 128-битного целого типа; вычитание модуля выполняется
+    без ветвлений.                                                                                 */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_mpzn_mul_montgomery_cios( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y,
+                                               ak_uint64 *p, ak_uint64 n0, const size_t size )
+{
+  size_t i, j;
+  ak_mpzn_uint128 w;
+  ak_uint64 c, m, t[ak_mpzn512_size+2], s[ak_mpzn512_size];
+
+  for( j = 0; j < size+2; j++ ) t[j] = 0;
+  for( i = 0; i < size; i++ ) {
+    /* t <- t + x*y[i] */
+     for( j = 0, c = 0; j < size; j++ ) {
+        w = ( ak_mpzn_uint128 )x[j]*y[i] + t[j] + c;
+        t[j] = ( ak_uint64 )w; c = ( ak_uint64 )( w >> 64 );
+     }
+     w = ( ak_mpzn_uint128 )t[size] + c;
+     t[size] = ( ak_uint64 )w; t[size+1] = ( ak_uint64 )( w >> 64 );
+
+    /* t <- ( t + m*p )/2^64 */
+     m = t[0]*n0;
+     w = ( ak_mpzn_uint128 )m*p[0] + t[0];
+     c = ( ak_uint64 )( w >> 64 );
+     for( j = 1; j < size; j++ ) {
+        w = ( ak_mpzn_uint128 )m*p[j] + t[j] + c;
+        t[j-1] = ( ak_uint64 )w; c = ( ak_uint64 )( w >> 64 );
+     }
+     w = ( ak_mpzn_uint128 )t[size] + c;
+     t[size-1] = ( ak_uint64 )w;
+     t[size] = t[size+1] + ( ak_uint64 )( w >> 64 );
+  }
+
+ /* s <- t - p, затем без ветвления выбираем t или s */
+  for( j = 0, c = 0; j < size; j++ ) {
+     w = ( ak_mpzn_uint128 )t[j] - p[j] - c;
+     s[j] = ( ak_uint64 )w; c = ( ak_uint64 )( w >> 64 )&1;
+  }
+  m = ( ak_uint64 )0 - ( c&( t[size]^1 ));
+  for( j = 0; j < size; j++ ) z[j] = ( t[j]&m )|( s[j]&~m );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_mpzn_mul_montgomery_4( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y,
+                                                                       ak_uint64 *p, ak_uint64 n0 )
+{
+  ak_mpzn_mul_montgomery_cios( z, x, y, p, n0, ak_mpzn256_size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_mpzn_mul_montgomery_8( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y,
+                                                                       ak_uint64 *p, ak_uint64 n0 )
+{
+  ak_mpzn_mul_montgomery_cios( z, x, y, p, n0, ak_mpzn512_size );
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция умножает два вычета x и y в представлении Монтгомери, после чего приводит полученное
+    произведение по модулю p, то есть для \f$ x \equiv x_0r \pmod{p} \f$ и
+    \f$ y \equiv y_0r \pmod{p} \f$ функция вычисляет значение,
+    удовлетворяющее сравнению \f$ z \equiv x_0y_0r \pmod{p}\f$.
+    Результат помещается в переменную z. Указатель на z может совпадать с одним из указателей на
+    перемножаемые вычеты.
+
+    @param z Указатель на вычет, в который помещается результат
+    @param x Левый аргумент опреации сложения
+    @param y Правый аргумент операции сложения
+    @param p Модуль, по которому производятся вычисления
+    @param n0 Константа, используемая в вычислениях. Представляет собой младшее слово
+    числа n, удовлетворяющего равенству \f$ rs - np = 1\f$.
+    @param size Размер модуля в словах (значение константы \ref ak_mpzn256_size или
+                                                                          \ref ak_mpzn512_size).
+
+    Для модулей длины 256 и 512 бит, при наличии у компилятора 128-битного целого типа,
+    используются специализированные реализации с развернутыми циклами.                           */
+/* ----------------------------------------------------------------------------------------------- */
+ inline void ak_mpzn_mul_montgomery( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y,
+                                               ak_uint64 *p, ak_uint64 n0, const size_t size )
+{
+#ifdef AK_HAVE_BUILTIN_UINT128
+  switch( size ) {
+    case ak_mpzn256_size: ak_mpzn_mul_montgomery_4( z, x, y, p, n0 ); return;
+    case ak_mpzn512_size: ak_mpzn_mul_montgomery_8( z, x, y, p, n0 ); return;
+    default: break;
+  }
+#endif
+  ak_mpzn_mul_montgomery_generic( z, x, y, p, n0, size );
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! Для вычета \f$ x \f$, заданного в представлении Монтгомери в виде \f$ xr \f$, где \f$ r \f$
     заданная степень двойки, вычисляется вычет \f$ z \f$,
@@ -841,6 +932,332 @@
   memcpy( z, res, size*sizeof( ak_uint64 ));
 }
 
+#ifdef AK_HAVE_BUILTIN_UINT128
+/* ----------------------------------------------------------------------------------------------- */
+/* Обращение вычетов:                                                                              */
+/* реализован алгоритм, основанный на последовательности шагов деления (divsteps), по материалам   */
+/* D.J. Bernstein, B.-Y. Yang Fast constant-time gcd computation and modular inversion,            */
+/*                                          IACR Transactions on CHES, 2019(3):340-398, 2019.      */
+/* Числа представляются в виде знаковых 62-битных слов; за один проход выполняются 62 шага,        */
+/* которые вычисляются по младшим словам и затем применяются к числам целиком.                     */
+/* ----------------------------------------------------------------------------------------------- */
+ #define ak_mpzn_mask62 ( 0x3FFFFFFFFFFFFFFFULL )
+ #define ak_mpzn_signed62_size ( ak_mpznmax_size + 2 )
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Матрица перехода, накапливающая 62 шага деления (значения домножены на \f$ 2^{62}\f$). */
+ struct mpzn_trans2x2 {
+  ak_int64 u, v, q, r;
+ };
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Преобразование вычета в последовательность из len знаковых 62-битных слов. */
+ static void ak_mpzn_to_signed62( ak_int64 *r, const ak_uint64 *x,
+                                                             const size_t size, const size_t len )
+{
+  size_t i, word, shift;
+  ak_uint64 v;
+
+  for( i = 0; i < len; i++ ) {
+     word = ( 62*i ) >> 6; shift = ( 62*i )&0x3F;
+     v = ( word < size ) ? x[word] >> shift : 0;
+     if(( shift > 2 ) && ( word+1 < size )) v |= x[word+1] << ( 64 - shift );
+     r[i] = ( ak_int64 )( v&ak_mpzn_mask62 );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Обратное преобразование неотрицательного числа, заданного 62-битными словами. */
+ static void ak_mpzn_from_signed62( ak_uint64 *z, const ak_int64 *r,
+                                                             const size_t size, const size_t len )
+{
+  size_t i, word, shift;
+
+  memset( z, 0, size*sizeof( ak_uint64 ));
+  for( i = 0; i < len; i++ ) {
+     word = ( 62*i ) >> 6; shift = ( 62*i )&0x3F;
+     if( word < size ) z[word] |= ( ak_uint64 )r[i] << shift;
+     if(( shift > 2 ) && ( word+1 < size )) z[word+1] |= ( ak_uint64 )r[i] >> ( 64 - shift );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление 62 шагов деления за время, не зависящее от значений f и g.
+
+    @param eta Величина, противоположная параметру \f$ \delta \f$ алгоритма
+    @param f0 Младшее слово числа f
+    @param g0 Младшее слово числа g
+    @param t Матрица перехода
+    @return Новое значение eta.                                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ static ak_int64 ak_mpzn_divsteps62( ak_int64 eta, ak_uint64 f0, ak_uint64 g0,
+                                                                        struct mpzn_trans2x2 *t )
+{
+  int i;
+  ak_uint64 u = 1, v = 0, q = 0, r = 1, c1, c2, f = f0, g = g0, x, y, z;
+
+  for( i = 0; i < 62; i++ ) {
+    /* c1 -- маска условия eta < 0, c2 -- маска нечетности g */
+     c1 = ( ak_uint64 )( eta >> 63 );
+     c2 = ( ak_uint64 )0 - ( g&1 );
+    /* если g нечетно, то g <- g + f или g <- g - f */
+     x = ( f^c1 ) - c1; y = ( u^c1 ) - c1; z = ( v^c1 ) - c1;
+     g += x&c2; q += y&c2; r += z&c2;
+    /* если eta < 0 и g нечетно, то f <- g, eta <- -eta */
+     c1 &= c2;
+     eta = ( eta^( ak_int64 )c1 ) - ( ak_int64 )( c1 + 1 );
+     f += g&c1; u += q&c1; v += r&c1;
+    /* g <- g/2 */
+     g >>= 1; u <<= 1; v <<= 1;
+  }
+  t->u = ( ak_int64 )u; t->v = ( ak_int64 )v; t->q = ( ak_int64 )q; t->r = ( ak_int64 )r;
+
+ return eta;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление 62 шагов деления с пропуском серий четных значений g (время вычислений
+    зависит от обрабатываемых данных).                                                             */
+/* ----------------------------------------------------------------------------------------------- */
+ static ak_int64 ak_mpzn_divsteps62_var( ak_int64 eta, ak_uint64 f0, ak_uint64 g0,
+                                                                        struct mpzn_trans2x2 *t )
+{
+  int i = 62, limit, zeros;
+  ak_uint64 u = 1, v = 0, q = 0, r = 1, f = f0, g = g0, m, w, tmp;
+
+  for( ;; ) {
+    /* все шаги для четного g сводятся к делению g на степень двойки */
+     zeros = __builtin_ctzll( g|( 0xFFFFFFFFFFFFFFFFULL << i ));
+     g >>= zeros; u <<= zeros; v <<= zeros;
+     eta -= zeros; i -= zeros;
+     if( i == 0 ) break;
+
+     if( eta < 0 ) {
+       eta = -eta;
+       tmp = f; f = g; g = 0 - tmp;
+       tmp = u; u = q; q = 0 - tmp;
+       tmp = v; v = r; r = 0 - tmp;
+      /* обнуляем до шести младших бит g */
+       limit = (( int )eta + 1 ) > i ? i : (( int )eta + 1 );
+       m = ( 0xFFFFFFFFFFFFFFFFULL >> ( 64 - limit ))&63;
+       w = ( f*g*( f*f - 2 ))&m;
+     } else {
+      /* обнуляем до четырех младших бит g */
+       limit = (( int )eta + 1 ) > i ? i : (( int )eta + 1 );
+       m = ( 0xFFFFFFFFFFFFFFFFULL >> ( 64 - limit ))&15;
+       w = f + ((( f + 1 )&4 ) << 1 );
+       w = (( 0 - w )*g )&m;
+     }
+     g += f*w; q += u*w; r += v*w;
+  }
+  t->u = ( ak_int64 )u; t->v = ( ak_int64 )v; t->q = ( ak_int64 )q; t->r = ( ak_int64 )r;
+
+ return eta;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление \f$ (d,e) \leftarrow t\cdot(d,e)/2^{62} \pmod{p} \f$.
+
+    Значения d и e остаются в интервале \f$ (-2p, p) \f$; pinv равно \f$ p^{-1} \pmod{2^{62}}\f$. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_mpzn_update_de62( ak_int64 *d, ak_int64 *e, const struct mpzn_trans2x2 *t,
+                                       const ak_int64 *p, const ak_uint64 pinv, const size_t len )
+{
+  size_t i;
+  ak_mpzn_int128 cd, ce;
+  const ak_int64 u = t->u, v = t->v, q = t->q, r = t->r;
+  ak_int64 sd = d[len-1] >> 63, se = e[len-1] >> 63, md, me;
+
+ /* для отрицательных d и e заранее добавляем модуль, затем выбираем md и me так,
+    чтобы младшие 62 бита суммы t*(d,e) + p*(md,me) обратились в ноль */
+  md = ( u&sd ) + ( v&se );
+  me = ( q&sd ) + ( r&se );
+  cd = ( ak_mpzn_int128 )u*d[0] + ( ak_mpzn_int128 )v*e[0];
+  ce = ( ak_mpzn_int128 )q*d[0] + ( ak_mpzn_int128 )r*e[0];
+  md -= ( ak_int64 )(( pinv*( ak_uint64 )cd + ( ak_uint64 )md )&ak_mpzn_mask62 );
+  me -= ( ak_int64 )(( pinv*( ak_uint64 )ce + ( ak_uint64 )me )&ak_mpzn_mask62 );
+  cd += ( ak_mpzn_int128 )p[0]*md;
+  ce += ( ak_mpzn_int128 )p[0]*me;
+  cd >>= 62; ce >>= 62;
+
+  for( i = 1; i < len; i++ ) {
+     cd += ( ak_mpzn_int128 )u*d[i] + ( ak_mpzn_int128 )v*e[i] + ( ak_mpzn_int128 )p[i]*md;
+     ce += ( ak_mpzn_int128 )q*d[i] + ( ak_mpzn_int128 )r*e[i] + ( ak_mpzn_int128 )p[i]*me;
+     d[i-1] = ( ak_int64 )(( ak_uint64 )cd&ak_mpzn_mask62 ); cd >>= 62;
+     e[i-1] = ( ak_int64 )(( ak_uint64 )ce&ak_mpzn_mask62 ); ce >>= 62;
+  }
+  d[len-1] = ( ak_int64 )cd;
+  e[len-1] = ( ak_int64 )ce;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление \f$ (f,g) \leftarrow t\cdot(f,g)/2^{62} \f$ (деление выполняется нацело). */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_mpzn_update_fg62( ak_int64 *f, ak_int64 *g,
+                                            const struct mpzn_trans2x2 *t, const size_t len )
+{
+  size_t i;
+  ak_mpzn_int128 cf, cg;
+  const ak_int64 u = t->u, v = t->v, q = t->q, r = t->r;
+
+  cf = ( ak_mpzn_int128 )u*f[0] + ( ak_mpzn_int128 )v*g[0];
+  cg = ( ak_mpzn_int128 )q*f[0] + ( ak_mpzn_int128 )r*g[0];
+  cf >>= 62; cg >>= 62;
+  for( i = 1; i < len; i++ ) {
+     cf += ( ak_mpzn_int128 )u*f[i] + ( ak_mpzn_int128 )v*g[i];
+     cg += ( ak_mpzn_int128 )q*f[i] + ( ak_mpzn_int128 )r*g[i];
+     f[i-1] = ( ak_int64 )(( ak_uint64 )cf&ak_mpzn_mask62 ); cf >>= 62;
+     g[i-1] = ( ak_int64 )(( ak_uint64 )cg&ak_mpzn_mask62 ); cg >>= 62;
+  }
+  f[len-1] = ( ak_int64 )cf;
+  g[len-1] = ( ak_int64 )cg;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Приведение слов числа к интервалу \f$ [0, 2^{62}) \f$ с переносом в старшее слово. */
+ static void ak_mpzn_carry62( ak_int64 *d, const size_t len )
+{
+  size_t i;
+  for( i = 0; i < len-1; i++ ) {
+     d[i+1] += d[i] >> 62;
+     d[i] = ( ak_int64 )(( ak_uint64 )d[i]&ak_mpzn_mask62 );
+  }
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Для вычета \f$ x \f$, заданного в представлении Монтгомери в виде \f$ x_0r \f$,
+    функция вычисляет вычет \f$ z \f$, удовлетворяющий сравнению \f$ z \equiv x_0^{-1}r \pmod{p}\f$,
+    т.е. обратный элемент в представлении Монтгомери. Результат совпадает со значением,
+    вычисляемым функцией ak_mpzn_modpow_montgomery() для степени \f$ p-2 \f$; для \f$ x = 0\f$
+    возвращается ноль.
+
+    Вычисления выполняются при помощи последовательности шагов деления Бернштейна-Янга.
+    Если обращаемое значение является секретным, выполняется фиксированное количество шагов
+    без ветвлений, зависящих от данных. Для открытых данных используется более быстрый вариант,
+    время работы которого зависит от значения x. При отсутствии у компилятора 128-битного
+    целого типа используется возведение в степень \f$ p-2 \f$.
+
+    @param z Вычет, в который помещается результат
+    @param x Обращаемый вычет, \f$ 0 \leq x < p \f$
+    @param r2 Величина \f$ r^2 \pmod{p} \f$, используемая в арифметике Монтгомери
+    @param p Простой модуль, по которому производятся вычисления
+    @param n0 Константа, используемая в вычислениях. Представляет собой младшее слово числа n,
+    удовлетворяющего равенству \f$ rs - np = 1\f$.
+    @param size Размер модуля в словах (значение константы \ref ak_mpzn256_size
+    или \ref ak_mpzn512_size )
+    @param secret Если значение истинно, то время вычислений не зависит от значения x.             */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_mpzn_inverse_montgomery( ak_uint64 *z, ak_uint64 *x, ak_uint64 *r2,
+                            ak_uint64 *p, ak_uint64 n0, const size_t size, const bool_t secret )
+{
+#ifdef AK_HAVE_BUILTIN_UINT128
+  size_t i, count, len = ( size << 6 )/62 + 1;
+  ak_int64 eta = -1, cond, f[ak_mpzn_signed62_size], g[ak_mpzn_signed62_size],
+                d[ak_mpzn_signed62_size], e[ak_mpzn_signed62_size], pm[ak_mpzn_signed62_size];
+  const ak_uint64 pinv = ( 0 - n0 )&ak_mpzn_mask62; /* p^{-1} (mod 2^62) */
+  struct mpzn_trans2x2 t;
+
+ /* инвариант: f = d*x*r^{-2}, g = e*x*r^{-2} (mod p); по окончании f = 1 или -1 */
+  ak_mpzn_to_signed62( pm, p, size, len );
+  ak_mpzn_to_signed62( f, p, size, len );
+  ak_mpzn_to_signed62( g, x, size, len );
+  ak_mpzn_to_signed62( e, r2, size, len );
+  memset( d, 0, len*sizeof( ak_int64 ));
+
+  if( secret ) {
+   /* оценка количества шагов из теоремы 11.2 работы Бернштейна-Янга */
+    count = (( 49*( size << 6 ) + 57 )/17 + 61 )/62;
+    for( i = 0; i < count; i++ ) {
+       eta = ak_mpzn_divsteps62( eta, ( ak_uint64 )f[0], ( ak_uint64 )g[0], &t );
+       ak_mpzn_update_de62( d, e, &t, pm, pinv, len );
+       ak_mpzn_update_fg62( f, g, &t, len );
+    }
+  } else {
+    for( ;; ) {
+       for( i = 0, cond = 0; i < len; i++ ) cond |= g[i];
+       if( cond == 0 ) break;
+       eta = ak_mpzn_divsteps62_var( eta, ( ak_uint64 )f[0], ( ak_uint64 )g[0], &t );
+       ak_mpzn_update_de62( d, e, &t, pm, pinv, len );
+       ak_mpzn_update_fg62( f, g, &t, len );
+    }
+  }
+
+ /* приводим d из интервала (-2p, p) к интервалу [0, p) и учитываем знак f */
+  cond = d[len-1] >> 63;
+  for( i = 0; i < len; i++ ) d[i] += pm[i]&cond;
+  cond = f[len-1] >> 63;
+  for( i = 0; i < len; i++ ) d[i] = ( d[i]^cond ) - cond;
+  ak_mpzn_carry62( d, len );
+  cond = d[len-1] >> 63;
+  for( i = 0; i < len; i++ ) d[i] += pm[i]&cond;
+  ak_mpzn_carry62( d, len );
+
+  ak_mpzn_from_signed62( z, d, size, len );
+#else
+  ak_mpznmax u = ak_mpznmax_zero;
+
+  ( void )r2; ( void )secret;
+  ak_mpzn_set_ui( u, size, 2 );
+  ak_mpzn_sub( u, p, u, size );
+  ak_mpzn_modpow_montgomery( z, x, u, p, n0, size ); // z <- x^{p-2} (mod p)
+#endif
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет обратные элементы для массива из count вычетов, заданных в представлении
+    Монтгомери, используя метод П. Монтгомери: вычисляется одно обращение произведения всех
+    элементов, а обратные к каждому элементу находятся при помощи \f$ 3(count-1) \f$ умножений.
+    Нулевым элементам массива соответствуют нулевые значения результата, остальные элементы
+    обрабатываются так же, как функцией ak_mpzn_inverse_montgomery().
+
+    Обращение выполняется за время, зависящее от значений вычетов, поэтому функция
+    предназначена только для обработки открытых данных.
+
+    @param z Массив из count вычетов (по size слов), в который помещается результат;
+    не должен пересекаться с массивом x
+    @param x Массив из count обращаемых вычетов (по size слов)
+    @param count Количество вычетов
+    @param r2 Величина \f$ r^2 \pmod{p} \f$, используемая в арифметике Монтгомери
+    @param p Простой модуль, по которому производятся вычисления
+    @param n0 Константа, используемая в вычислениях. Представляет собой младшее слово числа n,
+    удовлетворяющего равенству \f$ rs - np = 1\f$.
+    @param size Размер модуля в словах (значение константы \ref ak_mpzn256_size
+    или \ref ak_mpzn512_size )                                                                     */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_mpzn_inverse_montgomery_batch( ak_uint64 *z, ak_uint64 *x, const size_t count,
+                                    ak_uint64 *r2, ak_uint64 *p, ak_uint64 n0, const size_t size )
+{
+  size_t i;
+  ak_uint64 *xi = NULL;
+  ak_mpznmax one = ak_mpznmax_one, inv, t;
+
+  if( count == 0 ) return;
+ /* нулевые элементы заменяются единицей (в представлении Монтгомери) */
+  ak_mpzn_mul_montgomery( one, one, r2, p, n0, size );
+  #define ak_mpzn_batch_value( i ) ( ak_mpzn_cmp_ui( x+(i)*size, size, 0 ) ? one : x+(i)*size )
+
+ /* z[i] <- x[0]x[1]...x[i] */
+  ak_mpzn_set( z, ak_mpzn_batch_value( 0 ), size );
+  for( i = 1; i < count; i++ )
+     ak_mpzn_mul_montgomery( z+i*size, z+(i-1)*size, ak_mpzn_batch_value( i ), p, n0, size );
+
+ /* обращаем произведение и последовательно находим обратные элементы */
+  ak_mpzn_inverse_montgomery( inv, z+(count-1)*size, r2, p, n0, size, ak_false );
+  for( i = count-1; i > 0; i-- ) {
+     xi = x+i*size;
+     ak_mpzn_mul_montgomery( t, inv, z+(i-1)*size, p, n0, size );
+     if( ak_mpzn_cmp_ui( xi, size, 0 )) ak_mpzn_set_ui( z+i*size, size, 0 );
+      else {
+        ak_mpzn_mul_montgomery( inv, inv, xi, p, n0, size );
+        ak_mpzn_set( z+i*size, t, size );
+      }
+  }
+  if( ak_mpzn_cmp_ui( x, size, 0 )) ak_mpzn_set_ui( z, size, 0 );
+   else ak_mpzn_set( z, inv, size );
+  #undef ak_mpzn_batch_value
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 #ifdef AK_HAVE_GMP_H
 /* преобразование "туда и обратно" */
@@ -3,7 +3,10 @@
 /*                                                                                                 */
 /*  Файл ak_oid.с                                                                                  */
 /* ----------------------------------------------------------------------------------------------- */
- #include <libakrypt.h>
+ #include <libakrypt-internal.h>
+#ifdef AK_HAVE_PTHREAD_H
+ #include <pthread.h>
+#endif
 
 /* ----------------------------------------------------------------------------------------------- */
 /*                           функции для доступа к именам криптоалгоритмов                         */
@@ -65,6 +68,12 @@
 */
  static const char *asn1_nlfsr_n[] =     { "nlfsr", NULL };
  static const char *asn1_nlfsr_i[] =     { "1.2.643.2.52.1.1.6", NULL };
+ static const char *asn1_ctr_drbg_kuznechik_n[] = { "ctr-drbg-kuznechik", NULL };
+ static const char *asn1_ctr_drbg_kuznechik_i[] = { "1.2.643.2.52.1.1.7", NULL };
+#ifdef AK_HAVE_SYSRANDOM_H
+ static const char *asn1_getrandom_n[] =   { "getrandom", NULL };
+ static const char *asn1_getrandom_i[] =   { "1.2.643.2.52.1.1.8", NULL };
+#endif
 
  static const char *asn1_streebog256_n[] = { "streebog256", "md_gost12_256", NULL };
  static const char *asn1_streebog256_i[] = { "1.2.643.7.1.1.2.2", NULL };
@@ -76,6 +85,14 @@
  static const char *asn1_hmac_streebog512_i[] = { "1.2.643.7.1.1.4.2", NULL };
  static const char *asn1_nmac_streebog_n[] =    { "nmac-streebog", NULL };
  static const char *asn1_nmac_streebog_i[] =    { "1.2.643.2.52.1.8.1", NULL };
+ static const char *asn1_tree_streebog256_n[] = { "tree-streebog256", NULL };
+ static const char *asn1_tree_streebog256_i[] = { "1.2.643.2.52.1.2.1", NULL };
+ static const char *asn1_tree_streebog512_n[] = { "tree-streebog512", NULL };
+ static const char *asn1_tree_streebog512_i[] = { "1.2.643.2.52.1.2.2", NULL };
+ static const char *asn1_hmac_tree_streebog256_n[] = { "hmac-tree-streebog256", NULL };
+ static const char *asn1_hmac_tree_streebog256_i[] = { "1.2.643.2.52.1.8.2", NULL };
+ static const char *asn1_hmac_tree_streebog512_n[] = { "hmac-tree-streebog512", NULL };
+ static const char *asn1_hmac_tree_streebog512_i[] = { "1.2.643.2.52.1.8.3", NULL };
  static const char *asn1_magma_n[] =       { "magma", NULL };
  static const char *asn1_magma_i[] =       { "1.2.643.7.1.1.5.1", NULL };
  static const char *asn1_kuznechik_n[] =   { "kuznechik", "kuznyechik", "grasshopper", NULL };
@@ -478,6 +495,20 @@
                            ( ak_function_set_key_random_object *)ak_hmac_set_key_random, \
                        ( ak_function_set_key_from_password_object *)ak_hmac_set_key_from_password }
 
+ #define ak_object_hmac_tree_streebog256 { sizeof( struct hmac ), \
+                           ( ak_function_create_object *) ak_hmac_create_tree_streebog256, \
+                           ( ak_function_destroy_object *) ak_hmac_destroy, \
+                           ( ak_function_set_key_object *)ak_hmac_set_key, \
+                           ( ak_function_set_key_random_object *)ak_hmac_set_key_random, \
+                       ( ak_function_set_key_from_password_object *)ak_hmac_set_key_from_password }
+
+ #define ak_object_hmac_tree_streebog512 { sizeof( struct hmac ), \
+                           ( ak_function_create_object *) ak_hmac_create_tree_streebog512, \
+                           ( ak_function_destroy_object *) ak_hmac_destroy, \
+                           ( ak_function_set_key_object *)ak_hmac_set_key, \
+                           ( ak_function_set_key_random_object *)ak_hmac_set_key_random, \
+                       ( ak_function_set_key_from_password_object *)ak_hmac_set_key_from_password }
+
  #define ak_object_nmac_streebog { sizeof( struct hmac ), \
                            ( ak_function_create_object *) ak_hmac_create_nmac, \
                            ( ak_function_destroy_object *) ak_hmac_destroy, \
@@ -538,6 +569,18 @@ static struct oid libakrypt_oids[] =
                               (ak_function_destroy_object *)ak_random_destroy, NULL, NULL, NULL },
                                                                 ak_object_undefined, NULL, NULL }},
 
+#ifdef AK_HAVE_SYSRANDOM_H
+ { random_generator, algorithm, asn1_getrandom_i, asn1_getrandom_n, NULL,
+  {{ sizeof( struct random ), (ak_function_create_object *)ak_random_create_getrandom,
+                              (ak_function_destroy_object *)ak_random_destroy, NULL, NULL, NULL },
+                                                                ak_object_undefined, NULL, NULL }},
+#endif
+
+ { random_generator, algorithm, asn1_ctr_drbg_kuznechik_i, asn1_ctr_drbg_kuznechik_n, NULL,
+  {{ sizeof( struct random ), (ak_function_create_object *)ak_random_create_ctr_drbg_kuznechik,
+                              (ak_function_destroy_object *)ak_random_destroy, NULL, NULL, NULL },
+                                                                ak_object_undefined, NULL, NULL }},
+
 /* добавляем идентификаторы алгоритмов */
  { hash_function, algorithm, asn1_streebog256_i, asn1_streebog256_n, NULL,
   {{ sizeof( struct hash ), ( ak_function_create_object *) ak_hash_create_streebog256,
@@ -549,7 +592,17 @@ static struct oid libakrypt_oids[] =
                               ( ak_function_destroy_object *) ak_hash_destroy, NULL, NULL, NULL },
                               ak_object_undefined, (ak_function_run_object *) ak_hash_ptr, NULL }},
 
- { hmac_function, algorithm, asn1_hmac_streebog256_i, asn1_hmac_streebog256_n, NULL,
+ { hash_function, algorithm, asn1_tree_streebog256_i, asn1_tree_streebog256_n, NULL,
+  {{ sizeof( struct hash ), ( ak_function_create_object *) ak_hash_create_tree_streebog256,
+                              ( ak_function_destroy_object *) ak_hash_destroy, NULL, NULL, NULL },
+                              ak_object_undefined, (ak_function_run_object *) ak_hash_ptr, NULL }},
+
+{ hash_function, algorithm, asn1_tree_streebog512_i, asn1_tree_streebog512_n, NULL,
+  {{ sizeof( struct hash ), ( ak_function_create_object *) ak_hash_create_tree_streebog512,
+                              ( ak_function_destroy_object *) ak_hash_destroy, NULL, NULL, NULL },
+                              ak_object_undefined, (ak_function_run_object *) ak_hash_ptr, NULL }},
+
+{ hmac_function, algorithm, asn1_hmac_streebog256_i, asn1_hmac_streebog256_n, NULL,
                             { ak_object_hmac_streebog256,
                               ak_object_undefined, (ak_function_run_object *) ak_hmac_ptr, NULL }},
 
@@ -561,6 +614,14 @@ static struct oid libakrypt_oids[] =
                             { ak_object_nmac_streebog,
                               ak_object_undefined, (ak_function_run_object *) ak_hmac_ptr, NULL }},
 
+{ hmac_function, algorithm, asn1_hmac_tree_streebog256_i, asn1_hmac_tree_streebog256_n, NULL,
+                            { ak_object_hmac_tree_streebog256,
+                              ak_object_undefined, (ak_function_run_object *) ak_hmac_ptr, NULL }},
+
+{ hmac_function, algorithm, asn1_hmac_tree_streebog512_i, asn1_hmac_tree_streebog512_n, NULL,
+                            { ak_object_hmac_tree_streebog512,
+                              ak_object_undefined, (ak_function_run_object *) ak_hmac_ptr, NULL }},
+
  { block_cipher, algorithm, asn1_magma_i, asn1_magma_n, NULL,
                                        { ak_object_bckey_magma, ak_object_undefined, NULL, NULL }},
 
@@ -1021,12 +1082,163 @@ static struct oid libakrypt_oids[] =
  return NULL;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*                               индексы для быстрого поиска OID                                   */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Количество элементов массива OID, включая завершающий неопределенный элемент. */
+ #define ak_oid_array_size                    ( sizeof( libakrypt_oids )/( sizeof( struct oid )))
+/*! \brief Количество элементов каждой из хеш-таблиц (должно быть степенью двойки). */
+ #define ak_oid_index_size                                                                  (512)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Элемент хеш-таблицы с открытой адресацией и линейным пробированием. */
+ typedef struct oid_index_entry {
+  /*! \brief Ключ: строка, содержащая имя или идентификатор, либо указатель на данные. */
+   ak_const_pointer key;
+  /*! \brief Идентификатор, соответствующий ключу. */
+   ak_oid oid;
+ } *ak_oid_index_entry;
+
+/*! \brief Хеш-таблица для поиска по именам. */
+ static struct oid_index_entry oid_index_names[ ak_oid_index_size ];
+/*! \brief Хеш-таблица для поиска по идентификаторам. */
+ static struct oid_index_entry oid_index_ids[ ak_oid_index_size ];
+/*! \brief Хеш-таблица для поиска по указателям на данные. */
+ static struct oid_index_entry oid_index_data[ ak_oid_index_size ];
+/*! \brief Первые идентификаторы для каждого типа криптографического механизма. */
+ static ak_oid oid_first_by_engine[ undefined_engine + 1 ];
+/*! \brief Первые идентификаторы для каждого режима криптографического механизма. */
+ static ak_oid oid_first_by_mode[ undefined_mode + 1 ];
+/*! \brief Следующие идентификаторы того же типа (индекс совпадает с индексом в массиве OID). */
+ static ak_oid oid_next_by_engine[ ak_oid_array_size ];
+/*! \brief Следующие идентификаторы того же режима (индекс совпадает с индексом в массиве OID). */
+ static ak_oid oid_next_by_mode[ ak_oid_array_size ];
+/*! \brief Результат построения индексов. */
+ static int oid_index_error = ak_error_not_ready;
+#ifdef AK_HAVE_PTHREAD_H
+/*! \brief Флаг однократного построения индексов. */
+ static pthread_once_t oid_index_once = PTHREAD_ONCE_INIT;
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Поиск в хеш-таблице элемента с заданным ключом, либо первого свободного элемента.
+    \param table Хеш-таблица.
+    \param key Ключ.
+    \param string Флаг того, что ключ является строкой (иначе сравниваются указатели).
+    \return Указатель на элемент таблицы. Если таблица заполнена, возвращается NULL.               */
+/* ----------------------------------------------------------------------------------------------- */
+ static ak_oid_index_entry ak_oid_index_lookup( ak_oid_index_entry table,
+                                                        ak_const_pointer key, const bool_t string )
+{
+  size_t i, idx = 0;
+  ak_uint64 hash = 0xcbf29ce484222325LL;
+
+  if( string ) { /* FNV-1a */
+    const ak_uint8 *ptr = key;
+    while( *ptr ) hash = ( hash^( *ptr++ ))*0x100000001b3LL;
+  }
+   else hash = (( ak_uint64 )( size_t )key )*0x9e3779b97f4a7c15LL;
+  idx = ( size_t )( hash >> 32 )&( ak_oid_index_size - 1 );
+
+  for( i = 0; i < ak_oid_index_size; i++, idx = ( idx + 1 )&( ak_oid_index_size - 1 )) {
+     if( table[idx].key == NULL ) return table + idx;
+     if( string ) {
+       if( strcmp( table[idx].key, key ) == 0 ) return table + idx;
+     }
+      else if( table[idx].key == key ) return table + idx;
+  }
+ return NULL;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Добавление ключа в хеш-таблицу. Если ключ уже присутствует в таблице, сохраняется
+    первый встретившийся в массиве OID идентификатор (как и при последовательном переборе).      */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_oid_index_insert( ak_oid_index_entry table,
+                                          ak_const_pointer key, const bool_t string, ak_oid oid )
+{
+  ak_oid_index_entry entry = ak_oid_index_lookup( table, key, string );
+
+  if( entry == NULL ) return ak_error_message( ak_error_overflow, __func__,
+                                                  "the size of object identifiers index is small" );
+  if( entry->key == NULL ) {
+    entry->key = key;
+    entry->oid = oid;
+  }
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Поиск идентификатора в хеш-таблице. */
+/* ----------------------------------------------------------------------------------------------- */
+ static ak_oid ak_oid_index_find( ak_oid_index_entry table,
+                                                        ak_const_pointer key, const bool_t string )
+{
+  ak_oid_index_entry entry = ak_oid_index_lookup( table, key, string );
+
+  if(( entry != NULL ) && ( entry->key != NULL )) return entry->oid;
+  ak_error_set_value( ak_error_oid_id );
+ return NULL;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Построение хеш-таблиц и списков идентификаторов одного типа и одного режима. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_oid_index_build( void )
+{
+  size_t idx, jdx;
+  int error = ak_error_ok;
+  ak_oid oid, last_engine[ undefined_engine + 1 ], last_mode[ undefined_mode + 1 ];
+
+  memset( last_engine, 0, sizeof( last_engine ));
+  memset( last_mode, 0, sizeof( last_mode ));
+  for( idx = 0; idx < ak_libakrypt_oids_count(); idx++ ) {
+     oid = libakrypt_oids + idx;
+     for( jdx = 0; ( oid->name != NULL ) && ( oid->name[jdx] != NULL ); jdx++ )
+        if(( error = ak_oid_index_insert( oid_index_names,
+                                                oid->name[jdx], ak_true, oid )) != ak_error_ok ) goto labex;
+     for( jdx = 0; ( oid->id != NULL ) && ( oid->id[jdx] != NULL ); jdx++ )
+        if(( error = ak_oid_index_insert( oid_index_ids,
+                                                  oid->id[jdx], ak_true, oid )) != ak_error_ok ) goto labex;
+     if(( oid->data != NULL ) &&
+       (( error = ak_oid_index_insert( oid_index_data, oid->data, ak_false, oid )) != ak_error_ok ))
+       goto labex;
+
+    /* списки идентификаторов одного типа и одного режима */
+     if( last_engine[oid->engine] == NULL ) oid_first_by_engine[oid->engine] = oid;
+       else oid_next_by_engine[ last_engine[oid->engine] - libakrypt_oids ] = oid;
+     last_engine[oid->engine] = oid;
+     if( last_mode[oid->mode] == NULL ) oid_first_by_mode[oid->mode] = oid;
+       else oid_next_by_mode[ last_mode[oid->mode] - libakrypt_oids ] = oid;
+     last_mode[oid->mode] = oid;
+  }
+
+  labex: oid_index_error = error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вызывается при инициализации библиотеки, а также при первом поиске идентификатора,
+    если он выполняется до инициализации. Индексы строятся однократно.
+
+    @return В случае успеха, возвращается ak_error_ok (ноль). В случае возникновения ошибки,
+    возвращается ее код.                                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_oid_create_index( void )
+{
+#ifdef AK_HAVE_PTHREAD_H
+  pthread_once( &oid_index_once, ak_oid_index_build );
+#else
+  if( oid_index_error == ak_error_not_ready ) ak_oid_index_build();
+#endif
+ return oid_index_error;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*                          поиск OID - функции внутреннего интерфейса                             */
 /* ----------------------------------------------------------------------------------------------- */
  size_t ak_libakrypt_oids_count( void )
 {
- return ( sizeof( libakrypt_oids )/( sizeof( struct oid )) - 1 );
+ return ( ak_oid_array_size - 1 );
 }
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -1050,27 +1262,14 @@ static struct oid libakrypt_oids[] =
 /* ----------------------------------------------------------------------------------------------- */
  ak_oid ak_oid_find_by_name( const char *name )
 {
-  size_t idx = 0;
-
  /* надо ли стартовать */
   if( name == NULL ) {
     ak_error_message( ak_error_null_pointer, __func__, "using null pointer to oid name" );
     return NULL;
   }
- /* перебор по всем возможным значениям */
-  do{
-     const char *str = NULL;
-     size_t len = 0, jdx = 0;
-     while(( str = libakrypt_oids[idx].name[jdx] ) != NULL ) {
-        len = strlen( str );
-        if(( strlen( name ) == len ) && ak_ptr_is_equal( name, str, len ))
-          return  &libakrypt_oids[idx];
-        jdx++;
-     }
-  } while( ++idx < ak_libakrypt_oids_count( ));
+  if( ak_oid_create_index() != ak_error_ok ) return NULL;
 
-  ak_error_set_value( ak_error_oid_id );
- return NULL;
+ return ak_oid_index_find( oid_index_names, name, ak_true );
 }
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -1081,25 +1280,13 @@ static struct oid libakrypt_oids[] =
 /* ----------------------------------------------------------------------------------------------- */
  ak_oid ak_oid_find_by_id( const char *id )
 {
-  size_t idx = 0;
   if( id == NULL ) {
     ak_error_message( ak_error_null_pointer, __func__, "using null pointer to oid identifier" );
     return NULL;
   }
- /* перебор по всем возможным значениям */
-  do{
-     const char *str = NULL;
-     size_t len = 0, jdx = 0;
-     while(( str = libakrypt_oids[idx].id[jdx] ) != NULL ) {
-        len = strlen( str );
-        if(( strlen( id ) == len ) && ak_ptr_is_equal( id, str, len ))
-          return  &libakrypt_oids[idx];
-        jdx++;
-     }
-  } while( ++idx < ak_libakrypt_oids_count( ));
+  if( ak_oid_create_index() != ak_error_ok ) return NULL;
 
-  ak_error_set_value( ak_error_oid_id );
- return NULL;
+ return ak_oid_index_find( oid_index_ids, id, ak_true );
 }
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -1110,40 +1297,18 @@ static struct oid libakrypt_oids[] =
 /* ----------------------------------------------------------------------------------------------- */
  ak_oid ak_oid_find_by_ni( const char *ni )
 {
-  size_t idx = 0;
+  ak_oid oid = NULL;
+
   if( ni == NULL ) {
     ak_error_message( ak_error_null_pointer, __func__,
               "using null pointer to oid name or identifier" );
     return NULL;
   }
+  if( ak_oid_create_index() != ak_error_ok ) return NULL;
 
-  /* перебор по всем возможным значениям имен */
-  do{
-    const char *str = NULL;
-    size_t len = 0, jdx = 0;
-    while(( str = libakrypt_oids[idx].name[jdx] ) != NULL ) {
-      len = strlen( str );
-      if(( strlen( ni ) == len ) && ak_ptr_is_equal( ni, str, len ))
-        return  &libakrypt_oids[idx];
-      jdx++;
-    }
-  } while( ++idx < ak_libakrypt_oids_count( ));
-
-  /* перебор по всем возможным значениям идентификаторов */
-  idx = 0;
-  do{
-    const char *str = NULL;
-    size_t len = 0, jdx = 0;
-    while(( str = libakrypt_oids[idx].id[jdx] ) != NULL ) {
-      len = strlen( str );
-      if(( strlen( ni ) == len ) && ak_ptr_is_equal( ni, str, len ))
-        return  &libakrypt_oids[idx];
-      jdx++;
-    }
-  } while( ++idx < ak_libakrypt_oids_count( ));
-
-  ak_error_set_value( ak_error_oid_id );
- return NULL;
+ /* сначала ищем среди имен, потом среди идентификаторов */
+  if(( oid = ak_oid_index_find( oid_index_names, ni, ak_true )) != NULL ) return oid;
+ return ak_oid_index_find( oid_index_ids, ni, ak_true );
 }
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -1153,21 +1318,14 @@ static struct oid libakrypt_oids[] =
 /* ----------------------------------------------------------------------------------------------- */
  ak_oid ak_oid_find_by_data( ak_const_pointer ptr )
 {
-  size_t idx = 0;
-
  /* надо ли стартовать */
   if( ptr == NULL ) {
     ak_error_message( ak_error_null_pointer, __func__, "using null pointer to oid name" );
     return NULL;
   }
+  if( ak_oid_create_index() != ak_error_ok ) return NULL;
 
- /* перебор по всем возможным значениям */
-  do{
-     if( libakrypt_oids[idx].data == ptr ) return  &libakrypt_oids[idx];
-  } while( ++idx < ak_libakrypt_oids_count( ));
-
-  ak_error_set_value( ak_error_oid_id );
- return NULL;
+ return ak_oid_index_find( oid_index_data, ptr, ak_false );
 }
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -1178,10 +1336,9 @@ static struct oid libakrypt_oids[] =
 /* ----------------------------------------------------------------------------------------------- */
  ak_oid ak_oid_find_by_engine( const oid_engines_t engine )
 {
-  size_t idx = 0;
-  do{
-     if( libakrypt_oids[idx].engine == engine ) return &libakrypt_oids[idx];
-  } while( ++idx < ak_libakrypt_oids_count( ));
+  if(( ak_oid_create_index() == ak_error_ok ) &&
+     (( size_t )engine <= undefined_engine ) && ( oid_first_by_engine[engine] != NULL ))
+    return oid_first_by_engine[engine];
   ak_error_message( ak_error_oid_engine, __func__, "searching oid with wrong engine" );
 
  return NULL;
@@ -1195,10 +1352,9 @@ static struct oid libakrypt_oids[] =
 /* ----------------------------------------------------------------------------------------------- */
  ak_oid ak_oid_find_by_mode( const oid_modes_t mode )
 {
-  size_t idx = 0;
-  do{
-     if( libakrypt_oids[idx].mode == mode ) return &libakrypt_oids[idx];
-  } while( ++idx < ak_libakrypt_oids_count( ));
+  if(( ak_oid_create_index() == ak_error_ok ) &&
+     (( size_t )mode <= undefined_mode ) && ( oid_first_by_mode[mode] != NULL ))
+    return oid_first_by_mode[mode];
   ak_error_message( ak_error_oid_mode, __func__, "searching oid with wrong mode" );
 
  return NULL;
@@ -1220,6 +1376,10 @@ static struct oid libakrypt_oids[] =
    return NULL;
  }
 
+ /* для идентификаторов того же типа используем заранее построенный список */
+  if(( oid->engine == engine ) && ak_oid_check( oid ) && ( ak_oid_create_index() == ak_error_ok ))
+    return oid_next_by_engine[ oid - libakrypt_oids ];
+
  /* сдвигаемся по массиву OID вперед */
   while( (++oid)->engine != undefined_engine ) {
     if( oid->engine == engine ) return oid;
@@ -1244,6 +1404,10 @@ static struct oid libakrypt_oids[] =
    return NULL;
  }
 
+ /* для идентификаторов того же режима используем заранее построенный список */
+  if(( oid->mode == mode ) && ak_oid_check( oid ) && ( ak_oid_create_index() == ak_error_ok ))
+    return oid_next_by_mode[ oid - libakrypt_oids ];
+
  /* сдвигаемся по массиву OID вперед */
   while( (++oid)->mode != undefined_mode ) {
     if( oid->mode == mode ) return oid;
@@ -1259,13 +1423,11 @@ static struct oid libakrypt_oids[] =
 /* ----------------------------------------------------------------------------------------------- */
  bool_t ak_oid_check( const ak_pointer ptr )
 {
-  size_t i;
-  bool_t result = ak_false;
-
-  for( i = 0; i < ak_libakrypt_oids_count(); i++ )
-     if( ptr == &libakrypt_oids[i] ) result = ak_true;
+  size_t offset = ( size_t )ptr - ( size_t )libakrypt_oids;
 
- return result;
+  if(( size_t )ptr < ( size_t )libakrypt_oids ) return ak_false;
+  if( offset >= ak_libakrypt_oids_count()*sizeof( struct oid )) return ak_false;
+ return ( offset%sizeof( struct oid ) == 0 );
 }
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -28,7 +28,8 @@
  } *ak_option;
 
 /* ----------------------------------------------------------------------------------------------- */
-/*! Константные значения опций (значения по-умолчанию) */
+/*! Константные значения опций (значения по-умолчанию).
+    Порядок опций должен совпадать с порядком идентификаторов, определяемых типом \ref option_t. */
  static struct option options[] = {
      { "log_level", ak_log_standard, 0, 2 },
      { "pbkdf2_iteration_count", 2000, 1000, 65536 },
@@ -50,9 +51,23 @@
      { "openssl_compability", 0, 0, 1 },
   /* флаг использования цвета при выводе сообщений библиотеки */
      { "use_color_output", 1, 0, 1 },
+  /* длина фрагмента (в октетах), которыми считываются и обрабатываются файлы */
+     { "file_buffer_size", 1048576, 4096, 67108864 },
+  /* флаг отображения файлов в память при вычислении хеш-кодов и имитовставок */
+     { "use_mmap_for_files", 1, 0, 1 },
+  /* максимальное количество потоков, вычисляющих хеш-коды листьев при древовидном хешировании */
+     { "tree_hash_threads", 4, 1, 64 },
+  /* размер фрагмента (в октетах), вырабатываемого за один раз генератором ctr-drbg-kuznechik */
+     { "ctr_drbg_buffer_size", 16384, 4096, 65536 },
+  /* максимальное количество потоков, одновременно зашифровывающих и расшифровывающих
+     фрагменты одного файла */
+     { "encrypt_file_threads", 1, 1, 64 },
      { NULL, 0, 0, 0 } /* завершающая константа, должна всегда принимать нулевые значения */
  };
 
+/*! \brief Номер поколения значений опций, увеличивается при каждом изменении опций. */
+ static ak_uint64 options_generation = 1;
+
 /* ----------------------------------------------------------------------------------------------- */
  const char *ak_libakrypt_version( void )
 {
@@ -109,7 +124,11 @@
  ak_int64 ak_libakrypt_get_option_by_index( const size_t index )
 {
   if( index >= ak_libakrypt_options_count() ) return ak_error_wrong_option;
+ #ifdef _MSC_VER
  return options[index].value;
+ #else
+ return __atomic_load_n( &options[index].value, __ATOMIC_RELAXED );
+ #endif
 }
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -127,13 +146,38 @@
   int result = ak_error_wrong_option;
   for( i = 0; i < ak_libakrypt_options_count(); i++ ) {
      if( strncmp( name, options[i].name, strlen( options[i].name )) == 0 ) {
+     /* значение записывается до увеличения номера поколения: поток, считавший новый номер,
+        считывает и новое значение опции */
+      #ifdef _MSC_VER
        options[i].value = value;
+       options_generation++;
+      #else
+       __atomic_store_n( &options[i].value, value, __ATOMIC_RELAXED );
+       __atomic_add_fetch( &options_generation, 1, __ATOMIC_RELEASE );
+      #endif
        result = ak_error_ok;
      }
   }
  return result;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! Номер поколения увеличивается при каждом успешном вызове функции ak_libakrypt_set_option().
+    Сравнение сохраненного номера поколения с текущим позволяет определить, изменялись ли
+    значения опций с момента их последнего считывания. Номер поколения должен считываться
+    до значений опций.
+
+    \return Текущий номер поколения значений опций.                                               */
+/* ----------------------------------------------------------------------------------------------- */
+ ak_uint64 ak_libakrypt_get_options_generation( void )
+{
+#ifdef _MSC_VER
+  return options_generation;
+#else
+  return __atomic_load_n( &options_generation, __ATOMIC_ACQUIRE );
+#endif
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! При выводе используется текущая функция аудита.                                                */
 /* ----------------------------------------------------------------------------------------------- */
@@ -393,7 +437,7 @@
  if( ak_file_open_to_read( &fd, name ) == ak_error_ok ) {
    ak_file_close( &fd );
    if(( error = ak_ini_parse( name, ak_libakrypt_load_option_from_file, NULL )) == ak_error_ok ) {
-     if( ak_libakrypt_get_option_by_name( "log_level" ) > ak_log_none )
+     if( ak_libakrypt_get_option_by_index( log_level_option ) > ak_log_none )
        ak_error_message_fmt( ak_error_ok, "ak_libakrypt_log_options",
                                             "all options have been read from the %s file", name );
      return ak_true;
@@ -413,7 +457,7 @@
  if( ak_file_open_to_read( &fd, name ) == ak_error_ok ) {
    ak_file_close( &fd );
    if(( error = ak_ini_parse( name, ak_libakrypt_load_option_from_file, NULL )) == ak_error_ok ) {
-     if( ak_libakrypt_get_option_by_name( "log_level" ) > ak_log_none )
+     if( ak_libakrypt_get_option_by_index( log_level_option ) > ak_log_none )
        ak_error_message_fmt( ak_error_ok, "ak_libakrypt_log_options",
                                              "all options have been read from the %s file", name );
      return ak_true;
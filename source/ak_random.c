@@ -16,6 +16,15 @@
 #ifdef AK_HAVE_FCNTL_H
  #include <fcntl.h>
 #endif
+#ifdef AK_HAVE_ERRNO_H
+ #include <errno.h>
+#endif
+#ifdef AK_HAVE_SYSRANDOM_H
+ #include <sys/random.h>
+#endif
+#if defined( AK_HAVE_PTHREAD_H ) || defined( AK_HAVE_PTHREAD_ATFORK )
+ #include <pthread.h>
+#endif
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Инициализация генератора псевдо-случайных чисел.
@@ -729,6 +738,505 @@
    return ak_random_create_nlfsr_with_params( generator, 21, 849314 );
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*                     отслеживание вызова fork() для генераторов с состоянием                     */
+/* ----------------------------------------------------------------------------------------------- */
+#if defined( AK_HAVE_PTHREAD_H ) || defined( AK_HAVE_PTHREAD_ATFORK )
+/*! \brief Поколение процесса, увеличивается в дочернем процессе после вызова `fork()`. */
+ static volatile ak_uint64 random_fork_generation = 1;
+/*! \brief Флаг однократной регистрации обработчика `fork()`. */
+ static pthread_once_t random_fork_once = PTHREAD_ONCE_INIT;
+
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_random_fork_child( void )
+{
+  random_fork_generation++;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_random_fork_register( void )
+{
+  pthread_atfork( NULL, NULL, ak_random_fork_child );
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Получение текущего поколения процесса.
+
+    Данные, выработанные до вызова `fork()`, а также внутреннее состояние генераторов не должны
+    использоваться одновременно родительским и дочерним процессами. Поколение изменяется
+    обработчиком, зарегистрированным функцией `pthread_atfork()`, которая доступна в стандартной
+    библиотеке и без поддержки потоков POSIX, поэтому запрос не требует системного вызова.
+    Номер процесса используется в качестве поколения только при отсутствии функции
+    `pthread_atfork()`.                                                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline ak_uint64 ak_random_fork_generation( void )
+{
+#if defined( AK_HAVE_PTHREAD_H ) || defined( AK_HAVE_PTHREAD_ATFORK )
+  pthread_once( &random_fork_once, ak_random_fork_register );
+ return random_fork_generation;
+#else
+ #ifdef AK_HAVE_UNISTD_H
+  return ( ak_uint64 )getpid();
+ #else
+  return 1;
+ #endif
+#endif
+}
+
+#ifdef AK_HAVE_SYSRANDOM_H
+/* ----------------------------------------------------------------------------------------------- */
+/*                                 реализация класса rng_getrandom                                 */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Размер буффера (в октетах), заполняемого за одно обращение к функции `getrandom()`. */
+ #define ak_getrandom_buffer_size          (4096)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Буффер данных, выработанных операционной системой. Для каждого потока
+    создается собственный экземпляр буффера, поэтому синхронизация не требуется. */
+ static ak_thread_local struct getrandom_buffer {
+  /*! \brief Выработанные, но еще не выданные данные. */
+   ak_uint8 data[ ak_getrandom_buffer_size ];
+  /*! \brief Смещение первого невыданного октета. */
+   size_t offset;
+  /*! \brief Поколение процесса, в котором были выработаны данные. */
+   ak_uint64 generation;
+ } getrandom_buffer = { { 0 }, ak_getrandom_buffer_size, 0 };
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Чтение данных с помощью системного вызова `getrandom()`.
+    @return Функция возвращает количество считанных октетов.                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static size_t ak_random_getrandom_read( ak_uint8 *ptr, size_t size )
+{
+  ssize_t result = 0;
+  size_t count = 0;
+
+  while( count < size ) {
+    if(( result = getrandom( ptr + count, size - count, 0 )) < 0 ) {
+     #ifdef AK_HAVE_ERRNO_H
+      if( errno == EINTR ) continue;
+     #endif
+      break;
+    }
+    count += ( size_t )result;
+  }
+ return count;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_random_getrandom_ptr( ak_random rnd, const ak_pointer ptr, const ssize_t size )
+{
+  ak_uint8 *value = ptr;
+  size_t len = 0, count = ( size_t )size;
+  ak_uint64 generation = 0;
+  struct getrandom_buffer *buf = &getrandom_buffer;
+
+  if( rnd == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                      "use a null pointer to a random generator" );
+  if( ptr == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                                    "use a null pointer to data" );
+  if( size <= 0 ) return ak_error_message( ak_error_wrong_length, __func__ ,
+                                                           "use a data vector with wrong length" );
+ /* большие запросы обслуживаются без использования буффера */
+  if( count >= ak_getrandom_buffer_size ) {
+    if( ak_random_getrandom_read( value, count ) != count )
+      return ak_error_message( ak_error_read_data, __func__ , "wrong reading data from getrandom()" );
+    return ak_error_ok;
+  }
+
+ /* после fork() данные, выработанные родительским процессом, уничтожаются */
+  if( buf->generation != ( generation = ak_random_fork_generation( ))) {
+    memset( buf->data, 0, sizeof( buf->data ));
+    buf->offset = sizeof( buf->data );
+    buf->generation = generation;
+  }
+  while( count > 0 ) {
+    if( buf->offset == sizeof( buf->data )) {
+      if( ak_random_getrandom_read( buf->data, sizeof( buf->data )) != sizeof( buf->data ))
+        return ak_error_message( ak_error_read_data, __func__ ,
+                                                            "wrong reading data from getrandom()" );
+      buf->offset = 0;
+    }
+    len = ak_min( count, sizeof( buf->data ) - buf->offset );
+    memcpy( value, buf->data + buf->offset, len );
+    memset( buf->data + buf->offset, 0, len );
+    buf->offset += len;
+    value += len;
+    count -= len;
+  }
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Генератор возвращает данные, выработанные операционной системой с помощью системного
+    вызова `getrandom()`. В отличие от генераторов `dev-random` и `dev-urandom`, генератор не
+    использует файловый дескриптор, а небольшие запросы обслуживаются из буффера, который
+    заполняется одним системным вызовом и создается для каждого потока. После вызова `fork()`
+    содержимое буффера в дочернем процессе не используется.
+
+    @param generator Контекст создаваемого генератора.
+    \return В случае успеха, функция возвращает \ref ak_error_ok. В противном случае
+            возвращается код ошибки.                                                               */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_random_create_getrandom( ak_random generator )
+{
+  int error = ak_error_ok;
+
+  if(( error = ak_random_create( generator )) != ak_error_ok )
+    return ak_error_message( error, __func__ , "wrong initialization of random generator" );
+
+  generator->oid = ak_oid_find_by_name( "getrandom" );
+  generator->next = NULL;
+  generator->randomize_ptr = NULL; /* генератор не может быть инициализирован пользователем */
+  generator->random = ak_random_getrandom_ptr;
+  generator->free = NULL;
+
+ return error;
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*                         реализация генератора ctr-drbg-kuznechik                                */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Объем данных (в октетах), вырабатываемых генератором между двумя последовательными
+    обращениями к системному источнику энтропии. */
+ #define ak_ctr_drbg_reseed_interval   (16777216)
+/*! \brief Максимальный объем гаммы (в октетах), вырабатываемой генератором на одном ключе.
+    Если ресурс ключа Кузнечика (опция `kuznechik_cipher_resource`) меньше, то используется он. */
+ #define ak_ctr_drbg_rekey_interval     (1048576)
+/*! \brief Длина материала (ключ, синхропосылка и выравнивание до длины блока),
+    используемого для обновления состояния. */
+ #define ak_ctr_drbg_seed_size               (48)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Внутреннее состояние генератора, основанного на блочном шифре Кузнечик. */
+ typedef struct ctr_drbg {
+  /*! \brief Текущий ключ блочного шифра. */
+   struct bckey key;
+  /*! \brief Текущая синхропосылка. */
+   ak_uint8 iv[8];
+  /*! \brief Буффер, содержащий выработанные, но еще не выданные данные. */
+   ak_uint8 *buffer;
+  /*! \brief Размер фрагмента данных, вырабатываемого за один раз (без учета материала
+      для обновления состояния). */
+   size_t size;
+  /*! \brief Смещение первого невыданного октета в буффере. */
+   size_t offset;
+  /*! \brief Объем гаммы, выработанной на текущем ключе. */
+   size_t used;
+  /*! \brief Объем данных, выработанных после последнего обращения к источнику энтропии. */
+   ak_uint64 generated;
+  /*! \brief Поколение процесса, в котором было установлено текущее состояние. */
+   ak_uint64 generation;
+ } *ak_ctr_drbg;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Получение случайных данных из системного источника энтропии.
+
+    В первую очередь используется системный вызов `getrandom()`, при его отсутствии или ошибке
+    данные считываются из `/dev/urandom` (в ОС Windows используется криптопровайдер).
+
+    @param ptr Указатель на область памяти, в которую помещаются данные.
+    @param size Размер помещаемых данных, в байтах.
+    @return В случае успеха возвращается ak_error_ok (ноль). В случае возникновения ошибки
+    возвращается ее код.                                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_random_system_entropy( ak_uint8 *ptr, size_t size )
+{
+  int error = ak_error_undefined_function;
+#if defined(__unix__) || defined(__APPLE__) || defined(_WIN32)
+  struct random generator;
+#endif
+#ifdef AK_HAVE_SYSRANDOM_H
+  size_t count = ak_random_getrandom_read( ptr, size );
+
+  if( count == size ) return ak_error_ok;
+  ptr += count;
+  size -= count;
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+  error = ak_random_create_urandom( &generator );
+#endif
+#ifdef _WIN32
+  error = ak_random_create_winrtl( &generator );
+#endif
+  if( error != ak_error_ok ) return ak_error_message( error, __func__,
+                                                     "system source of entropy is not available" );
+#if defined(__unix__) || defined(__APPLE__) || defined(_WIN32)
+  error = ak_random_ptr( &generator, ptr, ( ssize_t )size );
+  ak_random_destroy( &generator );
+#endif
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Выработка очередного фрагмента данных и, при необходимости, обновление ключа
+    и синхропосылки.
+
+    Гамма вырабатывается в режиме гаммирования в объеме, на \ref ak_ctr_drbg_seed_size октетов
+    превышающем размер фрагмента. Если выработка следующего фрагмента на текущем ключе превысит
+    \ref ak_ctr_drbg_rekey_interval октетов или ресурс ключа, а также при наличии дополнительных
+    данных, последние октеты гаммы (сложенные с дополнительными данными) становятся новыми
+    ключом и синхропосылкой. Тем самым, раскрытие
+    текущего состояния не позволяет восстановить данные, выработанные на предыдущих ключах;
+    в остальных случаях последние октеты гаммы просто уничтожаются.
+
+    Развертка ключа Кузнечика заметно дороже выработки фрагмента гаммы, поэтому ключ не
+    меняется после каждого фрагмента.
+
+    Поскольку после каждого фрагмента расходуются \ref ak_ctr_drbg_seed_size октетов гаммы,
+    а ключ меняется только на границе фрагментов, выходная последовательность генератора
+    зависит от значения опции `ctr_drbg_buffer_size`.
+
+    @param ctx Внутреннее состояние генератора.
+    @param seed Дополнительные данные длины \ref ak_ctr_drbg_seed_size октетов, может принимать
+    значение NULL.
+    @return В случае успеха возвращается ak_error_ok (ноль). В случае возникновения ошибки
+    возвращается ее код.                                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_random_ctr_drbg_refill( ak_ctr_drbg ctx, const ak_uint8 *seed )
+{
+  size_t i = 0;
+  int error = ak_error_ok;
+  ak_uint8 *tail = ctx->buffer + ctx->size;
+  const size_t next = ctx->size + ak_ctr_drbg_seed_size;
+
+  memset( ctx->buffer, 0, next );
+ /* синхропосылка передается только при первом обращении к новому ключу,
+    далее значение счетчика продолжается с предыдущего фрагмента */
+  if(( error = ak_bckey_ctr( &ctx->key, ctx->buffer, ctx->buffer, next,
+                 ctx->used ? NULL : ctx->iv, ctx->used ? 0 : sizeof( ctx->iv ))) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect generation of key stream" );
+  ctx->used += next;
+
+ /* ключ меняется, если следующий фрагмент превысит допустимый объем гаммы на одном ключе
+    или оставшийся ресурс ключа (ресурс задается в блоках) */
+  if(( seed != NULL ) || ( ctx->used + next > ak_ctr_drbg_rekey_interval ) ||
+               ( ctx->key.key.resource.value.counter < ( ssize_t )( next/ctx->key.bsize ))) {
+    if( seed != NULL )
+      for( i = 0; i < ak_ctr_drbg_seed_size; i++ ) tail[i] ^= seed[i];
+    error = ak_bckey_set_key( &ctx->key, tail, 32 );
+    memcpy( ctx->iv, tail + 32, sizeof( ctx->iv ));
+    ctx->used = 0;
+  }
+  memset( tail, 0, ak_ctr_drbg_seed_size );
+  if( error != ak_error_ok ) return ak_error_message( error, __func__,
+                                                              "incorrect update of secret key" );
+  ctx->offset = 0;
+  ctx->generated += ctx->size;
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Установка состояния генератора: ключа и синхропосылки, с последующей выработкой
+    первого фрагмента данных. */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_random_ctr_drbg_set_seed( ak_ctr_drbg ctx, const ak_uint8 *seed )
+{
+  int error = ak_error_ok;
+
+  if(( error = ak_bckey_set_key( &ctx->key, ( ak_pointer )seed, 32 )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect assigning of secret key" );
+  memcpy( ctx->iv, seed + 32, sizeof( ctx->iv ));
+  ctx->used = 0;
+  ctx->generated = 0;
+  ctx->generation = ak_random_fork_generation();
+
+ return ak_random_ctr_drbg_refill( ctx, NULL );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Обновление состояния генератора в дочернем процессе после вызова `fork()`.
+
+    Ключ и синхропосылка заменяются значениями, полученными с использованием данных
+    системного источника энтропии, после чего выработанный ранее фрагмент уничтожается
+    и вырабатывается новый фрагмент на новом ключе. */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_random_ctr_drbg_fork_reseed( ak_ctr_drbg ctx, const ak_uint64 generation )
+{
+  int error = ak_error_ok;
+  ak_uint8 seed[ ak_ctr_drbg_seed_size ];
+
+  if(( error = ak_random_system_entropy( seed, sizeof( seed ))) == ak_error_ok )
+    error = ak_random_ctr_drbg_refill( ctx, seed );
+  memset( seed, 0, sizeof( seed ));
+  if( error != ak_error_ok ) return ak_error_message( error, __func__,
+                                                      "incorrect reseeding of generator's state" );
+  ctx->generated = 0;
+  ctx->generation = generation;
+
+ return ak_random_ctr_drbg_refill( ctx, NULL );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Инициализация генератора заданным массивом значений.
+
+    Значения сжимаются функцией хеширования Стрибог512, результат используется в качестве ключа
+    и синхропосылки. Последовательность, вырабатываемая после вызова данной функции, полностью
+    определяется заданным массивом (до очередного обращения к источнику энтропии) и значением
+    опции `ctr_drbg_buffer_size`, см. ak_random_ctr_drbg_refill().                             */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_random_ctr_drbg_randomize_ptr( ak_random rnd, const ak_pointer ptr,
+                                                                               const ssize_t size )
+{
+  struct hash ctx;
+  ak_uint8 seed[64];
+  int error = ak_error_ok;
+
+  if( rnd == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                      "use a null pointer to a random generator" );
+  if( ptr == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                          "use a null pointer to initial vector" );
+  if( size <= 0 ) return ak_error_message( ak_error_wrong_length, __func__ ,
+                                                          "use initial vector with wrong length" );
+  if(( error = ak_hash_create_streebog512( &ctx )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect creation of hash function context" );
+  error = ak_hash_ptr( &ctx, ptr, ( size_t )size, seed, sizeof( seed ));
+  ak_hash_destroy( &ctx );
+  if( error == ak_error_ok ) error = ak_random_ctr_drbg_set_seed( rnd->data.ctx, seed );
+  memset( seed, 0, sizeof( seed ));
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Выработка последовательности псевдо-случайных байт.
+
+    Запросы обслуживаются из заранее выработанного фрагмента; выданные данные удаляются из буффера.
+    После выработки \ref ak_ctr_drbg_reseed_interval октетов, а также в дочернем процессе
+    после вызова `fork()`, состояние генератора обновляется данными, полученными из системного
+    источника энтропии.                                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_random_ctr_drbg_random( ak_random rnd, const ak_pointer ptr, const ssize_t size )
+{
+  ak_ctr_drbg ctx = NULL;
+  ak_uint8 *value = ptr, seed[ ak_ctr_drbg_seed_size ];
+  size_t len = 0, count = ( size_t )size;
+  int error = ak_error_ok;
+  ak_uint64 generation = 0;
+
+  if( rnd == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                      "use a null pointer to a random generator" );
+  if( ptr == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                                    "use a null pointer to data" );
+  if( size <= 0 ) return ak_error_message( ak_error_wrong_length, __func__ ,
+                                                           "use a data vector with wrong length" );
+  ctx = rnd->data.ctx;
+ /* после fork() состояние, унаследованное от родительского процесса, не используется */
+  if( ctx->generation != ( generation = ak_random_fork_generation( ))) {
+    if(( error = ak_random_ctr_drbg_fork_reseed( ctx, generation )) != ak_error_ok )
+      return ak_error_message( error, __func__, "incorrect update of generator's state" );
+  }
+  while( count > 0 ) {
+    if( ctx->offset == ctx->size ) {
+      if( ctx->generated >= ak_ctr_drbg_reseed_interval ) {
+        if(( error = ak_random_system_entropy( seed, sizeof( seed ))) == ak_error_ok ) {
+          ctx->generated = 0;
+          error = ak_random_ctr_drbg_refill( ctx, seed );
+        }
+        memset( seed, 0, sizeof( seed ));
+      } else error = ak_random_ctr_drbg_refill( ctx, NULL );
+      if( error != ak_error_ok ) return ak_error_message( error, __func__,
+                                                      "incorrect update of generator's state" );
+    }
+    len = ak_min( count, ctx->size - ctx->offset );
+    memcpy( value, ctx->buffer + ctx->offset, len );
+    memset( ctx->buffer + ctx->offset, 0, len );
+    ctx->offset += len;
+    value += len;
+    count -= len;
+  }
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_random_ctr_drbg_free( ak_random rnd )
+{
+  ak_ctr_drbg ctx = NULL;
+
+  if( rnd == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                     "use a null pointer to a random generator" );
+  if(( ctx = rnd->data.ctx ) == NULL ) return ak_error_ok;
+  ak_bckey_destroy( &ctx->key );
+  if( ctx->buffer != NULL ) {
+    memset( ctx->buffer, 0, ctx->size + ak_ctr_drbg_seed_size );
+    free( ctx->buffer );
+  }
+  memset( ctx, 0, sizeof( struct ctr_drbg ));
+  free( ctx );
+  rnd->data.ctx = NULL;
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Генератор вырабатывает гамму блочного шифра Кузнечик в режиме гаммирования фрагментами,
+    длина которых определяется опцией `ctr_drbg_buffer_size` (от 4 до 64 Кб), и выдает данные
+    из выработанного фрагмента; таким образом, выработка масок и очистка памяти
+    с помощью функции ak_ptr_wipe() сводятся, в основном, к копированию памяти.
+
+    После выработки каждого мегабайта данных (или меньшего объема, если так ограничен ресурс
+    ключа Кузнечика) ключ и синхропосылка заменяются новыми значениями, выработанными тем же
+    генератором. Выходная последовательность зависит от длины фрагмента, поэтому при
+    использовании ak_random_randomize() для получения воспроизводимых данных значение опции
+    `ctr_drbg_buffer_size` также должно совпадать. Начальное состояние, а также его периодическое обновление,
+    формируются из системного источника энтропии (функция `getrandom()`, при ее отсутствии -
+    `/dev/urandom`). В дочернем процессе, созданном вызовом `fork()`, состояние генератора
+    обновляется из того же источника при первом обращении.
+
+    @param generator Контекст создаваемого генератора.
+    \return В случае успеха, функция возвращает \ref ak_error_ok. В противном случае
+            возвращается код ошибки.                                                               */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_random_create_ctr_drbg_kuznechik( ak_random generator )
+{
+  ak_ctr_drbg ctx = NULL;
+  int error = ak_error_ok;
+  ak_uint8 seed[ ak_ctr_drbg_seed_size ];
+
+  if(( error = ak_random_create( generator )) != ak_error_ok )
+    return ak_error_message( error, __func__ , "wrong initialization of random generator" );
+
+  if(( ctx = malloc( sizeof( struct ctr_drbg ))) == NULL )
+    return ak_error_message( ak_error_out_of_memory, __func__ ,
+                                                  "incorrect memory allocation for generator" );
+  memset( ctx, 0, sizeof( struct ctr_drbg ));
+  ctx->size = ( size_t )ak_libakrypt_get_option_by_index( ctr_drbg_buffer_size_option )&( ~0xFU );
+  if(( ctx->buffer = malloc( ctx->size + ak_ctr_drbg_seed_size )) == NULL ) {
+    free( ctx );
+    return ak_error_message( ak_error_out_of_memory, __func__ ,
+                                           "incorrect memory allocation for generator's buffer" );
+  }
+  if(( error = ak_bckey_create_kuznechik( &ctx->key )) != ak_error_ok ) {
+    free( ctx->buffer );
+    free( ctx );
+    return ak_error_message( error, __func__ , "incorrect creation of block cipher key" );
+  }
+
+  generator->oid = ak_oid_find_by_name( "ctr-drbg-kuznechik" );
+  generator->next = NULL; /* внутреннее состояние изменяется при выработке фрагмента данных */
+  generator->randomize_ptr = ak_random_ctr_drbg_randomize_ptr;
+  generator->random = ak_random_ctr_drbg_random;
+  generator->free = ak_random_ctr_drbg_free;
+  generator->data.ctx = ctx;
+
+ /* начальное состояние вырабатывается системным источником энтропии */
+  if(( error = ak_random_system_entropy( seed, sizeof( seed ))) == ak_error_ok )
+    error = ak_random_ctr_drbg_set_seed( ctx, seed );
+  memset( seed, 0, sizeof( seed ));
+  if( error != ak_error_ok ) {
+    ak_random_destroy( generator );
+    return ak_error_message( error, __func__ , "incorrect initialization of generator's state" );
+  }
+
+ return error;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*                                                                                    ak_random.c  */
 /* ----------------------------------------------------------------------------------------------- */
@@ -9,6 +9,9 @@
 #ifdef AK_HAVE_TIME_H
  #include <time.h>
 #endif
+#ifdef AK_HAVE_PTHREAD_H
+ #include <pthread.h>
+#endif
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Установление или изменение маски секретного ключа ассиметричного криптографического
@@ -37,7 +40,7 @@
 #ifndef AK_LITTLE_ENDIAN
   int i = 0;
 #endif
-  ak_mpznmax u, zeta;
+  ak_mpznmax zeta;
   ak_wcurve wc = NULL;
   int error = ak_error_ok;
   ak_uint64 *key = NULL, *mask = NULL;
@@ -80,10 +83,8 @@
      ak_mpzn_mul_montgomery( key, key, mask, wc->q, wc->nq, wc->size);
 
     /* вычисляем обратное значение для маски */
-     ak_mpzn_set_ui( u, wc->size, 2 );
-     ak_mpzn_sub( u, wc->q, u, wc->size );
-     ak_mpzn_modpow_montgomery( mask, // m <- m^{q-2} (mod q)
-                                    mask, u, wc->q, wc->nq, wc->size );
+     ak_mpzn_inverse_montgomery( mask, // m <- m^{-1} (mod q)
+                                      mask, wc->r2q, wc->q, wc->nq, wc->size, ak_true );
     /* меняем значение флага */
      skey->flags |= key_flag_set_mask;
 
@@ -100,9 +101,8 @@
     /* домножаем ключ на случайное число */
      ak_mpzn_mul_montgomery( key, key, zeta, wc->q, wc->nq, wc->size );
     /* вычисляем обратное значение zeta */
-     ak_mpzn_set_ui( u, wc->size, 2 );
-     ak_mpzn_sub( u, wc->q, u, wc->size );
-     ak_mpzn_modpow_montgomery( zeta, zeta, u, wc->q, wc->nq, wc->size ); // z <- z^{q-2} (mod q)
+     ak_mpzn_inverse_montgomery( zeta, zeta, wc->r2q,  // z <- z^{-1} (mod q)
+                                                        wc->q, wc->nq, wc->size, ak_true );
 
     /* домножаем маску на обратное значение zeta */
      ak_mpzn_mul_montgomery( mask, mask, zeta, wc->q, wc->nq, wc->size );
@@ -594,7 +594,7 @@
 
  /* поскольку функция не экспортируется, мы оставляем все проверки функциям верхнего уровня */
  /* вычисляем r */
-  ak_wpoint_pow( &wr, &wc->point, k, wc->size, wc );
+  ak_wpoint_pow_base( &wr, k, wc->size, wc );
   ak_wpoint_reduce( &wr, wc );
   ak_mpzn_rem( r, wr.x, wc->q, wc->size );
 
@@ -627,7 +627,7 @@
                                                              sizeof(ak_uint64)*wc->size, ak_true );
  /* завершаемся */
   memset( &wr, 0, sizeof( struct wpoint ));
-  sctx->key.set_mask( &sctx->key );
+  ak_skey_remask( &sctx->key, sizeof( ak_uint64 )*wc->size );
   memset( r, 0, sizeof( ak_mpzn512 ));
   memset( s, 0, sizeof( ak_mpzn512 ));
 }
@@ -872,7 +872,7 @@
  /* теперь определяем открытый ключ */
   ak_mpzn_mul_montgomery( k, ( ak_uint64 *)sctx->key.key, one,
                                                       pctx->wc->q, pctx->wc->nq, pctx->wc->size );
-  ak_wpoint_pow( &pctx->qpoint, &pctx->wc->point, k, pctx->wc->size, pctx->wc );
+  ak_wpoint_pow_base( &pctx->qpoint, k, pctx->wc->size, pctx->wc );
 
   ak_mpzn_mul_montgomery( k, ( ak_uint64 *)( sctx->key.key + sctx->key.key_size ),
                                                   one, pctx->wc->q, pctx->wc->nq, pctx->wc->size);
@@ -888,7 +888,7 @@
 
  /* перемаскируем секретный ключ */
   ak_ptr_wipe( k, sizeof( ak_uint64 )*ak_mpzn512_size, &sctx->key.generator );
-  sctx->key.set_mask( &sctx->key );
+  ak_skey_remask( &sctx->key, sizeof( ak_uint64 )*pctx->wc->size );
 
  return ak_error_ok;
 }
@@ -912,28 +912,53 @@
 }
 
 /* ----------------------------------------------------------------------------------------------- */
-/*! @param pctx контекст открытого ключа.
-    @param hash хеш-код сообщения (последовательность байт), для которого проверяется электронная подпись.
-    @param hsize размер хеш-кода, в байтах.
-    @param sign электронная подпись, для которой выполняется проверка.
-    @return Функция возыращает истину, если подпись верна. Если функция не верна или если
-    возникла ошибка, то возвращается ложь. Код Ошибки может получен с помощью
-    вызова функции ak_error_get_value().                                                           */
+/*! Функция вычисляет таблицу нечетных кратных точки, являющейся открытым ключом, и сохраняет ее
+    в контексте открытого ключа. Таблица используется всеми последующими вызовами функций проверки
+    подписи, что имеет смысл для ключей, проверяющих большое количество подписей
+    (например, для ключей центров сертификации). Если значение открытого ключа изменяется,
+    то сохраненная таблица не используется.
+
+    @param pctx контекст открытого ключа алгоритма электронной подписи.
+    @return В случае успеха возвращается ноль (\ref ak_error_ok). В противном случае возвращается
+    код ошибки.                                                                                    */
 /* ----------------------------------------------------------------------------------------------- */
- bool_t ak_verifykey_verify_hash( ak_verifykey pctx,
-                                        const ak_pointer hash, const size_t hsize, ak_pointer sign )
+ int ak_verifykey_precompute_table( ak_verifykey pctx )
+{
+  if( pctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                      "using null pointer to public key context" );
+  if( pctx->wc == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                  "using null pointer to elliptic curve context" );
+  ak_wpoint_set_odd_multiples( pctx->qtable, &pctx->qpoint, pctx->wc );
+  pctx->flags |= key_flag_set_qtable;
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка аргументов и импорт значений, необходимых для проверки подписи.
+
+    Функция извлекает из подписи значения \f$ r \f$ и \f$ s \f$, а также вычисляет значение
+    \f$ e \equiv h \pmod{q} \f$ в представлении Монтгомери (нулевое значение заменяется единицей).
+
+    @return Функция возвращает истину, если аргументы корректны.                                  */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_verifykey_verify_import( ak_verifykey pctx, const ak_pointer hash,
+                       const size_t hsize, ak_pointer sign, ak_uint64 *r, ak_uint64 *s, ak_uint64 *e )
 {
 #ifndef AK_LITTLE_ENDIAN
   int i = 0;
 #endif
-  ak_mpzn512 v, z1, z2, u, r, s, h;
-  struct wpoint cpoint, tpoint;
 
   if( pctx == NULL ) {
     ak_error_message( ak_error_null_pointer, __func__,
                                                "using a null pointer to secret key context" );
     return ak_false;
   }
+  if( pctx->wc == NULL ) {
+    ak_error_message( ak_error_null_pointer, __func__,
+                                                "using a null pointer to elliptic curve context" );
+    return ak_false;
+  }
   if( hash == NULL ) {
     ak_error_message( ak_error_null_pointer, __func__, "using a null pointer to hash value" );
     return ak_false;
@@ -952,20 +977,30 @@
   ak_mpzn_set_little_endian( r, pctx->wc->size, ( ak_uint64* )sign + pctx->wc->size,
                                                       sizeof(ak_uint64)*pctx->wc->size, ak_true );
 
-  memcpy( h, hash, sizeof( ak_uint64 )*pctx->wc->size );
+  memcpy( e, hash, sizeof( ak_uint64 )*pctx->wc->size );
 #ifndef AK_LITTLE_ENDIAN
-  for( i = 0; i < pctx->wc->size; i++ ) h[i] = bswap_64( h[i] );
+  for( i = 0; i < pctx->wc->size; i++ ) e[i] = bswap_64( e[i] );
 #endif
 
-  ak_mpzn_set( v, h, pctx->wc->size );
-  ak_mpzn_rem( v, v, pctx->wc->q, pctx->wc->size );
-  if( ak_mpzn_cmp_ui( v, pctx->wc->size, 0 )) ak_mpzn_set_ui( v, pctx->wc->size, 1 );
-  ak_mpzn_mul_montgomery( v, v, pctx->wc->r2q, pctx->wc->q, pctx->wc->nq, pctx->wc->size );
+  ak_mpzn_rem( e, e, pctx->wc->q, pctx->wc->size );
+  if( ak_mpzn_cmp_ui( e, pctx->wc->size, 0 )) ak_mpzn_set_ui( e, pctx->wc->size, 1 );
+  ak_mpzn_mul_montgomery( e, e, pctx->wc->r2q, pctx->wc->q, pctx->wc->nq, pctx->wc->size );
 
-  /* вычисляем v (в представлении Монтгомери) */
-  ak_mpzn_set_ui( u, pctx->wc->size, 2 );
-  ak_mpzn_sub( u, pctx->wc->q, u, pctx->wc->size );
-  ak_mpzn_modpow_montgomery( v, v, u, pctx->wc->q, pctx->wc->nq, pctx->wc->size ); // v <- v^{q-2} (mod q)
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление точки \f$ C = [z_1]P + [z_2]Q \f$, где \f$ z_1 \equiv sv \pmod{q} \f$,
+    \f$ z_2 \equiv -rv \pmod{q} \f$, а \f$ v \equiv e^{-1} \pmod{q} \f$ (в представлении Монтгомери).
+
+    Результирующая точка не приводится к аффинной форме.                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_verifykey_verify_point( ak_verifykey pctx, ak_uint64 *r, ak_uint64 *s,
+                                                                    ak_uint64 *v, ak_wpoint cpoint )
+{
+  ak_mpzn512 z1, z2;
+  struct wpoint ptable[ak_wpoint_wnaf_points], qtable[ak_wpoint_wnaf_points];
+  ak_wpoint qt = NULL;
 
   /* вычисляем z1 */
   ak_mpzn_mul_montgomery( z1, s, pctx->wc->r2q, pctx->wc->q, pctx->wc->nq, pctx->wc->size );
@@ -978,10 +1013,41 @@
   ak_mpzn_mul_montgomery( z2, z2, v, pctx->wc->q, pctx->wc->nq, pctx->wc->size );
   ak_mpzn_mul_montgomery( z2, z2, pctx->wc->point.z, pctx->wc->q, pctx->wc->nq, pctx->wc->size );
 
+ /* сложение точек */
+ /* используем сохраненную таблицу, если она вычислена для текущего значения ключа */
+  qt = pctx->qtable;
+  if( !( pctx->flags&key_flag_set_qtable ) ||
+      ak_mpzn_cmp( qt->x, pctx->qpoint.x, pctx->wc->size ) ||
+      ak_mpzn_cmp( qt->y, pctx->qpoint.y, pctx->wc->size ) ||
+      ak_mpzn_cmp( qt->z, pctx->qpoint.z, pctx->wc->size ))
+    ak_wpoint_set_odd_multiples( qt = qtable, &pctx->qpoint, pctx->wc );
+  ak_wpoint_set_odd_multiples( ptable, &pctx->wc->point, pctx->wc );
+  ak_wpoint_pow2_tables( cpoint, ptable, z1, qt, z2, pctx->wc->size, pctx->wc );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! @param pctx контекст открытого ключа.
+    @param hash хеш-код сообщения (последовательность байт), для которого проверяется электронная подпись.
+    @param hsize размер хеш-кода, в байтах.
+    @param sign электронная подпись, для которой выполняется проверка.
+    @return Функция возыращает истину, если подпись верна. Если функция не верна или если
+    возникла ошибка, то возвращается ложь. Код Ошибки может получен с помощью
+    вызова функции ak_error_get_value().                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ bool_t ak_verifykey_verify_hash( ak_verifykey pctx,
+                                        const ak_pointer hash, const size_t hsize, ak_pointer sign )
+{
+  ak_mpzn512 v, r, s;
+  struct wpoint cpoint;
+
+  if( !ak_verifykey_verify_import( pctx, hash, hsize, sign, r, s, v )) return ak_false;
+
+  /* вычисляем v (в представлении Монтгомери) */
+  ak_mpzn_inverse_montgomery( v, v, pctx->wc->r2q, // v <- v^{-1} (mod q)
+                                       pctx->wc->q, pctx->wc->nq, pctx->wc->size, ak_false );
+
  /* сложение точек и проверка */
-  ak_wpoint_pow( &cpoint, &pctx->wc->point, z1, pctx->wc->size, pctx->wc );
-  ak_wpoint_pow( &tpoint, &pctx->qpoint, z2, pctx->wc->size, pctx->wc );
-  ak_wpoint_add( &cpoint, &tpoint, pctx->wc );
+  ak_verifykey_verify_point( pctx, r, s, v, &cpoint );
   ak_wpoint_reduce( &cpoint, pctx->wc );
   ak_mpzn_rem( cpoint.x, cpoint.x, pctx->wc->q, pctx->wc->size );
 
@@ -992,6 +1058,217 @@
  return ak_true;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Данные, используемые при пакетной проверке одной электронной подписи. */
+ typedef struct verify_item {
+  /*! \brief Открытый ключ, используемый для проверки подписи. */
+   ak_verifykey pctx;
+  /*! \brief Первая половина подписи. */
+   ak_mpzn512 r;
+  /*! \brief Вторая половина подписи. */
+   ak_mpzn512 s;
+  /*! \brief Значение \f$ e^{-1} \pmod{q} \f$ (в представлении Монтгомери). */
+   ak_mpzn512 v;
+  /*! \brief Точка \f$ C \f$ в проективной форме. */
+   struct wpoint cpoint;
+  /*! \brief Этап проверки, на котором находится подпись. */
+   int stage;
+} *ak_verify_item;
+
+/*! \brief Проверка подписи завершена (или аргументы некорректны). */
+ #define ak_verify_stage_done      (0)
+/*! \brief Подпись импортирована, требуется обращение значения e. */
+ #define ak_verify_stage_imported  (1)
+/*! \brief Значение e обращено, требуется вычисление и приведение точки C. */
+ #define ak_verify_stage_inverted  (2)
+
+#ifdef AK_HAVE_PTHREAD_H
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Фрагмент массива подписей, для которых отдельный поток вычисляет точки \f$ C \f$. */
+ typedef struct verify_task {
+  /*! \brief Указатель на первый элемент фрагмента. */
+   ak_verify_item items;
+  /*! \brief Количество элементов во фрагменте. */
+   size_t count;
+  /*! \brief Поток, обрабатывающий фрагмент. */
+   pthread_t thread;
+  /*! \brief Флаг того, что поток был успешно запущен. */
+   bool_t started;
+} *ak_verify_task;
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+ static void *ak_verifykey_verify_points( ak_verify_item items, size_t count )
+{
+  size_t i;
+  for( i = 0; i < count; i++ )
+     if( items[i].stage == ak_verify_stage_inverted )
+       ak_verifykey_verify_point( items[i].pctx,
+                                             items[i].r, items[i].s, items[i].v, &items[i].cpoint );
+ return NULL;
+}
+
+#ifdef AK_HAVE_PTHREAD_H
+/* ----------------------------------------------------------------------------------------------- */
+ static void *ak_verifykey_verify_task( void *ptr )
+{
+  ak_verify_task task = ( ak_verify_task )ptr;
+ return ak_verifykey_verify_points( task->items, task->count );
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление точек \f$ C \f$ для массива подписей с помощью нескольких потоков.
+    Первый фрагмент обрабатывается вызывающим потоком.                                             */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_verifykey_verify_points_threads( ak_verify_item items, size_t count,
+                                                                             size_t threads )
+{
+#ifdef AK_HAVE_PTHREAD_H
+  size_t i, per;
+  ak_verify_task tasks = NULL;
+
+  if( threads > count ) threads = count;
+  if(( threads < 2 ) || (( tasks = calloc( threads, sizeof( struct verify_task ))) == NULL )) {
+    ak_verifykey_verify_points( items, count );
+    return;
+  }
+  per = ( count + threads - 1 )/threads;
+  for( i = 1; i < threads && i*per < count; i++ ) {
+     tasks[i].items = items + i*per;
+     tasks[i].count = ak_min( per, count - i*per );
+     if( pthread_create( &tasks[i].thread, NULL, ak_verifykey_verify_task, tasks+i ) == 0 )
+       tasks[i].started = ak_true;
+      else ak_verifykey_verify_task( tasks+i ); /* не удалось создать поток - обрабатываем сами */
+  }
+  ak_verifykey_verify_points( items, ak_min( per, count ));
+
+  while( i-- > 1 ) if( tasks[i].started ) pthread_join( tasks[i].thread, NULL );
+  free( tasks );
+#else
+  (void)threads;
+  ak_verifykey_verify_points( items, count );
+#endif
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция проверяет count электронных подписей, каждая из которых задается открытым ключом,
+    хеш-кодом сообщения и значением подписи. Результат проверки i-й подписи помещается
+    в i-й элемент массива results.
+
+    В отличие от последовательных вызовов функции ak_verifykey_verify_hash(), обращения вычетов
+    по модулю \f$ q \f$, а также обращения \f$ z \f$-координат, необходимые для приведения точек
+    к аффинной форме, выполняются для всех подписей, использующих одну эллиптическую кривую,
+    одновременно (методом Монтгомери, за одно обращение и несколько умножений).
+    Вычисление кратных точек, являющееся наиболее трудоемкой частью проверки, может выполняться
+    несколькими потоками.
+
+    Функция предназначена для проверки больших наборов подписей, например, подписей под
+    сертификатами, образующими цепочку или содержащимися в p7b контейнере.
+    Все открытые ключи должны оставаться неизменными во время работы функции.
+
+    @param pctx массив контекстов открытых ключей (ключи могут повторяться).
+    @param hash массив указателей на хеш-коды сообщений.
+    @param hsize массив размеров хеш-кодов, в байтах.
+    @param sign массив указателей на проверяемые подписи.
+    @param count количество проверяемых подписей.
+    @param results массив, в который помещаются результаты проверки подписей.
+    @param threads максимальное количество потоков, используемых для вычислений
+    (с учетом вызывающего потока). При сборке библиотеки без поддержки pthreads значение
+    игнорируется.
+
+    @return Функция возвращает \ref ak_error_ok, если все подписи верны, и
+    \ref ak_error_not_equal_data, если хотя бы одна из подписей не верна или не может быть
+    проверена. При некорректных значениях массивов возвращается код ошибки.                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_verifykey_verify_batch( ak_verifykey *pctx, ak_pointer *hash, const size_t *hsize,
+                      ak_pointer *sign, const size_t count, bool_t *results, const size_t threads )
+{
+  ak_wcurve wc = NULL;
+  ak_verify_item items = NULL;
+  ak_uint64 *x = NULL, *z = NULL;
+  size_t i, j, k, *group = NULL;
+  ak_mpznmax one = ak_mpznmax_one;
+  int error = ak_error_ok;
+
+  if(( pctx == NULL ) || ( hash == NULL ) || ( hsize == NULL ) || ( sign == NULL ) ||
+                                                                             ( results == NULL ))
+    return ak_error_message( ak_error_null_pointer, __func__, "using a null pointer to array" );
+  if( count == 0 ) return ak_error_ok;
+
+  if((( items = calloc( count, sizeof( struct verify_item ))) == NULL ) ||
+     (( group = malloc( count*sizeof( size_t ))) == NULL ) ||
+     (( x = malloc( count*ak_mpzn512_size*sizeof( ak_uint64 ))) == NULL ) ||
+     (( z = malloc( count*ak_mpzn512_size*sizeof( ak_uint64 ))) == NULL )) {
+    error = ak_error_message( ak_error_out_of_memory, __func__,
+                                                        "incorrect memory allocation for batch" );
+    goto labex;
+  }
+
+ /* 1. импортируем подписи */
+  for( i = 0; i < count; i++ ) {
+     results[i] = ak_false;
+     items[i].pctx = pctx[i];
+     if( ak_verifykey_verify_import( pctx[i], hash[i], hsize[i], sign[i],
+                                                           items[i].r, items[i].s, items[i].v ))
+       items[i].stage = ak_verify_stage_imported;
+  }
+
+ /* 2. для каждой кривой одновременно обращаем значения e по модулю q */
+  for( i = 0; i < count; i++ ) {
+     if( items[i].stage != ak_verify_stage_imported ) continue;
+     for( j = i, k = 0, wc = items[i].pctx->wc; j < count; j++ ) {
+        if(( items[j].stage == ak_verify_stage_imported ) && ( items[j].pctx->wc == wc )) {
+          group[k] = j;
+          ak_mpzn_set( x+k*wc->size, items[j].v, wc->size );
+          k++;
+        }
+     }
+     ak_mpzn_inverse_montgomery_batch( z, x, k, wc->r2q, wc->q, wc->nq, wc->size );
+     for( j = 0; j < k; j++ ) {
+        ak_mpzn_set( items[group[j]].v, z+j*wc->size, wc->size );
+        items[group[j]].stage = ak_verify_stage_inverted;
+     }
+  }
+
+ /* 3. вычисляем точки C */
+  ak_verifykey_verify_points_threads( items, count, threads );
+
+ /* 4. для каждой кривой одновременно обращаем z-координаты точек и сравниваем результат */
+  for( i = 0; i < count; i++ ) {
+     if( items[i].stage != ak_verify_stage_inverted ) continue;
+     for( j = i, k = 0, wc = items[i].pctx->wc; j < count; j++ ) {
+        if(( items[j].stage == ak_verify_stage_inverted ) && ( items[j].pctx->wc == wc )) {
+          group[k] = j;
+          ak_mpzn_set( x+k*wc->size, items[j].cpoint.z, wc->size );
+          k++;
+        }
+     }
+     ak_mpzn_inverse_montgomery_batch( z, x, k, wc->r2, wc->p, wc->n, wc->size );
+     for( j = 0; j < k; j++ ) {
+        ak_verify_item it = items + group[j];
+        it->stage = ak_verify_stage_done;
+       /* бесконечно удаленная точка не может дать верную подпись */
+        if( ak_mpzn_cmp_ui( x+j*wc->size, wc->size, 0 )) continue;
+        ak_mpzn_mul_montgomery( z+j*wc->size, z+j*wc->size, one, wc->p, wc->n, wc->size );
+        ak_mpzn_mul_montgomery( it->cpoint.x, it->cpoint.x, z+j*wc->size, wc->p, wc->n, wc->size );
+        ak_mpzn_rem( it->cpoint.x, it->cpoint.x, wc->q, wc->size );
+        results[group[j]] = !ak_mpzn_cmp( it->cpoint.x, it->r, wc->size );
+     }
+  }
+
+  for( i = 0; i < count; i++ )
+     if( results[i] != ak_true ) { error = ak_error_not_equal_data; break; }
+
+  labex:
+   if( items != NULL ) free( items );
+   if( group != NULL ) free( group );
+   if( x != NULL ) free( x );
+   if( z != NULL ) free( z );
+
+ return error;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! @param pctx контекст открытого ключа.
     @param in область памяти для которой проверяется электронная подпись.
@@ -309,6 +309,10 @@
   skey->oid = NULL;
   /* После создания ключа все его флаги не определены */
   skey->flags = key_flag_undefined;
+  /* по умолчанию маска ключа меняется после каждого обращения к ключу */
+  skey->remask.type = mask_always_policy;
+  skey->remask.interval = 1;
+  skey->remask.counter = 0;
  /* В заключение определяем указатели на методы.
     по умолчанию используются механизмы для работы с аддитивной по модулю 2 маской.
 
@@ -366,6 +370,106 @@
  return ak_error_ok;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция определяет, как часто должна меняться маска ключа после его использования.
+    По умолчанию, при создании ключа, маска меняется после каждого обращения к ключу.
+
+    Для политик \ref mask_every_n_calls_policy и \ref mask_every_n_bytes_policy
+    параметр `interval` задает количество обращений к ключу или количество обработанных
+    октетов, по истечении которого маска ключа меняется; для остальных политик значение
+    параметра игнорируется. Вне зависимости от политики, маска всегда накладывается на ключ
+    при присвоении ему значения.
+
+    @param skey Контекст секретного ключа.
+    @param type Политика смены маски.
+    @param interval Интервал смены маски.
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае,
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_skey_set_mask_policy( ak_skey skey, mask_policy_t type, ak_uint64 interval )
+{
+  if( skey == NULL ) return ak_error_message( ak_error_null_pointer,
+                                         __func__ , "using a null pointer to secret key context" );
+  switch( type ) {
+    case mask_always_policy:
+    case mask_never_after_schedule_policy:
+      interval = 1;
+      break;
+    case mask_every_n_calls_policy:
+    case mask_every_n_bytes_policy:
+      if( !interval ) return ak_error_message( ak_error_zero_length, __func__ ,
+                                                          "using zero interval for mask changing" );
+      break;
+    default: return ak_error_message( ak_error_undefined_value, __func__ ,
+                                                          "using undefined policy of key masking" );
+  }
+  skey->remask.type = type;
+  skey->remask.interval = interval;
+  skey->remask.counter = 0;
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вызывается после каждого использования ключа и, в соответствии с установленной
+    для ключа политикой, меняет (или оставляет прежней) маску ключа. Если маска с ключа была
+    снята, она накладывается на ключ вне зависимости от политики.
+
+    @param skey Контекст секретного ключа.
+    @param size Количество октетов, обработанных с использованием ключа.
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае,
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_skey_remask( ak_skey skey, size_t size )
+{
+  if( skey == NULL ) return ak_error_message( ak_error_null_pointer,
+                                         __func__ , "using a null pointer to secret key context" );
+ /* ключ не замаскирован */
+  if((( skey->flags)&key_flag_set_mask ) == 0 ) return skey->set_mask( skey );
+
+  switch( skey->remask.type ) {
+    case mask_never_after_schedule_policy:
+      return ak_error_ok;
+
+    case mask_every_n_calls_policy:
+      if( ++skey->remask.counter < skey->remask.interval ) return ak_error_ok;
+      break;
+
+    case mask_every_n_bytes_policy:
+      if(( skey->remask.counter += size ) < skey->remask.interval ) return ak_error_ok;
+      break;
+
+    default: break;
+  }
+  skey->remask.counter = 0;
+
+ return skey->set_mask( skey );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Сложение по модулю 2 двух областей памяти, выполняемое 64-х битными словами.
+
+    Основная часть данных обрабатывается словами (копирование через memcpy() не требует
+    выравнивания областей памяти), оставшийся хвост длины менее восьми октетов - побайтно.
+
+    @param out Область памяти, в которую помещается результат.
+    @param in Складываемая область памяти.
+    @param size Размер областей памяти (в октетах).                                                */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_skey_xor_words( ak_uint8 *out, const ak_uint8 *in, const size_t size )
+{
+  size_t idx = 0;
+  ak_uint64 x, y;
+
+  for( ; idx + sizeof( ak_uint64 ) <= size; idx += sizeof( ak_uint64 )) {
+     memcpy( &x, out+idx, sizeof( ak_uint64 ));
+     memcpy( &y, in+idx, sizeof( ak_uint64 ));
+     x ^= y;
+     memcpy( out+idx, &x, sizeof( ak_uint64 ));
+  }
+  for( ; idx < size; idx++ ) out[idx] ^= in[idx];
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! Функция вырабатывает случайный вектор \f$ v \f$ длины, совпадающей с длиной ключа,
     и заменяет значение ключа \f$ k \f$ на величину \f$ k \oplus v \f$.
@@ -377,7 +481,6 @@
 /* ----------------------------------------------------------------------------------------------- */
  int ak_skey_set_mask_xor( ak_skey skey )
 {
-  size_t idx = 0, jdx = 0;
   int error = ak_error_ok;
 
  /* "стандартные" проверки указателей и выделения памяти */
@@ -395,13 +498,12 @@
        return ak_error_message( error, __func__ ,
                                                  "wrong generation a random mask for key buffer" );
     /* накладываем маску на ключ */
-     jdx = skey->key_size;
-     for( idx = 0; idx < skey->key_size; idx++, jdx++ ) skey->key[idx] ^= skey->key[jdx];
+     ak_skey_xor_words( skey->key, skey->key+skey->key_size, skey->key_size );
     /* меняем значение флага */
      skey->flags |= key_flag_set_mask;
 
   } else { /* если маска уже установлена, то мы сменяем ее на новую */
-          ak_uint8 newmask[64];
+          ak_uint64 newmask[8];
           size_t jdx = 0, offset = 0,
               blocks = skey->key_size >> 6, /* работаем с блоком длины 64 байта */
                 tail = skey->key_size - ( blocks << 6 );
@@ -412,10 +514,9 @@
                                                      newmask, sizeof( newmask ))) != ak_error_ok )
                return ak_error_message( error, __func__ ,
                                                  "wrong generation a random mask for key buffer" );
-             for( idx = 0; idx < 64; idx++ ) {
-                  skey->key[offset+idx] ^= newmask[idx];
-                  skey->key[offset+idx+skey->key_size] ^= newmask[idx];
-             }
+             ak_skey_xor_words( skey->key+offset, (ak_uint8 *)newmask, sizeof( newmask ));
+             ak_skey_xor_words( skey->key+offset+skey->key_size,
+                                                          (ak_uint8 *)newmask, sizeof( newmask ));
           }
          /* потом обрабатываем хвост */
           if( tail ) {
@@ -423,10 +524,8 @@
                                                        newmask, (ssize_t)tail )) != ak_error_ok )
               return ak_error_message( error, __func__ ,
                                                   "wrong random mask generation for key buffer" );
-            for( idx = 0; idx < tail; idx++ ) {
-               skey->key[offset+idx] ^= newmask[idx];
-               skey->key[offset+idx+skey->key_size] ^= newmask[idx];
-            }
+            ak_skey_xor_words( skey->key+offset, (ak_uint8 *)newmask, tail );
+            ak_skey_xor_words( skey->key+offset+skey->key_size, (ak_uint8 *)newmask, tail );
           }
   }
 
@@ -441,8 +540,6 @@
 /* ----------------------------------------------------------------------------------------------- */
  int ak_skey_unmask_xor( ak_skey skey )
 {
-  size_t idx = 0, jdx = 0;
-
  /* "стандартные" проверки указателей и выделения памяти */
   if( skey == NULL ) return ak_error_message( ak_error_null_pointer,
                                          __func__ , "using a null pointer to secret key context" );
@@ -453,12 +550,9 @@
  /* проверяем, установлена ли маска ранее */
   if( (( skey->flags)&key_flag_set_mask ) == 0 ) return ak_error_ok;
 
- /* снимаем маску с ключа (побайтно) */
-  jdx = skey->key_size;
-  for( idx = 0; idx < skey->key_size; idx++, jdx++ ) {
-     skey->key[idx] ^= skey->key[jdx];
-     skey->key[jdx] = 0;
-  }
+ /* снимаем маску с ключа */
+  ak_skey_xor_words( skey->key, skey->key+skey->key_size, skey->key_size );
+  memset( skey->key+skey->key_size, 0, skey->key_size );
 
  /* меняем значение флага */
   skey->flags ^= key_flag_set_mask;
@@ -786,7 +880,7 @@
                                                              "using a password with zero length" );
  /* присваиваем буффер и маскируем его */
   if(( error = ak_hmac_pbkdf2_streebog512( pass, pass_size, salt, salt_size,
-                   (const size_t) ak_libakrypt_get_option_by_name( "pbkdf2_iteration_count" ),
+                   (const size_t) ak_libakrypt_get_option_by_index( pbkdf2_iteration_count_option ),
                                                      skey->key_size, skey->key )) != ak_error_ok )
     return ak_error_message( error, __func__ , "wrong generation a secret key data" );
   memset( skey->key+skey->key_size, 0, skey->key_size ); /* обнуляем массив масок */
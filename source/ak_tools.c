@@ -20,8 +20,8 @@
 #endif
 
 /* ----------------------------------------------------------------------------------------------- */
-/*!  Переменная, содержащая в себе код последней ошибки                                            */
- static int ak_errno = ak_error_ok;
+/*!  Переменная, содержащая в себе код последней ошибки (для каждого потока своя)                 */
+ static ak_thread_local int ak_errno = ak_error_ok;
  static int ak_log_level = ak_log_standard;
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -70,6 +70,10 @@
     На этом уровне выводятся все сообщения, доступные на первых двух уровнях, а также
     сообщения отладочного характера, позволяющие проследить логику работы функций библиотеки.
 
+    Кроме того, уровень \ref ak_log_silent полностью отключает вывод сообщений: функции
+    ak_error_message() и ak_error_message_fmt() только устанавливают код ошибки,
+    не формируя строку сообщения.
+
     Для вывода сообщений об ошибке необходимо использовать функции ak_error_message()
     и ak_error_message_fmt(), которые формируют строку с сообщением специального вида и
     выводят данную строку в установленное устройство аудита (консоль, демон syslog и т.п.).
@@ -82,10 +86,12 @@
  @} */
 
 /* ----------------------------------------------------------------------------------------------- */
-/*! \param level Уровень аудита, может принимать значения \ref ak_log_none,
+/*! \param level Уровень аудита, может принимать значения \ref ak_log_silent, \ref ak_log_none,
     \ref ak_log_standard и \ref ak_log_maximum
 
-    \note Допускается передавать в функцию любое целое число, не превосходящее 16.
+    \note Допускается передавать в функцию любое целое число, не превосходящее 16;
+    отрицательные значения соответствуют уровню \ref ak_log_none. Уровень \ref ak_log_silent
+    устанавливается только при явной передаче в функцию данного значения.
     Однако для всех значений от \ref ak_log_maximum  до 16 поведение функции аудита
     будет одинаковым. Дополнительный диапазон предназначен для приложений библиотеки.
 
@@ -93,6 +99,7 @@
 /* ----------------------------------------------------------------------------------------------- */
  int ak_log_set_level( int level )
 {
+   if( level == ak_log_silent ) return ( ak_log_level = ak_log_silent );
    if( level < 0 ) return ( ak_log_level = ak_log_none );
    if( level > 16 ) return ( ak_log_level = 16 );
  return ( ak_log_level = level );
@@ -104,6 +111,17 @@
  return ak_log_level;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка того, что сообщения должны быть выведены.
+
+    На уровне \ref ak_log_silent сообщения отбрасываются до формирования строки; на остальных
+    уровнях выбор выводимых сообщений выполняется вызывающими функциями. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline bool_t ak_log_is_enabled( void )
+{
+ return ( ak_log_level >= ak_log_none );
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \b Внимание. Функция экспортируется.
     \param value Код ошибки, который будет установлен. В случае, если значение value положительно,
@@ -117,8 +135,8 @@
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! \b Внимание. Функция экспортируется.
-    \return Функция возвращает текущее значение кода ошибки. Данное значение не является
-    защищенным от возможности изменения различными потоками выполнения программы.                  */
+    \return Функция возвращает текущее значение кода ошибки. Значение хранится отдельно
+    для каждого потока выполнения программы.                                                       */
 /* ----------------------------------------------------------------------------------------------- */
  int ak_error_get_value( void )
 {
@@ -165,6 +183,19 @@
  return ak_error_ok;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Замена указателя на функцию аудита. Указатель считывается функцией ak_log_set_message()
+    без блокировки, поэтому при наличии потоков запись выполняется атомарно. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_log_store_function( ak_function_log *function )
+{
+#ifdef AK_HAVE_PTHREAD_H
+  __atomic_store_n( &ak_function_log_default, function, __ATOMIC_RELEASE );
+#else
+  ak_function_log_default = function;
+#endif
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! Функция устанавливает в качестве основного обработчика
     вывода сообщений функцию, задаваемую указателем function. Если аргумент function равен NULL,
@@ -182,7 +213,7 @@
   pthread_mutex_lock( &ak_function_log_default_mutex );
 #endif
   if( function != NULL ) {
-    ak_function_log_default = function;
+    ak_log_store_function( function );
     if( function == ak_function_log_stderr ) { /* раскрашиваем вывод кодов ошибок */
       #ifndef _WIN32
         ak_error_code_start_string = ak_error_code_start_red_string;
@@ -195,9 +226,9 @@
   }
    else {
     #ifdef AK_HAVE_SYSLOG_H
-      ak_function_log_default = ak_function_log_syslog;
+      ak_log_store_function( ak_function_log_syslog );
     #else
-      ak_function_log_default = ak_function_log_stderr;
+      ak_log_store_function( ak_function_log_stderr );
     #endif
    }
 #ifdef AK_HAVE_PTHREAD_H
@@ -217,14 +248,22 @@
  int ak_log_set_message( const char *message )
 {
   int result = ak_error_ok;
-  if( ak_function_log_default == NULL ) return ak_error_set_value( ak_error_undefined_function );
+#ifdef AK_HAVE_PTHREAD_H
+  ak_function_log *function = __atomic_load_n( &ak_function_log_default, __ATOMIC_ACQUIRE );
+#else
+  ak_function_log *function = ak_function_log_default;
+#endif
+
+  if( function == NULL ) return ak_error_set_value( ak_error_undefined_function );
   if( message == NULL ) {
     return ak_error_message( ak_error_null_pointer, __func__ , "use a null string for message" );
   } else {
           #ifdef AK_HAVE_PTHREAD_H
+          /* кольцевые буфферы принадлежат потокам, поэтому блокировка не требуется */
+           if( function == ak_function_log_ring ) return function( message );
            pthread_mutex_lock( &ak_function_log_default_mutex );
           #endif
-           result = ak_function_log_default( message );
+           result = function( message );
           #ifdef AK_HAVE_PTHREAD_H
            pthread_mutex_unlock( &ak_function_log_default_mutex );
           #endif
@@ -233,6 +272,280 @@
  return ak_error_ok;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*                   вывод сообщений через кольцевые буфферы потоков выполнения                    */
+/* ----------------------------------------------------------------------------------------------- */
+#ifdef AK_HAVE_PTHREAD_H
+/*! \brief Количество сообщений, помещаемых в кольцевой буффер одного потока. */
+ #define ak_log_ring_slots                   (64)
+/*! \brief Максимальная длина одного сообщения (вместе с завершающим нулем). */
+ #define ak_log_ring_slot_size             (1024)
+/*! \brief Период опроса кольцевых буфферов (в наносекундах). */
+ #define ak_log_ring_period            (10000000L)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Кольцевой буффер сообщений одного потока.
+
+    Индекс `head` изменяется только потоком-владельцем буффера, индекс `tail` - только потоком,
+    выводящим сообщения, поэтому запись и чтение сообщений не требуют блокировок.                  */
+ typedef struct log_ring {
+  /*! \brief Сообщения. */
+   char messages[ ak_log_ring_slots ][ ak_log_ring_slot_size ];
+  /*! \brief Количество помещенных в буффер сообщений. */
+   size_t head;
+  /*! \brief Количество выведенных сообщений. */
+   size_t tail;
+  /*! \brief Флаг того, что буффер закреплен за некоторым потоком. */
+   int used;
+  /*! \brief Следующий буффер в списке. */
+   struct log_ring *next;
+ } *ak_log_ring;
+
+/*! \brief Список кольцевых буфферов; элементы только добавляются, буфферы завершившихся потоков
+    используются повторно. Список удаляется функцией ak_log_ring_destroy(). */
+ static ak_log_ring log_rings = NULL;
+/*! \brief Номер списка буфферов, увеличивается при каждом удалении списка. */
+ static ak_uint64 log_rings_epoch = 0;
+/*! \brief Кольцевой буффер текущего потока. */
+ static ak_thread_local ak_log_ring log_ring_current = NULL;
+/*! \brief Номер списка, которому принадлежит буффер текущего потока. */
+ static ak_thread_local ak_uint64 log_ring_current_epoch = 0;
+/*! \brief Ключ, используемый для освобождения буффера при завершении потока. */
+ static pthread_key_t log_ring_key;
+/*! \brief Флаг того, что ключ создан (ключ удаляется вместе со списком буфферов). */
+ static int log_ring_key_created = 0;
+/*! \brief Функция, которой выводятся накопленные в буфферах сообщения. */
+ static ak_function_log *log_ring_output = NULL;
+/*! \brief Поток, выводящий сообщения. */
+ static pthread_t log_ring_thread;
+/*! \brief Состояние потока: 0 - не запущен, 1 - работает, 2 - завершается. */
+ static int log_ring_state = 0;
+/*! \brief Количество сообщений, потерянных из-за переполнения буфферов. */
+ static ak_uint64 log_ring_dropped = 0;
+
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_log_ring_release( void *ptr )
+{
+  __atomic_store_n( &(( ak_log_ring )ptr)->used, 0, __ATOMIC_RELEASE );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_log_ring_create_key( void )
+{
+  if( __atomic_load_n( &log_ring_key_created, __ATOMIC_ACQUIRE )) return;
+  pthread_mutex_lock( &ak_function_log_default_mutex );
+  if( !log_ring_key_created ) {
+    pthread_key_create( &log_ring_key, ak_log_ring_release );
+    __atomic_store_n( &log_ring_key_created, 1, __ATOMIC_RELEASE );
+  }
+  pthread_mutex_unlock( &ak_function_log_default_mutex );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Закрепление кольцевого буффера за текущим потоком.
+
+    В первую очередь используются опустошенные буфферы завершившихся потоков, при их отсутствии
+    создается новый буффер, который добавляется в начало списка.                                   */
+/* ----------------------------------------------------------------------------------------------- */
+ static ak_log_ring ak_log_ring_acquire( void )
+{
+  int expected = 0;
+  ak_log_ring ring = NULL;
+
+  ak_log_ring_create_key();
+  for( ring = __atomic_load_n( &log_rings, __ATOMIC_ACQUIRE ); ring != NULL; ring = ring->next ) {
+     expected = 0;
+     if( !__atomic_compare_exchange_n( &ring->used, &expected, 1, 0,
+                                                      __ATOMIC_ACQ_REL, __ATOMIC_RELAXED )) continue;
+    /* буффер, содержащий еще не выведенные сообщения, не используется */
+     if( ring->head == __atomic_load_n( &ring->tail, __ATOMIC_ACQUIRE )) break;
+     __atomic_store_n( &ring->used, 0, __ATOMIC_RELEASE );
+  }
+  if( ring == NULL ) {
+    if(( ring = calloc( 1, sizeof( struct log_ring ))) == NULL ) return NULL;
+    ring->used = 1;
+    ring->next = __atomic_load_n( &log_rings, __ATOMIC_ACQUIRE );
+    while( !__atomic_compare_exchange_n( &log_rings, &ring->next, ring, 0,
+                                                            __ATOMIC_RELEASE, __ATOMIC_ACQUIRE ));
+  }
+  pthread_setspecific( log_ring_key, ring );
+  log_ring_current_epoch = __atomic_load_n( &log_rings_epoch, __ATOMIC_ACQUIRE );
+ return ( log_ring_current = ring );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция копирует сообщение в кольцевой буффер текущего потока (буффер создается при первом
+    обращении). Если буффер заполнен, сообщение отбрасывается, а количество потерянных сообщений
+    выводится при остановке потока, обслуживающего буфферы.
+
+    Функция устанавливается в качестве функции аудита вызовом ak_log_ring_start().
+
+    \param message Выводимое сообщение
+    \return В случае успеха, возвращается ak_error_ok (ноль). В случае возникновения ошибки,
+    возвращается ее код.                                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_function_log_ring( const char *message )
+{
+  size_t head = 0;
+  ak_log_ring ring = log_ring_current;
+
+  if( message == NULL ) return ak_error_ok;
+ /* буффер, принадлежавший удаленному списку, заменяется новым */
+  if(( ring == NULL ) ||
+               ( log_ring_current_epoch != __atomic_load_n( &log_rings_epoch, __ATOMIC_ACQUIRE )))
+    if(( ring = ak_log_ring_acquire()) == NULL ) return ak_error_out_of_memory;
+
+  head = ring->head;
+  if( head - __atomic_load_n( &ring->tail, __ATOMIC_ACQUIRE ) >= ak_log_ring_slots ) {
+    __atomic_add_fetch( &log_ring_dropped, 1, __ATOMIC_RELAXED );
+    return ak_error_ok;
+  }
+  ak_snprintf( ring->messages[ head%ak_log_ring_slots ], ak_log_ring_slot_size, "%s", message );
+  __atomic_store_n( &ring->head, head + 1, __ATOMIC_RELEASE );
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вывод всех накопленных в буфферах сообщений. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_log_ring_drain( void )
+{
+  size_t head, tail;
+  ak_log_ring ring = NULL;
+
+  for( ring = __atomic_load_n( &log_rings, __ATOMIC_ACQUIRE ); ring != NULL; ring = ring->next ) {
+     head = __atomic_load_n( &ring->head, __ATOMIC_ACQUIRE );
+     for( tail = ring->tail; tail != head; tail++ ) {
+        log_ring_output( ring->messages[ tail%ak_log_ring_slots ] );
+        __atomic_store_n( &ring->tail, tail + 1, __ATOMIC_RELEASE );
+     }
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static void *ak_log_ring_thread_function( void *ptr )
+{
+  struct timespec period = { 0, ak_log_ring_period };
+
+  (void)ptr;
+  while( __atomic_load_n( &log_ring_state, __ATOMIC_ACQUIRE ) == 1 ) {
+    ak_log_ring_drain();
+    nanosleep( &period, NULL );
+  }
+  ak_log_ring_drain();
+ return NULL;
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция запускает поток, который периодически выводит сообщения, накопленные в кольцевых
+    буфферах потоков, с помощью заданной функции, и устанавливает ak_function_log_ring()
+    в качестве функции аудита. Тем самым, потоки, вырабатывающие сообщения, не блокируют
+    друг друга, а функция `function` вызывается только одним потоком.
+
+    \param function Функция вывода сообщений, например, ak_function_log_stderr().
+    \return В случае успеха, возвращается ak_error_ok (ноль). В случае возникновения ошибки,
+    возвращается ее код.                                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_log_ring_start( ak_function_log *function )
+{
+#ifdef AK_HAVE_PTHREAD_H
+  int expected = 0;
+
+  if(( function == NULL ) || ( function == ak_function_log_ring ))
+    return ak_error_message( ak_error_null_pointer, __func__, "using wrong output function" );
+  if( !__atomic_compare_exchange_n( &log_ring_state, &expected, 1, 0,
+                                                            __ATOMIC_ACQ_REL, __ATOMIC_RELAXED ))
+    return ak_error_message( ak_error_not_ready, __func__, "ring logger is already started" );
+
+  log_ring_output = function;
+  __atomic_store_n( &log_ring_dropped, 0, __ATOMIC_RELAXED );
+  if( pthread_create( &log_ring_thread, NULL, ak_log_ring_thread_function, NULL ) != 0 ) {
+    __atomic_store_n( &log_ring_state, 0, __ATOMIC_RELEASE );
+    return ak_error_message( ak_error_undefined_function, __func__,
+                                                   "incorrect creation of ring logger thread" );
+  }
+ return ak_log_set_function( ak_function_log_ring );
+#else
+  (void)function;
+ return ak_error_message( ak_error_undefined_function, __func__,
+                                            "ring logger requires support of POSIX threads" );
+#endif
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция восстанавливает функцию аудита, переданную в ak_log_ring_start(), выводит все
+    накопленные сообщения и дожидается завершения потока, обслуживающего буфферы.
+
+    \return В случае успеха, возвращается ak_error_ok (ноль). В случае возникновения ошибки,
+    возвращается ее код.                                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_log_ring_stop( void )
+{
+#ifdef AK_HAVE_PTHREAD_H
+  ak_uint64 dropped = 0;
+  char message[128];
+
+  if( __atomic_load_n( &log_ring_state, __ATOMIC_ACQUIRE ) != 1 ) return ak_error_ok;
+  ak_log_set_function( log_ring_output );
+  __atomic_store_n( &log_ring_state, 2, __ATOMIC_RELEASE );
+  pthread_join( log_ring_thread, NULL );
+ /* поток, получивший указатель на ak_function_log_ring() до замены функции аудита, мог поместить
+    сообщение в буффер уже после того, как завершившийся поток опустошил буфферы; после завершения
+    потока выводом сообщений занимается текущий поток */
+  ak_log_ring_drain();
+  __atomic_store_n( &log_ring_state, 0, __ATOMIC_RELEASE );
+
+  if(( dropped = __atomic_load_n( &log_ring_dropped, __ATOMIC_RELAXED )) > 0 ) {
+    ak_snprintf( message, sizeof( message ),
+             "ring logger dropped %llu message(s) due to buffer overflow", (unsigned long long)dropped );
+    ak_log_set_message( message );
+  }
+#endif
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция останавливает поток, обслуживающий кольцевые буфферы, и освобождает память, занятую
+    буфферами. Сообщения, помещенные в буфферы после остановки потока, не выводятся, выводится
+    только их количество. Функция вызывается при завершении работы с библиотекой, когда
+    потоки, использующие функцию ak_function_log_ring(), должны быть завершены.
+
+    \return Функция возвращает \ref ak_error_ok (ноль).                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_log_ring_destroy( void )
+{
+#ifdef AK_HAVE_PTHREAD_H
+  char message[128];
+  ak_uint64 leftover = 0;
+  ak_log_ring ring = NULL, next = NULL;
+
+  ak_log_ring_stop();
+  pthread_mutex_lock( &ak_function_log_default_mutex );
+  if( log_ring_key_created ) {
+    pthread_key_delete( log_ring_key );
+    __atomic_store_n( &log_ring_key_created, 0, __ATOMIC_RELEASE );
+  }
+  ring = __atomic_exchange_n( &log_rings, NULL, __ATOMIC_ACQ_REL );
+  __atomic_add_fetch( &log_rings_epoch, 1, __ATOMIC_RELEASE );
+  pthread_mutex_unlock( &ak_function_log_default_mutex );
+
+  for( ; ring != NULL; ring = next ) {
+     next = ring->next;
+     leftover += __atomic_load_n( &ring->head, __ATOMIC_ACQUIRE ) - ring->tail;
+     free( ring );
+  }
+  log_ring_current = NULL;
+  if( leftover > 0 ) {
+    ak_snprintf( message, sizeof( message ),
+                      "ring logger lost %llu message(s) sent after its stop", (unsigned long long)leftover );
+    ak_log_set_message( message );
+  }
+#endif
+ return ak_error_ok;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \param str Строка, в которую помещается результат (сообщение)
     \param size Максимальный размер помещаемого в строку str сообщения
@@ -343,6 +656,9 @@
     \param message Читаемое (понятное для пользователя) сообщение
     \param function Имя функции, вызвавшей ошибку
 
+    На уровне аудита \ref ak_log_silent функция только устанавливает код ошибки,
+    строка сообщения не формируется.
+
     \hidecallgraph
     \hidecallergraph
     \return Функция возвращает установленный код ошибки.                                           */
@@ -353,6 +669,7 @@
   char error_event_string[1024];
   const char *br0 = "", *br1 = "():", *br = NULL;
 
+  if( !ak_log_is_enabled( )) return ak_error_set_value( code );
   memset( error_event_string, 0, 1024 );
   if(( function == NULL ) || strcmp( function, "" ) == 0 ) br = br0;
     else br = br1;
@@ -389,6 +706,7 @@
   va_list args;
   char ak_static_buffer_fmt[512];
 
+  if( !ak_log_is_enabled( )) return ak_error_set_value( code );
   va_start( args, format );
   memset( ak_static_buffer_fmt, 0, sizeof( ak_static_buffer_fmt ));
 
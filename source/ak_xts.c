@@ -12,6 +12,46 @@
  #include <stdalign.h>
 #endif
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция реализует основной цикл преобразования данных в режиме XTS.
+
+    Данные рассматриваются как последовательность 64-х битных слов, к каждому из которых
+    прибавляется соответствующее слово псевдослучайной последовательности (tweak).
+    Значения tweak вычисляются сразу для \ref ak_bckey_batch_size октетов, после чего
+    все блоки группы преобразуются одним вызовом функции `blocks_fn`.
+
+    @param bkey Ключ, используемый для шифрования информации.
+    @param blocks_fn Функция зашифрования или расшифрования последовательности блоков.
+    @param tweak Текущее значение tweak (изменяется в ходе работы функции).
+    @param inptr Указатель на входные данные.
+    @param outptr Указатель на выходные данные.
+    @param words Количество обрабатываемых 64-х битных слов.                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_bckey_xts_blocks( ak_bckey bkey, ak_function_bckey_blocks *blocks_fn,
+                     ak_uint64 *tweak, ak_uint64 *inptr, ak_uint64 *outptr, size_t words )
+{
+  size_t i, cnt;
+  ak_uint64 t[2], gamma[ ak_bckey_batch_size/sizeof( ak_uint64 )],
+                                          buffer[ ak_bckey_batch_size/sizeof( ak_uint64 )];
+  while( words > 0 ) {
+     cnt = ak_min( words, ak_bckey_batch_size/sizeof( ak_uint64 ));
+     for( i = 0; i < cnt; i++ ) {
+        gamma[i] = tweak[i&1];
+        buffer[i] = inptr[i]^gamma[i];
+        if( i&1 ) { /* изменяем значение tweak */
+          t[0] = tweak[0] >> 63; t[1] = tweak[1] >> 63;
+          tweak[0] <<= 1; tweak[1] <<= 1;
+          tweak[1] ^= t[0];
+          if( t[1] ) tweak[0] ^= 0x87;
+        }
+     }
+     blocks_fn( &bkey->key, buffer, buffer, ( cnt << 3 )/bkey->bsize );
+     for( i = 0; i < cnt; i++ ) outptr[i] = buffer[i]^gamma[i];
+     inptr += cnt; outptr += cnt; words -= cnt;
+  }
+  ak_ptr_wipe( gamma, sizeof( gamma ), &bkey->key.generator );
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! Функция реализует алгоритм двухключевого шифрования, описываемый в стандарте IEEE P 1619.
 
@@ -37,14 +77,13 @@
                         ak_pointer in, ak_pointer out, size_t size, ak_pointer iv, size_t iv_size )
 {
   int error = ak_error_ok;
-  ak_int64 jcnt = 0, blocks = 0;
-  ak_uint64 *inptr = (ak_uint64 *)in, *outptr = (ak_uint64 *)out;
+  ak_int64 blocks = 0;
 #ifdef AK_HAVE_STDALIGN_H
  #ifndef AK_HAVE_WINDOWS_H
   alignas(16)
  #endif
 #endif
-  ak_uint64 tweak[2], t[2], *tptr = t;
+  ak_uint64 tweak[2];
 
  /* проверяем целостность ключа */
   if( encryptionKey->key.check_icode( &encryptionKey->key ) != ak_true )
@@ -84,55 +123,17 @@
    else encryptionKey->key.resource.value.counter -= blocks;
 
  /* запускаем основной цикл обработки блоков информации */
-   switch( encryptionKey->bsize ) {
-     case  8: /* шифр с длиной блока 64 бита */
-       while( blocks > 0 ) {
-          *tptr = *inptr^*(tweak+jcnt); inptr++;
-          encryptionKey->encrypt( &encryptionKey->key, tptr, tptr );
-          *outptr = *tptr ^ *(tweak+jcnt); outptr++;
-          --blocks;
-          tptr++;
-
-          if( !(jcnt = 1 - jcnt)) { /* изменяем значение tweak */
-            tptr = t;
-            t[0] = tweak[0] >> 63; t[1] = tweak[1] >> 63;
-            tweak[0] <<= 1; tweak[1] <<= 1;
-            tweak[1] ^= t[0];
-            if( t[1] ) tweak[0] ^= 0x87;
-          }
-       }
-       break;
-
-     case 16: /* шифр с длиной блока 128 бит */
-       while( blocks > 0 ) {
-         /* шифруем */
-          t[0] = *inptr^*tweak; inptr++;
-          t[1] = *inptr^*(tweak+1); inptr++;
-
-          encryptionKey->encrypt( &encryptionKey->key, t, t );
-          *outptr = t[0]^*tweak; outptr++;
-          *outptr = t[1]^*(tweak+1); outptr++;
-          --blocks;
-
-         /* изменяем значение tweak */
-          t[0] = tweak[0] >> 63;
-          t[1] = tweak[1] >> 63;
-          tweak[0] <<= 1;
-          tweak[1] <<= 1;
-          tweak[1] ^= t[0];
-          if( t[1] ) tweak[0] ^= 0x87;
-       }
-       break;
-   }
+  ak_bckey_xts_blocks( encryptionKey, encryptionKey->encrypt_blocks, tweak,
+                                       in, out, ( size_t )blocks*( encryptionKey->bsize >> 3 ));
 
  /* очищаем */
   if(( error = ak_ptr_wipe( tweak, sizeof( tweak ), &encryptionKey->key.generator )) != ak_error_ok )
    ak_error_message( error, __func__ , "wrong wiping of tweak value" );
 
  /* перемаскируем ключ */
-  if(( error = encryptionKey->key.set_mask( &encryptionKey->key )) != ak_error_ok )
+  if(( error = ak_skey_remask( &encryptionKey->key, size )) != ak_error_ok )
     ak_error_message( error, __func__ , "wrong remasking of encryption key" );
-  if(( error = authenticationKey->key.set_mask( &authenticationKey->key )) != ak_error_ok )
+  if(( error = ak_skey_remask( &authenticationKey->key, size )) != ak_error_ok )
     ak_error_message( error, __func__ , "wrong remasking of authentication key" );
 
   return error;
@@ -174,14 +175,13 @@
                         ak_pointer in, ak_pointer out, size_t size, ak_pointer iv, size_t iv_size )
 {
   int error = ak_error_ok;
-  ak_int64 jcnt = 0, blocks = 0;
-  ak_uint64 *inptr = (ak_uint64 *)in, *outptr = (ak_uint64 *)out;
+  ak_int64 blocks = 0;
 #ifdef AK_HAVE_STDALIGN_H
  #ifndef AK_HAVE_WINDOWS_H
   alignas(16)
  #endif
 #endif
-  ak_uint64 tweak[2], t[2], *tptr = t;
+  ak_uint64 tweak[2];
 
  /* проверяем целостность ключа */
   if( encryptionKey->key.check_icode( &encryptionKey->key ) != ak_true )
@@ -221,55 +221,17 @@
    else encryptionKey->key.resource.value.counter -= blocks;
 
  /* запускаем основной цикл обработки блоков информации */
-   switch( encryptionKey->bsize ) {
-     case  8: /* шифр с длиной блока 64 бита */
-       while( blocks > 0 ) {
-          *tptr = *inptr^*(tweak+jcnt); inptr++;
-          encryptionKey->decrypt( &encryptionKey->key, tptr, tptr );
-          *outptr = *tptr ^ *(tweak+jcnt); outptr++;
-          --blocks;
-          tptr++;
-
-          if( !(jcnt = 1 - jcnt)) { /* изменяем значение tweak */
-            tptr = t;
-            t[0] = tweak[0] >> 63; t[1] = tweak[1] >> 63;
-            tweak[0] <<= 1; tweak[1] <<= 1;
-            tweak[1] ^= t[0];
-            if( t[1] ) tweak[0] ^= 0x87;
-          }
-       }
-       break;
-
-     case 16: /* шифр с длиной блока 128 бит */
-       while( blocks > 0 ) {
-         /* шифруем */
-          t[0] = *inptr^*tweak; inptr++;
-          t[1] = *inptr^*(tweak+1); inptr++;
-
-          encryptionKey->decrypt( &encryptionKey->key, t, t );
-          *outptr = t[0]^*tweak; outptr++;
-          *outptr = t[1]^*(tweak+1); outptr++;
-          --blocks;
-
-         /* изменяем значение tweak */
-          t[0] = tweak[0] >> 63;
-          t[1] = tweak[1] >> 63;
-          tweak[0] <<= 1;
-          tweak[1] <<= 1;
-          tweak[1] ^= t[0];
-          if( t[1] ) tweak[0] ^= 0x87;
-       }
-       break;
-   }
+  ak_bckey_xts_blocks( encryptionKey, encryptionKey->decrypt_blocks, tweak,
+                                       in, out, ( size_t )blocks*( encryptionKey->bsize >> 3 ));
 
  /* очищаем */
   if(( error = ak_ptr_wipe( tweak, sizeof( tweak ), &encryptionKey->key.generator )) != ak_error_ok )
    ak_error_message( error, __func__ , "wrong wiping of tweak value" );
 
  /* перемаскируем ключ */
-  if(( error = encryptionKey->key.set_mask( &encryptionKey->key )) != ak_error_ok )
+  if(( error = ak_skey_remask( &encryptionKey->key, size )) != ak_error_ok )
     ak_error_message( error, __func__ , "wrong remasking of encryption key" );
-  if(( error = authenticationKey->key.set_mask( &authenticationKey->key )) != ak_error_ok )
+  if(( error = ak_skey_remask( &authenticationKey->key, size )) != ak_error_ok )
     ak_error_message( error, __func__ , "wrong remasking of authentication key" );
 
   return error;
@@ -14,6 +14,10 @@
 /** \addtogroup mac-doc
  @{ */
  extern const ak_uint64 streebog_Areverse_expand_with_pi[8][256];
+/*! \brief Нелинейная перестановка октетов, общая для алгоритмов Стрибог и Кузнечик. */
+ extern const sbox gost_pi;
+/*! \brief Выбор реализации функции сжатия алгоритма Стрибог, поддерживаемой процессором. */
+ int ak_hash_streebog_select_kernel( void );
 /** @} */
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -29,6 +33,17 @@
 /*! \brief Формирование имени файла, в который будет помещаться секретный или открытый ключ. */
  int ak_skey_generate_file_name_from_buffer( ak_uint8 * , const size_t ,
                                                          char * , const size_t , export_format_t );
+/*! \brief Размер буффера (в октетах), используемого режимами шифрования для одновременной
+    обработки нескольких блоков информации: 8 блоков Кузнечика или 16 блоков Магмы. */
+ #define ak_bckey_batch_size  (128)
+/*! \brief Минимальный объем данных (в октетах), обрабатываемый одним потоком при многопоточной
+    реализации режимов гаммирования. */
+ #define ak_bckey_thread_min_size  (16384)
+/*! \brief Максимальное количество потоков, используемых при многопоточной
+    реализации режимов гаммирования. */
+ #define ak_bckey_max_threads  (64)
+/*! \brief Разбиение последовательности блоков на фрагменты для многопоточной обработки. */
+ size_t ak_bckey_split_blocks( size_t , size_t , size_t , size_t * );
 /*! \brief Инициализация секретного ключа алгоритма блочного шифрования. */
  int ak_bckey_create( ak_bckey , size_t , size_t );
 /*! \brief Инициализация ключа алгоритма блочного шифрования значением другого ключа */
@@ -50,6 +65,35 @@
                                                                 const sbox , ak_kuznechik_params );
 /*! \brief Инициализация внутренних переменных значениями, регламентируемыми ГОСТ Р 34.12-2015. */
  int ak_bckey_kuznechik_init_gost_tables( void );
+/*! \brief Считывание значений опций библиотеки, используемых ключом алгоритма блочного шифрования. */
+ int ak_bckey_load_options( ak_bckey );
+/*! \brief Получение значений опций, кэшированных в контексте ключа алгоритма блочного шифрования.
+    \details Значения считываются повторно только в том случае, если опции библиотеки
+    изменялись после их последнего считывания. */
+ static inline ak_bckey_options ak_bckey_get_options( ak_bckey bkey )
+{
+  if( bkey->options.generation != ak_libakrypt_get_options_generation( ))
+    ak_bckey_load_options( bkey );
+ return &bkey->options;
+}
+/*! \brief Описание одной из реализаций многоблочных функций алгоритма блочного шифрования. */
+ typedef struct bckey_kernel {
+  /*! \brief Имя реализации. */
+   const char *name;
+  /*! \brief Функция проверки того, что реализация поддерживается процессором. */
+   bool_t (*is_supported)( void );
+  /*! \brief Функции зашифрования (индекс определяется флагом совместимости с openssl). */
+   ak_function_bckey_blocks *encrypt[2];
+  /*! \brief Функции расшифрования (индекс определяется флагом совместимости с openssl). */
+   ak_function_bckey_blocks *decrypt[2];
+ } *ak_bckey_kernel;
+/*! \brief Выбор реализации многоблочных функций алгоритма Кузнечик, поддерживаемой процессором. */
+ int ak_bckey_kuznechik_select_kernel( void );
+/*! \brief Выбор реализации многоблочных функций алгоритма Магма, поддерживаемой процессором. */
+ int ak_bckey_magma_select_kernel( void );
+/*! \brief Выбор реализации накопления сумм произведений в конечных полях, поддерживаемой
+    процессором. */
+ int ak_gf2n_select_kernel( void );
 /** @} */
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -75,6 +119,34 @@
  int ak_mac_ptr( ak_mac , ak_pointer , const size_t , ak_pointer , const size_t );
 /*! \brief Применение сжимающего отображения к заданному файлу. */
  int ak_mac_file( ak_mac , const char* , ak_pointer , const size_t );
+/*! \brief Обработка целых блоков нескольких независимых сообщений. */
+ int ak_hash_update_multi( ak_hash * , const ak_pointer * , const size_t * , const size_t );
+/*! \brief Сохранение состояния контекста хеширования, обработавшего один блок данных. */
+ int ak_hash_get_state( ak_hash , ak_streebog );
+/*! \brief Восстановление сохраненного состояния контекста хеширования. */
+ int ak_hash_set_state( ak_hash , const ak_streebog );
+/*! \brief Проверка того, что контекст реализует древовидное хеширование. */
+ bool_t ak_hash_is_tree( ak_hash );
+/*! \brief Многопоточная обработка файла контекстом древовидного хеширования. */
+ int ak_hash_tree_update_file( ak_hash , ak_file , ak_uint8 * , size_t * );
+/** @} */
+
+/** \addtogroup oid-doc
+ @{ */
+/*! \brief Построение индексов, используемых для поиска идентификаторов криптографических
+    механизмов по именам, идентификаторам и указателям на данные. */
+ int ak_oid_create_index( void );
+/** @} */
+
+/** \addtogroup curves-doc
+ @{ */
+/*! \brief Удаление таблиц кратных точек, используемых при вычислении кратных образующих точек. */
+ void ak_wcurve_comb_cache_destroy( void );
+/*! \brief Вычисление таблицы нечетных кратных точки. */
+ void ak_wpoint_set_odd_multiples( ak_wpoint , ak_wpoint , ak_wcurve );
+/*! \brief Вычисление суммы кратных точек по заранее вычисленным таблицам. */
+ void ak_wpoint_pow2_tables( ak_wpoint , ak_wpoint , ak_uint64 * ,
+                                                   ak_wpoint , ak_uint64 * , size_t , ak_wcurve );
 /** @} */
 
 /** \addtogroup aead-doc
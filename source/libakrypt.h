@@ -137,6 +137,28 @@ extern "C" {
  dll_export int ak_libakrypt_destroy( void );
 
 /* ----------------------------------------------------------------------------------------------- */
+/*! \brief Идентификаторы опций библиотеки.
+    \details Значение идентификатора совпадает с индексом опции, поэтому оно может передаваться
+    в функцию ak_libakrypt_get_option_by_index() вместо поиска опции по имени.                    */
+ typedef enum {
+   log_level_option,
+   pbkdf2_iteration_count_option,
+   hmac_key_count_resource_option,
+   digital_signature_count_resource_option,
+   magma_cipher_resource_option,
+   kuznechik_cipher_resource_option,
+   acpkm_message_count_option,
+   acpkm_section_magma_block_count_option,
+   acpkm_section_kuznechik_block_count_option,
+   openssl_compability_option,
+   use_color_output_option,
+   file_buffer_size_option,
+   use_mmap_for_files_option,
+   tree_hash_threads_option,
+   ctr_drbg_buffer_size_option,
+   encrypt_file_threads_option
+ } option_t;
+
 /*! \brief Функция возвращает номер версии бибилиотеки libakrypt. */
  dll_export const char *ak_libakrypt_version( void );
 /*! \brief Функция возвращает общее количества опций библиотеки. */
@@ -149,6 +171,8 @@ extern "C" {
  dll_export ak_int64 ak_libakrypt_get_option_by_index( const size_t );
 /*! \brief Функция устанавливает значение заданной опции. */
  dll_export int ak_libakrypt_set_option( const char * , const ak_int64 );
+/*! \brief Функция возвращает номер поколения значений опций библиотеки. */
+ dll_export ak_uint64 ak_libakrypt_get_options_generation( void );
 /*! \brief Функция считывает значения опций библиотеки из файла. */
  dll_export bool_t ak_libakrypt_load_options( void );
 /*! \brief Функция выводит текущие значения всех опций библиотеки. */
@@ -454,11 +478,18 @@ extern "C" {
 /*! \brief Инициализация контекста, реализующего интерфейс доступа к генератору псевдо-случайных чисел, предоставляемому ОС Windows. */
  dll_export int ak_random_create_winrtl( ak_random );
 #endif
+#ifdef AK_HAVE_SYSRANDOM_H
+/*! \brief Инициализация контекста генератора, использующего системный вызов getrandom(). */
+ dll_export int ak_random_create_getrandom( ak_random );
+#endif
 /*! \brief Инициализация контекста нелинейного конгруэнтного генератора с обратной квадратичной связью. */
  dll_export int ak_random_create_nlfsr( ak_random );
 /*! \brief Инициализация контекста нелинейного конгруэнтного генератора с обратной квадратичной связью
     с явным указанием параметров генератора. */
  dll_export int ak_random_create_nlfsr_with_params( ak_random , size_t , ak_uint64 );
+/*! \brief Инициализация контекста генератора, основанного на блочном шифре Кузнечик в режиме
+    гаммирования и периодически обновляемого из системного источника энтропии. */
+ dll_export int ak_random_create_ctr_drbg_kuznechik( ak_random );
 /*! \brief Инициализация контекста генератора по заданному OID алгоритма генерации псевдо-случайных чисел. */
  dll_export int ak_random_create_oid( ak_random, ak_oid );
 /*! \brief Установка внутреннего состояния генератора псевдо-случайных чисел. */
@@ -505,6 +536,8 @@ extern "C" {
    key_flag_not_ctr = 0x0000000000000100ULL,
   /*! \brief Флаг, который определяет, можно ли использовать значение внутреннего буффера в режиме omac. */
    key_flag_omac_buffer_used = 0x0000000000000200ULL,
+  /*! \brief Флаг, который определяет, вычислена ли таблица кратных точек открытого ключа. */
+   key_flag_set_qtable = 0x0000000000000400ULL,
  } key_flag_values_t;
 
 /*! \brief Множество состояний флагов  */
@@ -520,6 +553,30 @@ extern "C" {
 
 } memory_allocation_policy_t;
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Политика смены маски секретного ключа после его использования. */
+ typedef enum {
+  /*! \brief Маска ключа меняется после каждого обращения к ключу (значение по умолчанию). */
+   mask_always_policy,
+  /*! \brief Маска ключа меняется после заданного количества обращений к ключу. */
+   mask_every_n_calls_policy,
+  /*! \brief Маска ключа меняется после обработки заданного количества октетов. */
+   mask_every_n_bytes_policy,
+  /*! \brief Маска ключа устанавливается только при присвоении ключу значения. */
+   mask_never_after_schedule_policy
+} mask_policy_t;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Параметры смены маски секретного ключа. */
+ typedef struct mask_policy {
+  /*! \brief Тип политики смены маски. */
+   mask_policy_t type;
+  /*! \brief Интервал (количество обращений или октетов), по истечении которого меняется маска. */
+   ak_uint64 interval;
+  /*! \brief Количество обращений или октетов, накопленных с момента последней смены маски. */
+   ak_uint64 counter;
+} *ak_mask_policy;
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Тип ключа шифрования контента. */
  typedef enum {
@@ -609,6 +666,8 @@ extern "C" {
    key_flags_t flags;
   /*! \brief Способ выделения памяти. */
    memory_allocation_policy_t policy;
+  /*! \brief Политика смены маски ключа. */
+   struct mask_policy remask;
   /*! \brief указатель на функцию маскирования ключа */
    ak_function_skey *set_mask;
   /*! \brief указатель на функцию демаскирования ключа */
@@ -632,6 +691,10 @@ extern "C" {
  dll_export int ak_skey_create( ak_skey , size_t );
 /*! \brief Очистка структуры секретного ключа. */
  dll_export int ak_skey_destroy( ak_skey );
+/*! \brief Установка политики смены маски секретного ключа. */
+ dll_export int ak_skey_set_mask_policy( ak_skey , mask_policy_t , ak_uint64 );
+/*! \brief Смена маски секретного ключа после его использования в соответствии с политикой. */
+ dll_export int ak_skey_remask( ak_skey , size_t );
 /*! \brief Присвоение секретному ключу уникального номера. */
  dll_export int ak_skey_set_unique_number( ak_skey );
 /*! \brief Присвоение секретному ключу заданного номера. */
@@ -674,10 +737,29 @@ extern "C" {
  typedef int ( ak_function_bckey_create ) ( ak_bckey );
 /*! \brief Функция зашифрования/расширования одного блока информации. */
  typedef void ( ak_function_bckey )( ak_skey, ak_pointer, ak_pointer );
+/*! \brief Функция зашифрования/расширования нескольких последовательно расположенных блоков. */
+ typedef void ( ak_function_bckey_blocks )( ak_skey, ak_pointer, ak_pointer, size_t );
 /*! \brief Функция, предназначенная для зашифрования/расшифрования области памяти заданного размера */
  typedef int ( ak_function_bckey_encrypt )( ak_bckey, ak_pointer, ak_pointer, size_t,
                                                                                 ak_pointer, size_t );
 /* ----------------------------------------------------------------------------------------------- */
+/*! \brief Значения опций библиотеки, используемые ключом алгоритма блочного шифрования.
+    \details Значения считываются при создании ключа и повторно считываются только после
+    изменения опций библиотеки (изменения номера поколения опций), что позволяет
+    не выполнять поиск опций при каждом вызове функций шифрования.                                 */
+/* ----------------------------------------------------------------------------------------------- */
+ typedef struct bckey_options {
+  /*! \brief Номер поколения опций, из которого считаны значения. */
+   ak_uint64 generation;
+  /*! \brief Флаг совместимости с библиотекой openssl. */
+   int oc;
+  /*! \brief Максимальное количество блоков в одной секции режима ACPKM. */
+   ak_int64 acpkm_section_block_count;
+  /*! \brief Максимальное количество блоков, обрабатываемых на одном ключе. */
+   ak_int64 cipher_resource;
+ } *ak_bckey_options;
+
+/* ----------------------------------------------------------------------------------------------- */
 /*! \brief Секретный ключ блочного алгоритма шифрования. */
  struct bckey {
   /*! \brief Указатель на секретный ключ. */
@@ -694,10 +776,18 @@ extern "C" {
    ak_function_bckey *encrypt;
   /*! \brief Функция расширования одного блока информации. */
    ak_function_bckey *decrypt;
+  /*! \brief Функция зашифрования последовательности из нескольких блоков информации.
+      \details Блоки обрабатываются независимо друг от друга, что позволяет реализации
+      выполнять преобразование нескольких блоков одновременно. */
+   ak_function_bckey_blocks *encrypt_blocks;
+  /*! \brief Функция расшифрования последовательности из нескольких блоков информации. */
+   ak_function_bckey_blocks *decrypt_blocks;
   /*! \brief Функция развертки ключа. */
    ak_function_skey *schedule_keys;
   /*! \brief Функция уничтожения развернутых ключей. */
    ak_function_skey *delete_keys;
+  /*! \brief Значения опций библиотеки, используемые ключом. */
+   struct bckey_options options;
 };
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -771,6 +861,10 @@ extern "C" {
 /*! \brief Шифрование данных в режиме гаммирования из ГОСТ Р 34.13-2015
    (counter mode, ctr). */
  dll_export int ak_bckey_ctr( ak_bckey , ak_pointer , ak_pointer , size_t , ak_pointer , size_t );
+/*! \brief Шифрование данных в режиме гаммирования из ГОСТ Р 34.13-2015
+   с использованием нескольких потоков. */
+ dll_export int ak_bckey_ctr_parallel( ak_bckey , ak_pointer , ak_pointer , size_t ,
+                                                                    ak_pointer , size_t , size_t );
 /*! \brief Шифрование данных в режиме гаммирования с обратной связью по выходу
    (output feedback, ofb). */
  dll_export int ak_bckey_ofb( ak_bckey , ak_pointer , ak_pointer , size_t , ak_pointer , size_t );
@@ -785,6 +879,10 @@ extern "C" {
 /*! \brief Шифрование данных в режиме `CTR-ACPKM` из Р 1323565.1.017—2018. */
  dll_export int ak_bckey_ctr_acpkm( ak_bckey , ak_pointer , ak_pointer , size_t , size_t ,
                                                                              ak_pointer , size_t );
+/*! \brief Шифрование данных в режиме `CTR-ACPKM` из Р 1323565.1.017—2018
+   с использованием нескольких потоков. */
+ dll_export int ak_bckey_ctr_acpkm_parallel( ak_bckey , ak_pointer , ak_pointer , size_t ,
+                                                           size_t , ak_pointer , size_t , size_t );
 /*! \brief Зашифрование данных в режиме `XTS`. */
  dll_export int ak_bckey_encrypt_xts( ak_bckey ,  ak_bckey , ak_pointer , ak_pointer , size_t ,
                                                                              ak_pointer , size_t );
@@ -860,13 +958,46 @@ extern "C" {
   size_t hsize;
 } *ak_streebog;
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Длина листа (в октетах) для древовидного хеширования. */
+ #define ak_streebog_tree_leaf_size    (1048576)
+/*! \brief Максимальное количество уровней дерева при древовидном хешировании. */
+ #define ak_streebog_tree_max_levels   (64)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Структура для хранения внутренних данных древовидного хеширования на основе
+    функций хеширования семейства Стрибог. */
+/*! \details Входные данные разбиваются на листья фиксированной длины, хеш-код каждого листа
+    вычисляется независимо, после чего хеш-коды объединяются попарно в двоичное дерево.
+    Для разделения областей применения функции хеширования к каждому листу дописывается
+    октет 0x00, к каждой паре хеш-кодов - октет 0x01, а к хеш-коду вершины дерева, вместе
+    с длиной данных и длиной листа, - октет 0x02.
+
+    \note Структура размещается в динамической памяти при создании контекста функции
+    хеширования и доступна через поле `mctx.ctx`; размер структуры \ref hash при этом
+    не зависит от максимального количества уровней дерева.                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ typedef struct streebog_tree {
+ /*! \brief Контекст хеширования текущего листа. */
+  struct streebog leaf;
+ /*! \brief Количество октетов, обработанных в текущем листе. */
+  ak_uint64 filled;
+ /*! \brief Количество обработанных (закрытых) листьев. */
+  ak_uint64 count;
+ /*! \brief Длина листа (в октетах). */
+  ak_uint64 leaf_size;
+ /*! \brief Хеш-коды вершин незавершенных поддеревьев, по одной на каждый уровень дерева. */
+  ak_uint8 nodes[ ak_streebog_tree_max_levels ][64];
+} *ak_streebog_tree;
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Контекст бесключевой функции хеширования. */
 /*! \details Класс предоставляет интерфейс для реализации бесключевых функций хеширования, построенных
     с использованием итеративных сжимающих отображений. В настоящее время
     с использованием класса \ref hash реализованы следующие отечественные алгоритмы хеширования
      - Стрибог256,
-     - Стрибог512.
+     - Стрибог512,
+     - древовидное хеширование на основе функций Стрибог256 и Стрибог512.
 
   Перед началом работы контекст функции хэширования должен быть инициализирован
   вызовом одной из функций инициализации, например, функции ak_hash_create_streebog256()
@@ -891,6 +1022,10 @@ extern "C" {
  dll_export int ak_hash_create_streebog256( ak_hash );
 /*! \brief Инициализация контекста функции бесключевого хеширования ГОСТ Р 34.11-2012 (Стрибог512). */
  dll_export int ak_hash_create_streebog512( ak_hash );
+/*! \brief Инициализация контекста древовидного хеширования на основе функции Стрибог256. */
+ dll_export int ak_hash_create_tree_streebog256( ak_hash );
+/*! \brief Инициализация контекста древовидного хеширования на основе функции Стрибог512. */
+ dll_export int ak_hash_create_tree_streebog512( ak_hash );
 /*! \brief Инициализация контекста функции бесключевого хеширования по заданному OID алгоритма. */
  dll_export int ak_hash_create_oid( ak_hash, ak_oid );
 /*! \brief Уничтожение контекста функции хеширования. */
@@ -909,8 +1044,19 @@ extern "C" {
  dll_export int ak_hash_finalize( ak_hash , const ak_pointer , const size_t , ak_pointer , const size_t );
 /*! \brief Хеширование заданной области памяти. */
  dll_export int ak_hash_ptr( ak_hash , const ak_pointer , const size_t , ak_pointer , const size_t );
+/*! \brief Вычисление хеш-кодов для нескольких независимых сообщений. */
+ dll_export int ak_hash_ptr_multi( ak_hash * , const ak_pointer * , const size_t * ,
+                                                   ak_pointer * , const size_t , const size_t );
 /*! \brief Хеширование заданного файла. */
  dll_export int ak_hash_file( ak_hash , const char*, ak_pointer , const size_t );
+/*! \brief Древовидное хеширование файла с сохранением хеш-кодов листьев. */
+ dll_export int ak_hash_tree_file_leaves( ak_hash , const char * , const char * ,
+                                                                     ak_pointer , const size_t );
+/*! \brief Проверка заданного диапазона листьев файла по сохраненным хеш-кодам листьев. */
+ dll_export int ak_hash_tree_file_check_leaves( ak_hash , const char * , const char * ,
+                                                          const size_t , const size_t , size_t * );
+/*! \brief Вычисление хеш-кода по сохраненным хеш-кодам листьев. */
+ dll_export int ak_hash_tree_leaves_root( ak_hash , const char * , ak_pointer , const size_t );
 /** @} */
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -929,7 +1075,13 @@ extern "C" {
      (с длиной хеш кода как 256 бит, так и 512 бит).
 
      \note Использование ключей, чья длина превышает размер блока бесключевой функции
-     хеширования, реализовано в соответствии с RFC 2104.                                           */
+     хеширования, реализовано в соответствии с RFC 2104.
+
+     \note Состояния функции хеширования после обработки ключа, сложенного с константами ipad
+     и opad, вычисляются один раз после присвоения ключу значения и далее восстанавливаются
+     копированием; это вдвое сокращает количество вызовов функции сжатия для коротких сообщений.
+     Сохраненные состояния позволяют вычислять имитовставку без знания ключа, поэтому они
+     хранятся только в контексте и уничтожаются вместе с ним.                                      */
 /* ----------------------------------------------------------------------------------------------- */
  typedef struct hmac {
   /*! \brief Контекст секретного ключа */
@@ -941,12 +1093,22 @@ extern "C" {
   /*! \brief Идентификатор второго алгоритма хеширования,
       применяется только в алгоритмах семейства NMAC (см. Р 1323565.1.022-2018) */
    ak_oid nmac_second_hash_oid;
+  /*! \brief Состояние функции хеширования после обработки ключа, сложенного с константой ipad. */
+   struct streebog istate;
+  /*! \brief Состояние функции хеширования после обработки ключа, сложенного с константой opad. */
+   struct streebog ostate;
+  /*! \brief Флаг того, что состояния istate и ostate вычислены для текущего значения ключа. */
+   bool_t precomputed;
 } *ak_hmac;
 
 /*! \brief Создание секретного ключа алгоритма выработки имитовставки HMAC на основе функции Стрибог256. */
  dll_export int ak_hmac_create_streebog256( ak_hmac );
 /*! \brief Создание секретного ключа алгоритма выработки имитовставки HMAC на основе функции Стрибог512. */
  dll_export int ak_hmac_create_streebog512( ak_hmac );
+/*! \brief Создание секретного ключа алгоритма HMAC на основе древовидного хеширования Стрибог256. */
+ dll_export int ak_hmac_create_tree_streebog256( ak_hmac );
+/*! \brief Создание секретного ключа алгоритма HMAC на основе древовидного хеширования Стрибог512. */
+ dll_export int ak_hmac_create_tree_streebog512( ak_hmac );
 /*! \brief Создание секретного ключа алгоритма выработки имитовставки NMAC, использующего две функции семейства Стрибог. */
  dll_export int ak_hmac_create_nmac( ak_hmac );
 /*! \brief Создание секретного ключа алгоритма выработки имитовставки HMAC c помощью заданного oid. */
@@ -1069,6 +1231,9 @@ extern "C" {
 /*! \brief Вычисление имитовставки для заданной области памяти. */
  dll_export int ak_hmac_ptr( ak_hmac , const ak_pointer , const size_t ,
                                                                        ak_pointer , const size_t );
+/*! \brief Вычисление имитовставок для нескольких независимых сообщений. */
+ dll_export int ak_hmac_ptr_multi( ak_hmac * , const ak_pointer * , const size_t * ,
+                                                   ak_pointer * , const size_t , const size_t );
 /*! \brief Вычисление имитовставки для заданного файла. */
  dll_export int ak_hmac_file( ak_hmac , const char* , ak_pointer , const size_t );
 /*! \brief Развертка ключевого вектора из пароля (согласно Р 50.1.111-2016, раздел 4) */
@@ -1330,6 +1495,12 @@ extern "C" {
 /*! \brief Модульное возведение в степень в представлении Монтгомери. */
  dll_export void ak_mpzn_modpow_montgomery( ak_uint64 *, ak_uint64 *, ak_uint64 *,
                                                            ak_uint64 *, ak_uint64, const size_t );
+/*! \brief Обращение вычета в представлении Монтгомери. */
+ dll_export void ak_mpzn_inverse_montgomery( ak_uint64 *, ak_uint64 *, ak_uint64 *,
+                                             ak_uint64 *, ak_uint64, const size_t, const bool_t );
+/*! \brief Одновременное обращение массива вычетов в представлении Монтгомери. */
+ dll_export void ak_mpzn_inverse_montgomery_batch( ak_uint64 *, ak_uint64 *, const size_t,
+                                              ak_uint64 *, ak_uint64 *, ak_uint64, const size_t );
 /* ----------------------------------------------------------------------------------------------- */
 #ifdef AK_HAVE_GMP_H
 /*! \brief Преобразование ak_mpznxxx в mpz_t. */
@@ -1365,6 +1536,10 @@ extern "C" {
 };
 /*! \brief Контекст точки эллиптической кривой в короткой форме Вейерштрасса */
  typedef struct wpoint *ak_wpoint;
+/*! \brief Ширина окна представления wNAF, используемого при вычислении суммы кратных точек. */
+ #define ak_wpoint_wnaf_width  (5)
+/*! \brief Количество нечетных кратных точки, хранимых в таблице для представления wNAF. */
+ #define ak_wpoint_wnaf_points  ( 1 << ( ak_wpoint_wnaf_width - 2 ))
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Инициализация и присвоение контексту значения образующей точки эллиптической кривой. */
@@ -1387,6 +1562,11 @@ extern "C" {
  dll_export void ak_wpoint_reduce( ak_wpoint , ak_wcurve );
 /*! \brief Вычисление кратной точки эллиптической кривой. */
  dll_export void ak_wpoint_pow( ak_wpoint , ak_wpoint , ak_uint64 *, size_t , ak_wcurve );
+/*! \brief Вычисление кратной точки для образующей точки эллиптической кривой. */
+ dll_export void ak_wpoint_pow_base( ak_wpoint , ak_uint64 *, size_t , ak_wcurve );
+/*! \brief Вычисление суммы кратных точек с переменным временем работы. */
+ dll_export void ak_wpoint_pow2( ak_wpoint , ak_wpoint , ak_uint64 *, ak_wpoint , ak_uint64 *,
+                                                                              size_t , ak_wcurve );
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Класс, реализующий эллиптическую кривую, заданную в короткой форме Вейерштрасса
@@ -1494,6 +1674,16 @@ extern "C" {
  dll_export void ak_gf256_mul_uint64( ak_pointer z, ak_pointer x, ak_pointer y );
 /*! \brief Умножение двух элементов поля \f$ \mathbb F_{2^{512}}\f$. */
  dll_export void ak_gf512_mul_uint64( ak_pointer z, ak_pointer x, ak_pointer y );
+/*! \brief Накопление суммы попарных произведений элементов поля \f$ \mathbb F_{2^{64}}\f$. */
+ dll_export void ak_gf64_mul_sum_uint64( ak_pointer z, ak_pointer x, ak_pointer y, const size_t count );
+/*! \brief Накопление суммы попарных произведений элементов поля \f$ \mathbb F_{2^{128}}\f$. */
+ dll_export void ak_gf128_mul_sum_uint64( ak_pointer z, ak_pointer x, ak_pointer y, const size_t count );
+/*! \brief Накопление суммы попарных произведений элементов поля \f$ \mathbb F_{2^{64}}\f$
+    с отложенным приведением (реализация выбирается в зависимости от процессора). */
+ dll_export void ak_gf64_mul_sum( ak_pointer z, ak_pointer x, ak_pointer y, const size_t count );
+/*! \brief Накопление суммы попарных произведений элементов поля \f$ \mathbb F_{2^{128}}\f$
+    с отложенным приведением (реализация выбирается в зависимости от процессора). */
+ dll_export void ak_gf128_mul_sum( ak_pointer z, ak_pointer x, ak_pointer y, const size_t count );
 
 #ifdef AK_HAVE_BUILTIN_CLMULEPI64
 /*! \brief Умножение двух элементов поля \f$ \mathbb F_{2^{64}}\f$. */
@@ -1635,6 +1825,21 @@ extern "C" {
   ak_tlv next;
 };
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief ASN1 дерево, все уровни и узлы которого размещены в одной области памяти.
+    \details Дерево создается функцией ak_asn1_arena_decode() и ссылается на данные
+    декодированной der-последовательности без их копирования; память освобождается
+    одним вызовом функции ak_asn1_arena_destroy().                                                 */
+/* ----------------------------------------------------------------------------------------------- */
+ typedef struct asn1_arena {
+  /*! \brief корневой уровень дерева */
+   ak_asn1 root;
+  /*! \brief область памяти, в которой размещены уровни и узлы дерева */
+   ak_pointer memory;
+  /*! \brief размер области памяти (в октетах) */
+   size_t size;
+ } *ak_asn1_arena;
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Структура, используемая для передачи информации о битовых строках. */
  typedef struct bit_string {
@@ -1844,6 +2049,11 @@ extern "C" {
  dll_export int ak_asn1_encode( ak_asn1 , ak_pointer , size_t * );
 /*! \brief Декодирование ASN1 дерева из заданной DER-последовательности октетов. */
  dll_export int ak_asn1_decode( ak_asn1 , const ak_pointer , const size_t , bool_t );
+/*! \brief Декодирование ASN1 дерева без копирования данных с размещением всех узлов
+    в одной области памяти. */
+ dll_export int ak_asn1_arena_decode( ak_asn1_arena , const ak_pointer , const size_t );
+/*! \brief Освобождение памяти, занимаемой ASN1 деревом, созданным функцией ak_asn1_arena_decode(). */
+ dll_export int ak_asn1_arena_destroy( ak_asn1_arena );
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Экспорт ASN.1 дерева в файл в виде der-последовательности. */
@@ -1967,6 +2177,9 @@ extern "C" {
   struct wpoint qpoint;
  /*! \brief флаги состояния ключа */
   ak_uint64 flags;
+ /*! \brief таблица нечетных кратных точки qpoint, используемая при проверке подписи
+     (вычисляется функцией ak_verifykey_precompute_table()) */
+  struct wpoint qtable[ak_wpoint_wnaf_points];
 } *ak_verifykey;
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -1986,6 +2199,8 @@ extern "C" {
  dll_export int ak_verifykey_set_number( ak_verifykey );
 /*! \brief Уничтожение контекста открытого ключа. */
  dll_export int ak_verifykey_destroy( ak_verifykey );
+/*! \brief Вычисление таблицы кратных точек открытого ключа для ускорения проверки подписей. */
+ dll_export int ak_verifykey_precompute_table( ak_verifykey );
 
 /* ----------------------------------------------------------------------------------------------- */
 /** @} *//** \addtogroup signalg-doc Алгоритмы выработки и проверки электроной подписи
@@ -2006,6 +2221,10 @@ extern "C" {
 /*! \brief Проверка электронной подписи для вычисленного заранее значения хеш-функции. */
  dll_export bool_t ak_verifykey_verify_hash( ak_verifykey , const ak_pointer ,
                                                                        const size_t , ak_pointer );
+/*! \brief Одновременная проверка массива электронных подписей для вычисленных заранее значений
+    хеш-функции. */
+ dll_export int ak_verifykey_verify_batch( ak_verifykey * , ak_pointer * , const size_t * ,
+                                    ak_pointer * , const size_t , bool_t * , const size_t );
 /*! \brief Проверка электронной подписи для заданной области памяти. */
  dll_export bool_t ak_verifykey_verify_ptr( ak_verifykey , const ak_pointer ,
                                                                        const size_t , ak_pointer );